@@ -70,6 +70,7 @@ class Signal:
     max_val: float
     unit: str
     comment: Optional[str] = None
+    mux: Optional[str] = None  # 'M' = mux selector, 'm<N>' = present when selector is N
 
 
 @dataclass
@@ -97,9 +98,9 @@ def parse_dbc_file(filepath: Path) -> tuple[dict, dict]:
         r'BO_ (\d+) (\w+): (\d+) (\w+)'
     )
     
-    # Parse signals: SG_ <SignalName> : <StartBit>|<Length>@<ByteOrder><Sign> (<Scale>,<Offset>) [<Min>|<Max>] "<Unit>" <ReceivingNodes>
+    # Parse signals: SG_ <SignalName> [M|m<N>] : <StartBit>|<Length>@<ByteOrder><Sign> (<Scale>,<Offset>) [<Min>|<Max>] "<Unit>" <ReceivingNodes>
     sig_pattern = re.compile(
-        r'SG_ (\w+) : (\d+)\|(\d+)@([01])([+-]) \(([^,]+),([^)]+)\) \[([^|]+)\|([^\]]+)\] "([^"]*)"'
+        r'SG_ (\w+) (?:(M|m\d+) )?: (\d+)\|(\d+)@([01])([+-]) \(([^,]+),([^)]+)\) \[([^|]+)\|([^\]]+)\] "([^"]*)"'
     )
     
     # Parse comments
@@ -135,15 +136,16 @@ def parse_dbc_file(filepath: Path) -> tuple[dict, dict]:
         if sig_match and current_message:
             signal = Signal(
                 name=sig_match.group(1),
-                start_bit=int(sig_match.group(2)),
-                length=int(sig_match.group(3)),
-                byte_order=sig_match.group(4),
-                signed=sig_match.group(5) == '-',
-                scale=float(sig_match.group(6)),
-                offset=float(sig_match.group(7)),
-                min_val=float(sig_match.group(8)),
-                max_val=float(sig_match.group(9)),
-                unit=sig_match.group(10)
+                start_bit=int(sig_match.group(3)),
+                length=int(sig_match.group(4)),
+                byte_order=sig_match.group(5),
+                signed=sig_match.group(6) == '-',
+                scale=float(sig_match.group(7)),
+                offset=float(sig_match.group(8)),
+                min_val=float(sig_match.group(9)),
+                max_val=float(sig_match.group(10)),
+                unit=sig_match.group(11),
+                mux=sig_match.group(2)
             )
             current_message.signals.append(signal)
             i += 1
@@ -238,6 +240,9 @@ def format_signal(sig: Signal, indent: str = "  ") -> str:
     lines = [f"{indent}{sig.name}:"]
     lines.append(f"{indent}  Bits: {sig.start_bit}|{sig.length} ({byte_order}, {signed})")
     
+    if sig.mux:
+        lines.append(f"{indent}  Mux: {sig.mux}")
+    
     if sig.scale != 1 or sig.offset != 0:
         lines.append(f"{indent}  Formula: raw * {sig.scale} + {sig.offset}")
     
@@ -0,0 +1,175 @@
+#!/usr/bin/env python3
+"""
+Convert a CAN flight recorder capture (CFR1) to GVRET CSV.
+
+The firmware freezes a pre/post trigger window in PSRAM (CanFlightRecorder)
+and uploads it via the system.recorder command (op=read) as base64 chunks.
+This script turns the reassembled capture into the same GVRET CSV format
+SavvyCAN writes, so the other analysis scripts here can read it directly.
+
+Input can be either:
+  - the raw binary capture, or
+  - a text file with the base64 "data" fields of consecutive read replies,
+    one chunk per line (--base64)
+
+Usage:
+    python flight_recorder_to_gvret.py capture.bin [output.csv]
+    python flight_recorder_to_gvret.py --base64 chunks.txt [output.csv]
+
+Timestamps are the device's micros() clock (unwrapped), so the conversion
+is lossless: every frame keeps its exact ID, DLC, data and arrival time.
+
+The recorder sees only frames that passed the TWAI acceptance filter.
+Version 2 captures carry the installed filter code/mask, which is printed
+so a filtered trace is not mistaken for the raw bus.
+"""
+
+import base64
+import csv
+import os
+import struct
+import sys
+
+CAPTURE_HEADER = struct.Struct('<4sBBHIIIIII')   # 32 bytes (version 1)
+FILTER_HEADER = struct.Struct('<IIB3x')          # 12 bytes (version 2)
+BLOCK_HEADER = struct.Struct('<IIHH')            # 12 bytes
+
+TRIGGERS = {
+    0: 'none', 1: 'manual', 2: 'chargeStatus', 3: 'chargeAborted',
+    4: 'bapContinuationError', 5: 'wakeFailed', 6: 'busOff',
+}
+
+
+def read_varint(buf: bytes, pos: int):
+    """Decode an unsigned LEB128 value, return (value, new_pos)."""
+    value = 0
+    shift = 0
+    while True:
+        byte = buf[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        if not byte & 0x80:
+            return value, pos
+        shift += 7
+
+
+def decode_capture(capture: bytes):
+    """
+    Decode a CFR1 capture.
+
+    Returns (header dict, list of (timestamp_us, can_id, extended, data)).
+    """
+    if len(capture) < CAPTURE_HEADER.size:
+        raise ValueError('capture too short')
+
+    (magic, version, trigger, block_count, trigger_us, pre_ms, post_ms,
+     record_count, payload_bytes, dropped) = CAPTURE_HEADER.unpack_from(capture, 0)
+    if magic != b'CFR1':
+        raise ValueError(f'bad magic {magic!r}')
+    if version not in (1, 2):
+        raise ValueError(f'unsupported version {version}')
+
+    header = {
+        'trigger': TRIGGERS.get(trigger, str(trigger)),
+        'trigger_us': trigger_us,
+        'pre_ms': pre_ms,
+        'post_ms': post_ms,
+        'blocks': block_count,
+        'records': record_count,
+        'dropped': dropped,
+        'filter': None,     # Unknown (version 1)
+    }
+
+    frames = []
+    pos = CAPTURE_HEADER.size
+    if version >= 2:
+        code, mask, single = FILTER_HEADER.unpack_from(capture, pos)
+        pos += FILTER_HEADER.size
+        header['filter'] = (code, mask, bool(single))
+    wrap_offset = 0
+    last_abs = None
+
+    for _ in range(block_count):
+        first_us, _last_us, used, count = BLOCK_HEADER.unpack_from(capture, pos)
+        pos += BLOCK_HEADER.size
+        end = pos + used
+
+        # Unwrap the 32-bit micros() clock across blocks
+        base = first_us + wrap_offset
+        if last_abs is not None and base < last_abs - (1 << 31):
+            wrap_offset += 1 << 32
+            base += 1 << 32
+
+        ts = base
+        for _ in range(count):
+            flags = capture[pos]
+            pos += 1
+            delta, pos = read_varint(capture, pos)
+            ts += delta
+            extended = bool(flags & 0x80)
+            dlc = flags & 0x0F
+            id_len = 4 if extended else 2
+            can_id = int.from_bytes(capture[pos:pos + id_len], 'little')
+            pos += id_len
+            data = capture[pos:pos + dlc]
+            pos += dlc
+            frames.append((ts, can_id, extended, data))
+
+        if pos != end:
+            raise ValueError(f'block length mismatch at offset {pos} (expected {end})')
+        last_abs = ts
+
+    if len(frames) != record_count:
+        raise ValueError(f'record count mismatch: {len(frames)} != {record_count}')
+
+    return header, frames
+
+
+def write_gvret(frames, output_file: str):
+    """Write frames as GVRET CSV (SavvyCAN layout)."""
+    with open(output_file, 'w', newline='') as f:
+        writer = csv.writer(f)
+        writer.writerow(['Time Stamp', 'ID', 'Extended', 'Dir', 'Bus', 'LEN',
+                         'D1', 'D2', 'D3', 'D4', 'D5', 'D6', 'D7', 'D8'])
+        for ts, can_id, extended, data in frames:
+            row = [str(ts), f'{can_id:08X}', 'true' if extended else 'false',
+                   'Rx', '0', str(len(data))]
+            row += [f'{b:02X}' for b in data]
+            row += [''] * (8 - len(data))
+            writer.writerow(row)
+
+
+def load_capture(path: str, is_base64: bool) -> bytes:
+    if not is_base64:
+        with open(path, 'rb') as f:
+            return f.read()
+    with open(path, 'r') as f:
+        return b''.join(base64.b64decode(line.strip()) for line in f if line.strip())
+
+
+if __name__ == '__main__':
+    args = sys.argv[1:]
+    is_base64 = '--base64' in args
+    args = [a for a in args if a != '--base64']
+    if not args:
+        print(__doc__)
+        sys.exit(1)
+
+    input_file = args[0]
+    output_file = args[1] if len(args) > 1 else os.path.splitext(input_file)[0] + '_gvret.csv'
+
+    header, frames = decode_capture(load_capture(input_file, is_base64))
+    write_gvret(frames, output_file)
+
+    print(f"Trigger: {header['trigger']} at {header['trigger_us']} us "
+          f"(window -{header['pre_ms']}ms/+{header['post_ms']}ms)")
+    print(f"Blocks: {header['blocks']}, frames: {len(frames)}, dropped: {header['dropped']}")
+    if header['filter'] is None:
+        print("Filter: not recorded (version 1 capture), IDs may be missing")
+    elif header['filter'][1] == 0xFFFFFFFF:
+        print("Filter: accept all (raw bus)")
+    else:
+        code, mask, single = header['filter']
+        print(f"Filter: {'single' if single else 'dual'} code=0x{code:08X} mask=0x{mask:08X} "
+              f"- frames the filter drops are not in this capture")
+    print(f"Output: {output_file}")
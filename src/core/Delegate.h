@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * Delegate - Compile-time bound callback (object pointer + stub)
+ *
+ * Binding a member function makes it a template argument, so the stub is a
+ * direct call that the compiler can inline (when the body is visible) instead
+ * of going through std::function's type-erased manager. Two words, no heap,
+ * trivially copyable - safe to keep in fixed arrays on the CAN path.
+ *
+ * Usage:
+ *   auto d = Delegate<void(const PlugState&)>::bind<BatteryManager, &BatteryManager::onPlugStateUpdate>(this);
+ *   d(plug);
+ *
+ * std::function remains the fallback where callers need captures.
+ */
+template<typename Signature>
+class Delegate;
+
+template<typename... Args>
+class Delegate<void(Args...)> {
+public:
+    using Stub = void (*)(void*, Args...);
+
+    Delegate() = default;
+
+    /**
+     * Bind a member function; Method is resolved at compile time.
+     * A virtual Method still dispatches through the vtable - for those,
+     * bind a stub that makes a qualified call (see bindStub()).
+     */
+    template<typename T, void (T::*Method)(Args...)>
+    static Delegate bind(T* object) {
+        return Delegate(object, &methodStub<T, Method>);
+    }
+
+    /**
+     * Bind a static stub taking the object as void*, e.g. one that calls
+     * static_cast<T*>(object)->T::method(...) (qualified, non-virtual).
+     */
+    template<Stub Function>
+    static Delegate bindStub(void* object) {
+        return Delegate(object, Function);
+    }
+
+    explicit operator bool() const { return stub != nullptr; }
+
+    bool operator==(const Delegate& other) const {
+        return object == other.object && stub == other.stub;
+    }
+
+    void operator()(Args... args) const {
+        stub(object, args...);
+    }
+
+private:
+    void* object = nullptr;
+    Stub stub = nullptr;
+
+    Delegate(void* object, Stub stub) : object(object), stub(stub) {}
+
+    template<typename T, void (T::*Method)(Args...)>
+    static void methodStub(void* object, Args... args) {
+        (static_cast<T*>(object)->*Method)(args...);
+    }
+};
+
+/**
+ * DelegateList - Fixed-capacity subscriber list of Delegates (no heap).
+ */
+template<typename Signature, size_t Capacity>
+class DelegateList;
+
+template<typename... Args, size_t Capacity>
+class DelegateList<void(Args...), Capacity> {
+public:
+    /**
+     * Add a subscriber.
+     * @return false if the list is full
+     */
+    bool add(const Delegate<void(Args...)>& delegate) {
+        if (count >= Capacity || !delegate) {
+            return false;
+        }
+        items[count++] = delegate;
+        return true;
+    }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    void operator()(Args... args) const {
+        for (size_t i = 0; i < count; i++) {
+            items[i](args...);
+        }
+    }
+
+private:
+    Delegate<void(Args...)> items[Capacity];
+    size_t count = 0;
+};
@@ -155,11 +155,12 @@ void DeviceController::initModules()
         Serial.println("[DEVICE] VehicleManager setup failed!");
     }
 
-    // Connect CAN frame callback to VehicleManager
-    canManager->setFrameCallback([this](uint32_t canId, const uint8_t *data, uint8_t dlc, bool extended)
-                                 { vehicleManager->onCanFrame(canId, data, dlc, extended); });
+    // Connect CAN frame batches to VehicleManager (one lock per batch,
+    // bound at compile time - direct call instead of a vtable dispatch)
+    canManager->bindFrameSink(vehicleManager);
 
-    // Now start CAN
+    // Now start CAN - at the cached bitrate, or detect it first (listen-only)
+    canManager->setAutobaud(true);
     canManager->start();
 
     Serial.println("[DEVICE] All modules initialized");
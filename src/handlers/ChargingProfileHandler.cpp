@@ -238,7 +238,8 @@ CommandResult ChargingProfileHandler::handleRefresh(CommandContext& ctx) {
     Serial.println("[PROFILES] Requesting profile refresh from vehicle");
     
     ChargingProfileManager& pm = vehicleManager->profiles();
-    bool success = pm.requestAllProfiles();
+    uint32_t maxAgeMs = ctx.params["maxAgeMs"] | (uint32_t)BapPropertyCache::DEFAULT_MAX_AGE_MS;
+    bool success = pm.requestAllProfiles(maxAgeMs);
     
     if (success) {
         return CommandResult::ok("Profile refresh requested");
@@ -2,6 +2,8 @@
 #include "../core/DeviceController.h"
 #include "../core/CommandRouter.h"
 #include "../modules/LinkManager.h"
+#include "../modules/CanManager.h"
+#include <base64.h>
 
 // Static action list
 const char* SystemHandler::supportedActions[] = {
@@ -9,9 +11,12 @@ const char* SystemHandler::supportedActions[] = {
     "sleep",
     "wakeup",
     "telemetry",
-    "info"
+    "info",
+    "canProfile",
+    "recorder",
+    "busLoad"
 };
-const size_t SystemHandler::supportedActionCount = 5;
+const size_t SystemHandler::supportedActionCount = 8;
 
 SystemHandler::SystemHandler(DeviceController* deviceController, CommandRouter* commandRouter)
     : deviceController(deviceController), commandRouter(commandRouter) {
@@ -35,6 +40,15 @@ CommandResult SystemHandler::handleCommand(CommandContext& ctx) {
     else if (ctx.actionName == "info") {
         return handleInfo(ctx);
     }
+    else if (ctx.actionName == "canProfile") {
+        return handleCanProfile(ctx);
+    }
+    else if (ctx.actionName == "recorder") {
+        return handleRecorder(ctx);
+    }
+    else if (ctx.actionName == "busLoad") {
+        return handleBusLoad(ctx);
+    }
     
     return CommandResult::notSupported();
 }
@@ -141,5 +155,172 @@ CommandResult SystemHandler::handleInfo(CommandContext& ctx) {
     // Runtime
     result.data["uptime"] = millis();
     
+    // CAN bitrate (autobaud detection time and confidence)
+    CanManager* canManager = deviceController ? deviceController->getCanManager() : nullptr;
+    if (canManager) {
+        const CanAutobaudResult& autobaud = canManager->getAutobaudResult();
+        JsonObject can = result.data["can"].to<JsonObject>();
+        can["speed"] = CanManager::speedName(canManager->getSpeed());
+        can["autobaud"] = canManager->isAutobaudEnabled();
+        if (autobaud.valid) {
+            can["source"] = autobaud.fromCache ? "cache" : "detected";
+            can["detectMs"] = autobaud.durationMs;
+            can["confidence"] = autobaud.confidence;
+            can["frames"] = autobaud.frames;
+            can["busErrors"] = autobaud.busErrors;
+        } else {
+            can["source"] = "configured";
+        }
+    }
+    
+    return result;
+}
+
+CommandResult SystemHandler::handleCanProfile(CommandContext& ctx) {
+    if (!deviceController) {
+        return CommandResult::error("DeviceController not available");
+    }
+    
+    CanManager* canManager = deviceController->getCanManager();
+    if (!canManager) {
+        return CommandResult::error("CanManager not available");
+    }
+    
+    CanIdProfiler& profiler = canManager->profiler();
+    
+    // Optional controls (applied before reporting)
+    if (ctx.params["enabled"].is<bool>()) {
+        profiler.setEnabled(ctx.params["enabled"].as<bool>());
+    }
+    if (ctx.params["telemetry"].is<bool>()) {
+        profiler.setTelemetryEnabled(ctx.params["telemetry"].as<bool>());
+    }
+    
+    CommandResult result = CommandResult::ok();
+    result.data["enabled"] = profiler.isEnabled();
+    result.data["telemetry"] = profiler.isTelemetryEnabled();
+    result.data["idCount"] = profiler.getIdCount();
+    result.data["tableOverflows"] = profiler.getTableOverflows();
+    result.data["jitterBaseUs"] = CanIdProfiler::JITTER_BUCKET_BASE_US;
+    profiler.toJson(result.data["ids"].to<JsonArray>(), true);
+    
+    // Reset after reporting so the caller gets the data collected so far
+    if (ctx.params["reset"] | false) {
+        profiler.reset();
+        result.data["reset"] = true;
+    }
+    
+    Serial.printf("[SYSTEM] CAN profile: %u IDs, %lu overflows\r\n",
+        (unsigned)profiler.getIdCount(), profiler.getTableOverflows());
+    return result;
+}
+
+CommandResult SystemHandler::handleBusLoad(CommandContext& ctx) {
+    if (!deviceController) {
+        return CommandResult::error("DeviceController not available");
+    }
+    
+    CanManager* canManager = deviceController->getCanManager();
+    if (!canManager) {
+        return CommandResult::error("CanManager not available");
+    }
+    
+    CanBusLoad& load = canManager->busLoad();
+    
+    if (ctx.params["telemetry"].is<bool>()) {
+        load.setTelemetryEnabled(ctx.params["telemetry"].as<bool>());
+    }
+    
+    CommandResult result = CommandResult::ok();
+    load.toJson(result.data.to<JsonObject>());
+    result.data["telemetry"] = load.isTelemetryEnabled();
+    result.data["missedTotal"] = canManager->getMissedCount();
+    result.data["ringOverflowsTotal"] = canManager->getRingOverflows();
+    
+    // Reset after reporting (applied by the CAN task on its next rollover)
+    if (ctx.params["reset"] | false) {
+        load.reset();
+        result.data["reset"] = true;
+    }
+    
+    const CanBusLoad::Window& minute = load.getWindow(CanBusLoad::WINDOW_COUNT - 1);
+    Serial.printf("[SYSTEM] Bus load: %.1f%% over %u s, peak %lu frames/s\r\n",
+        load.loadPercent(minute, false), minute.seconds, load.getPeakFramesPerSecond());
+    return result;
+}
+
+CommandResult SystemHandler::handleRecorder(CommandContext& ctx) {
+    if (!deviceController) {
+        return CommandResult::error("DeviceController not available");
+    }
+    
+    CanManager* canManager = deviceController->getCanManager();
+    if (!canManager) {
+        return CommandResult::error("CanManager not available");
+    }
+    
+    CanFlightRecorder& recorder = canManager->recorder();
+    const char* op = ctx.params["op"] | "status";
+    
+    if (strcmp(op, "read") == 0) {
+        size_t total = recorder.getCaptureSize();
+        if (total == 0) {
+            return CommandResult::error("No frozen capture");
+        }
+        
+        uint32_t offset = ctx.params["offset"] | 0;
+        size_t length = ctx.params["length"] | RECORDER_MAX_CHUNK;
+        if (length == 0 || length > RECORDER_MAX_CHUNK) {
+            length = RECORDER_MAX_CHUNK;
+        }
+        if (offset >= total) {
+            return CommandResult::invalidParams("offset past end of capture");
+        }
+        
+        uint8_t* chunk = static_cast<uint8_t*>(malloc(length));
+        if (!chunk) {
+            return CommandResult::error("Out of memory");
+        }
+        size_t copied = recorder.readCapture(offset, chunk, length);
+        
+        CommandResult result = CommandResult::ok();
+        result.data["offset"] = offset;
+        result.data["length"] = copied;
+        result.data["total"] = total;
+        result.data["data"] = base64::encode(chunk, copied);
+        free(chunk);
+        return result;
+    }
+    
+    if (strcmp(op, "trigger") == 0) {
+        recorder.trigger(CanFlightRecorder::Trigger::MANUAL);
+    }
+    else if (strcmp(op, "arm") == 0) {
+        recorder.arm();
+    }
+    else if (strcmp(op, "config") == 0) {
+        uint32_t preMs = ctx.params["preMs"] | recorder.getPreTriggerMs();
+        uint32_t postMs = ctx.params["postMs"] | recorder.getPostTriggerMs();
+        recorder.setWindow(preMs, postMs);
+        if (ctx.params["triggers"].is<uint32_t>()) {
+            recorder.setTriggerMask(ctx.params["triggers"].as<uint32_t>());
+        }
+    }
+    else if (strcmp(op, "status") != 0) {
+        return CommandResult::invalidParams("op must be status, trigger, arm, config or read");
+    }
+    
+    CommandResult result = CommandResult::ok();
+    result.data["state"] = CanFlightRecorder::stateName(recorder.getState());
+    result.data["trigger"] = CanFlightRecorder::triggerName(recorder.getTriggerReason());
+    result.data["triggers"] = recorder.getTriggerMask();
+    result.data["preMs"] = recorder.getPreTriggerMs();
+    result.data["postMs"] = recorder.getPostTriggerMs();
+    result.data["bufferBytes"] = recorder.getBufferBytes();
+    result.data["retainedMs"] = recorder.getRetainedMs();
+    result.data["frames"] = recorder.getRecordedFrames();
+    result.data["evictedBlocks"] = recorder.getEvictedBlocks();
+    result.data["captures"] = recorder.getCaptureCount();
+    result.data["captureBytes"] = recorder.getCaptureSize();
     return result;
 }
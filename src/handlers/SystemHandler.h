@@ -15,7 +15,15 @@ class CommandRouter;
  * - system.sleep      - Force device to enter deep sleep
  * - system.wakeup     - Acknowledge wakeup (no-op, confirms device is awake)
  * - system.telemetry  - Force immediate telemetry send
- * - system.info       - Return detailed device info
+ * - system.info       - Return detailed device info (incl. CAN bitrate/autobaud)
+ * - system.canProfile - Per-CAN-ID rate/jitter profile
+ *                       (params: reset, enabled, telemetry - all optional bools)
+ * - system.recorder   - CAN flight recorder control and capture upload
+ *                       (params: op = status|trigger|arm|config|read,
+ *                        config: preMs, postMs, triggers (bitmask)
+ *                        read: offset, length -> base64 chunk)
+ * - system.busLoad    - Bus utilization over 1/10/60 s with RX loss deltas
+ *                       (params: telemetry, reset - optional bools)
  */
 class SystemHandler : public ICommandHandler {
 public:
@@ -41,6 +49,12 @@ private:
     CommandResult handleWakeup(CommandContext& ctx);
     CommandResult handleTelemetry(CommandContext& ctx);
     CommandResult handleInfo(CommandContext& ctx);
+    CommandResult handleCanProfile(CommandContext& ctx);
+    CommandResult handleRecorder(CommandContext& ctx);
+    CommandResult handleBusLoad(CommandContext& ctx);
+    
+    // Max raw bytes per recorder read (base64 grows this by 4/3 in the reply)
+    static constexpr size_t RECORDER_MAX_CHUNK = 2048;
     
     // Supported actions list
     static const char* supportedActions[];
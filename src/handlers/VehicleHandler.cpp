@@ -9,9 +9,11 @@ const char* VehicleHandler::supportedActions[] = {
     "startCharging",
     "stopCharging",
     "requestState",
-    "getState"
+    "getState",
+    "setCustomSignals",
+    "getCustomSignals"
 };
-const size_t VehicleHandler::supportedActionCount = 6;
+const size_t VehicleHandler::supportedActionCount = 8;
 
 VehicleHandler::VehicleHandler(VehicleManager* vehicleManager, CommandRouter* commandRouter)
     : vehicleManager(vehicleManager), commandRouter(commandRouter) {
@@ -42,6 +44,12 @@ CommandResult VehicleHandler::handleCommand(CommandContext& ctx) {
     else if (ctx.actionName == "getState") {
         return handleGetState(ctx);
     }
+    else if (ctx.actionName == "setCustomSignals") {
+        return handleSetCustomSignals(ctx);
+    }
+    else if (ctx.actionName == "getCustomSignals") {
+        return handleGetCustomSignals(ctx);
+    }
     
     return CommandResult::notSupported();
 }
@@ -166,15 +174,19 @@ CommandResult VehicleHandler::handleStopCharging(CommandContext& ctx) {
 CommandResult VehicleHandler::handleRequestState(CommandContext& ctx) {
     Serial.println("[VEHICLE] Requesting BAP states...");
     
-    // Request all BAP states from the vehicle
-    bool plugOk = vehicleManager->batteryControl().requestPlugState();
-    bool chargeOk = vehicleManager->batteryControl().requestChargeState();
-    bool climateOk = vehicleManager->batteryControl().requestClimateState();
+    // Request all BAP states from the vehicle; values the car already pushed
+    // within maxAgeMs (and its heartbeat period) are not re-read
+    uint32_t maxAgeMs = ctx.params["maxAgeMs"] | (uint32_t)BapPropertyCache::DEFAULT_MAX_AGE_MS;
+    uint32_t hits = vehicleManager->bapProperties().getHits();
+    bool plugOk = vehicleManager->batteryControl().requestPlugState(maxAgeMs);
+    bool chargeOk = vehicleManager->batteryControl().requestChargeState(maxAgeMs);
+    bool climateOk = vehicleManager->batteryControl().requestClimateState(maxAgeMs);
     
     CommandResult result = CommandResult::ok("State requests sent");
     result.data["plugRequested"] = plugOk;
     result.data["chargeRequested"] = chargeOk;
     result.data["climateRequested"] = climateOk;
+    result.data["cached"] = vehicleManager->bapProperties().getHits() - hits;
     
     return result;
 }
@@ -194,13 +206,13 @@ CommandResult VehicleHandler::handleGetState(CommandContext& ctx) {
     JsonObject battery = result.data["battery"].to<JsonObject>();
     battery["soc"] = battState.soc;
     battery["socSource"] = battState.socSource == DataSource::BAP ? "bap" : "can";
-    battery["powerKw"] = battState.powerKw;
-    battery["temperature"] = battState.temperature;
+    battery["powerKw"] = battState.powerKw();
+    battery["temperature"] = battState.temperature();
     battery["charging"] = battState.charging;
     battery["chargingSource"] = battState.chargingSource == DataSource::BAP ? "bap" : "can";
     
-    // Charging details (from BAP) - available when chargingUpdate is non-zero
-    if (battState.chargingUpdate > 0) {
+    // Charging details (from BAP) - available once chargingUpdate has been stamped
+    if (battState.chargingUpdate.valid()) {
         battery["chargingMode"] = battState.chargingMode;
         battery["chargingStatus"] = battState.chargingStatus;
         battery["chargingAmps"] = battState.chargingAmps;
@@ -211,7 +223,7 @@ CommandResult VehicleHandler::handleGetState(CommandContext& ctx) {
     // Drive state
     JsonObject drive = result.data["drive"].to<JsonObject>();
     drive["ignitionOn"] = driveState.ignitionOn;
-    drive["speedKmh"] = driveState.speedKmh;
+    drive["speedKmh"] = driveState.speedKmh();
     drive["odometerKm"] = driveState.odometerKm;
     
     // Body state
@@ -230,8 +242,8 @@ CommandResult VehicleHandler::handleGetState(CommandContext& ctx) {
     
     // Climate state (unified)
     JsonObject climate = result.data["climate"].to<JsonObject>();
-    climate["insideTemp"] = climState.insideTemp;
-    climate["outsideTemp"] = climState.outsideTemp;
+    climate["insideTemp"] = climState.insideTemp();
+    climate["outsideTemp"] = climState.outsideTemp();
     climate["active"] = climState.climateActive;
     climate["heating"] = climState.heating;
     climate["cooling"] = climState.cooling;
@@ -245,3 +257,91 @@ CommandResult VehicleHandler::handleGetState(CommandContext& ctx) {
     
     return result;
 }
+
+// ============================================================================
+// Custom Signal Table Commands
+// ============================================================================
+
+CommandResult VehicleHandler::handleSetCustomSignals(CommandContext& ctx) {
+    if (!ctx.params["signals"].is<JsonArray>()) {
+        return CommandResult::invalidParams("Missing 'signals' array");
+    }
+    JsonArray list = ctx.params["signals"].as<JsonArray>();
+    if (list.size() > CustomSignalTable::MAX_SIGNALS) {
+        return CommandResult::invalidParams("Too many signals");
+    }
+    
+    CustomSignalTable::Signal signals[CustomSignalTable::MAX_SIGNALS];
+    size_t count = 0;
+    for (JsonVariant item : list) {
+        JsonObject entry = item.as<JsonObject>();
+        if (!entry["id"].is<int>() || !entry["start"].is<int>() || !entry["length"].is<int>() ||
+            !entry["key"].is<const char*>()) {
+            return CommandResult::invalidParams("Each signal needs id, start, length and key");
+        }
+        int canId = entry["id"].as<int>();
+        int startBit = entry["start"].as<int>();
+        int length = entry["length"].as<int>();
+        if (canId < 0 || canId > 0xFFFF || startBit < 0 || startBit > 63 || length < 1 || length > 32) {
+            return CommandResult::invalidParams("Signal id, start or length out of range");
+        }
+        
+        CustomSignalTable::Signal& signal = signals[count++];
+        memset(&signal, 0, sizeof(signal));
+        signal.canId = canId;
+        signal.startBit = startBit;
+        signal.length = length;
+        const char* order = entry["order"] | "intel";
+        signal.order = strcmp(order, "motorola") == 0 ? BroadcastDecoder::ByteOrder::MOTOROLA
+                                                      : BroadcastDecoder::ByteOrder::INTEL;
+        signal.sign = (entry["signed"] | false) ? BroadcastDecoder::Signedness::SIGNED
+                                                 : BroadcastDecoder::Signedness::UNSIGNED;
+        signal.scale = entry["scale"] | 1.0f;
+        signal.offset = entry["offset"] | 0.0f;
+        strncpy(signal.key, entry["key"].as<const char*>(), CustomSignalTable::KEY_SIZE);
+        if (signal.key[CustomSignalTable::KEY_SIZE - 1] != '\0') {
+            return CommandResult::invalidParams("Signal key too long (max 15 characters)");
+        }
+    }
+    
+    const char* error = nullptr;
+    if (!vehicleManager->setCustomSignals(signals, count, &error)) {
+        Serial.printf("[VEHICLE] Custom signal table rejected: %s\r\n", error);
+        return CommandResult::invalidParams(error);
+    }
+    
+    CommandResult result = CommandResult::ok("Custom signals updated");
+    result.data["count"] = count;
+    result.data["frameCost"] = CustomSignalTable::frameCost(signals, count);
+    result.data["frameCostBudget"] = CustomSignalTable::FRAME_COST_BUDGET;
+    return result;
+}
+
+CommandResult VehicleHandler::handleGetCustomSignals(CommandContext& ctx) {
+    const CustomSignalTable& table = vehicleManager->customSignals();
+    
+    CommandResult result = CommandResult::ok();
+    JsonArray list = result.data["signals"].to<JsonArray>();
+    for (size_t i = 0; i < table.size(); i++) {
+        const CustomSignalTable::Signal& signal = table.getSignal(i);
+        JsonObject entry = list.add<JsonObject>();
+        entry["id"] = signal.canId;
+        entry["start"] = signal.startBit;
+        entry["length"] = signal.length;
+        entry["order"] = signal.order == BroadcastDecoder::ByteOrder::MOTOROLA ? "motorola" : "intel";
+        entry["signed"] = signal.sign == BroadcastDecoder::Signedness::SIGNED;
+        entry["scale"] = signal.scale;
+        entry["offset"] = signal.offset;
+        entry["key"] = signal.key;
+        if (table.hasValue(i)) {
+            entry["raw"] = table.getRaw(i);
+            entry["value"] = table.getValue(i);
+            entry["ageSec"] = table.getAgeSec(i);
+        }
+    }
+    result.data["framesMatched"] = table.getFramesMatched();
+    result.data["signalsDecoded"] = table.getSignalsDecoded();
+    result.data["shortFrames"] = table.getShortFrames();
+    
+    return result;
+}
@@ -17,6 +17,8 @@ class CommandRouter;
  * - vehicle.stopCharging    - Stop charging
  * - vehicle.requestState    - Request current BAP states (plug, charge, climate)
  * - vehicle.getState        - Get current vehicle state snapshot
+ * - vehicle.setCustomSignals - Replace the runtime signal decoder table
+ * - vehicle.getCustomSignals - Get the runtime signal table, values and stats
  * 
  * These commands are sent to the vehicle via the BAP (Bedien- und Anzeigeprotokoll)
  * protocol over the CAN bus.
@@ -46,6 +48,8 @@ private:
     CommandResult handleStopCharging(CommandContext& ctx);
     CommandResult handleRequestState(CommandContext& ctx);
     CommandResult handleGetState(CommandContext& ctx);
+    CommandResult handleSetCustomSignals(CommandContext& ctx);
+    CommandResult handleGetCustomSignals(CommandContext& ctx);
     
     // Supported actions list
     static const char* supportedActions[];
@@ -0,0 +1,134 @@
+#include "CanBusLoad.h"
+
+constexpr uint8_t CanBusLoad::WINDOW_SECONDS[];
+
+CanBusLoad::CanBusLoad() {
+    // Per-frame cost on the RX path is a table lookup
+    for (uint8_t ext = 0; ext < 2; ext++) {
+        for (uint8_t dlc = 0; dlc <= 8; dlc++) {
+            expectedBits[ext][dlc] = frameBits(dlc, ext, false);
+            worstBits[ext][dlc] = frameBits(dlc, ext, true);
+        }
+    }
+}
+
+// =============================================================================
+// Writer side (CAN RX task)
+// =============================================================================
+
+void CanBusLoad::rollover(uint32_t nowUs, uint32_t missedTotal, uint32_t ringOverflowTotal) {
+    if (resetRequested || !started) {
+        resetRequested = false;
+        clear(nowUs);
+        lastMissedTotal = missedTotal;
+        lastRingOverflowTotal = ringOverflowTotal;
+        started = true;
+        return;
+    }
+
+    // Loss counters are sampled once per second and land in the closing bucket.
+    // A smaller total means the driver was reinstalled (counters restart at 0).
+    current.missed = missedTotal >= lastMissedTotal ? missedTotal - lastMissedTotal : missedTotal;
+    current.ringOverflows = ringOverflowTotal >= lastRingOverflowTotal
+        ? ringOverflowTotal - lastRingOverflowTotal : ringOverflowTotal;
+    lastMissedTotal = missedTotal;
+    lastRingOverflowTotal = ringOverflowTotal;
+
+    uint32_t elapsed = (nowUs - bucketStartUs) / BUCKET_US;
+    pushBucket(current);
+    current = Bucket();
+
+    // Seconds without a rollover (RX task starved) count as idle
+    for (uint32_t i = 1; i < elapsed && i < HISTORY_SECONDS; i++) {
+        pushBucket(Bucket());
+    }
+    bucketStartUs = (elapsed < HISTORY_SECONDS) ? bucketStartUs + elapsed * BUCKET_US : nowUs;
+
+    // Publish windows and the 60 s peak
+    uint32_t peak = 0;
+    for (size_t i = 0; i < filled; i++) {
+        if (history[i].frames > peak) {
+            peak = history[i].frames;
+        }
+    }
+    for (uint8_t w = 0; w < WINDOW_COUNT; w++) {
+        Window& window = published[w];
+        window.seconds = filled < WINDOW_SECONDS[w] ? filled : WINDOW_SECONDS[w];
+        window.frames = sums[w].frames;
+        window.bitsExpected = sums[w].bitsExpected;
+        window.bitsWorst = sums[w].bitsWorst;
+        window.missed = sums[w].missed;
+        window.ringOverflows = sums[w].ringOverflows;
+    }
+    peakFrames = peak;
+}
+
+void CanBusLoad::pushBucket(const Bucket& bucket) {
+    for (uint8_t w = 0; w < WINDOW_COUNT; w++) {
+        Bucket& sum = sums[w];
+
+        // Drop the bucket that leaves this window (before it is overwritten)
+        if (filled >= WINDOW_SECONDS[w]) {
+            const Bucket& leaving = history[(head + HISTORY_SECONDS - WINDOW_SECONDS[w]) % HISTORY_SECONDS];
+            sum.frames -= leaving.frames;
+            sum.bitsExpected -= leaving.bitsExpected;
+            sum.bitsWorst -= leaving.bitsWorst;
+            sum.missed -= leaving.missed;
+            sum.ringOverflows -= leaving.ringOverflows;
+        }
+        sum.frames += bucket.frames;
+        sum.bitsExpected += bucket.bitsExpected;
+        sum.bitsWorst += bucket.bitsWorst;
+        sum.missed += bucket.missed;
+        sum.ringOverflows += bucket.ringOverflows;
+    }
+
+    history[head] = bucket;
+    head = (head + 1) % HISTORY_SECONDS;
+    if (filled < HISTORY_SECONDS) {
+        filled++;
+    }
+}
+
+void CanBusLoad::clear(uint32_t nowUs) {
+    current = Bucket();
+    for (size_t i = 0; i < HISTORY_SECONDS; i++) {
+        history[i] = Bucket();
+    }
+    for (uint8_t w = 0; w < WINDOW_COUNT; w++) {
+        sums[w] = Bucket();
+        published[w] = Window();
+    }
+    head = 0;
+    filled = 0;
+    bucketStartUs = nowUs;
+    peakFrames = 0;
+}
+
+// =============================================================================
+// Reader side (main loop)
+// =============================================================================
+
+float CanBusLoad::loadPercent(const Window& window, bool worstCase) const {
+    if (window.seconds == 0 || bitrate == 0) {
+        return 0.0f;
+    }
+    uint32_t bits = worstCase ? window.bitsWorst : window.bitsExpected;
+    return bits * 100.0f / ((float)bitrate * window.seconds);
+}
+
+void CanBusLoad::toJson(JsonObject out) const {
+    out["bitrate"] = bitrate;
+    out["peakFps"] = peakFrames;
+
+    static const char* const WINDOW_KEYS[WINDOW_COUNT] = {"1s", "10s", "60s"};
+    for (uint8_t w = 0; w < WINDOW_COUNT; w++) {
+        Window window = published[w];
+        JsonObject obj = out[WINDOW_KEYS[w]].to<JsonObject>();
+        obj["fps"] = window.framesPerSecond();
+        obj["load"] = loadPercent(window, false);
+        obj["loadMax"] = loadPercent(window, true);
+        obj["missed"] = window.missed;
+        obj["ringOverflows"] = window.ringOverflows;
+    }
+}
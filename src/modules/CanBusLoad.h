@@ -0,0 +1,157 @@
+#pragma once
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+/**
+ * CanBusLoad - Bus utilization estimate from received frames
+ *
+ * Fed from the CAN RX task: every received frame adds its on-wire bit count
+ * (from DLC and standard/extended ID) to the current one-second bucket.
+ * Buckets are kept for 60 s with running sums, so record() and the
+ * once-per-second rollover both cost O(1).
+ *
+ * Frame length model (data frames, incl. 3-bit interframe space):
+ * - standard: 47 + 8*DLC bits, 34 + 8*DLC of them subject to stuffing
+ * - extended: 67 + 8*DLC bits, 54 + 8*DLC of them subject to stuffing
+ * - worst case: one stuff bit per 4 stuffable bits after the first
+ * - expected: random bits, one stuff bit per ~31 stuffable bits
+ * The true load lies between the two; payloads full of 0x00 push it
+ * towards the worst case.
+ *
+ * Only frames passing the TWAI acceptance filter are seen, so with a filter
+ * installed the figures are a lower bound on the real bus load.
+ *
+ * Each window also reports TWAI RX missed (driver rx_queue_len overflow)
+ * and decode ring overflow deltas, so frame loss can be correlated with load.
+ *
+ * Thread Safety:
+ * - record(), rolloverDue() and rollover() are called only from the CAN RX task
+ * - Readers on the main loop get the windows published at the last
+ *   rollover; individual fields are atomic, a window may mix two seconds
+ * - reset() is deferred to the writer via a flag
+ */
+class CanBusLoad {
+public:
+    static constexpr uint32_t BUCKET_US = 1000000;
+    static constexpr size_t HISTORY_SECONDS = 60;
+    static constexpr uint8_t WINDOW_COUNT = 3;
+    static constexpr uint8_t WINDOW_SECONDS[WINDOW_COUNT] = {1, 10, 60};
+
+    struct Window {
+        uint8_t seconds = 0;            // Seconds of data actually covered (<= nominal)
+        uint32_t frames = 0;
+        uint32_t bitsExpected = 0;
+        uint32_t bitsWorst = 0;
+        uint32_t missed = 0;            // TWAI RX queue overflows
+        uint32_t ringOverflows = 0;     // Decode ring overflows
+
+        float framesPerSecond() const { return seconds ? (float)frames / seconds : 0.0f; }
+    };
+
+    CanBusLoad();
+
+    /**
+     * On-wire length of a data frame in bits (incl. interframe space).
+     * @param worstCase Maximum stuffing instead of the random-bit expectation
+     */
+    static constexpr uint16_t frameBits(uint8_t dlc, bool extended, bool worstCase) {
+        return (extended ? 67 : 47) + 8 * dlc +
+               (worstCase ? ((extended ? 54 : 34) + 8 * dlc - 1) / 4
+                          : ((extended ? 54 : 34) + 8 * dlc + 15) / 31);
+    }
+
+    /**
+     * Set the nominal bus bitrate used for utilization (bits per second).
+     */
+    void setBitrate(uint32_t bitsPerSecond) { bitrate = bitsPerSecond; }
+    uint32_t getBitrate() const { return bitrate; }
+
+    /**
+     * Include the estimate as an optional section in vehicle telemetry.
+     */
+    void setTelemetryEnabled(bool enable) { telemetryEnabled = enable; }
+    bool isTelemetryEnabled() const { return telemetryEnabled; }
+
+    /**
+     * Account one received frame. CAN RX task only.
+     */
+    void record(uint8_t dlc, bool extended) {
+        if (dlc > 8) {
+            dlc = 8;
+        }
+        current.frames++;
+        current.bitsExpected += expectedBits[extended][dlc];
+        current.bitsWorst += worstBits[extended][dlc];
+    }
+
+    /**
+     * Check if the current bucket is complete. CAN RX task only.
+     */
+    bool rolloverDue(uint32_t nowUs) const {
+        return !started || resetRequested || nowUs - bucketStartUs >= BUCKET_US;
+    }
+
+    /**
+     * Close elapsed buckets and publish the windows. CAN RX task only.
+     * @param missedTotal Driver rx_missed_count (cumulative)
+     * @param ringOverflowTotal Decode ring overflow count (cumulative)
+     */
+    void rollover(uint32_t nowUs, uint32_t missedTotal, uint32_t ringOverflowTotal);
+
+    /**
+     * Request a reset of all windows. Applied by the writer on its next rollover().
+     */
+    void reset() { resetRequested = true; }
+
+    /**
+     * Get a published window (index into WINDOW_SECONDS).
+     */
+    const Window& getWindow(uint8_t index) const { return published[index]; }
+
+    /**
+     * Utilization of a window in percent (expected or worst-case stuffing).
+     */
+    float loadPercent(const Window& window, bool worstCase) const;
+
+    /**
+     * Highest one-second frame count in the last 60 s.
+     */
+    uint32_t getPeakFramesPerSecond() const { return peakFrames; }
+
+    /**
+     * Serialize bitrate, windows and peak rate.
+     */
+    void toJson(JsonObject out) const;
+
+private:
+    struct Bucket {
+        uint32_t frames = 0;
+        uint32_t bitsExpected = 0;
+        uint32_t bitsWorst = 0;
+        uint32_t missed = 0;
+        uint32_t ringOverflows = 0;
+    };
+
+    uint16_t expectedBits[2][9];
+    uint16_t worstBits[2][9];
+
+    Bucket current;
+    Bucket history[HISTORY_SECONDS];
+    Bucket sums[WINDOW_COUNT];
+    size_t head = 0;                    // Next history slot to write
+    size_t filled = 0;                  // Completed buckets in history
+    uint32_t bucketStartUs = 0;
+    uint32_t lastMissedTotal = 0;
+    uint32_t lastRingOverflowTotal = 0;
+    bool started = false;
+
+    Window published[WINDOW_COUNT];
+    volatile uint32_t peakFrames = 0;
+    volatile uint32_t bitrate = 500000;
+    volatile bool telemetryEnabled = false;
+    volatile bool resetRequested = false;
+
+    void pushBucket(const Bucket& bucket);
+    void clear(uint32_t nowUs);
+};
@@ -0,0 +1,322 @@
+#include "CanFilterPlanner.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace CanFilterPlanner {
+
+namespace {
+
+    constexpr uint32_t STD_ID_SPACE = 2048;
+    constexpr double EXT_ID_SPACE = 536870912.0;  // 2^29
+
+    // Dual mode: register bits [19:16] and [3:0] hold filter 1's data nibbles
+    constexpr uint16_t DUAL_FORCED_DONT_CARE = 0x000F;
+
+    /**
+     * One registered item projected into both filter layouts.
+     * dc = don't-care bits (TWAI mask polarity).
+     */
+    struct Item {
+        uint32_t value32;
+        uint32_t dc32;
+        uint16_t value16;
+        uint16_t dc16;
+    };
+
+    struct Cube32 {
+        uint32_t code;
+        uint32_t mask;
+    };
+
+    struct Cube16 {
+        uint16_t code;
+        uint16_t mask;
+        bool empty;
+    };
+
+    inline int popcount32(uint32_t v) {
+        return __builtin_popcount(v);
+    }
+
+    Item makeStdItem(uint16_t id) {
+        Item item;
+        item.value32 = (uint32_t)(id & 0x7FF) << 21;
+        item.dc32 = 0x001FFFFF;                       // RTR + data bytes
+        item.value16 = (uint16_t)((id & 0x7FF) << 5);
+        item.dc16 = 0x001F;                           // RTR + data nibble
+        return item;
+    }
+
+    Item makeExtItem(const ExtRange& range) {
+        uint32_t mask = range.mask & 0x1FFFFFFF;
+        uint32_t id = range.id & mask;
+        uint32_t free = ~mask & 0x1FFFFFFF;
+        Item item;
+        item.value32 = id << 3;
+        item.dc32 = (free << 3) | 0x7;                // RTR + unused
+        item.value16 = (uint16_t)((id >> 13) & 0xFFFF);
+        item.dc16 = (uint16_t)(((free >> 13) & 0xFFFF) | DUAL_FORCED_DONT_CARE);
+        return item;
+    }
+
+    // -------------------------------------------------------------------------
+    // Expected accepted-ID counts (uniform IDs and payload bits)
+    // -------------------------------------------------------------------------
+
+    double expectedStd32(uint32_t mask) {
+        int idFree = popcount32((mask >> 21) & 0x7FF);
+        int payloadCared = 21 - popcount32(mask & 0x001FFFFF);
+        return std::ldexp(1.0, idFree - payloadCared);
+    }
+
+    double expectedExt32(uint32_t mask) {
+        int idFree = popcount32(mask >> 3);
+        int otherCared = 3 - popcount32(mask & 0x7);
+        return std::ldexp(1.0, idFree - otherCared);
+    }
+
+    double expectedStd16(uint16_t mask) {
+        int idFree = popcount32((mask >> 5) & 0x7FF);
+        int rtrCared = (mask & 0x10) ? 0 : 1;
+        return std::ldexp(1.0, idFree - rtrCared);
+    }
+
+    double expectedExt16(uint16_t mask) {
+        // ID bits 12..0 are never compared in dual mode
+        return std::ldexp(1.0, 13 + popcount32(mask));
+    }
+
+    // -------------------------------------------------------------------------
+    // Cube construction
+    // -------------------------------------------------------------------------
+
+    void addToCube(Cube32& cube, const Item& item, bool first) {
+        if (first) {
+            cube.code = item.value32;
+            cube.mask = item.dc32;
+        } else {
+            cube.mask |= item.dc32 | (cube.code ^ item.value32);
+        }
+        cube.code &= ~cube.mask;
+    }
+
+    void addToCube(Cube16& cube, const Item& item) {
+        if (cube.empty) {
+            cube.code = item.value16;
+            cube.mask = item.dc16;
+            cube.empty = false;
+        } else {
+            cube.mask |= item.dc16 | (cube.code ^ item.value16);
+        }
+        cube.code &= ~cube.mask;
+    }
+
+    struct Counts {
+        double wantedStd;
+        double wantedExt;
+        double extWeight;
+    };
+
+    double rate(double accepted, double wanted, double space) {
+        double unwanted = space - wanted;
+        if (unwanted <= 0.0) {
+            return 0.0;
+        }
+        double falseAccepts = std::max(0.0, accepted - wanted);
+        return falseAccepts / unwanted;
+    }
+
+    /**
+     * Traffic-weighted false-accept rate of a filter.
+     */
+    double cost(double stdAccepted, double extAccepted, const Counts& counts) {
+        return (1.0 - counts.extWeight) * rate(stdAccepted, counts.wantedStd, STD_ID_SPACE) +
+               counts.extWeight * rate(extAccepted, counts.wantedExt, EXT_ID_SPACE);
+    }
+
+    /**
+     * Expected accepted IDs for the union of two 16-bit filters.
+     */
+    void dualExpected(const Cube16& a, const Cube16& b, double& stdAccepted, double& extAccepted) {
+        stdAccepted = expectedStd16(a.mask) + expectedStd16(b.mask);
+        extAccepted = expectedExt16(a.mask) + expectedExt16(b.mask);
+
+        // Inclusion-exclusion: two cubes intersect if they agree on commonly cared bits
+        uint16_t cared = (uint16_t)(~a.mask & ~b.mask);
+        if (((a.code ^ b.code) & cared) == 0) {
+            uint16_t interMask = a.mask & b.mask;
+            stdAccepted -= expectedStd16(interMask);
+            extAccepted -= expectedExt16(interMask);
+        }
+    }
+
+    double dualCost(const Item* items, size_t count, uint32_t groupBits,
+                    const Counts& counts, Cube16& outA, Cube16& outB) {
+        Cube16 a = {0, 0, true};
+        Cube16 b = {0, 0, true};
+        for (size_t i = 0; i < count; i++) {
+            if (groupBits & (1UL << i)) {
+                addToCube(b, items[i]);
+            } else {
+                addToCube(a, items[i]);
+            }
+        }
+        // An empty filter duplicates the other (TWAI cannot express "reject all")
+        if (a.empty) a = b;
+        if (b.empty) b = a;
+
+        double stdAccepted, extAccepted;
+        dualExpected(a, b, stdAccepted, extAccepted);
+        outA = a;
+        outB = b;
+        return cost(stdAccepted, extAccepted, counts);
+    }
+
+    /**
+     * Find the best 2-way split of items into the dual filter halves.
+     * Bit i of the result puts item i into filter 2.
+     */
+    uint32_t bestDualSplit(const Item* items, size_t count, const Counts& counts) {
+        Cube16 a, b;
+        uint32_t bestBits = 0;
+        double bestCost = dualCost(items, count, 0, counts, a, b);
+
+        if (count <= EXHAUSTIVE_LIMIT) {
+            // Item 0 stays in filter 1 (halves are symmetric)
+            uint32_t limit = 1UL << (count - 1);
+            for (uint32_t bits = 1; bits < limit; bits++) {
+                uint32_t groupBits = bits << 1;
+                double cost = dualCost(items, count, groupBits, counts, a, b);
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestBits = groupBits;
+                }
+            }
+            return bestBits;
+        }
+
+        // Seed: split on each key bit, keep the best
+        for (int bit = 4; bit < 16; bit++) {
+            uint32_t groupBits = 0;
+            for (size_t i = 0; i < count; i++) {
+                if (items[i].value16 & (1U << bit)) {
+                    groupBits |= 1UL << i;
+                }
+            }
+            double cost = dualCost(items, count, groupBits, counts, a, b);
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestBits = groupBits;
+            }
+        }
+
+        // Local search: move single items across while it helps
+        bool improved = true;
+        while (improved) {
+            improved = false;
+            for (size_t i = 0; i < count; i++) {
+                uint32_t groupBits = bestBits ^ (1UL << i);
+                double cost = dualCost(items, count, groupBits, counts, a, b);
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestBits = groupBits;
+                    improved = true;
+                }
+            }
+        }
+        return bestBits;
+    }
+
+}  // namespace
+
+Plan plan(const uint16_t* stdIds, size_t stdCount,
+          const ExtRange* extRanges, size_t extCount,
+          float extTrafficShare) {
+    Plan result;
+
+    // Group bits are held in a uint32_t
+    static constexpr size_t MAX_ITEMS = 32;
+    Item items[MAX_ITEMS];
+    size_t count = 0;
+    Counts counts = {0.0, 0.0, std::min(1.0, std::max(0.0, (double)extTrafficShare))};
+
+    for (size_t i = 0; i < stdCount; i++) {
+        uint16_t id = stdIds[i] & 0x7FF;
+        // Skip duplicates
+        bool seen = false;
+        for (size_t j = 0; j < i; j++) {
+            if ((stdIds[j] & 0x7FF) == id) {
+                seen = true;
+                break;
+            }
+        }
+        if (seen) continue;
+        if (count >= MAX_ITEMS) return result;  // Too many to plan - accept all
+        items[count++] = makeStdItem(id);
+        counts.wantedStd += 1.0;
+    }
+    for (size_t i = 0; i < extCount; i++) {
+        if (count >= MAX_ITEMS) return result;
+        items[count++] = makeExtItem(extRanges[i]);
+        counts.wantedExt += std::ldexp(1.0, 29 - popcount32(extRanges[i].mask & 0x1FFFFFFF));
+    }
+
+    if (count == 0) {
+        return result;
+    }
+
+    // Single filter: one cube over everything
+    Cube32 single;
+    for (size_t i = 0; i < count; i++) {
+        addToCube(single, items[i], i == 0);
+    }
+    double singleStd = expectedStd32(single.mask);
+    double singleExt = expectedExt32(single.mask);
+    double singleCost = cost(singleStd, singleExt, counts);
+
+    // Dual filter: best split across the two halves
+    Cube16 a, b;
+    uint32_t split = bestDualSplit(items, count, counts);
+    double dual = dualCost(items, count, split, counts, a, b);
+
+    if (dual < singleCost) {
+        double stdAccepted, extAccepted;
+        dualExpected(a, b, stdAccepted, extAccepted);
+        result.singleFilter = false;
+        result.acceptanceCode = ((uint32_t)a.code << 16) | b.code;
+        result.acceptanceMask = ((uint32_t)a.mask << 16) | b.mask;
+        result.falseStdIds = (float)std::max(0.0, stdAccepted - counts.wantedStd);
+        result.falseExtIds = (float)std::max(0.0, extAccepted - counts.wantedExt);
+    } else {
+        result.singleFilter = true;
+        result.acceptanceCode = single.code;
+        result.acceptanceMask = single.mask;
+        result.falseStdIds = (float)std::max(0.0, singleStd - counts.wantedStd);
+        result.falseExtIds = (float)std::max(0.0, singleExt - counts.wantedExt);
+    }
+
+    result.acceptAll = result.acceptanceMask == 0xFFFFFFFF;
+    result.stdFalseAcceptRate = (float)rate(result.falseStdIds + counts.wantedStd, counts.wantedStd, STD_ID_SPACE);
+    result.extFalseAcceptRate = (float)rate(result.falseExtIds + counts.wantedExt, counts.wantedExt, EXT_ID_SPACE);
+    return result;
+}
+
+bool acceptsId(const Plan& plan, uint32_t canId, bool extended) {
+    if (plan.singleFilter) {
+        uint32_t key = extended ? ((canId & 0x1FFFFFFF) << 3) : ((canId & 0x7FF) << 21);
+        uint32_t idBits = extended ? 0xFFFFFFF8 : 0xFFE00000;
+        return ((key ^ plan.acceptanceCode) & ~plan.acceptanceMask & idBits) == 0;
+    }
+
+    uint16_t key = extended ? (uint16_t)((canId >> 13) & 0xFFFF) : (uint16_t)((canId & 0x7FF) << 5);
+    uint16_t idBits = extended ? 0xFFFF : 0xFFE0;
+    uint16_t code1 = (uint16_t)(plan.acceptanceCode >> 16);
+    uint16_t mask1 = (uint16_t)(plan.acceptanceMask >> 16);
+    uint16_t code2 = (uint16_t)(plan.acceptanceCode & 0xFFFF);
+    uint16_t mask2 = (uint16_t)(plan.acceptanceMask & 0xFFFF);
+    return ((key ^ code1) & ~mask1 & idBits) == 0 ||
+           ((key ^ code2) & ~mask2 & idBits) == 0;
+}
+
+}  // namespace CanFilterPlanner
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * CanFilterPlanner - Derives a TWAI hardware acceptance filter from CAN IDs
+ *
+ * Pure functions (no Arduino/ESP-IDF dependencies) so the planner can be
+ * compiled and exercised on the host.
+ *
+ * TWAI filter model (ESP32 SJA1000-compatible, mask bit 1 = don't care):
+ *
+ *   Single filter - one 32-bit code/mask:
+ *     Standard: [31:21] ID, [20] RTR, [19:0] data bytes 1-2
+ *     Extended: [31:3] ID, [2] RTR, [1:0] unused
+ *
+ *   Dual filter - two 16-bit halves, filter 1 = [31:16], filter 2 = [15:0]:
+ *     Standard: [15:5] ID, [4] RTR, [3:0] data byte 1 nibble (filter 1 only)
+ *     Extended: [15:0] ID bits 28..13 (ID bits 12..0 are not compared)
+ *   Register bits [19:16] and [3:0] carry filter 1's data nibbles for
+ *   standard frames, so the planner always leaves them as don't care.
+ *
+ * The same code/mask is applied to both standard and extended frames, so a
+ * plan for standard IDs can leak extended frames (and vice versa). The
+ * false-accept estimate accounts for this, assuming uniformly distributed
+ * IDs and payload bits.
+ */
+namespace CanFilterPlanner {
+
+    /**
+     * Range of extended (29-bit) IDs, e.g. {0x17330000, 0x1FFF0000} for all BAP.
+     * Bits set in mask must match id; bits clear are don't care.
+     */
+    struct ExtRange {
+        uint32_t id;
+        uint32_t mask;
+    };
+
+    /**
+     * Resulting filter configuration plus its expected cost.
+     */
+    struct Plan {
+        uint32_t acceptanceCode = 0;
+        uint32_t acceptanceMask = 0xFFFFFFFF;   // Accept all
+        bool singleFilter = true;
+        bool acceptAll = true;
+
+        // Expected number of IDs accepted that nobody registered
+        float falseStdIds = 0.0f;               // Out of 2048 standard IDs
+        float falseExtIds = 0.0f;               // Out of 2^29 extended IDs
+
+        // falseXxxIds / unregistered IDs of that type (0.0 = perfect, 1.0 = accept all)
+        float stdFalseAcceptRate = 1.0f;
+        float extFalseAcceptRate = 1.0f;
+
+        bool operator==(const Plan& other) const {
+            return acceptanceCode == other.acceptanceCode &&
+                   acceptanceMask == other.acceptanceMask &&
+                   singleFilter == other.singleFilter;
+        }
+        bool operator!=(const Plan& other) const { return !(*this == other); }
+    };
+
+    // Maximum number of items (standard IDs + extended ranges) searched exhaustively
+    // for the dual-filter split. Larger sets use per-bit split seeds plus local search.
+    static constexpr size_t EXHAUSTIVE_LIMIT = 16;
+
+    // Powertrain bus traffic is mostly 11-bit broadcast; 29-bit frames are
+    // mainly BAP/NM and far less frequent
+    static constexpr float DEFAULT_EXT_TRAFFIC_SHARE = 0.1f;
+
+    /**
+     * Compute the best single- or dual-filter plan for the given IDs.
+     * Every registered ID is guaranteed to pass the resulting filter.
+     * An empty set yields an accept-all plan.
+     *
+     * @param stdIds Standard (11-bit) IDs to accept
+     * @param stdCount Number of standard IDs
+     * @param extRanges Extended ID ranges to accept
+     * @param extCount Number of extended ranges
+     * @param extTrafficShare Expected share of unregistered bus traffic that is
+     *        extended frames (weights the std/ext false-accept rates)
+     * @return Plan with code/mask and false-accept estimate
+     */
+    Plan plan(const uint16_t* stdIds, size_t stdCount,
+              const ExtRange* extRanges, size_t extCount,
+              float extTrafficShare = DEFAULT_EXT_TRAFFIC_SHARE);
+
+    /**
+     * Check whether a data frame ID passes the plan's ID bits.
+     * Payload-dependent bits are ignored (treated as matching).
+     */
+    bool acceptsId(const Plan& plan, uint32_t canId, bool extended);
+
+}  // namespace CanFilterPlanner
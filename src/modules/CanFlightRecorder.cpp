@@ -0,0 +1,279 @@
+#include "CanFlightRecorder.h"
+#include <esp_heap_caps.h>
+
+CanFlightRecorder::~CanFlightRecorder() {
+    if (buffer != nullptr) {
+        heap_caps_free(buffer);
+        buffer = nullptr;
+    }
+}
+
+bool CanFlightRecorder::begin(size_t bufferBytes) {
+    if (buffer != nullptr) {
+        return true;
+    }
+
+    size_t blocks = bufferBytes / BLOCK_SIZE;
+    if (blocks < 2) {
+        Serial.println("[Recorder] Buffer too small - disabled");
+        return false;
+    }
+
+    buffer = static_cast<uint8_t*>(heap_caps_malloc(blocks * BLOCK_SIZE, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+    if (buffer == nullptr) {
+        Serial.printf("[Recorder] Failed to allocate %u bytes in PSRAM - disabled\r\n", (unsigned)(blocks * BLOCK_SIZE));
+        return false;
+    }
+
+    blockCount = blocks;
+    clearRing();
+    state = State::ARMED;
+
+    Serial.printf("[Recorder] %u KB PSRAM ring (%u blocks), window -%lums/+%lums, triggers 0x%02lX\r\n",
+        (unsigned)(getBufferBytes() / 1024), (unsigned)blockCount,
+        preTriggerMs, postTriggerMs, triggerMask);
+    return true;
+}
+
+// =============================================================================
+// Writer side (CAN decode task)
+// =============================================================================
+
+void CanFlightRecorder::record(const CanRxFrame* frames, size_t count) {
+    applyRequests();
+
+    // Frames queued before trigger() stamped the time are older than the
+    // trigger: signed difference, or they would end the window at once
+    for (size_t i = 0; i < count; i++) {
+        if (state == State::TRIGGERED &&
+            (int32_t)(frames[i].timestampUs - triggerTimestampUs) >= (int32_t)(postTriggerMs * 1000UL)) {
+            freeze();
+        }
+        if (state != State::ARMED && state != State::TRIGGERED) {
+            return;
+        }
+        appendFrame(frames[i]);
+    }
+}
+
+void CanFlightRecorder::poll() {
+    applyRequests();
+
+    // Freeze on time as well - the bus may be silent after the event (bus-off)
+    if (state == State::TRIGGERED &&
+        (uint32_t)micros() - triggerTimestampUs >= postTriggerMs * 1000UL) {
+        freeze();
+    }
+}
+
+void CanFlightRecorder::applyRequests() {
+    if (rearmRequested) {
+        rearmRequested = false;
+        if (buffer != nullptr) {
+            clearRing();
+            pendingTrigger = Trigger::NONE;
+            triggerReason = Trigger::NONE;
+            state = State::ARMED;
+        }
+    }
+
+    Trigger reason = pendingTrigger;
+    if (reason != Trigger::NONE) {
+        pendingTrigger = Trigger::NONE;
+        if (state == State::ARMED) {
+            triggerReason = reason;
+            triggerTimestampUs = pendingTriggerUs;
+            state = State::TRIGGERED;
+        }
+    }
+}
+
+void CanFlightRecorder::clearRing() {
+    oldestBlock = 0;
+    usedBlocks = 0;
+    lastRecordUs = 0;
+    frozenFirstBlock = 0;
+    frozenBlockCount = 0;
+    captureSize = 0;
+}
+
+void CanFlightRecorder::openBlock(uint32_t timestampUs) {
+    if (usedBlocks == blockCount) {
+        // Ring full - evict the oldest block
+        oldestBlock = (oldestBlock + 1) % blockCount;
+        usedBlocks--;
+        evictedBlocks++;
+    }
+    usedBlocks++;
+
+    BlockHeader* header = currentBlock();
+    header->firstTimestampUs = timestampUs;
+    header->lastTimestampUs = timestampUs;
+    header->usedBytes = 0;
+    header->recordCount = 0;
+    lastRecordUs = timestampUs;
+}
+
+void CanFlightRecorder::appendFrame(const CanRxFrame& frame) {
+    if (frame.dlc > 8) {
+        droppedFrames++;
+        return;
+    }
+
+    if (usedBlocks == 0 ||
+        sizeof(BlockHeader) + currentBlock()->usedBytes + MAX_RECORD_SIZE > BLOCK_SIZE) {
+        openBlock(frame.timestampUs);
+    }
+
+    BlockHeader* header = currentBlock();
+    uint8_t* out = reinterpret_cast<uint8_t*>(header) + sizeof(BlockHeader) + header->usedBytes;
+    uint8_t* start = out;
+
+    *out++ = (frame.extended ? 0x80 : 0x00) | (frame.dlc & 0x0F);
+
+    // LEB128 delta since the previous record in this block
+    uint32_t delta = frame.timestampUs - lastRecordUs;
+    do {
+        uint8_t byte = delta & 0x7F;
+        delta >>= 7;
+        *out++ = delta ? (byte | 0x80) : byte;
+    } while (delta);
+
+    uint32_t id = frame.canId;
+    *out++ = id & 0xFF;
+    *out++ = (id >> 8) & 0xFF;
+    if (frame.extended) {
+        *out++ = (id >> 16) & 0xFF;
+        *out++ = (id >> 24) & 0xFF;
+    }
+
+    memcpy(out, frame.data, frame.dlc);
+    out += frame.dlc;
+
+    header->usedBytes += out - start;
+    header->recordCount++;
+    header->lastTimestampUs = frame.timestampUs;
+    lastRecordUs = frame.timestampUs;
+    recordedFrames++;
+}
+
+void CanFlightRecorder::freeze() {
+    // Oldest block that still overlaps the pre-trigger window
+    uint32_t windowStartUs = triggerTimestampUs - preTriggerMs * 1000UL;
+    size_t first = 0;
+    while (first + 1 < usedBlocks &&
+           (int32_t)(blockAt(oldestBlock + first)->lastTimestampUs - windowStartUs) < 0) {
+        first++;
+    }
+
+    frozenFirstBlock = oldestBlock + first;
+    frozenBlockCount = usedBlocks - first;
+
+    uint32_t records = 0;
+    uint32_t payload = 0;
+    for (size_t i = 0; i < frozenBlockCount; i++) {
+        const BlockHeader* header = blockAt(frozenFirstBlock + i);
+        records += header->recordCount;
+        payload += sizeof(BlockHeader) + header->usedBytes;
+    }
+
+    memcpy(captureHeader.magic, "CFR1", 4);
+    captureHeader.version = FORMAT_VERSION;
+    captureHeader.triggerReason = static_cast<uint8_t>(triggerReason);
+    captureHeader.blockCount = frozenBlockCount;
+    captureHeader.triggerTimestampUs = triggerTimestampUs;
+    captureHeader.preTriggerMs = preTriggerMs;
+    captureHeader.postTriggerMs = postTriggerMs;
+    captureHeader.recordCount = records;
+    captureHeader.payloadBytes = payload;
+    captureHeader.droppedFrames = droppedFrames;
+    captureHeader.acceptanceCode = filterCode;
+    captureHeader.acceptanceMask = filterMask;
+    captureHeader.singleFilter = filterSingle ? 1 : 0;
+
+    captureSize = sizeof(CaptureHeader) + payload;
+    captureCount++;
+    state = State::FROZEN;
+}
+
+// =============================================================================
+// Control / export
+// =============================================================================
+
+void CanFlightRecorder::trigger(Trigger reason) {
+    if (reason == Trigger::NONE || !(triggerMask & triggerBit(reason))) {
+        return;
+    }
+    if (state != State::ARMED || pendingTrigger != Trigger::NONE) {
+        return;
+    }
+    pendingTriggerUs = micros();
+    pendingTrigger = reason;
+}
+
+uint32_t CanFlightRecorder::getRetainedMs() const {
+    if (usedBlocks == 0) {
+        return 0;
+    }
+    const BlockHeader* oldest = blockAt(oldestBlock);
+    return (lastRecordUs - oldest->firstTimestampUs) / 1000;
+}
+
+size_t CanFlightRecorder::readCapture(uint32_t offset, uint8_t* dest, size_t len) const {
+    if (state != State::FROZEN || offset >= captureSize) {
+        return 0;
+    }
+
+    size_t copied = 0;
+    size_t position = 0;    // Start of the current segment in the export
+
+    // Segment 0: capture header
+    if (offset < sizeof(CaptureHeader)) {
+        size_t n = sizeof(CaptureHeader) - offset;
+        if (n > len) n = len;
+        memcpy(dest, reinterpret_cast<const uint8_t*>(&captureHeader) + offset, n);
+        copied += n;
+    }
+    position = sizeof(CaptureHeader);
+
+    // Segments 1..n: blocks (header + used record bytes, contiguous in the ring)
+    for (size_t i = 0; i < frozenBlockCount && copied < len; i++) {
+        const BlockHeader* header = blockAt(frozenFirstBlock + i);
+        size_t segmentSize = sizeof(BlockHeader) + header->usedBytes;
+        uint32_t readPos = offset + copied;
+
+        if (readPos < position + segmentSize) {
+            size_t inSegment = readPos - position;
+            size_t n = segmentSize - inSegment;
+            if (n > len - copied) n = len - copied;
+            memcpy(dest + copied, reinterpret_cast<const uint8_t*>(header) + inSegment, n);
+            copied += n;
+        }
+        position += segmentSize;
+    }
+
+    return copied;
+}
+
+const char* CanFlightRecorder::stateName(State state) {
+    switch (state) {
+        case State::DISABLED: return "disabled";
+        case State::ARMED: return "armed";
+        case State::TRIGGERED: return "triggered";
+        case State::FROZEN: return "frozen";
+        default: return "unknown";
+    }
+}
+
+const char* CanFlightRecorder::triggerName(Trigger trigger) {
+    switch (trigger) {
+        case Trigger::NONE: return "none";
+        case Trigger::MANUAL: return "manual";
+        case Trigger::CHARGE_STATUS: return "chargeStatus";
+        case Trigger::CHARGE_ABORTED: return "chargeAborted";
+        case Trigger::BAP_CONTINUATION_ERROR: return "bapContinuationError";
+        case Trigger::WAKE_FAILED: return "wakeFailed";
+        case Trigger::BUS_OFF: return "busOff";
+        default: return "unknown";
+    }
+}
@@ -0,0 +1,248 @@
+#pragma once
+
+#include <Arduino.h>
+#include "CanRxFrame.h"
+
+/**
+ * CanFlightRecorder - PSRAM ring of raw CAN frames with trigger/freeze
+ *
+ * Keeps the most recent traffic in a compact binary ring so that a charge
+ * abort, BAP reassembly error, failed wake or bus-off can be debugged
+ * after the fact. A trigger freezes a pre/post window around the event,
+ * which is then uploaded in chunks (system.recorder) and converted to
+ * GVRET CSV with docs/canbus-reverse-engineering/flight_recorder_to_gvret.py.
+ *
+ * Storage (PSRAM, no allocation after begin()):
+ * - Fixed-size blocks; the oldest block is evicted when the ring is full
+ * - Each block starts with an absolute timestamp, records inside it carry
+ *   a varint delta, so blocks decode independently after eviction
+ *
+ * Block:  BlockHeader, then records
+ * Record: flags (bit7 extended, bits3:0 DLC)
+ *         delta us since previous record in block (LEB128, 1-5 bytes)
+ *         ID (2 bytes LE standard, 4 bytes LE extended)
+ *         DLC data bytes
+ *
+ * Capture export (little endian): CaptureHeader, then each frozen block
+ * as BlockHeader + usedBytes of records.
+ *
+ * Only frames passing the TWAI acceptance filter are recorded (it is fed
+ * from the decode ring), so with a filter installed the capture is not the
+ * raw bus: IDs the filter drops are missing. CanManager reports the
+ * installed filter (setAcceptanceFilter) and the capture header carries it,
+ * so the GVRET export can say which IDs the trace can contain.
+ *
+ * Thread Safety:
+ * - record()/poll() are called only from the CAN decode task (single writer)
+ * - trigger()/arm()/configure() only post requests; the writer applies them
+ * - readCapture() is only valid while FROZEN (writer does not touch blocks)
+ */
+class CanFlightRecorder {
+public:
+    enum class State : uint8_t {
+        DISABLED,   // No buffer (PSRAM allocation failed or begin() not called)
+        ARMED,      // Recording, waiting for a trigger
+        TRIGGERED,  // Recording the post-trigger window
+        FROZEN      // Capture complete, ready for upload
+    };
+
+    enum class Trigger : uint8_t {
+        NONE = 0,
+        MANUAL = 1,                 // system.recorder op=trigger
+        CHARGE_STATUS = 2,          // Any BAP charge status transition
+        CHARGE_ABORTED = 3,         // Transition into BapChargeStatus::ABORTED_*
+        BAP_CONTINUATION_ERROR = 4, // BapFrameAssembler continuationErrors increased
+        WAKE_FAILED = 5,            // WakeController wakeFailed increased
+        BUS_OFF = 6                 // TWAI bus-off (keep last, see ALL_TRIGGERS)
+    };
+
+    static constexpr uint32_t triggerBit(Trigger t) { return 1UL << static_cast<uint8_t>(t); }
+
+    // Shifts spelled out: triggerBit() is not usable in constants of its own class
+    static constexpr uint32_t ALL_TRIGGERS =
+        ((2UL << static_cast<uint8_t>(Trigger::BUS_OFF)) - 1) & ~(1UL << static_cast<uint8_t>(Trigger::NONE));
+
+    static constexpr size_t DEFAULT_BUFFER_BYTES = 512 * 1024;
+    static constexpr size_t BLOCK_SIZE = 4096;
+    static constexpr uint32_t DEFAULT_PRE_TRIGGER_MS = 20000;
+    static constexpr uint32_t DEFAULT_POST_TRIGGER_MS = 5000;
+    static constexpr uint32_t DEFAULT_TRIGGER_MASK =
+        ALL_TRIGGERS & ~(1UL << static_cast<uint8_t>(Trigger::CHARGE_STATUS));  // Every status change is too often
+
+#pragma pack(push, 1)
+    struct BlockHeader {
+        uint32_t firstTimestampUs;  // Absolute micros() of first record
+        uint32_t lastTimestampUs;   // Absolute micros() of last record
+        uint16_t usedBytes;         // Record bytes following the header
+        uint16_t recordCount;
+    };
+
+    struct CaptureHeader {
+        char magic[4];              // "CFR1"
+        uint8_t version;
+        uint8_t triggerReason;      // Trigger
+        uint16_t blockCount;
+        uint32_t triggerTimestampUs;
+        uint32_t preTriggerMs;
+        uint32_t postTriggerMs;
+        uint32_t recordCount;
+        uint32_t payloadBytes;      // Bytes following this header
+        uint32_t droppedFrames;     // Frames that did not fit (oversized DLC etc.)
+        uint32_t acceptanceCode;    // TWAI filter installed at freeze time
+        uint32_t acceptanceMask;    // 0xFFFFFFFF: accept all (unfiltered capture)
+        uint8_t singleFilter;       // 1 = single, 0 = dual filter mode
+        uint8_t reserved[3];
+    };
+#pragma pack(pop)
+
+    static constexpr uint8_t FORMAT_VERSION = 2;        // 2: acceptance filter in the header
+
+    CanFlightRecorder() = default;
+    ~CanFlightRecorder();
+
+    /**
+     * Allocate the ring in PSRAM and arm the recorder.
+     * @param bufferBytes Ring size (rounded down to whole blocks)
+     * @return true if the buffer was allocated
+     */
+    bool begin(size_t bufferBytes = DEFAULT_BUFFER_BYTES);
+
+    // =========================================================================
+    // Writer side (CAN decode task only)
+    // =========================================================================
+
+    /**
+     * Append a batch of frames (ignored unless ARMED/TRIGGERED).
+     */
+    void record(const CanRxFrame* frames, size_t count);
+
+    /**
+     * Apply pending requests and time-based transitions.
+     * Called periodically even when no frames arrive (e.g. after bus-off).
+     */
+    void poll();
+
+    // =========================================================================
+    // Control (any task)
+    // =========================================================================
+
+    /**
+     * Fire a trigger. Ignored if not enabled in the trigger mask or not ARMED.
+     */
+    void trigger(Trigger reason);
+
+    /**
+     * Discard the frozen capture and start recording again.
+     */
+    void arm() { rearmRequested = true; }
+
+    /**
+     * Set which triggers freeze a capture (bit = triggerBit(Trigger)).
+     */
+    void setTriggerMask(uint32_t mask) { triggerMask = mask; }
+    uint32_t getTriggerMask() const { return triggerMask; }
+
+    /**
+     * Set the capture window around a trigger.
+     */
+    void setWindow(uint32_t preMs, uint32_t postMs) {
+        preTriggerMs = preMs;
+        postTriggerMs = postMs;
+    }
+    uint32_t getPreTriggerMs() const { return preTriggerMs; }
+    uint32_t getPostTriggerMs() const { return postTriggerMs; }
+
+    /**
+     * Record the TWAI acceptance filter frames pass before they reach the
+     * recorder (CanManager, on every driver install).
+     */
+    void setAcceptanceFilter(uint32_t code, uint32_t mask, bool singleFilter) {
+        filterCode = code;
+        filterMask = mask;
+        filterSingle = singleFilter;
+    }
+
+    // =========================================================================
+    // Status / export
+    // =========================================================================
+
+    State getState() const { return state; }
+    Trigger getTriggerReason() const { return triggerReason; }
+    static const char* stateName(State state);
+    static const char* triggerName(Trigger trigger);
+
+    size_t getBufferBytes() const { return blockCount * BLOCK_SIZE; }
+    uint32_t getRecordedFrames() const { return recordedFrames; }
+    uint32_t getEvictedBlocks() const { return evictedBlocks; }
+    uint32_t getCaptureCount() const { return captureCount; }
+
+    /**
+     * Time span currently held in the ring (ms).
+     */
+    uint32_t getRetainedMs() const;
+
+    /**
+     * Total size of the frozen capture export (0 unless FROZEN).
+     */
+    size_t getCaptureSize() const { return state == State::FROZEN ? captureSize : 0; }
+
+    /**
+     * Copy part of the frozen capture export.
+     * @param offset Byte offset into the export
+     * @param dest Destination buffer
+     * @param len Maximum bytes to copy
+     * @return Bytes copied (0 if not FROZEN or offset past the end)
+     */
+    size_t readCapture(uint32_t offset, uint8_t* dest, size_t len) const;
+
+private:
+    uint8_t* buffer = nullptr;
+    size_t blockCount = 0;
+
+    // Ring of blocks (writer-owned)
+    size_t oldestBlock = 0;
+    size_t usedBlocks = 0;          // Blocks holding data, including the current one
+    uint32_t lastRecordUs = 0;
+
+    // Frozen window (valid while FROZEN)
+    size_t frozenFirstBlock = 0;
+    size_t frozenBlockCount = 0;
+    size_t captureSize = 0;
+    CaptureHeader captureHeader = {};
+
+    volatile State state = State::DISABLED;
+    volatile Trigger triggerReason = Trigger::NONE;
+    uint32_t triggerTimestampUs = 0;
+
+    // Requests from other tasks
+    volatile Trigger pendingTrigger = Trigger::NONE;
+    volatile uint32_t pendingTriggerUs = 0;
+    volatile bool rearmRequested = false;
+
+    // Configuration
+    volatile uint32_t triggerMask = DEFAULT_TRIGGER_MASK;
+    volatile uint32_t preTriggerMs = DEFAULT_PRE_TRIGGER_MS;
+    volatile uint32_t postTriggerMs = DEFAULT_POST_TRIGGER_MS;
+    volatile uint32_t filterCode = 0;
+    volatile uint32_t filterMask = 0xFFFFFFFF;
+    volatile bool filterSingle = true;
+
+    // Statistics
+    volatile uint32_t recordedFrames = 0;
+    volatile uint32_t droppedFrames = 0;
+    volatile uint32_t evictedBlocks = 0;
+    volatile uint32_t captureCount = 0;
+
+    static constexpr size_t MAX_RECORD_SIZE = 1 + 5 + 4 + 8;
+
+    BlockHeader* blockAt(size_t index) const {
+        return reinterpret_cast<BlockHeader*>(buffer + (index % blockCount) * BLOCK_SIZE);
+    }
+    BlockHeader* currentBlock() const { return blockAt(oldestBlock + usedBlocks - 1); }
+
+    void applyRequests();
+    void clearRing();
+    void openBlock(uint32_t timestampUs);
+    void appendFrame(const CanRxFrame& frame);
+    void freeze();
+};
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#include "CanRxFrame.h"
+
+/**
+ * CanFrameRing - Lock-free single-producer/single-consumer frame ring
+ *
+ * Decouples the CAN RX task (producer) from the decode task (consumer)
+ * so that TWAI draining never waits on domain processing or locks.
+ *
+ * Design:
+ * - Fixed capacity (power of two), storage embedded - no heap after construction
+ * - Head and tail live on separate cache lines to avoid false sharing
+ * - Indices are free-running; (head - tail) is the occupancy
+ * - Acquire/release ordering publishes frame contents across cores
+ *
+ * Exactly one task may call push(), and exactly one task may call pop()/peek().
+ *
+ * @tparam CAPACITY Number of frame slots (must be a power of two)
+ */
+template <uint32_t CAPACITY>
+class CanFrameRing {
+    static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0,
+                  "CanFrameRing capacity must be a power of two");
+
+public:
+    static constexpr uint32_t CACHE_LINE = 64;
+
+    /**
+     * Enqueue a frame (producer side).
+     * @return false if the ring is full (frame not stored, overflow counted)
+     */
+    bool push(uint32_t canId, const uint8_t* data, uint8_t dlc, bool extended, uint32_t timestampUs) {
+        uint32_t head = headIndex.load(std::memory_order_relaxed);
+        uint32_t tail = tailIndex.load(std::memory_order_acquire);
+        uint32_t used = head - tail;
+        if (used >= CAPACITY) {
+            overflows++;
+            return false;
+        }
+
+        CanRxFrame& slot = slots[head & MASK];
+        slot.timestampUs = timestampUs;
+        slot.canId = canId;
+        slot.dlc = dlc > 8 ? 8 : dlc;
+        slot.extended = extended;
+        memcpy(slot.data, data, slot.dlc);
+
+        headIndex.store(head + 1, std::memory_order_release);
+
+        if (used + 1 > highWater) {
+            highWater = used + 1;
+        }
+        return true;
+    }
+
+    /**
+     * Get the oldest frame without removing it (consumer side).
+     * The returned pointer stays valid until the matching pop().
+     * @return nullptr if the ring is empty
+     */
+    const CanRxFrame* peek() const {
+        uint32_t tail = tailIndex.load(std::memory_order_relaxed);
+        if (headIndex.load(std::memory_order_acquire) == tail) {
+            return nullptr;
+        }
+        return &slots[tail & MASK];
+    }
+
+    /**
+     * Get the oldest frames as one contiguous span (consumer side).
+     * The span stops at the end of the storage array, so a wrapped backlog
+     * is returned over two calls. Frames stay valid until the matching pop().
+     * @param first Set to the oldest frame
+     * @param maxCount Upper bound on the span length
+     * @return Number of frames in the span (0 if empty)
+     */
+    uint32_t peekSpan(const CanRxFrame*& first, uint32_t maxCount) const {
+        uint32_t tail = tailIndex.load(std::memory_order_relaxed);
+        uint32_t available = headIndex.load(std::memory_order_acquire) - tail;
+        uint32_t offset = tail & MASK;
+        uint32_t untilWrap = CAPACITY - offset;
+
+        uint32_t count = available < untilWrap ? available : untilWrap;
+        if (count > maxCount) {
+            count = maxCount;
+        }
+        first = &slots[offset];
+        return count;
+    }
+
+    /**
+     * Release frames returned by peek()/peekSpan() (consumer side).
+     * @param count Number of frames to release
+     */
+    void pop(uint32_t count = 1) {
+        tailIndex.store(tailIndex.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    /**
+     * Current occupancy (approximate when read from a third task).
+     */
+    uint32_t size() const {
+        return headIndex.load(std::memory_order_acquire) - tailIndex.load(std::memory_order_acquire);
+    }
+
+    uint32_t capacity() const { return CAPACITY; }
+    uint32_t getHighWater() const { return highWater; }
+    uint32_t getOverflows() const { return overflows; }
+
+    /**
+     * Reset statistics. Only call while producer and consumer are stopped.
+     */
+    void resetStats() {
+        highWater = 0;
+        overflows = 0;
+    }
+
+    /**
+     * Discard all queued frames. Only call while producer and consumer are stopped.
+     */
+    void clear() {
+        tailIndex.store(headIndex.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr uint32_t MASK = CAPACITY - 1;
+
+    // Producer-owned (CAN RX task)
+    alignas(CACHE_LINE) std::atomic<uint32_t> headIndex{0};
+    volatile uint32_t highWater = 0;
+    volatile uint32_t overflows = 0;
+
+    // Consumer-owned (decode task)
+    alignas(CACHE_LINE) std::atomic<uint32_t> tailIndex{0};
+
+    alignas(CACHE_LINE) CanRxFrame slots[CAPACITY];
+};
@@ -0,0 +1,156 @@
+#include "CanIdProfiler.h"
+
+bool CanIdProfiler::Entry::isSilent(uint32_t nowMs) const {
+    if (!used || ewmaGapUs == 0) {
+        return false;
+    }
+    uint32_t thresholdMs = (ewmaGapUs / 1000) * SILENT_GAP_FACTOR;
+    if (thresholdMs < SILENT_MIN_MS) {
+        thresholdMs = SILENT_MIN_MS;
+    }
+    return nowMs - lastSeenMs > thresholdMs;
+}
+
+void CanIdProfiler::record(const CanRxFrame* frames, size_t count) {
+    if (resetRequested) {
+        clear();
+        resetRequested = false;
+    }
+    if (!enabled) {
+        return;
+    }
+
+    uint32_t nowMs = millis();
+    for (size_t i = 0; i < count; i++) {
+        Entry* entry = findOrInsert(frames[i].canId, frames[i].extended);
+        if (entry == nullptr) {
+            tableOverflows++;
+            continue;
+        }
+        recordFrame(*entry, frames[i].timestampUs, nowMs);
+    }
+}
+
+void CanIdProfiler::toJson(JsonArray out, bool detailed) const {
+    uint32_t nowMs = millis();
+
+    // Emit in ascending ID order without sorting the live table
+    uint64_t lastKey = 0;
+    bool first = true;
+    for (size_t emitted = 0; emitted < MAX_IDS; emitted++) {
+        const Entry* next = nullptr;
+        uint64_t nextKey = 0;
+        for (size_t i = 0; i < MAX_IDS; i++) {
+            const Entry& e = table[i];
+            if (!e.used) continue;
+            uint64_t key = ((uint64_t)e.extended << 32) | e.canId;
+            if ((first || key > lastKey) && (next == nullptr || key < nextKey)) {
+                next = &e;
+                nextKey = key;
+            }
+        }
+        if (next == nullptr) {
+            break;
+        }
+        first = false;
+        lastKey = nextKey;
+
+        JsonObject obj = out.add<JsonObject>();
+        char idStr[12];
+        snprintf(idStr, sizeof(idStr), next->extended ? "0x%08lX" : "0x%03lX", (unsigned long)next->canId);
+        obj["id"] = idStr;
+        obj["count"] = next->count;
+        obj["hz"] = next->rateHz();
+        obj["gapUs"] = next->ewmaGapUs;
+        obj["ageMs"] = nowMs - next->lastSeenMs;
+        obj["silent"] = next->isSilent(nowMs);
+
+        if (detailed) {
+            obj["ext"] = next->extended;
+            obj["minGapUs"] = next->minGapUs;
+            obj["maxGapUs"] = next->maxGapUs;
+            JsonArray jitter = obj["jitter"].to<JsonArray>();
+            for (size_t b = 0; b < JITTER_BUCKETS; b++) {
+                jitter.add(next->jitter[b]);
+            }
+        }
+    }
+}
+
+// =============================================================================
+// Private methods (decode task only)
+// =============================================================================
+
+CanIdProfiler::Entry* CanIdProfiler::findOrInsert(uint32_t canId, bool extended) {
+    // Fibonacci hash, linear probing
+    uint32_t key = canId ^ (extended ? 0x80000000UL : 0);
+    size_t index = (key * 2654435761UL) % MAX_IDS;
+
+    for (size_t probe = 0; probe < MAX_IDS; probe++) {
+        Entry& entry = table[index];
+        if (!entry.used) {
+            entry = Entry();
+            entry.canId = canId;
+            entry.extended = extended;
+            entry.used = true;
+            idCount++;
+            return &entry;
+        }
+        if (entry.canId == canId && entry.extended == extended) {
+            return &entry;
+        }
+        index = (index + 1) % MAX_IDS;
+    }
+    return nullptr;
+}
+
+void CanIdProfiler::recordFrame(Entry& entry, uint32_t timestampUs, uint32_t nowMs) {
+    bool restart = entry.count == 0 || (nowMs - entry.lastSeenMs) > MAX_GAP_MS;
+    uint32_t gapUs = timestampUs - entry.lastUs;
+
+    entry.count++;
+    entry.lastUs = timestampUs;
+    entry.lastSeenMs = nowMs;
+
+    if (restart) {
+        return;
+    }
+
+    if (entry.ewmaGapUs == 0) {
+        // First gap seeds all statistics
+        entry.ewmaGapUs = gapUs;
+        entry.minGapUs = gapUs;
+        entry.maxGapUs = gapUs;
+        return;
+    }
+
+    uint32_t deviationUs = gapUs > entry.ewmaGapUs ? gapUs - entry.ewmaGapUs : entry.ewmaGapUs - gapUs;
+    uint8_t bucket = jitterBucket(deviationUs);
+    if (entry.jitter[bucket] < UINT16_MAX) {
+        entry.jitter[bucket]++;
+    }
+
+    if (gapUs < entry.minGapUs) entry.minGapUs = gapUs;
+    if (gapUs > entry.maxGapUs) entry.maxGapUs = gapUs;
+
+    // EWMA with alpha = 1/8
+    entry.ewmaGapUs = entry.ewmaGapUs + ((int32_t)(gapUs - entry.ewmaGapUs) >> 3);
+}
+
+void CanIdProfiler::clear() {
+    for (size_t i = 0; i < MAX_IDS; i++) {
+        table[i] = Entry();
+    }
+    idCount = 0;
+    tableOverflows = 0;
+}
+
+uint8_t CanIdProfiler::jitterBucket(uint32_t deviationUs) {
+    uint8_t bucket = 0;
+    uint32_t limit = JITTER_BUCKET_BASE_US;
+    while (deviationUs >= limit && bucket < JITTER_BUCKETS - 1) {
+        bucket++;
+        limit <<= 1;
+    }
+    return bucket;
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "CanRxFrame.h"
+
+/**
+ * CanIdProfiler - Per-CAN-ID arrival rate and jitter statistics
+ *
+ * Fed from the CAN decode task with the RX timestamps captured by the CAN
+ * task, so the numbers reflect bus arrival times rather than decode delays.
+ *
+ * Per observed ID (standard and extended tracked separately):
+ * - frame count
+ * - EWMA inter-arrival gap, min/max gap
+ * - log2-scaled jitter histogram (|gap - EWMA gap|)
+ * - last-seen time (to spot ECUs that go silent)
+ *
+ * Memory: fixed open-addressed table, no heap. IDs beyond MAX_IDS are
+ * counted in getTableOverflows() but not profiled.
+ *
+ * Thread Safety:
+ * - record() is called only from the decode task (single writer)
+ * - Readers on the main loop see each field atomically, but an entry
+ *   may be mid-update; good enough for statistics
+ * - reset() is deferred to the writer via a flag
+ */
+class CanIdProfiler {
+public:
+    static constexpr size_t MAX_IDS = 64;
+    static constexpr size_t JITTER_BUCKETS = 8;
+
+    // Jitter bucket i covers [BASE << (i-1), BASE << i) us; bucket 0 is < BASE,
+    // the last bucket is open-ended (>= 32ms)
+    static constexpr uint32_t JITTER_BUCKET_BASE_US = 500;
+
+    // A gap longer than this is treated as a restart, not an inter-arrival time
+    // (also keeps 32-bit micros() wrap out of the statistics)
+    static constexpr uint32_t MAX_GAP_MS = 60000;
+
+    // An ID is reported silent if not seen for this many average gaps
+    static constexpr uint32_t SILENT_GAP_FACTOR = 5;
+    static constexpr uint32_t SILENT_MIN_MS = 1000;
+
+    struct Entry {
+        uint32_t canId = 0;
+        bool extended = false;
+        bool used = false;
+        uint32_t count = 0;
+        uint32_t lastUs = 0;
+        uint32_t lastSeenMs = 0;
+        uint32_t ewmaGapUs = 0;
+        uint32_t minGapUs = 0;
+        uint32_t maxGapUs = 0;
+        uint16_t jitter[JITTER_BUCKETS] = {};
+
+        /**
+         * Average arrival rate derived from the EWMA gap.
+         */
+        float rateHz() const { return ewmaGapUs ? 1000000.0f / ewmaGapUs : 0.0f; }
+
+        /**
+         * Check if the ID stopped arriving (relative to its own period).
+         */
+        bool isSilent(uint32_t nowMs) const;
+    };
+
+    CanIdProfiler() = default;
+
+    /**
+     * Enable/disable profiling (record() becomes a no-op when disabled).
+     */
+    void setEnabled(bool enable) { enabled = enable; }
+    bool isEnabled() const { return enabled; }
+
+    /**
+     * Include the profile as an optional section in vehicle telemetry.
+     */
+    void setTelemetryEnabled(bool enable) { telemetryEnabled = enable; }
+    bool isTelemetryEnabled() const { return telemetryEnabled; }
+
+    /**
+     * Record a batch of received frames. Decode task only.
+     */
+    void record(const CanRxFrame* frames, size_t count);
+
+    /**
+     * Request a reset of all statistics. Applied by the writer on its next record().
+     */
+    void reset() { resetRequested = true; }
+
+    /**
+     * Number of table slots in use.
+     */
+    size_t getIdCount() const { return idCount; }
+
+    /**
+     * Frames whose ID could not get a table slot.
+     */
+    uint32_t getTableOverflows() const { return tableOverflows; }
+
+    /**
+     * Direct access to a table slot (check Entry::used).
+     */
+    const Entry& getEntry(size_t index) const { return table[index]; }
+
+    /**
+     * Serialize profiled IDs, sorted by ID.
+     * @param out Array to append one object per ID to
+     * @param detailed Include min/max gap and the jitter histogram
+     */
+    void toJson(JsonArray out, bool detailed) const;
+
+private:
+    Entry table[MAX_IDS];
+    volatile size_t idCount = 0;
+    volatile uint32_t tableOverflows = 0;
+    volatile bool enabled = true;
+    volatile bool telemetryEnabled = false;
+    volatile bool resetRequested = false;
+
+    Entry* findOrInsert(uint32_t canId, bool extended);
+    void recordFrame(Entry& entry, uint32_t timestampUs, uint32_t nowMs);
+    void clear();
+    static uint8_t jitterBucket(uint32_t deviationUs);
+};
@@ -1,4 +1,57 @@
 #include "CanManager.h"
+#include <Preferences.h>
+
+/**
+ * Bitrate found by autobaud. RTC copy survives deep sleep, so a wake starts
+ * at the right rate without probing; the NVS copy survives power loss.
+ */
+typedef struct {
+    uint32_t magic;
+    uint8_t speed;
+} CanSpeedCache;
+
+static constexpr uint32_t SPEED_CACHE_MAGIC = 0x43414E42;  // "CANB"
+static constexpr const char* SPEED_NVS_NAMESPACE = "can";
+static constexpr const char* SPEED_NVS_KEY = "speed";
+
+RTC_DATA_ATTR CanSpeedCache rtcSpeedCache = {};
+
+static bool loadCachedSpeed(CanSpeed& speed) {
+    if (rtcSpeedCache.magic == SPEED_CACHE_MAGIC) {
+        speed = static_cast<CanSpeed>(rtcSpeedCache.speed);
+        return true;
+    }
+
+    Preferences prefs;
+    if (!prefs.begin(SPEED_NVS_NAMESPACE, true)) {
+        return false;
+    }
+    uint8_t stored = prefs.getUChar(SPEED_NVS_KEY, 0xFF);
+    prefs.end();
+
+    if (stored > static_cast<uint8_t>(CanSpeed::CAN_1MBPS)) {
+        return false;
+    }
+    speed = static_cast<CanSpeed>(stored);
+    rtcSpeedCache.speed = stored;
+    rtcSpeedCache.magic = SPEED_CACHE_MAGIC;
+    return true;
+}
+
+static void storeCachedSpeed(CanSpeed speed) {
+    uint8_t value = static_cast<uint8_t>(speed);
+    rtcSpeedCache.speed = value;
+    rtcSpeedCache.magic = SPEED_CACHE_MAGIC;
+
+    // Flash write only when the rate actually changed
+    Preferences prefs;
+    if (prefs.begin(SPEED_NVS_NAMESPACE, false)) {
+        if (prefs.getUChar(SPEED_NVS_KEY, 0xFF) != value) {
+            prefs.putUChar(SPEED_NVS_KEY, value);
+        }
+        prefs.end();
+    }
+}
 
 CanManager::CanManager() {
 }
@@ -8,11 +61,19 @@ CanManager::~CanManager() {
         stop();
     }
     
-    // Clean up semaphore
+    // Clean up semaphores
     if (taskExitedSemaphore != nullptr) {
         vSemaphoreDelete(taskExitedSemaphore);
         taskExitedSemaphore = nullptr;
     }
+    if (decodeExitedSemaphore != nullptr) {
+        vSemaphoreDelete(decodeExitedSemaphore);
+        decodeExitedSemaphore = nullptr;
+    }
+    if (txExitedSemaphore != nullptr) {
+        vSemaphoreDelete(txExitedSemaphore);
+        txExitedSemaphore = nullptr;
+    }
 }
 
 bool CanManager::setup() {
@@ -20,6 +81,9 @@ bool CanManager::setup() {
     
     // Transceiver enable is hardwired to 3.3V
     
+    // Flight recorder runs without PSRAM too (just disabled)
+    flightRecorder.begin();
+    
     Serial.println("[CAN] Setup complete (not started)");
     return true;
 }
@@ -28,11 +92,18 @@ void CanManager::loop() {
     // Main loop only handles state transitions and status checks
     // Actual RX processing happens in dedicated task on Core 0
     
+    // TX completion callbacks run here, not on the TX task
+    txScheduler.dispatchCompletions();
+    
     switch (state) {
         case CanState::OFF:
             // Nothing to do
             break;
 
+        case CanState::DETECTING:
+            pollAutobaud();
+            break;
+
         case CanState::STARTING:
             // Check if driver is ready
             if (timeInState() > 100) {
@@ -42,6 +113,23 @@ void CanManager::loop() {
             break;
 
         case CanState::RUNNING:
+            // Registered ID set changed - TWAI filters can only be set at install time
+            if (filterReprogramPending) {
+                Serial.println("[CAN] Acceptance filter changed - reinstalling driver...");
+                stop();
+                start();
+                break;
+            }
+            
+            // Cached bitrate turned out wrong - probe again
+            if (autobaudRedetectPending) {
+                Serial.println("[CAN] Bitrate looks wrong - restarting autobaud...");
+                autobaudRedetectPending = false;
+                stop();
+                start();
+                break;
+            }
+            
             // Periodically check bus status (from main loop - less critical)
             if (millis() - lastStatusCheck > STATUS_CHECK_INTERVAL) {
                 checkBusStatus();
@@ -76,7 +164,7 @@ void CanManager::prepareForSleep() {
 }
 
 bool CanManager::isBusy() {
-    return state == CanState::STARTING;
+    return state == CanState::STARTING || state == CanState::DETECTING;
 }
 
 bool CanManager::isReady() {
@@ -91,6 +179,26 @@ bool CanManager::start() {
 
     Serial.println("[CAN] Starting CAN controller...");
 
+    if (autobaudEnabled) {
+        CanSpeed cached;
+        if (!loadCachedSpeed(cached)) {
+            return beginAutobaud();
+        }
+        canSpeed = cached;
+        if (!autobaudResult.valid || autobaudResult.speed != cached) {
+            autobaudResult = CanAutobaudResult();
+            autobaudResult.valid = true;
+            autobaudResult.fromCache = true;
+            autobaudResult.speed = cached;
+            autobaudResult.confidence = 100;
+            Serial.printf("[CAN] Autobaud: using cached %s\r\n", speedName(cached));
+        }
+    }
+
+    return startController();
+}
+
+bool CanManager::startController() {
     if (!installDriver()) {
         Serial.println("[CAN] Failed to install driver");
         setState(CanState::CAN_ERROR);
@@ -112,15 +220,53 @@ bool CanManager::start() {
     lastRxMissedCount = 0;
     lastStatusCheck = millis();
     lastTestMessage = millis();
+    rxRing.clear();
+    rxRing.resetStats();
+    decodeBatches = 0;
+    decodedFrames = 0;
+    maxBatchSize = 0;
+    decodeLatencyAvgUs = 0;
+    decodeLatencyMaxUs = 0;
+    sinkCyclesPerFrame = 0;
+    loadEstimator.setBitrate(speedBitrate(canSpeed));
+    loadEstimator.reset();
     
-    // Create synchronization semaphore for task exit
+    // Create synchronization semaphores for task exit
     if (taskExitedSemaphore == nullptr) {
         taskExitedSemaphore = xSemaphoreCreateBinary();
     }
+    if (decodeExitedSemaphore == nullptr) {
+        decodeExitedSemaphore = xSemaphoreCreateBinary();
+    }
+    if (txExitedSemaphore == nullptr) {
+        txExitedSemaphore = xSemaphoreCreateBinary();
+    }
+    
+    // Start the decode task first so the ring has a consumer before frames arrive
+    decodeRunning = true;
+    BaseType_t taskResult = xTaskCreatePinnedToCore(
+        decodeTaskEntry,
+        "CAN_DEC",
+        DECODE_TASK_STACK_SIZE,
+        this,
+        DECODE_TASK_PRIORITY,
+        &decodeTaskHandle,
+        DECODE_TASK_CORE
+    );
+    
+    if (taskResult != pdPASS) {
+        Serial.println("[CAN] Failed to create decode task!");
+        decodeRunning = false;
+        decodeTaskHandle = nullptr;
+        twai_stop();
+        uninstallDriver();
+        setState(CanState::CAN_ERROR);
+        return false;
+    }
     
     // Start the dedicated CAN receive task on Core 0
     taskRunning = true;
-    BaseType_t taskResult = xTaskCreatePinnedToCore(
+    taskResult = xTaskCreatePinnedToCore(
         canTaskEntry,           // Task function
         "CAN_RX",              // Task name
         CAN_TASK_STACK_SIZE,   // Stack size
@@ -132,14 +278,45 @@ bool CanManager::start() {
     
     if (taskResult != pdPASS) {
         Serial.println("[CAN] Failed to create CAN task!");
+        taskRunning = false;
+        canTaskHandle = nullptr;
+        decodeRunning = false;
+        stopTask(decodeTaskHandle, decodeExitedSemaphore, "Decode");
+        twai_stop();
+        uninstallDriver();
+        setState(CanState::CAN_ERROR);
+        return false;
+    }
+    
+    // Start the TX task last - submissions are accepted from here on
+    txRunning = true;
+    taskResult = xTaskCreatePinnedToCore(
+        txTaskEntry,
+        "CAN_TX",
+        TX_TASK_STACK_SIZE,
+        this,
+        TX_TASK_PRIORITY,
+        &txTaskHandle,
+        TX_TASK_CORE
+    );
+    
+    if (taskResult != pdPASS) {
+        Serial.println("[CAN] Failed to create TX task!");
+        txRunning = false;
+        txTaskHandle = nullptr;
+        taskRunning = false;
+        stopTask(canTaskHandle, taskExitedSemaphore, "CAN");
+        decodeRunning = false;
+        stopTask(decodeTaskHandle, decodeExitedSemaphore, "Decode");
         twai_stop();
         uninstallDriver();
         setState(CanState::CAN_ERROR);
         return false;
     }
+    txScheduler.setAccepting(true);
     
-    Serial.printf("[CAN] CAN task started on Core %d with priority %d\r\n", 
-        CAN_TASK_CORE, CAN_TASK_PRIORITY);
+    Serial.printf("[CAN] CAN task started on Core %d with priority %d (decode priority %d, ring %lu frames)\r\n", 
+        CAN_TASK_CORE, CAN_TASK_PRIORITY, DECODE_TASK_PRIORITY, RX_RING_CAPACITY);
 
     setState(CanState::STARTING);
     Serial.println("[CAN] Controller started");
@@ -151,45 +328,73 @@ bool CanManager::stop() {
         return true;
     }
 
+    if (state == CanState::DETECTING) {
+        // Only the listen-only probe driver is installed
+        Serial.println("[CAN] Autobaud aborted");
+        twai_stop();
+        uninstallDriver();
+        setState(CanState::OFF);
+        return true;
+    }
+
     Serial.println("[CAN] Stopping CAN controller...");
     
-    // Stop the CAN task first
-    if (canTaskHandle != nullptr) {
-        // Signal task to stop
-        taskRunning = false;
-        
-        // Wait for task to signal that it has exited (timeout 200ms)
-        if (taskExitedSemaphore != nullptr) {
-            if (xSemaphoreTake(taskExitedSemaphore, pdMS_TO_TICKS(200)) == pdTRUE) {
-                Serial.println("[CAN] Task exited gracefully");
-            } else {
-                Serial.println("[CAN] Task exit timeout - forcing deletion");
-            }
-        } else {
-            // No semaphore, wait a short time
-            vTaskDelay(pdMS_TO_TICKS(50));
-        }
-        
-        // Task should have already deleted itself, but check just in case
-        if (eTaskGetState(canTaskHandle) != eDeleted) {
-            vTaskDelete(canTaskHandle);
-            Serial.println("[CAN] Task forcefully deleted");
-        }
-        
-        canTaskHandle = nullptr;
-        Serial.println("[CAN] CAN task stopped");
-    }
+    // Stop TX first and fail whatever is still queued (callbacks run from loop())
+    txScheduler.setAccepting(false);
+    txRunning = false;
+    stopTask(txTaskHandle, txExitedSemaphore, "TX");
+    txScheduler.flush(CanTxResult::FLUSHED);
+    
+    // Stop the CAN RX task (no more producers)
+    taskRunning = false;
+    stopTask(canTaskHandle, taskExitedSemaphore, "CAN");
+    
+    // Then stop the decode task - it drains whatever is left in the ring
+    decodeRunning = false;
+    stopTask(decodeTaskHandle, decodeExitedSemaphore, "Decode");
 
     // Stop and uninstall the driver
     twai_stop();
     uninstallDriver();
 
     setState(CanState::OFF);
-    Serial.printf("[CAN] Stopped. Messages: %lu, Errors: %lu, Missed: %lu\r\n", 
-        messageCount, errorCount, lastRxMissedCount);
+    Serial.printf("[CAN] Stopped. Messages: %lu, Errors: %lu, Missed: %lu, Ring overflows: %lu (high-water %lu/%lu), TX sent: %lu failed: %lu\r\n", 
+        messageCount, errorCount, lastRxMissedCount,
+        rxRing.getOverflows(), rxRing.getHighWater(), RX_RING_CAPACITY,
+        txScheduler.getSent(), txScheduler.getFailedCount());
     return true;
 }
 
+void CanManager::stopTask(TaskHandle_t& handle, SemaphoreHandle_t exitedSemaphore, const char* name) {
+    if (handle == nullptr) {
+        return;
+    }
+    
+    // Wake the task in case it is blocked waiting for a notification
+    xTaskNotifyGive(handle);
+    
+    // Wait for task to signal that it has exited (timeout 200ms)
+    if (exitedSemaphore != nullptr) {
+        if (xSemaphoreTake(exitedSemaphore, pdMS_TO_TICKS(200)) == pdTRUE) {
+            Serial.printf("[CAN] %s task exited gracefully\r\n", name);
+        } else {
+            Serial.printf("[CAN] %s task exit timeout - forcing deletion\r\n", name);
+        }
+    } else {
+        // No semaphore, wait a short time
+        vTaskDelay(pdMS_TO_TICKS(50));
+    }
+    
+    // Task should have already deleted itself, but check just in case
+    if (eTaskGetState(handle) != eDeleted) {
+        vTaskDelete(handle);
+        Serial.printf("[CAN] %s task forcefully deleted\r\n", name);
+    }
+    
+    handle = nullptr;
+    Serial.printf("[CAN] %s task stopped\r\n", name);
+}
+
 // =============================================================================
 // CAN Task (runs on Core 0)
 // =============================================================================
@@ -210,43 +415,28 @@ void CanManager::canTaskLoop() {
         esp_err_t result = twai_receive(&message, pdMS_TO_TICKS(10));
         
         if (result == ESP_OK) {
-            messageCount++;
-            
-            // Process the message immediately
-            if (frameCallback) {
-                frameCallback(
-                    message.identifier,
-                    message.data,
-                    message.data_length_code,
-                    message.extd
-                );
-            }
-            
-            // Report activity (for sleep management)
-            if (activityCallback) {
-                activityCallback();
-            }
+            enqueueMessage(message);
             
             // After receiving one message, drain any others in the queue
             // Use non-blocking receive to get all pending messages
             while (taskRunning && twai_receive(&message, 0) == ESP_OK) {
-                messageCount++;
-                
-                if (frameCallback) {
-                    frameCallback(
-                        message.identifier,
-                        message.data,
-                        message.data_length_code,
-                        message.extd
-                    );
-                }
-                
-                if (activityCallback) {
-                    activityCallback();
-                }
+                enqueueMessage(message);
+            }
+            
+            // Wake the decode task once per burst
+            if (decodeTaskHandle != nullptr) {
+                xTaskNotifyGive(decodeTaskHandle);
             }
         }
         // ESP_ERR_TIMEOUT is normal - just means no message in the timeout period
+        
+        // Close the bus load bucket once per second, sampling driver RX misses
+        uint32_t nowUs = micros();
+        if (loadEstimator.rolloverDue(nowUs)) {
+            twai_status_info_t status;
+            uint32_t missed = (twai_get_status_info(&status) == ESP_OK) ? status.rx_missed_count : lastRxMissedCount;
+            loadEstimator.rollover(nowUs, missed, rxRing.getOverflows());
+        }
     }
     
     Serial.println("[CAN] Task exiting gracefully");
@@ -259,6 +449,139 @@ void CanManager::canTaskLoop() {
     vTaskDelete(NULL);
 }
 
+void CanManager::enqueueMessage(const twai_message_t& message) {
+    messageCount++;
+    loadEstimator.record(message.rtr ? 0 : message.data_length_code, message.extd);
+    
+    // Ring full means the decode task has fallen >RX_RING_CAPACITY frames behind;
+    // the frame is dropped and counted in rxRing overflows
+    rxRing.push(message.identifier, message.data, message.data_length_code,
+                message.extd, micros());
+}
+
+// =============================================================================
+// TX Task (runs on Core 0)
+// =============================================================================
+
+void CanManager::txTaskEntry(void* param) {
+    CanManager* self = static_cast<CanManager*>(param);
+    self->txTaskLoop();
+}
+
+void CanManager::txTaskLoop() {
+    Serial.printf("[CAN] TX task running on Core %d\r\n", xPortGetCoreID());
+    
+    while (txRunning) {
+        // Sleep when idle or backing off; transmit() notifies on new frames
+        uint32_t waitMs = txScheduler.poll();
+        if (waitMs > 0) {
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(waitMs));
+        }
+    }
+    
+    Serial.println("[CAN] TX task exiting gracefully");
+    
+    if (txExitedSemaphore != nullptr) {
+        xSemaphoreGive(txExitedSemaphore);
+    }
+    
+    vTaskDelete(NULL);
+}
+
+bool CanManager::transmit(uint32_t canId, const uint8_t* data, uint8_t dlc, bool extended,
+                          CanTxPriority priority, CanTxCallback onComplete, uint32_t deadlineMs) {
+    CanTxFrame frame;
+    frame.canId = canId;
+    frame.dlc = dlc > 8 ? 8 : dlc;
+    frame.extended = extended;
+    memcpy(frame.data, data, frame.dlc);
+    return transmitSequence(&frame, 1, priority, std::move(onComplete), deadlineMs);
+}
+
+bool CanManager::transmitSequence(const CanTxFrame* frames, size_t count, CanTxPriority priority,
+                                  CanTxCallback onComplete, uint32_t deadlineMs) {
+    if (!txScheduler.submitSequence(frames, count, priority, std::move(onComplete), deadlineMs)) {
+        return false;
+    }
+    if (txTaskHandle != nullptr) {
+        xTaskNotifyGive(txTaskHandle);
+    }
+    return true;
+}
+
+// =============================================================================
+// Decode Task (runs on Core 0, below CAN RX priority)
+// =============================================================================
+
+void CanManager::decodeTaskEntry(void* param) {
+    CanManager* self = static_cast<CanManager*>(param);
+    self->decodeTaskLoop();
+}
+
+void CanManager::decodeTaskLoop() {
+    Serial.printf("[CAN] Decode task running on Core %d\r\n", xPortGetCoreID());
+    
+    while (decodeRunning) {
+        // Sleep until the RX task signals a burst (timeout bounds shutdown latency)
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(10));
+        drainRing();
+        flightRecorder.poll();
+    }
+    
+    // RX task is already stopped - process anything still queued
+    drainRing();
+    
+    Serial.println("[CAN] Decode task exiting gracefully");
+    
+    if (decodeExitedSemaphore != nullptr) {
+        xSemaphoreGive(decodeExitedSemaphore);
+    }
+    
+    vTaskDelete(NULL);
+}
+
+void CanManager::drainRing() {
+    const CanRxFrame* frames = nullptr;
+    uint32_t count;
+    
+    while ((count = rxRing.peekSpan(frames, DECODE_BATCH_MAX)) > 0) {
+        // Per-ID rate/jitter uses the RX timestamps, so decode delay doesn't skew it
+        idProfiler.record(frames, count);
+        flightRecorder.record(frames, count);
+        
+        // One sink call for the whole contiguous span
+        uint32_t startCycles = ESP.getCycleCount();
+        if (staticSink) {
+            staticSink(frames, count);
+        } else if (frameSink) {
+            frameSink->onCanFrames(frames, count);
+        }
+        uint32_t cyclesPerFrame = (ESP.getCycleCount() - startCycles) / count;
+        sinkCyclesPerFrame = sinkCyclesPerFrame + ((int32_t)(cyclesPerFrame - sinkCyclesPerFrame) >> 4);
+        
+        // Report activity once per batch (for sleep management)
+        if (activityCallback) {
+            activityCallback();
+        }
+        
+        // Enqueue -> decode-complete latency of the oldest frame (worst in batch)
+        uint32_t latencyUs = (uint32_t)micros() - frames[0].timestampUs;
+        if (latencyUs > decodeLatencyMaxUs) {
+            decodeLatencyMaxUs = latencyUs;
+        }
+        // EWMA with alpha = 1/16
+        decodeLatencyAvgUs = decodeLatencyAvgUs + ((int32_t)(latencyUs - decodeLatencyAvgUs) >> 4);
+        
+        rxRing.pop(count);
+        
+        decodeBatches++;
+        decodedFrames += count;
+        if (count > maxBatchSize) {
+            maxBatchSize = count;
+        }
+    }
+}
+
 // =============================================================================
 // Private methods
 // =============================================================================
@@ -276,7 +599,7 @@ unsigned long CanManager::timeInState() {
     return millis() - stateEntryTime;
 }
 
-bool CanManager::installDriver() {
+bool CanManager::installDriver(bool listenOnly) {
     // Get timing config based on speed setting
     twai_timing_config_t timingConfig;
     
@@ -311,12 +634,41 @@ bool CanManager::installDriver() {
     // Increase RX queue to handle bursts while task is processing
     twai_general_config_t generalConfig = TWAI_GENERAL_CONFIG_DEFAULT(CAN_TX_PIN, CAN_RX_PIN, TWAI_MODE_NORMAL);
     generalConfig.rx_queue_len = 32;  // Moderate queue - task drains quickly
-    generalConfig.tx_queue_len = 8;   // Keep TX small, we don't send much
+    generalConfig.tx_queue_len = 0;   // No driver queue - CanTxScheduler orders and retries TX
+    generalConfig.alerts_enabled = TWAI_ALERT_TX_SUCCESS | TWAI_ALERT_TX_FAILED;  // Consumed by the TX task
+    
+    if (listenOnly) {
+        // Autobaud probe: never ACK or flag errors on a bus we may be misreading,
+        // and see all traffic (the acceptance filter would hide valid frames)
+        generalConfig.mode = TWAI_MODE_LISTEN_ONLY;
+        generalConfig.alerts_enabled = 0;
+        twai_filter_config_t acceptAll = TWAI_FILTER_CONFIG_ACCEPT_ALL();
+        esp_err_t result = twai_driver_install(&generalConfig, &timingConfig, &acceptAll);
+        if (result != ESP_OK) {
+            Serial.printf("[CAN] Failed to install listen-only driver: %s\r\n", esp_err_to_name(result));
+            return false;
+        }
+        return true;
+    }
     
-    // Accept all messages - hardware filtering is limited for our use case
-    // (we need many different standard IDs across a wide range)
-    // Software filtering happens in VehicleManager
+    // Hardware filter planned from the registered IDs (accept all if none).
+    // It is a coarse pre-filter; exact routing still happens in VehicleManager.
     twai_filter_config_t filterConfig = TWAI_FILTER_CONFIG_ACCEPT_ALL();
+    if (!filterPlan.acceptAll) {
+        filterConfig.acceptance_code = filterPlan.acceptanceCode;
+        filterConfig.acceptance_mask = filterPlan.acceptanceMask;
+        filterConfig.single_filter = filterPlan.singleFilter;
+        Serial.printf("[CAN] Filter: %s code=0x%08lX mask=0x%08lX (false accept std:%.0f%% ext:%.2f%%)\r\n",
+            filterPlan.singleFilter ? "single" : "dual",
+            filterPlan.acceptanceCode, filterPlan.acceptanceMask,
+            filterPlan.stdFalseAcceptRate * 100.0f, filterPlan.extFalseAcceptRate * 100.0f);
+    } else {
+        Serial.println("[CAN] Filter: accept all");
+    }
+    installedPlan = filterPlan;
+    filterReprogramPending = false;
+    flightRecorder.setAcceptanceFilter(filterConfig.acceptance_code, filterConfig.acceptance_mask,
+                                       filterConfig.single_filter);
 
     Serial.printf("[CAN] Installing driver (TX: GPIO%d, RX: GPIO%d)\r\n", CAN_TX_PIN, CAN_RX_PIN);
 
@@ -329,10 +681,213 @@ bool CanManager::installDriver() {
     return true;
 }
 
+void CanManager::setAcceptanceIds(const uint16_t* stdIds, size_t stdCount,
+                                  const CanFilterPlanner::ExtRange* extRanges, size_t extCount) {
+    updateFilterPlan(CanFilterPlanner::plan(stdIds, stdCount, extRanges, extCount));
+}
+
+void CanManager::clearAcceptanceIds() {
+    updateFilterPlan(CanFilterPlanner::Plan());
+}
+
+void CanManager::updateFilterPlan(const CanFilterPlanner::Plan& plan) {
+    filterPlan = plan;
+    
+    // Only running drivers need reinstalling; otherwise start() picks it up
+    if (state != CanState::OFF && filterPlan != installedPlan) {
+        filterReprogramPending = true;
+    }
+}
+
 void CanManager::uninstallDriver() {
     twai_driver_uninstall();
 }
 
+// =============================================================================
+// Autobaud (listen-only probing, driven from loop())
+// =============================================================================
+
+const char* CanManager::speedName(CanSpeed speed) {
+    switch (speed) {
+        case CanSpeed::CAN_100KBPS: return "100 kbps";
+        case CanSpeed::CAN_125KBPS: return "125 kbps";
+        case CanSpeed::CAN_250KBPS: return "250 kbps";
+        case CanSpeed::CAN_500KBPS: return "500 kbps";
+        case CanSpeed::CAN_1MBPS: return "1 Mbps";
+        default: return "unknown";
+    }
+}
+
+uint32_t CanManager::speedBitrate(CanSpeed speed) {
+    switch (speed) {
+        case CanSpeed::CAN_100KBPS: return 100000;
+        case CanSpeed::CAN_125KBPS: return 125000;
+        case CanSpeed::CAN_250KBPS: return 250000;
+        case CanSpeed::CAN_500KBPS: return 500000;
+        case CanSpeed::CAN_1MBPS: return 1000000;
+        default: return 500000;
+    }
+}
+
+void CanManager::invalidateSpeedCache() {
+    rtcSpeedCache.magic = 0;
+
+    Preferences prefs;
+    if (prefs.begin(SPEED_NVS_NAMESPACE, false)) {
+        prefs.remove(SPEED_NVS_KEY);
+        prefs.end();
+    }
+    autobaudResult = CanAutobaudResult();
+    Serial.println("[CAN] Cached bitrate cleared");
+}
+
+bool CanManager::beginAutobaud() {
+    // Configured rate first (most likely), then the remaining presets
+    static const CanSpeed PRESETS[SPEED_COUNT] = {
+        CanSpeed::CAN_500KBPS, CanSpeed::CAN_250KBPS, CanSpeed::CAN_125KBPS,
+        CanSpeed::CAN_1MBPS, CanSpeed::CAN_100KBPS
+    };
+    probeOrder[0] = canSpeed;
+    uint8_t count = 1;
+    for (uint8_t i = 0; i < SPEED_COUNT; i++) {
+        if (PRESETS[i] != canSpeed) {
+            probeOrder[count++] = PRESETS[i];
+        }
+    }
+
+    for (uint8_t i = 0; i < SPEED_COUNT; i++) {
+        probes[i] = AutobaudProbe();
+    }
+    probeIndex = 0;
+    detectStartTime = millis();
+    autobaudResult = CanAutobaudResult();
+
+    Serial.printf("[CAN] Autobaud: probing %u rates in listen-only mode (%lums each)\r\n",
+        SPEED_COUNT, AUTOBAUD_PROBE_MS);
+
+    if (!startProbe()) {
+        setState(CanState::CAN_ERROR);
+        return false;
+    }
+    setState(CanState::DETECTING);
+    return true;
+}
+
+bool CanManager::startProbe() {
+    CanSpeed configured = canSpeed;
+    canSpeed = probeOrder[probeIndex];
+    bool installed = installDriver(true);
+    canSpeed = configured;
+
+    if (!installed) {
+        return false;
+    }
+    esp_err_t result = twai_start();
+    if (result != ESP_OK) {
+        Serial.printf("[CAN] Autobaud: failed to start driver: %s\r\n", esp_err_to_name(result));
+        uninstallDriver();
+        return false;
+    }
+    probeStartTime = millis();
+    return true;
+}
+
+void CanManager::pollAutobaud() {
+    AutobaudProbe& probe = probes[probeIndex];
+
+    // Frames are only counted here - nothing is routed until normal start
+    twai_message_t message;
+    while (twai_receive(&message, 0) == ESP_OK) {
+        probe.frames++;
+    }
+
+    twai_status_info_t status;
+    if (twai_get_status_info(&status) == ESP_OK) {
+        probe.busErrors = status.bus_error_count;
+    }
+
+    probe.durationMs = millis() - probeStartTime;
+    bool clean = probe.frames >= AUTOBAUD_EARLY_FRAMES && probe.busErrors == 0;
+    if (!clean && probe.durationMs < AUTOBAUD_PROBE_MS) {
+        return;
+    }
+
+    twai_stop();
+    uninstallDriver();
+    Serial.printf("[CAN] Autobaud: %s -> %lu frames, %lu bus errors in %lums\r\n",
+        speedName(probeOrder[probeIndex]), probe.frames, probe.busErrors, probe.durationMs);
+
+    // Unambiguous: plenty of frames and not a single error
+    if (clean) {
+        finishAutobaud(probeIndex);
+        return;
+    }
+
+    probeIndex++;
+    if (probeIndex < SPEED_COUNT) {
+        if (!startProbe()) {
+            setState(CanState::CAN_ERROR);
+        }
+        return;
+    }
+
+    // All rates tried - best score wins, if it saw any real traffic
+    int winner = -1;
+    int32_t bestScore = 0;
+    for (uint8_t i = 0; i < SPEED_COUNT; i++) {
+        int32_t score = (int32_t)probes[i].frames - (int32_t)probes[i].busErrors;
+        if (probes[i].frames >= AUTOBAUD_MIN_FRAMES && (winner < 0 || score > bestScore)) {
+            winner = i;
+            bestScore = score;
+        }
+    }
+    finishAutobaud(winner);
+}
+
+void CanManager::finishAutobaud(int winner) {
+    setState(CanState::OFF);
+
+    CanAutobaudResult& result = autobaudResult;
+    result.durationMs = millis() - detectStartTime;
+    result.probes = probeIndex < SPEED_COUNT ? probeIndex + 1 : SPEED_COUNT;
+
+    if (winner < 0) {
+        // Silent bus (vehicle asleep) - nothing to learn, use the configured rate
+        result.valid = false;
+        Serial.printf("[CAN] Autobaud: no traffic after %lums - starting at configured %s\r\n",
+            result.durationMs, speedName(canSpeed));
+        startController();
+        return;
+    }
+
+    const AutobaudProbe& best = probes[winner];
+
+    // Confidence: share of valid frames vs. bus errors at the winning rate,
+    // scaled down if another rate also received traffic (ambiguous result)
+    uint32_t runnerUpFrames = 0;
+    for (uint8_t i = 0; i < SPEED_COUNT; i++) {
+        if (i != winner && probes[i].frames > runnerUpFrames) {
+            runnerUpFrames = probes[i].frames;
+        }
+    }
+    uint32_t confidence = best.frames * 100 / (best.frames + best.busErrors);
+    confidence = confidence * best.frames / (best.frames + runnerUpFrames);
+
+    result.valid = true;
+    result.fromCache = false;
+    result.speed = probeOrder[winner];
+    result.confidence = confidence;
+    result.frames = best.frames;
+    result.busErrors = best.busErrors;
+
+    canSpeed = result.speed;
+    storeCachedSpeed(canSpeed);
+
+    Serial.printf("[CAN] Autobaud: detected %s in %lums (confidence %u%%, %lu frames, %lu errors, %u rates tried)\r\n",
+        speedName(canSpeed), result.durationMs, result.confidence, best.frames, best.busErrors, result.probes);
+    startController();
+}
+
 void CanManager::processReceivedMessages() {
     // This is now only used as fallback - main processing in canTaskLoop()
     twai_message_t message;
@@ -344,13 +899,18 @@ void CanManager::processReceivedMessages() {
             logMessage(message);
         }
         
-        if (frameCallback) {
-            frameCallback(
-                message.identifier,
-                message.data,
-                message.data_length_code,
-                message.extd
-            );
+        if (staticSink || frameSink) {
+            CanRxFrame frame;
+            frame.timestampUs = micros();
+            frame.canId = message.identifier;
+            frame.dlc = message.data_length_code > 8 ? 8 : message.data_length_code;
+            frame.extended = message.extd;
+            memcpy(frame.data, message.data, frame.dlc);
+            if (staticSink) {
+                staticSink(&frame, 1);
+            } else {
+                frameSink->onCanFrames(&frame, 1);
+            }
         }
         
         if (activityCallback) {
@@ -363,10 +923,24 @@ void CanManager::checkBusStatus() {
     twai_status_info_t status;
     
     if (twai_get_status_info(&status) == ESP_OK) {
+        // Only receive errors and not a single valid frame: the (cached) bitrate
+        // is wrong. Bus errors and bus-off alone are no evidence: our own wake
+        // and keep-alive frames go unacknowledged on a sleeping bus, which only
+        // raises the TX error counter.
+        if (autobaudEnabled && messageCount == 0 && status.rx_error_counter >= AUTOBAUD_REDETECT_RX_ERRORS) {
+            Serial.printf("[CAN] RX error counter %lu (%lu bus errors) and no frames at %s\r\n",
+                status.rx_error_counter, status.bus_error_count, speedName(canSpeed));
+            errorCount += status.bus_error_count;
+            invalidateSpeedCache();
+            autobaudRedetectPending = true;
+            return;
+        }
+        
         // Check for bus-off condition
         if (status.state == TWAI_STATE_BUS_OFF) {
             Serial.println("[CAN] Bus-off detected!");
             errorCount++;
+            flightRecorder.trigger(CanFlightRecorder::Trigger::BUS_OFF);
             setState(CanState::BUS_OFF);
             return;
         }
@@ -445,28 +1019,29 @@ void CanManager::sendTestMessage() {
         }
     }
     
-    twai_message_t message;
-    message.identifier = 0x123;  // Test ID
-    message.extd = 0;            // Standard frame (11-bit ID)
-    message.rtr = 0;             // Not a remote frame
-    message.data_length_code = 8;
-    message.data[0] = 0xDE;
-    message.data[1] = 0xAD;
-    message.data[2] = 0xBE;
-    message.data[3] = 0xEF;
-    message.data[4] = counter++;
-    message.data[5] = (millis() >> 16) & 0xFF;
-    message.data[6] = (millis() >> 8) & 0xFF;
-    message.data[7] = millis() & 0xFF;
-    
-    esp_err_t result = twai_transmit(&message, pdMS_TO_TICKS(100));
-    
-    if (result == ESP_OK) {
-        Serial.printf("[CAN] TX: ID:0x%03lX [%d] DE AD BE EF %02X ...\r\n", 
-            message.identifier, message.data_length_code, message.data[4]);
-    } else if (result == ESP_ERR_TIMEOUT) {
-        Serial.println("[CAN] TX timeout - no ACK received (is another node connected?)");
-    } else {
-        Serial.printf("[CAN] TX failed: %s\r\n", esp_err_to_name(result));
+    uint8_t data[8];
+    data[0] = 0xDE;
+    data[1] = 0xAD;
+    data[2] = 0xBE;
+    data[3] = 0xEF;
+    data[4] = counter++;
+    data[5] = (millis() >> 16) & 0xFF;
+    data[6] = (millis() >> 8) & 0xFF;
+    data[7] = millis() & 0xFF;
+    
+    uint8_t sequence = data[4];
+    bool queued = transmit(0x123, data, 8, false, CanTxPriority::DIAGNOSTIC,  // Test ID, standard frame
+        [sequence](CanTxResult result) {
+            if (result == CanTxResult::SENT) {
+                Serial.printf("[CAN] TX: ID:0x123 [8] DE AD BE EF %02X ...\r\n", sequence);
+            } else if (result == CanTxResult::NO_ACK) {
+                Serial.println("[CAN] TX failed - no ACK received (is another node connected?)");
+            } else {
+                Serial.printf("[CAN] TX failed: %s\r\n", CanTxScheduler::resultName(result));
+            }
+        });
+    
+    if (!queued) {
+        Serial.println("[CAN] TX rejected - queue full or CAN not running");
     }
 }
@@ -3,6 +3,14 @@
 #include <Arduino.h>
 #include "driver/twai.h"
 #include "../core/IModule.h"
+#include "../core/Delegate.h"
+#include "CanFrameRing.h"
+#include "CanFilterPlanner.h"
+#include "ICanFrameSink.h"
+#include "CanIdProfiler.h"
+#include "CanBusLoad.h"
+#include "CanFlightRecorder.h"
+#include "CanTxScheduler.h"
 #include <functional>
 
 /**
@@ -10,6 +18,7 @@
  */
 enum class CanState {
     OFF,            // CAN controller is off
+    DETECTING,      // Autobaud: probing bitrates in listen-only mode
     STARTING,       // CAN controller is starting
     RUNNING,        // CAN controller is running and receiving
     BUS_OFF,        // Bus-off state (too many errors)
@@ -28,10 +37,18 @@ enum class CanSpeed {
 };
 
 /**
- * Callback type for received CAN frames.
- * Parameters: canId, data, dlc, extended
+ * Outcome of autobaud (last detection, or the cached rate used at start)
  */
-using CanFrameCallback = std::function<void(uint32_t, const uint8_t*, uint8_t, bool)>;
+struct CanAutobaudResult {
+    bool valid = false;             // Rate detected or loaded from cache
+    bool fromCache = false;         // Loaded from RTC/NVS, no probing
+    CanSpeed speed = CanSpeed::CAN_500KBPS;
+    uint32_t durationMs = 0;        // Probing time (0 for cache hits)
+    uint8_t confidence = 0;         // 0-100, see CanManager::finishAutobaud()
+    uint32_t frames = 0;            // Valid frames seen at the winning rate
+    uint32_t busErrors = 0;         // Bus errors seen at the winning rate
+    uint8_t probes = 0;             // Rates tried
+};
 
 /**
  * CanManager - ESP32 TWAI (CAN) bus control module
@@ -45,7 +62,12 @@ using CanFrameCallback = std::function<void(uint32_t, const uint8_t*, uint8_t, b
  * Architecture:
  * - CAN RX runs on Core 0 in a dedicated high-priority task
  * - This prevents message loss when main loop is busy with serial/network
- * - Frame processing callback is invoked from the CAN task context
+ * - The RX task only timestamps frames and pushes them into a lock-free SPSC ring
+ * - A separate decode task drains the ring in batches and hands each batch to
+ *   the frame sink (ICanFrameSink); activity is reported once per batch
+ * - Decode may block on VehicleManager's state lock without stalling TWAI draining
+ * - TX is asynchronous: callers submit to CanTxScheduler and a TX task on
+ *   Core 0 sends by priority class; completions are dispatched from loop()
  * 
  * Hardware:
  * - Uses ESP32's built-in TWAI (CAN) controller
@@ -72,11 +94,40 @@ public:
     void setActivityCallback(ActivityCallback callback) { activityCallback = callback; }
 
     /**
-     * Set the frame callback for routing frames to VehicleManager.
+     * Set the batch sink for routing frames to VehicleManager.
+     * Receives each decode batch as one contiguous span.
+     * Replaces any callback set with setFrameCallback() or bindFrameSink().
+     * NOTE: This is called from the CAN decode task on Core 0!
+     */
+    void setFrameSink(ICanFrameSink* sink) {
+        staticSink = CanBatchDelegate();
+        frameSink = sink;
+    }
+
+    /**
+     * Bind the batch sink at compile time (static dispatch).
+     * Sink::onCanFrames is called with a qualified, non-virtual call from a
+     * stub instantiated for Sink, so no vtable or std::function is involved.
+     * Replaces any sink set with setFrameSink()/setFrameCallback().
+     * NOTE: This is called from the CAN decode task on Core 0!
+     */
+    template<typename Sink>
+    void bindFrameSink(Sink* sink) {
+        frameSink = nullptr;
+        staticSink = CanBatchDelegate::bindStub<&CanManager::sinkStub<Sink>>(sink);
+    }
+
+    /**
+     * Set a per-frame callback (adapted onto the batch sink).
      * Called for each received CAN frame with (canId, data, dlc, extended).
-     * NOTE: This is called from the CAN task on Core 0!
+     * Replaces any sink set with setFrameSink().
+     * NOTE: This is called from the CAN decode task on Core 0!
      */
-    void setFrameCallback(CanFrameCallback callback) { frameCallback = callback; }
+    void setFrameCallback(CanFrameCallback callback) {
+        callbackSink.setCallback(callback);
+        staticSink = CanBatchDelegate();
+        frameSink = &callbackSink;
+    }
 
     /**
      * Get current CAN state.
@@ -107,12 +158,94 @@ public:
      */
     void setSpeed(CanSpeed speed) { canSpeed = speed; }
 
+    /**
+     * Get the configured (or detected) CAN bus speed.
+     */
+    CanSpeed getSpeed() const { return canSpeed; }
+
+    /**
+     * Enable automatic bitrate detection.
+     * start() uses the rate cached in RTC/NVS if there is one; otherwise it
+     * probes each CanSpeed preset in listen-only mode (never ACKs or sends),
+     * picks the rate with the most valid frames vs. bus errors, caches it and
+     * starts normally. A silent bus falls back to the setSpeed() rate.
+     * A cached rate that produces only bus errors is dropped and re-detected.
+     */
+    void setAutobaud(bool enabled) { autobaudEnabled = enabled; }
+    bool isAutobaudEnabled() const { return autobaudEnabled; }
+
+    /**
+     * Get the last autobaud outcome (detection time, confidence).
+     */
+    const CanAutobaudResult& getAutobaudResult() const { return autobaudResult; }
+
+    /**
+     * Forget the cached bitrate (RTC and NVS); the next start() re-detects.
+     */
+    void invalidateSpeedCache();
+
+    static const char* speedName(CanSpeed speed);
+    static uint32_t speedBitrate(CanSpeed speed);
+
     /**
      * Enable/disable verbose message logging.
      * @param enabled true to log all received messages
      */
     void setVerbose(bool enabled) { verbose = enabled; }
 
+    /**
+     * Set the CAN IDs consumed by the application and derive the TWAI
+     * hardware acceptance filter from them (see CanFilterPlanner).
+     * If the resulting filter differs from the installed one while running,
+     * the driver is reinstalled from loop().
+     * @param stdIds Standard (11-bit) IDs
+     * @param stdCount Number of standard IDs
+     * @param extRanges Extended (29-bit) ID ranges
+     * @param extCount Number of extended ranges
+     */
+    void setAcceptanceIds(const uint16_t* stdIds, size_t stdCount,
+                          const CanFilterPlanner::ExtRange* extRanges, size_t extCount);
+
+    /**
+     * Remove the hardware filter (accept all frames).
+     */
+    void clearAcceptanceIds();
+
+    /**
+     * Get the currently planned acceptance filter.
+     */
+    const CanFilterPlanner::Plan& getFilterPlan() const { return filterPlan; }
+
+    // =========================================================================
+    // Transmit (non-blocking, see CanTxScheduler)
+    // =========================================================================
+
+    /**
+     * Queue a frame for transmission.
+     * @param priority TX class (KEEP_ALIVE first ... DIAGNOSTIC last)
+     * @param onComplete Called from loop() with the outcome (optional)
+     * @param deadlineMs Drop if not sent within this time (0 = class default)
+     * @return false if rejected (not running or queue full); onComplete is not called
+     */
+    bool transmit(uint32_t canId, const uint8_t* data, uint8_t dlc, bool extended,
+                  CanTxPriority priority = CanTxPriority::COMMAND,
+                  CanTxCallback onComplete = nullptr, uint32_t deadlineMs = 0);
+
+    /**
+     * Queue frames that must be sent in order, e.g. a long BAP message.
+     * The first frame uses priority, the rest go as BAP_CONTINUATION.
+     * onComplete is called once for the whole sequence.
+     * @return false if rejected (nothing queued)
+     */
+    bool transmitSequence(const CanTxFrame* frames, size_t count,
+                          CanTxPriority priority = CanTxPriority::BAP_START,
+                          CanTxCallback onComplete = nullptr, uint32_t deadlineMs = 0);
+
+    /**
+     * Get the TX scheduler (queue depth, failure counters by cause).
+     */
+    CanTxScheduler& scheduler() { return txScheduler; }
+
     /**
      * Get message receive count since start.
      */
@@ -128,9 +261,102 @@ public:
      */
     uint32_t getMissedCount() { return lastRxMissedCount; }
 
+    // =========================================================================
+    // RX ring / decode statistics
+    // =========================================================================
+
+    /**
+     * Get current number of frames waiting in the RX ring.
+     */
+    uint32_t getRingDepth() const { return rxRing.size(); }
+
+    /**
+     * Get RX ring capacity in frames.
+     */
+    uint32_t getRingCapacity() const { return rxRing.capacity(); }
+
+    /**
+     * Get highest RX ring occupancy seen since start.
+     */
+    uint32_t getRingHighWater() const { return rxRing.getHighWater(); }
+
+    /**
+     * Get count of frames dropped because the RX ring was full.
+     */
+    uint32_t getRingOverflows() const { return rxRing.getOverflows(); }
+
+    /**
+     * Get number of decode batches processed since start.
+     */
+    uint32_t getDecodeBatches() const { return decodeBatches; }
+
+    /**
+     * Get number of frames delivered to the sink since start.
+     */
+    uint32_t getDecodedFrames() const { return decodedFrames; }
+
+    /**
+     * Get largest batch delivered to the sink since start.
+     */
+    uint32_t getMaxBatchSize() const { return maxBatchSize; }
+
+    /**
+     * Get average batch size (frames per batch) since start.
+     */
+    float getAvgBatchSize() const { return decodeBatches ? (float)decodedFrames / decodeBatches : 0.0f; }
+
+    /**
+     * Get smoothed sink cost in CPU cycles per frame (CCOUNT around the
+     * sink call, includes routing and decode in the sink).
+     */
+    uint32_t getSinkCyclesPerFrame() const { return sinkCyclesPerFrame; }
+
+    /**
+     * Check if the sink is bound statically (bindFrameSink()).
+     */
+    bool isSinkStatic() const { return static_cast<bool>(staticSink); }
+
+    /**
+     * Get the per-ID arrival rate/jitter profiler (fed from the decode task).
+     */
+    CanIdProfiler& profiler() { return idProfiler; }
+
+    /**
+     * Get the bus load estimator (fed from the CAN RX task).
+     */
+    CanBusLoad& busLoad() { return loadEstimator; }
+
+    /**
+     * Get the PSRAM flight recorder (fed from the decode task).
+     */
+    CanFlightRecorder& recorder() { return flightRecorder; }
+
+    /**
+     * Get smoothed enqueue->decode latency in microseconds.
+     */
+    uint32_t getDecodeLatencyAvgUs() const { return decodeLatencyAvgUs; }
+
+    /**
+     * Get worst enqueue->decode latency in microseconds since start.
+     */
+    uint32_t getDecodeLatencyMaxUs() const { return decodeLatencyMaxUs; }
+
+    // RX ring sizing (public so host tools can mirror the device pipeline)
+    static constexpr uint32_t RX_RING_CAPACITY = 256;     // ~5 KB, >100ms of traffic at 500 kbps
+    static constexpr uint32_t DECODE_BATCH_MAX = 32;      // Frames per decode batch
+
 private:
     ActivityCallback activityCallback = nullptr;
-    CanFrameCallback frameCallback = nullptr;
+    using CanBatchDelegate = Delegate<void(const CanRxFrame*, size_t)>;
+
+    ICanFrameSink* frameSink = nullptr;
+    CanBatchDelegate staticSink;        // bindFrameSink() - takes precedence when set
+    CallbackFrameSink callbackSink;     // Adapter for setFrameCallback()
+
+    template<typename Sink>
+    static void sinkStub(void* sink, const CanRxFrame* frames, size_t count) {
+        static_cast<Sink*>(sink)->Sink::onCanFrames(frames, count);
+    }
 
     CanState state = CanState::OFF;
     CanState previousState = CanState::OFF;
@@ -139,11 +365,60 @@ private:
     CanSpeed canSpeed = CanSpeed::CAN_500KBPS;  // Default to OBD-II speed
     bool verbose = false;  // Log all received messages (disabled - too noisy)
 
+    // Autobaud (runs from loop() in DETECTING state, main loop only)
+    static constexpr uint8_t SPEED_COUNT = 5;
+    struct AutobaudProbe {
+        uint32_t frames = 0;
+        uint32_t busErrors = 0;
+        uint32_t durationMs = 0;
+    };
+    bool autobaudEnabled = false;
+    bool autobaudRedetectPending = false;
+    CanAutobaudResult autobaudResult;
+    AutobaudProbe probes[SPEED_COUNT];
+    CanSpeed probeOrder[SPEED_COUNT];
+    uint8_t probeIndex = 0;
+    unsigned long probeStartTime = 0;
+    unsigned long detectStartTime = 0;
+    bool beginAutobaud();
+    bool startProbe();
+    void pollAutobaud();
+    void finishAutobaud(int winner);
+
+    // Hardware acceptance filter (default: accept all until IDs are registered)
+    CanFilterPlanner::Plan filterPlan;
+    CanFilterPlanner::Plan installedPlan;
+    bool filterReprogramPending = false;
+    void updateFilterPlan(const CanFilterPlanner::Plan& plan);
+
     // Statistics (accessed from both cores - use volatile)
     volatile uint32_t messageCount = 0;
     volatile uint32_t errorCount = 0;
     volatile uint32_t lastRxMissedCount = 0;
 
+    // RX ring between CAN RX task (producer) and decode task (consumer)
+    CanFrameRing<RX_RING_CAPACITY> rxRing;
+
+    // Decode statistics (written by decode task only)
+    volatile uint32_t decodeBatches = 0;
+    volatile uint32_t decodedFrames = 0;
+    volatile uint32_t maxBatchSize = 0;
+    volatile uint32_t decodeLatencyAvgUs = 0;
+    volatile uint32_t decodeLatencyMaxUs = 0;
+    volatile uint32_t sinkCyclesPerFrame = 0;
+
+    // Per-ID arrival statistics (decode task writes, main loop reads)
+    CanIdProfiler idProfiler;
+
+    // Bus utilization windows (CAN RX task writes, main loop reads)
+    CanBusLoad loadEstimator;
+
+    // Raw frame capture with trigger/freeze (PSRAM)
+    CanFlightRecorder flightRecorder;
+
+    // Prioritized TX queue (TX task sends, loop() dispatches completions)
+    CanTxScheduler txScheduler;
+
     // Timing
     unsigned long stateEntryTime = 0;
     unsigned long lastStatusCheck = 0;
@@ -163,12 +438,31 @@ private:
     static void canTaskEntry(void* param);
     void canTaskLoop();
 
+    // Dedicated decode task (drains rxRing)
+    TaskHandle_t decodeTaskHandle = nullptr;
+    volatile bool decodeRunning = false;
+    SemaphoreHandle_t decodeExitedSemaphore = nullptr;
+    static void decodeTaskEntry(void* param);
+    void decodeTaskLoop();
+
+    // Dedicated TX task (owns the TWAI TX buffer)
+    TaskHandle_t txTaskHandle = nullptr;
+    volatile bool txRunning = false;
+    SemaphoreHandle_t txExitedSemaphore = nullptr;
+    static void txTaskEntry(void* param);
+    void txTaskLoop();
+
+    void drainRing();
+    void enqueueMessage(const twai_message_t& message);
+    void stopTask(TaskHandle_t& handle, SemaphoreHandle_t exitedSemaphore, const char* name);
+
     // State machine helpers
     void setState(CanState newState);
     unsigned long timeInState();
 
     // CAN operations
-    bool installDriver();
+    bool startController();
+    bool installDriver(bool listenOnly = false);
     void uninstallDriver();
     void processReceivedMessages();
     void checkBusStatus();
@@ -183,4 +477,17 @@ private:
     static const uint32_t CAN_TASK_STACK_SIZE = 4096;
     static const UBaseType_t CAN_TASK_PRIORITY = 5;  // Higher than normal (1)
     static const BaseType_t CAN_TASK_CORE = 0;       // Run on Core 0 (WiFi/BT core)
+    
+    static const uint32_t DECODE_TASK_STACK_SIZE = 4096;
+    static const UBaseType_t DECODE_TASK_PRIORITY = 4;  // Below RX so TWAI is always drained first
+    static const BaseType_t DECODE_TASK_CORE = 0;
+
+    static const uint32_t TX_TASK_STACK_SIZE = 4096;
+    static const UBaseType_t TX_TASK_PRIORITY = 5;      // Same as RX - short bursts, keep-alive timing
+    static const BaseType_t TX_TASK_CORE = 0;
+
+    static const uint32_t AUTOBAUD_PROBE_MS = 250;          // Listen time per rate (budget: 5 x 250ms)
+    static const uint32_t AUTOBAUD_MIN_FRAMES = 3;          // Fewer = no traffic at this rate
+    static const uint32_t AUTOBAUD_EARLY_FRAMES = 16;       // Error-free frames to stop probing early
+    static const uint32_t AUTOBAUD_REDETECT_RX_ERRORS = 96; // Receive error counter with no frames -> wrong rate
 };
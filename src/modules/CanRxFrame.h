@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Raw CAN frame as captured by the CAN RX task.
+ * Timestamp is micros() at dequeue from the TWAI driver.
+ */
+struct CanRxFrame {
+    uint32_t timestampUs;
+    uint32_t canId;
+    uint8_t dlc;
+    bool extended;
+    uint8_t data[8];
+};
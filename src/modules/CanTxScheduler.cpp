@@ -0,0 +1,398 @@
+#include "CanTxScheduler.h"
+
+CanTxScheduler::CanTxScheduler() {
+    mutex = xSemaphoreCreateMutex();
+}
+
+CanTxScheduler::~CanTxScheduler() {
+    if (mutex != nullptr) {
+        vSemaphoreDelete(mutex);
+        mutex = nullptr;
+    }
+}
+
+uint32_t CanTxScheduler::defaultDeadlineMs(CanTxPriority priority) {
+    switch (priority) {
+        case CanTxPriority::KEEP_ALIVE: return 250;         // Half the 500ms keep-alive interval
+        case CanTxPriority::BAP_CONTINUATION: return 500;
+        case CanTxPriority::BAP_START: return 1000;
+        case CanTxPriority::COMMAND: return 1000;
+        case CanTxPriority::DIAGNOSTIC: return 500;
+        default: return 1000;
+    }
+}
+
+// =============================================================================
+// Submission (any task)
+// =============================================================================
+
+bool CanTxScheduler::submit(const CanTxFrame& frame, CanTxPriority priority,
+                            CanTxCallback onComplete, uint32_t deadlineMs) {
+    return submitSequence(&frame, 1, priority, std::move(onComplete), deadlineMs);
+}
+
+bool CanTxScheduler::submitSequence(const CanTxFrame* frames, size_t count, CanTxPriority priority,
+                                    CanTxCallback onComplete, uint32_t deadlineMs) {
+    if (count == 0 || count > MAX_PENDING) {
+        countResult(CanTxResult::QUEUE_FULL, count);
+        return false;
+    }
+    if (!accepting) {
+        countResult(CanTxResult::NOT_RUNNING, count);
+        return false;
+    }
+
+    uint32_t now = millis();
+    uint32_t deadline = now + (deadlineMs ? deadlineMs : defaultDeadlineMs(priority));
+
+    lock();
+    if (freeSlotCount() < count) {
+        unlock();
+        countResult(CanTxResult::QUEUE_FULL, count);
+        return false;
+    }
+
+    uint8_t first = NO_SLOT;
+    uint8_t prev = NO_SLOT;
+    for (size_t i = 0; i < count; i++) {
+        uint8_t index = allocSlot();
+        Slot& slot = slots[index];
+        slot.frame = frames[i];
+        if (slot.frame.dlc > 8) {
+            slot.frame.dlc = 8;
+        }
+        slot.state = (i == 0) ? SlotState::QUEUED : SlotState::WAITING;
+        slot.priority = (i == 0) ? priority : CanTxPriority::BAP_CONTINUATION;
+        slot.result = CanTxResult::SENT;
+        slot.lastFailure = CanTxResult::EXPIRED;
+        slot.next = NO_SLOT;
+        slot.order = nextOrder++;
+        slot.submittedMs = now;
+        slot.deadlineMs = deadline;
+        slot.notBeforeMs = now;
+        slot.attempts = 0;
+
+        if (prev == NO_SLOT) {
+            first = index;
+        } else {
+            slots[prev].next = index;
+        }
+        prev = index;
+    }
+    slots[first].onComplete = std::move(onComplete);
+
+    submitted += count;
+    queueDepth += count;
+    if (queueDepth > queueHighWater) {
+        queueHighWater = queueDepth;
+    }
+    unlock();
+    return true;
+}
+
+// =============================================================================
+// TX task
+// =============================================================================
+
+uint32_t CanTxScheduler::poll() {
+    if (inFlight != NO_SLOT) {
+        // Single-shot frame in the TX buffer - wait for its outcome
+        uint32_t elapsed = millis() - inFlightSinceMs;
+        uint32_t alerts = 0;
+        if (elapsed < ACK_TIMEOUT_MS) {
+            twai_read_alerts(&alerts, pdMS_TO_TICKS(ACK_TIMEOUT_MS - elapsed));
+        }
+
+        bool success = alerts & TWAI_ALERT_TX_SUCCESS;
+        bool failed = (alerts & TWAI_ALERT_TX_FAILED) || millis() - inFlightSinceMs >= ACK_TIMEOUT_MS;
+        if (success || failed) {
+            lock();
+            completeInFlight(success, millis());
+            unlock();
+        }
+        return 0;
+    }
+
+    lock();
+    uint32_t now = millis();
+    expireOverdue(now);
+
+    uint32_t waitMs = IDLE_WAIT_MS;
+    uint8_t index = pickNext(now, waitMs);
+    if (index != NO_SLOT) {
+        startTransmit(index, now);
+        waitMs = 0;
+    }
+    unlock();
+    return waitMs;
+}
+
+uint8_t CanTxScheduler::pickNext(uint32_t now, uint32_t& waitMs) {
+    uint8_t best = NO_SLOT;
+
+    for (size_t i = 0; i < MAX_PENDING; i++) {
+        const Slot& slot = slots[i];
+        if (slot.state != SlotState::QUEUED) {
+            continue;
+        }
+
+        // Same-ID frames leave in submission order (keeps BAP groups intact)
+        bool blocked = false;
+        for (size_t j = 0; j < MAX_PENDING && !blocked; j++) {
+            const Slot& other = slots[j];
+            blocked = (other.state == SlotState::QUEUED || other.state == SlotState::WAITING) &&
+                      (int32_t)(other.order - slot.order) < 0 &&
+                      other.frame.canId == slot.frame.canId &&
+                      other.frame.extended == slot.frame.extended;
+        }
+        if (blocked) {
+            continue;
+        }
+
+        // Backing off after a failed attempt - others may go meanwhile
+        int32_t backoff = (int32_t)(slot.notBeforeMs - now);
+        if (backoff > 0) {
+            if ((uint32_t)backoff < waitMs) {
+                waitMs = backoff;
+            }
+            continue;
+        }
+
+        if (best == NO_SLOT || slot.priority < slots[best].priority ||
+            (slot.priority == slots[best].priority && (int32_t)(slot.order - slots[best].order) < 0)) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+void CanTxScheduler::expireOverdue(uint32_t now) {
+    for (size_t i = 0; i < MAX_PENDING; i++) {
+        Slot& slot = slots[i];
+        if (slot.state == SlotState::QUEUED && (int32_t)(now - slot.deadlineMs) >= 0) {
+            finish(i, slot.attempts > 0 ? slot.lastFailure : CanTxResult::EXPIRED, now);
+        }
+    }
+}
+
+void CanTxScheduler::startTransmit(uint8_t index, uint32_t now) {
+    Slot& slot = slots[index];
+
+    twai_message_t message = {};
+    message.identifier = slot.frame.canId;
+    message.extd = slot.frame.extended ? 1 : 0;
+    message.rtr = 0;
+    message.ss = 1;     // Single shot - retries are ours, bounded by the deadline
+    message.data_length_code = slot.frame.dlc;
+    memcpy(message.data, slot.frame.data, slot.frame.dlc);
+
+    // Discard a late alert from a frame we already gave up on
+    uint32_t staleAlerts = 0;
+    twai_read_alerts(&staleAlerts, 0);
+
+    slot.attempts++;
+    esp_err_t result = twai_transmit(&message, 0);
+    if (result == ESP_OK) {
+        slot.state = SlotState::IN_FLIGHT;
+        inFlight = index;
+        inFlightSinceMs = now;
+        return;
+    }
+
+    // Driver refused the frame (stopped, bus-off, TX buffer still busy)
+    attemptFailures++;
+    slot.lastFailure = CanTxResult::DRIVER_ERROR;
+    slot.notBeforeMs = now + RETRY_BACKOFF_MS;
+}
+
+void CanTxScheduler::completeInFlight(bool success, uint32_t now) {
+    uint8_t index = inFlight;
+    inFlight = NO_SLOT;
+    if (index == NO_SLOT) {
+        return;
+    }
+
+    Slot& slot = slots[index];
+    if (success) {
+        uint32_t delayMs = now - slot.submittedMs;
+        if (delayMs > maxQueueDelayMs) {
+            maxQueueDelayMs = delayMs;
+        }
+        finish(index, CanTxResult::SENT, now);
+        return;
+    }
+
+    // No ACK, lost arbitration or bus error - retry until the deadline
+    attemptFailures++;
+    slot.lastFailure = CanTxResult::NO_ACK;
+    slot.state = SlotState::QUEUED;
+    slot.notBeforeMs = now + RETRY_BACKOFF_MS;
+}
+
+void CanTxScheduler::finish(uint8_t index, CanTxResult result, uint32_t now) {
+    Slot& slot = slots[index];
+    uint8_t next = slot.next;
+    slot.next = NO_SLOT;
+
+    countResult(result);
+    queueDepth--;
+
+    if (result == CanTxResult::SENT && next != NO_SLOT) {
+        // Hand the sequence (and its callback) to the next frame
+        Slot& following = slots[next];
+        following.state = SlotState::QUEUED;
+        following.priority = CanTxPriority::BAP_CONTINUATION;
+        following.notBeforeMs = now;
+        following.onComplete = std::move(slot.onComplete);
+        slot.onComplete = nullptr;
+        slot.state = SlotState::FREE;
+        return;
+    }
+
+    // Failure drops the rest of the sequence
+    while (next != NO_SLOT) {
+        Slot& dropped = slots[next];
+        uint8_t after = dropped.next;
+        dropped.next = NO_SLOT;
+        dropped.state = SlotState::FREE;
+        countResult(CanTxResult::SEQUENCE_ABORTED);
+        queueDepth--;
+        next = after;
+    }
+
+    if (slot.onComplete) {
+        slot.result = result;
+        slot.state = SlotState::DONE;
+        pendingCompletions++;
+    } else {
+        slot.state = SlotState::FREE;
+    }
+}
+
+void CanTxScheduler::flush(CanTxResult reason) {
+    lock();
+    uint32_t now = millis();
+    inFlight = NO_SLOT;
+    for (size_t i = 0; i < MAX_PENDING; i++) {
+        if (slots[i].state == SlotState::QUEUED || slots[i].state == SlotState::IN_FLIGHT) {
+            finish(i, reason, now);
+        }
+    }
+    unlock();
+}
+
+// =============================================================================
+// Main loop
+// =============================================================================
+
+void CanTxScheduler::dispatchCompletions() {
+    if (pendingCompletions == 0) {
+        return;
+    }
+
+    for (size_t i = 0; i < MAX_PENDING; i++) {
+        CanTxCallback callback;
+        CanTxResult result;
+
+        lock();
+        if (slots[i].state != SlotState::DONE) {
+            unlock();
+            continue;
+        }
+        callback = std::move(slots[i].onComplete);
+        slots[i].onComplete = nullptr;
+        result = slots[i].result;
+        slots[i].state = SlotState::FREE;
+        pendingCompletions--;
+        unlock();
+
+        // Outside the lock - the callback may submit again
+        callback(result);
+    }
+}
+
+// =============================================================================
+// Statistics
+// =============================================================================
+
+uint32_t CanTxScheduler::getFailedCount() const {
+    uint32_t failed = 0;
+    for (uint8_t i = 1; i < RESULT_COUNT; i++) {
+        failed += results[i];
+    }
+    return failed;
+}
+
+void CanTxScheduler::resetStats() {
+    submitted = 0;
+    for (uint8_t i = 0; i < RESULT_COUNT; i++) {
+        results[i] = 0;
+    }
+    attemptFailures = 0;
+    queueHighWater = queueDepth;
+    maxQueueDelayMs = 0;
+}
+
+const char* CanTxScheduler::resultName(CanTxResult result) {
+    switch (result) {
+        case CanTxResult::SENT: return "sent";
+        case CanTxResult::QUEUE_FULL: return "queueFull";
+        case CanTxResult::NOT_RUNNING: return "notRunning";
+        case CanTxResult::EXPIRED: return "expired";
+        case CanTxResult::NO_ACK: return "noAck";
+        case CanTxResult::DRIVER_ERROR: return "driverError";
+        case CanTxResult::FLUSHED: return "flushed";
+        case CanTxResult::SEQUENCE_ABORTED: return "sequenceAborted";
+        default: return "unknown";
+    }
+}
+
+const char* CanTxScheduler::priorityName(CanTxPriority priority) {
+    switch (priority) {
+        case CanTxPriority::KEEP_ALIVE: return "keepAlive";
+        case CanTxPriority::BAP_CONTINUATION: return "bapContinuation";
+        case CanTxPriority::BAP_START: return "bapStart";
+        case CanTxPriority::COMMAND: return "command";
+        case CanTxPriority::DIAGNOSTIC: return "diagnostic";
+        default: return "unknown";
+    }
+}
+
+// =============================================================================
+// Private helpers
+// =============================================================================
+
+void CanTxScheduler::lock() {
+    if (mutex != nullptr) {
+        xSemaphoreTake(mutex, portMAX_DELAY);
+    }
+}
+
+void CanTxScheduler::unlock() {
+    if (mutex != nullptr) {
+        xSemaphoreGive(mutex);
+    }
+}
+
+size_t CanTxScheduler::freeSlotCount() const {
+    size_t count = 0;
+    for (size_t i = 0; i < MAX_PENDING; i++) {
+        if (slots[i].state == SlotState::FREE) {
+            count++;
+        }
+    }
+    return count;
+}
+
+uint8_t CanTxScheduler::allocSlot() {
+    for (size_t i = 0; i < MAX_PENDING; i++) {
+        if (slots[i].state == SlotState::FREE) {
+            return i;
+        }
+    }
+    return NO_SLOT;
+}
+
+void CanTxScheduler::countResult(CanTxResult result, uint32_t frames) {
+    results[static_cast<uint8_t>(result)] += frames;
+}
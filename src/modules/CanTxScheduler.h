@@ -0,0 +1,217 @@
+#pragma once
+
+#include <Arduino.h>
+#include <functional>
+#include "driver/twai.h"
+
+/**
+ * TX priority classes (lower value = sent first)
+ */
+enum class CanTxPriority : uint8_t {
+    KEEP_ALIVE = 0,         // Wake, BAP init and keep-alive heartbeat
+    BAP_CONTINUATION = 1,   // Remaining frames of a long BAP message already on the wire
+    BAP_START = 2,          // Short BAP messages and long message start frames
+    COMMAND = 3,            // Broadcast commands (TM_01 horn/flash/lock)
+    DIAGNOSTIC = 4          // Test frames
+};
+
+/**
+ * Outcome of a TX request (also the failure cause counters)
+ */
+enum class CanTxResult : uint8_t {
+    SENT = 0,               // Acknowledged on the bus
+    QUEUE_FULL,             // Rejected on submit - no free slot
+    NOT_RUNNING,            // Rejected on submit - CAN TX task not running
+    EXPIRED,                // Deadline passed before the frame got the bus
+    NO_ACK,                 // Deadline passed after failed attempts (no ACK / arbitration / error)
+    DRIVER_ERROR,           // Deadline passed while the driver refused frames (bus-off, stopped)
+    FLUSHED,                // Discarded when CAN stopped
+    SEQUENCE_ABORTED        // Not sent because an earlier frame of its sequence failed
+};
+
+/**
+ * One CAN frame to transmit
+ */
+struct CanTxFrame {
+    uint32_t canId = 0;
+    uint8_t data[8] = {};
+    uint8_t dlc = 0;
+    bool extended = false;
+};
+
+/**
+ * Completion callback, invoked from CanManager::loop() (main loop), never
+ * from the TX task, so handlers may touch main-loop state without locking.
+ */
+using CanTxCallback = std::function<void(CanTxResult result)>;
+
+/**
+ * CanTxScheduler - Prioritized, non-blocking CAN transmit queue
+ *
+ * Callers submit frames and return immediately; the CAN TX task (Core 0)
+ * owns the TWAI TX buffer and sends one frame at a time, highest priority
+ * class first, FIFO within a class.
+ *
+ * Transmission:
+ * - The TWAI driver queue is disabled; each frame is sent single-shot and
+ *   completed via TX_SUCCESS / TX_FAILED alerts
+ * - A failed attempt is retried after RETRY_BACKOFF_MS until the frame's
+ *   deadline, while other frames (other IDs) may go in between, so a
+ *   stalled frame never holds up keep-alives or other sequences
+ * - Frames past their deadline are dropped, not sent late
+ *
+ * Ordering:
+ * - Frames with the same CAN ID leave in submission order
+ * - A sequence (multi-frame BAP message) is sent strictly in order; once
+ *   its first frame is on the wire the rest are promoted to BAP_CONTINUATION
+ *   so new BAP starts cannot interleave with it
+ * - If a sequence frame fails, the rest of the sequence is dropped
+ *
+ * Memory: fixed slot pool, no allocation per frame (callbacks capturing more
+ * than a pointer or two may allocate inside std::function).
+ *
+ * Thread Safety:
+ * - submit()/submitSequence() may be called from any task
+ * - poll() is called only from the CAN TX task
+ * - dispatchCompletions() and flush() are called from the main loop
+ */
+class CanTxScheduler {
+public:
+    static constexpr size_t MAX_PENDING = 32;             // Slots (frames) queued or in flight
+    static constexpr uint8_t PRIORITY_COUNT = 5;
+    static constexpr uint8_t RESULT_COUNT = 8;
+
+    static constexpr uint32_t RETRY_BACKOFF_MS = 2;       // Between single-shot attempts of one frame
+    static constexpr uint32_t ACK_TIMEOUT_MS = 20;        // Give up waiting for a TX alert
+    static constexpr uint32_t IDLE_WAIT_MS = 10;          // TX task wake-up when nothing is queued
+
+    CanTxScheduler();
+    ~CanTxScheduler();
+
+    /**
+     * Default deadline for a priority class (ms from submission).
+     * Keep-alives expire before the next one is due.
+     */
+    static uint32_t defaultDeadlineMs(CanTxPriority priority);
+
+    /**
+     * Accept or reject new submissions (set by CanManager with the TX task).
+     */
+    void setAccepting(bool accept) { accepting = accept; }
+
+    /**
+     * Queue one frame.
+     * @param deadlineMs Drop the frame if not sent within this time (0 = class default)
+     * @return false if rejected (counted; onComplete is not called)
+     */
+    bool submit(const CanTxFrame& frame, CanTxPriority priority,
+                CanTxCallback onComplete = nullptr, uint32_t deadlineMs = 0);
+
+    /**
+     * Queue frames that must go out back-to-back in order (long BAP message).
+     * onComplete is called once: SENT after the last frame, or the first failure.
+     * @param priority Class of the first frame; later frames are BAP_CONTINUATION
+     * @param deadlineMs Deadline for the whole sequence (0 = class default)
+     * @return false if rejected (nothing queued, onComplete not called)
+     */
+    bool submitSequence(const CanTxFrame* frames, size_t count, CanTxPriority priority,
+                        CanTxCallback onComplete = nullptr, uint32_t deadlineMs = 0);
+
+    // =========================================================================
+    // TX task side
+    // =========================================================================
+
+    /**
+     * Advance the scheduler: wait for the in-flight frame's alert, or expire
+     * overdue frames and start the next eligible one.
+     * @return 0 to call again immediately, otherwise ms to sleep (woken early
+     *         by a submit notification)
+     */
+    uint32_t poll();
+
+    /**
+     * Fail every queued and in-flight frame (CAN stopped).
+     * Only call while the TX task is not running.
+     */
+    void flush(CanTxResult reason);
+
+    // =========================================================================
+    // Main loop side
+    // =========================================================================
+
+    /**
+     * Run completion callbacks of finished requests and free their slots.
+     */
+    void dispatchCompletions();
+
+    // =========================================================================
+    // Statistics
+    // =========================================================================
+
+    uint32_t getSubmitted() const { return submitted; }
+    uint32_t getSent() const { return results[static_cast<uint8_t>(CanTxResult::SENT)]; }
+    uint32_t getResultCount(CanTxResult result) const { return results[static_cast<uint8_t>(result)]; }
+    uint32_t getFailedCount() const;
+    uint32_t getAttemptFailures() const { return attemptFailures; }
+    uint32_t getQueueDepth() const { return queueDepth; }
+    uint32_t getQueueHighWater() const { return queueHighWater; }
+    uint32_t getMaxQueueDelayMs() const { return maxQueueDelayMs; }
+    void resetStats();
+
+    static const char* resultName(CanTxResult result);
+    static const char* priorityName(CanTxPriority priority);
+
+private:
+    static constexpr uint8_t NO_SLOT = 0xFF;
+
+    enum class SlotState : uint8_t {
+        FREE,
+        WAITING,        // Later frame of a sequence, not yet eligible
+        QUEUED,         // Eligible for transmission
+        IN_FLIGHT,      // In the TWAI TX buffer
+        DONE            // Finished, callback pending dispatch
+    };
+
+    struct Slot {
+        CanTxFrame frame;
+        SlotState state = SlotState::FREE;
+        CanTxPriority priority = CanTxPriority::DIAGNOSTIC;
+        CanTxResult result = CanTxResult::SENT;
+        CanTxResult lastFailure = CanTxResult::EXPIRED;  // Cause reported if the deadline passes
+        uint8_t next = NO_SLOT;         // Next frame of the sequence
+        uint32_t order = 0;             // Submission order
+        uint32_t submittedMs = 0;
+        uint32_t deadlineMs = 0;        // Absolute millis()
+        uint32_t notBeforeMs = 0;       // Retry backoff
+        uint16_t attempts = 0;
+        CanTxCallback onComplete;       // Held by the sequence's current frame
+    };
+
+    Slot slots[MAX_PENDING];
+    SemaphoreHandle_t mutex = nullptr;
+    uint32_t nextOrder = 0;
+    uint8_t inFlight = NO_SLOT;
+    uint32_t inFlightSinceMs = 0;
+
+    volatile bool accepting = false;
+    volatile uint32_t pendingCompletions = 0;   // DONE slots awaiting dispatch
+
+    // Statistics
+    volatile uint32_t submitted = 0;
+    volatile uint32_t results[RESULT_COUNT] = {};
+    volatile uint32_t attemptFailures = 0;
+    volatile uint32_t queueDepth = 0;
+    volatile uint32_t queueHighWater = 0;
+    volatile uint32_t maxQueueDelayMs = 0;
+
+    void lock();
+    void unlock();
+    size_t freeSlotCount() const;
+    uint8_t allocSlot();
+    uint8_t pickNext(uint32_t now, uint32_t& waitMs);
+    void expireOverdue(uint32_t now);
+    void startTransmit(uint8_t index, uint32_t now);
+    void completeInFlight(bool success, uint32_t now);
+    void finish(uint8_t index, CanTxResult result, uint32_t now);
+    void countResult(CanTxResult result, uint32_t frames = 1);
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include "CanRxFrame.h"
+
+/**
+ * Callback type for received CAN frames.
+ * Parameters: canId, data, dlc, extended
+ */
+using CanFrameCallback = std::function<void(uint32_t, const uint8_t*, uint8_t, bool)>;
+
+/**
+ * ICanFrameSink - Batched consumer of received CAN frames
+ *
+ * CanManager's decode task hands over each batch drained from the RX ring
+ * as one contiguous span, so consumers pay one virtual call (and can take
+ * their locks once) per batch instead of per frame.
+ *
+ * Called from the CAN decode task on Core 0.
+ * The span is only valid for the duration of the call.
+ */
+class ICanFrameSink {
+public:
+    virtual ~ICanFrameSink() = default;
+
+    /**
+     * Process a batch of frames in arrival order.
+     * @param frames First frame of the batch
+     * @param count Number of frames (>= 1)
+     */
+    virtual void onCanFrames(const CanRxFrame* frames, size_t count) = 0;
+};
+
+/**
+ * CallbackFrameSink - Adapter for per-frame CanFrameCallback consumers.
+ */
+class CallbackFrameSink : public ICanFrameSink {
+public:
+    CallbackFrameSink() = default;
+    explicit CallbackFrameSink(CanFrameCallback callback) : callback(callback) {}
+
+    void setCallback(CanFrameCallback newCallback) { callback = newCallback; }
+    bool hasCallback() const { return static_cast<bool>(callback); }
+
+    void onCanFrames(const CanRxFrame* frames, size_t count) override {
+        if (!callback) {
+            return;
+        }
+        for (size_t i = 0; i < count; i++) {
+            callback(frames[i].canId, frames[i].data, frames[i].dlc, frames[i].extended);
+        }
+    }
+
+private:
+    CanFrameCallback callback = nullptr;
+};
@@ -1,6 +1,7 @@
 #include "VehicleProvider.h"
 #include "../vehicle/VehicleManager.h"
 #include "../core/CommandRouter.h"
+#include "../modules/CanManager.h"
 
 VehicleProvider::VehicleProvider(VehicleManager* vehicleManager)
     : vehicleManager(vehicleManager) {
@@ -21,7 +22,7 @@ void VehicleProvider::getTelemetry(JsonObject& data) {
     JsonObject battery = data["battery"].to<JsonObject>();
     
     // SOC (BAP primary, includes source tracking)
-    if (battState.socSource != DataSource::NONE && battState.soc > 0.0f) {
+    if (battState.socSource != DataSource::NONE && battState.soc > 0) {
         battery["soc"] = battState.soc;
         battery["socSource"] = battState.socSource == DataSource::BAP ? "bap" : "can";
     }
@@ -32,7 +33,7 @@ void VehicleProvider::getTelemetry(JsonObject& data) {
                                  battState.chargingSource == DataSource::CAN_STD ? "can" : "none";
     
     // Charging details (from BAP when available)
-    if (battState.chargingUpdate > 0) {
+    if (battState.chargingUpdate.valid()) {
         battery["chargingMode"] = static_cast<uint8_t>(battState.chargingMode);
         battery["chargingStatus"] = static_cast<uint8_t>(battState.chargingStatus);
         battery["chargingAmps"] = battState.chargingAmps;
@@ -40,11 +41,11 @@ void VehicleProvider::getTelemetry(JsonObject& data) {
         battery["remainingMin"] = battState.remainingTimeMin;
     }
     
-    // Power and energy (CAN)
-    battery["powerKw"] = battState.powerKw;
-    battery["energyWh"] = battState.energyWh;
-    battery["maxEnergyWh"] = battState.maxEnergyWh;
-    battery["temperature"] = battState.temperature;
+    // Power and energy (CAN, converted from raw here)
+    battery["powerKw"] = battState.powerKw();
+    battery["energyWh"] = battState.energyWh();
+    battery["maxEnergyWh"] = battState.maxEnergyWh();
+    battery["temperature"] = battState.temperature();
     battery["balancing"] = battState.balancingActive;
     
     // === Drive state ===
@@ -52,7 +53,7 @@ void VehicleProvider::getTelemetry(JsonObject& data) {
     drive["ignition"] = static_cast<uint8_t>(driveState.ignition);
     drive["keyInserted"] = driveState.keyInserted;
     drive["ignitionOn"] = driveState.ignitionOn;
-    drive["speedKmh"] = driveState.speedKmh;
+    drive["speedKmh"] = driveState.speedKmh();
     drive["odometerKm"] = driveState.odometerKm;
     
     // === Body state ===
@@ -75,7 +76,7 @@ void VehicleProvider::getTelemetry(JsonObject& data) {
         range["totalKm"] = rangeState.totalRangeKm;
         range["electricKm"] = rangeState.electricRangeKm;
         range["displayKm"] = rangeState.displayRangeKm;
-        range["consumption"] = rangeState.consumptionKwh100km;
+        range["consumption"] = rangeState.consumptionKwh100km();
         range["tendency"] = rangeState.tendencyStr();
         range["reserveWarning"] = rangeState.reserveWarning;
     }
@@ -83,22 +84,29 @@ void VehicleProvider::getTelemetry(JsonObject& data) {
     // === CAN GPS state (if valid) ===
     if (gpsState.isValid()) {
         JsonObject gps = data["canGps"].to<JsonObject>();
-        gps["lat"] = gpsState.latitude;
-        gps["lng"] = gpsState.longitude;
-        gps["alt"] = gpsState.altitude;
-        gps["heading"] = gpsState.heading;
+        gps["lat"] = gpsState.latitude();
+        gps["lng"] = gpsState.longitude();
+        gps["alt"] = gpsState.altitude();
+        gps["heading"] = gpsState.heading();
         gps["satellites"] = gpsState.satsInUse;
         gps["fixType"] = gpsState.fixTypeStr();
-        gps["hdop"] = gpsState.hdop;
+        gps["hdop"] = gpsState.hdop();
+        if (gpsState.isMapMatchedValid()) {
+            gps["mapLat"] = gpsState.mapLatitude();
+            gps["mapLng"] = gpsState.mapLongitude();
+            if (gpsState.mapHeadingUpdate.valid()) {
+                gps["mapHeading"] = gpsState.mapHeading();
+            }
+        }
     }
     
     // === Climate state (unified) ===
     JsonObject climate = data["climate"].to<JsonObject>();
     
     // Temperature (with source tracking)
-    climate["insideTemp"] = climState.insideTemp;
+    climate["insideTemp"] = climState.insideTemp();
     climate["insideTempSource"] = climState.insideTempSource == DataSource::BAP ? "bap" : "can";
-    climate["outsideTemp"] = climState.outsideTemp;
+    climate["outsideTemp"] = climState.outsideTemp();
     
     // Climate control (BAP-only with source tracking)
     climate["active"] = climState.climateActive;
@@ -120,6 +128,30 @@ void VehicleProvider::getTelemetry(JsonObject& data) {
         plug["lockState"] = battState.plugState.lockState;
     }
     
+    // === Custom signals (server-configured via vehicle.setCustomSignals) ===
+    const CustomSignalTable& customSignals = vehicleManager->customSignals();
+    if (customSignals.size() > 0) {
+        JsonObject custom = data["custom"].to<JsonObject>();
+        for (size_t i = 0; i < customSignals.size(); i++) {
+            if (customSignals.hasValue(i)) {
+                custom[customSignals.getSignal(i).key] = customSignals.getValue(i);
+            }
+        }
+    }
+    
+    // === CAN ID profile (optional, enabled via system.canProfile) ===
+    CanManager* canManager = vehicleManager->can();
+    if (canManager && canManager->profiler().isTelemetryEnabled()) {
+        canManager->profiler().toJson(data["canProfile"].to<JsonArray>(), false);
+    }
+    
+    // === Bus load (optional, enabled via system.busLoad) ===
+    if (canManager && canManager->busLoad().isTelemetryEnabled()) {
+        JsonObject bus = data["bus"].to<JsonObject>();
+        canManager->busLoad().toJson(bus);
+        bus["missedTotal"] = canManager->getMissedCount();
+    }
+    
     // === Meta ===
     data["vehicleAwake"] = vehicleManager->isVehicleAwake();
     data["canFrameCount"] = vehicleManager->getFrameCount();
@@ -196,19 +228,19 @@ bool VehicleProvider::hasChanged() {
     }
     
     // SOC changed significantly (use unified soc field)
-    float socDiff = abs(battState.soc - lastSoc);
+    int socDiff = abs((int)battState.soc - (int)lastSoc);
     if (socDiff >= SOC_CHANGE_THRESHOLD) {
         return true;
     }
     
     // Power changed significantly (useful during charging)
-    float powerDiff = abs(battState.powerKw - lastPowerKw);
+    int powerDiff = abs((int)battState.powerRaw - (int)lastPowerRaw);
     if (powerDiff >= POWER_CHANGE_THRESHOLD) {
         return true;
     }
     
     // Speed changed significantly (useful when driving)
-    float speedDiff = abs(driveState.speedKmh - lastSpeedKmh);
+    int speedDiff = abs((int)driveState.speedRaw - (int)lastSpeedRaw);
     if (speedDiff >= SPEED_CHANGE_THRESHOLD) {
         return true;
     }
@@ -229,12 +261,12 @@ void VehicleProvider::onTelemetrySent() {
         const BodyManager::State& bodyState = vehicleManager->body()->getState();
         
         lastSoc = battState.soc;
-        lastPowerKw = battState.powerKw;
+        lastPowerRaw = battState.powerRaw;
         lastIgnitionOn = driveState.ignitionOn;
         lastCharging = battState.charging;
         lastLocked = bodyState.isLocked();
         lastPlugged = battState.plugState.isPlugged();
-        lastSpeedKmh = driveState.speedKmh;
+        lastSpeedRaw = driveState.speedRaw;
     }
 }
 
@@ -299,7 +331,7 @@ void VehicleProvider::checkAndEmitEvents() {
         JsonDocument doc;
         JsonObject details = doc.to<JsonObject>();
         details["soc"] = battState.soc;
-        details["powerKw"] = battState.powerKw;
+        details["powerKw"] = battState.powerKw();
         
         if (eventCharging) {
             Serial.println("[VEHICLE] Event: chargingStarted");
@@ -414,7 +446,7 @@ void VehicleProvider::checkAndEmitEvents() {
         JsonObject details = doc.to<JsonObject>();
         details["heating"] = climState.heating;
         details["cooling"] = climState.cooling;
-        details["temp"] = climState.insideTemp;
+        details["temp"] = climState.insideTemp();
         
         if (eventClimateActive) {
             Serial.println("[VEHICLE] Event: climateStarted");
@@ -426,11 +458,11 @@ void VehicleProvider::checkAndEmitEvents() {
     }
     
     // === SOC Threshold Events (20%, 50%, 80%, 100%) ===
-    float currentSoc = battState.soc;
-    if (battState.socSource != DataSource::NONE && battState.soc > 0.0f && eventLastSoc > 0) {
+    uint8_t currentSoc = battState.soc;
+    if (battState.socSource != DataSource::NONE && battState.soc > 0 && eventLastSoc > 0) {
         // Check if we crossed any threshold
-        int lastThreshold = (int)(eventLastSoc / 20) * 20;  // Round down to nearest 20%
-        int currentThreshold = (int)(currentSoc / 20) * 20;
+        int lastThreshold = (eventLastSoc / 20) * 20;  // Round down to nearest 20%
+        int currentThreshold = (currentSoc / 20) * 20;
         
         if (currentThreshold != lastThreshold && currentThreshold > 0) {
             // Crossed a threshold
@@ -461,7 +493,7 @@ void VehicleProvider::checkAndEmitEvents() {
     eventLastSoc = currentSoc;
     
     // === Low Battery Event (below 20%) ===
-    if (battState.socSource != DataSource::NONE && battState.soc > 0.0f && currentSoc < 20 && eventLastSoc >= 20) {
+    if (battState.socSource != DataSource::NONE && battState.soc > 0 && currentSoc < 20 && eventLastSoc >= 20) {
         JsonDocument doc;
         JsonObject details = doc.to<JsonObject>();
         details["soc"] = currentSoc;
@@ -67,14 +67,14 @@ private:
     unsigned long lastReportTime = 0;
     unsigned long lastEventCheckTime = 0;
     
-    // Last reported values for change detection
-    float lastSoc = 0.0f;
-    float lastPowerKw = 0.0f;
+    // Last reported values for change detection (raw signal units)
+    uint8_t lastSoc = 0;
+    uint16_t lastPowerRaw = 0;
     bool lastIgnitionOn = false;
     bool lastCharging = false;
     bool lastLocked = false;
     bool lastPlugged = false;
-    float lastSpeedKmh = 0.0f;
+    uint16_t lastSpeedRaw = 0;
     
     // Event tracking (separate from telemetry change detection)
     bool eventIgnitionOn = false;
@@ -87,13 +87,13 @@ private:
     bool eventRearRightDoorOpen = false;
     bool eventTrunkOpen = false;
     bool eventClimateActive = false;
-    float eventLastSoc = 0.0f;  // For SOC threshold events
+    uint8_t eventLastSoc = 0;  // For SOC threshold events
     bool eventsInitialized = false;
     
-    // Thresholds for change detection
-    static constexpr float SOC_CHANGE_THRESHOLD = 1.0f;      // 1% SOC change
-    static constexpr float POWER_CHANGE_THRESHOLD = 0.5f;    // 0.5 kW power change
-    static constexpr float SPEED_CHANGE_THRESHOLD = 5.0f;    // 5 km/h speed change
+    // Thresholds for change detection, in raw signal units (compared exactly)
+    static constexpr uint8_t SOC_CHANGE_THRESHOLD = 1;       // 1% SOC change
+    static constexpr uint16_t POWER_CHANGE_THRESHOLD = 50;   // 0.5 kW power change (0.01 kW/bit)
+    static constexpr uint16_t SPEED_CHANGE_THRESHOLD = 500;  // 5 km/h speed change (0.01 km/h/bit)
     
     // Reporting intervals
     static constexpr unsigned long REPORT_INTERVAL_AWAKE = 30 * 1000;  // 30s when vehicle awake
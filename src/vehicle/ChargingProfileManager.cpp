@@ -93,15 +93,19 @@ void ChargingProfileManager::clearAllProfiles() {
 // BAP Request Methods (TODO: Move to BatteryControlChannel)
 // =============================================================================
 
-bool ChargingProfileManager::requestAllProfiles() {
-    uint8_t frame[8];
-    
-    // Build GET request for ProfilesArray
-    encodeShortMessage(frame, OpCode::GET, DEVICE_BATTERY_CONTROL,
-                      Function::PROFILES_ARRAY, nullptr, 0);
+bool ChargingProfileManager::requestAllProfiles(uint32_t maxAgeMs, BapClient::ResponseCallback callback,
+                                                BapClient::Options options) {
+    // Only a decoded STATUS makes the cached array usable (heartbeats are not parsed)
+    bool decoded = false;
+    for (uint8_t i = 0; i < PROFILE_COUNT; i++) {
+        decoded = decoded || profiles[i].valid;
+    }
+    options.maxAgeMs = decoded ? maxAgeMs : 0;
     
+    // GET ProfilesArray; the STATUS is decoded by BatteryControlChannel
     Serial.println("[ProfileMgr] Requesting all profiles...");
-    return manager->sendCanFrame(CAN_ID_BATTERY_TX, frame, 8, true);
+    return manager->bap().get(CAN_ID_BATTERY_TX, DEVICE_BATTERY_CONTROL, Function::PROFILES_ARRAY,
+                              std::move(callback), options) != BapClient::NO_REQUEST;
 }
 
 bool ChargingProfileManager::updateTimerProfile(uint8_t profileIndex, const Profile& profile) {
@@ -139,7 +143,7 @@ bool ChargingProfileManager::setTimerProfileEnabled(uint8_t profileIndex, bool e
     Serial.printf("[ProfileMgr] %s timer profile %d\r\n", 
                   enable ? "Enabling" : "Disabling", profileIndex);
     
-    return manager->sendCanFrame(CAN_ID_BATTERY_TX, frame, 8, true);
+    return manager->sendCanFrame(CAN_ID_BATTERY_TX, frame, 8, true, CanTxPriority::BAP_START);
 }
 
 // =============================================================================
@@ -321,17 +325,13 @@ void ChargingProfileManager::updateStateMachine() {
             break;
             
         case ProfileUpdateState::READING_PROFILE:
-            // Check if profile became valid (received from CAN)
+            // Check if profile became valid (received from CAN); a failed
+            // read is reported by the request's callback
             if (profiles[pendingProfileIndex].valid) {
                 Serial.printf("[ProfileMgr] Profile %d received after %lums\r\n", 
                              pendingProfileIndex, elapsed);
                 setUpdateState(ProfileUpdateState::UPDATING_PROFILE);
             }
-            // Check for timeout
-            else if (elapsed > PROFILE_READ_TIMEOUT) {
-                Serial.printf("[ProfileMgr] Profile %d read timeout\r\n", pendingProfileIndex);
-                setUpdateState(ProfileUpdateState::UPDATE_FAILED);
-            }
             break;
             
         case ProfileUpdateState::UPDATING_PROFILE:
@@ -470,7 +470,17 @@ bool ChargingProfileManager::sendProfileReadRequest(uint8_t profileIndex) {
     // TODO: Implement GET request for profile array
     // For now, just request all profiles
     Serial.printf("[ProfileMgr] Sending GET request for profile %d\r\n", profileIndex);
-    return requestAllProfiles();
+    BapClient::Options options;
+    options.deadlineMs = PROFILE_READ_TIMEOUT;
+    return requestAllProfiles(0, [this, profileIndex](const BapClient::Response& response) {
+        // STATUS was decoded before this runs; anything else ends the read
+        if (updateState != ProfileUpdateState::READING_PROFILE || profiles[profileIndex].valid) {
+            return;
+        }
+        Serial.printf("[ProfileMgr] Profile %d read failed (result %u, %u attempts, %lums)\r\n",
+                      profileIndex, (unsigned)response.result, response.attempts, response.totalMs);
+        setUpdateState(ProfileUpdateState::UPDATE_FAILED);
+    }, options);
 }
 
 bool ChargingProfileManager::sendProfileUpdateRequest(uint8_t profileIndex) {
@@ -542,19 +552,14 @@ bool ChargingProfileManager::sendProfileUpdateRequest(uint8_t profileIndex) {
     Serial.printf("[ProfileMgr] Sending profile %d update: %d bytes, temp=%.1fC\r\n",
                  profileIndex, totalPayloadLen, p.getTemperature());
     
-    // Use high-level sendBapMessage helper - it handles framing automatically
-    auto sendFrame = [this](const uint8_t* data, uint8_t len) {
-        return manager->sendCanFrame(CAN_ID_BATTERY_TX, data, len, true);
-    };
-    
-    uint8_t frameCount = BapProtocol::sendBapMessage(
-        sendFrame,
+    // Long message: the transmitter gives it its own BAP group
+    uint8_t frameCount = manager->sendBapMessage(
+        CAN_ID_BATTERY_TX,
         OpCode::SET_GET,
         DEVICE_BATTERY_CONTROL,
         Function::PROFILES_ARRAY,
         payload,
-        totalPayloadLen,
-        0  // group
+        totalPayloadLen
     );
     
     if (frameCount == 0) {
@@ -562,7 +567,7 @@ bool ChargingProfileManager::sendProfileUpdateRequest(uint8_t profileIndex) {
         return false;
     }
     
-    Serial.printf("[ProfileMgr] Sent %d frames for profile %d update\r\n", frameCount, profileIndex);
+    Serial.printf("[ProfileMgr] Queued %d frames for profile %d update\r\n", frameCount, profileIndex);
     return true;
 }
 
@@ -604,7 +609,7 @@ bool ChargingProfileManager::stopProfile0(std::function<void(bool, const char*)>
     return true;
 }
 
-void ChargingProfileManager::processOperationModeResponse(const BapProtocol::BapMessage& msg) {
+void ChargingProfileManager::processOperationModeResponse(const BapProtocol::BapMessageView& msg) {
     // Only process if we're waiting for a response
     if (execState != ExecutionState::WAITING_RESPONSE) {
         return;  // Not expecting response
@@ -707,7 +712,7 @@ bool ChargingProfileManager::sendExecuteCommand() {
     
     Serial.printf("[ProfileMgr] Sending EXECUTE command: operation=0x%02X\n", p.operation);
     
-    return manager->sendCanFrame(CAN_ID_BATTERY_TX, frame, 8, true);
+    return manager->sendCanFrame(CAN_ID_BATTERY_TX, frame, 8, true, CanTxPriority::BAP_START);
 }
 
 bool ChargingProfileManager::sendStopCommand() {
@@ -722,7 +727,7 @@ bool ChargingProfileManager::sendStopCommand() {
     
     Serial.println("[ProfileMgr] Sending STOP command");
     
-    return manager->sendCanFrame(CAN_ID_BATTERY_TX, frame, 8, true);
+    return manager->sendCanFrame(CAN_ID_BATTERY_TX, frame, 8, true, CanTxPriority::BAP_START);
 }
 
 void ChargingProfileManager::completeExecution(bool success, const char* error) {
@@ -4,6 +4,8 @@
 #include <functional>
 #include "ChargingProfile.h"
 #include "protocols/BapProtocol.h"
+#include "bap/BapClient.h"
+#include "bap/BapPropertyCache.h"
 
 // Forward declaration
 class VehicleManager;
@@ -73,12 +75,17 @@ public:
     
     /**
      * Request all profiles from the vehicle
+     * @param maxAgeMs Skip the GET if the cached ProfilesArray is this fresh
+     *                 and has been decoded (0 = always send)
+     * @param callback Outcome of the GET (from the main loop), optional
      * @return true if request sent successfully
      * 
      * TODO: This should be moved to BatteryControlChannel as it involves
      * sending BAP commands. Kept here temporarily for backwards compatibility.
      */
-    bool requestAllProfiles();
+    bool requestAllProfiles(uint32_t maxAgeMs = BapPropertyCache::DEFAULT_MAX_AGE_MS,
+                            BapClient::ResponseCallback callback = nullptr,
+                            BapClient::Options options = BapClient::Options());
     
     /**
      * Update a timer profile (1-3) configuration
@@ -243,7 +250,7 @@ public:
      * - Status (0x04) - operation complete
      * - Error (0x07) - operation failed
      */
-    void processOperationModeResponse(const BapProtocol::BapMessage& msg);
+    void processOperationModeResponse(const BapProtocol::BapMessageView& msg);
     
 private:
     VehicleManager* manager;
@@ -268,7 +275,7 @@ private:
     std::function<void(bool)> pendingCallback = nullptr;
     
     // Timeout for profile operations
-    static constexpr unsigned long PROFILE_READ_TIMEOUT = 5000;   // 5s
+    static constexpr unsigned long PROFILE_READ_TIMEOUT = 5000;   // 5s, GET deadline incl. retries
     static constexpr unsigned long PROFILE_UPDATE_TIMEOUT = 5000; // 5s
     
     /**
@@ -59,6 +59,18 @@ public:
      */
     virtual void processCanFrame(uint32_t canId, const uint8_t* data, uint8_t dlc) = 0;
 
+    /**
+     * Account a standard CAN frame whose payload is unchanged since the last
+     * processCanFrame() for this ID (VehicleManager's payload cache).
+     * Must leave the state exactly as processCanFrame() with the same bytes
+     * would: bump frame counters and freshness timestamps, nothing else.
+     * Called from CAN task on Core 0 with mutex held.
+     *
+     * @param canId Standard CAN ID (11-bit)
+     * @param dlc Data length code (1-8)
+     */
+    virtual void refreshCanFrame(uint32_t canId, uint8_t dlc) = 0;
+
     /**
      * Called when vehicle wake sequence completes.
      * Optional: Override if domain needs to perform actions after wake.
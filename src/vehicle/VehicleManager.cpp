@@ -1,10 +1,49 @@
 #include "VehicleManager.h"
 #include "../modules/CanManager.h"
 #include "protocols/BapProtocol.h"
+#include "protocols/VehicleMessages.h"
+
+// =============================================================================
+// Hardware acceptance filter input
+// =============================================================================
+
+// Standard IDs routed in routeFrame() come from the generated routing table
+// (VehicleMessages::ROUTED_STD_IDS, tools/dbc_codegen/selection.txt)
+using VehicleMessages::ROUTED_STD_IDS;
+using VehicleMessages::ROUTED_EXT_IDS;
+using VehicleMessages::ROUTED_EXT_ID_COUNT;
+
+// Routed standard IDs left out of the payload cache: decode depends on more
+// than the payload bytes
+static const uint16_t UNCACHED_STD_IDS[] = {
+    0x66E,                  // Klima_03: CAN inside temp applies only once BAP is stale
+};
+
+// Extended ID ranges routed in routeFrame() (BAP 0x1733xxxx), in addition to
+// the extended broadcasts of the routing table (ROUTED_EXT_IDS)
+static const CanFilterPlanner::ExtRange ROUTED_EXT_RANGES[] = {
+    { 0x17330000, 0x1FFF0000 },
+};
+static constexpr size_t ROUTED_EXT_RANGE_COUNT = sizeof(ROUTED_EXT_RANGES) / sizeof(ROUTED_EXT_RANGES[0]);
+
+// =============================================================================
+// BAP channels without a decoder yet (docs/canbus-reverse-engineering/CAN_IDS.md)
+// =============================================================================
+
+static const uint32_t DOOR_LOCKING_RX_IDS[] = { 0x17330D01, 0x17330D02, 0x17330D10 };
+static const uint32_t ENI_RX_IDS[] = { 0x17333710, 0x17333711 };
 
 VehicleManager::VehicleManager(CanManager *canMgr)
     : canManager(canMgr), 
       batteryControlChannel(this), 
+      doorLockingChannel("DoorLocking", 0x0D, 0x17330D00, DOOR_LOCKING_RX_IDS, 3),
+      eniChannel("ENI", 0x37, 0x17333700, ENI_RX_IDS, 2),
+      bapClient(this),
+      bapDiscovery(this),
+      bapTx([this](const CanTxFrame &frame, CanTxPriority priority, CanTxCallback onComplete) {
+          return canManager && canManager->transmit(frame.canId, frame.data, frame.dlc, frame.extended,
+                                                    priority, std::move(onComplete));
+      }),
       profileManager(this), 
       batteryManager(this), 
       climateManager(this), 
@@ -20,6 +59,27 @@ VehicleManager::VehicleManager(CanManager *canMgr)
     {
         Serial.println("[VehicleManager] CRITICAL: Failed to create state mutex!");
     }
+
+    // BAP routes exist before the first frame is routed
+    bapRouter.addChannel(&batteryControlChannel);
+    bapRouter.addChannel(&doorLockingChannel);
+    bapRouter.addChannel(&eniChannel);
+    bapRouter.addMessageObserver(
+        BapChannelRouter::MessageObserver::bind<BapDiscovery, &BapDiscovery::onMessage>(&bapDiscovery));
+    bapRouter.addMessageObserver(
+        BapChannelRouter::MessageObserver::bind<BapClient, &BapClient::onMessage>(&bapClient));
+    bapRouter.addMessageObserver(
+        BapChannelRouter::MessageObserver::bind<BapPropertyCache, &BapPropertyCache::onMessage>(&bapCache));
+
+    // Battery Control properties a GET may be answered from
+    typedef BatteryControlChannel::Function BatteryFunction;
+    bapCache.addProperty(BatteryControlChannel::DEVICE_ID, BatteryFunction::PLUG_STATE);
+    bapCache.addProperty(BatteryControlChannel::DEVICE_ID, BatteryFunction::CHARGE_STATE);
+    bapCache.addProperty(BatteryControlChannel::DEVICE_ID, BatteryFunction::CLIMATE_STATE);
+    bapCache.addProperty(BatteryControlChannel::DEVICE_ID, BatteryFunction::PROFILES_ARRAY);
+
+    // Devices we send requests to (the monitor channels only listen)
+    bapDiscovery.addDevice(BatteryControlChannel::DEVICE_ID, BatteryControlChannel::CAN_ID_TX);
 }
 
 VehicleManager::~VehicleManager()
@@ -50,14 +110,46 @@ bool VehicleManager::setup()
     rangeManager.setup();
     Serial.println("[VehicleManager] === All Managers Initialized ===");
 
+    // Server-configured signals persisted in NVS
+    if (customSignalTable.load())
+    {
+        Serial.printf("[VehicleManager] Custom signals: %u loaded from NVS (%u CAN IDs)\r\n",
+                      (unsigned)customSignalTable.size(), (unsigned)customSignalTable.idCount());
+    }
+
+    // BAP function lists from earlier wakes (checked against the fingerprint on wake)
+    uint8_t bapDevicesLoaded = bapDiscovery.load();
+    if (bapDevicesLoaded > 0)
+    {
+        Serial.printf("[VehicleManager] BAP discovery: %u function lists loaded from NVS\r\n", bapDevicesLoaded);
+    }
+
+    // Let the TWAI hardware drop traffic no domain or custom signal consumes
+    applyAcceptanceFilter();
+
+    // Unchanged-payload fast path for every routed standard ID that allows it
+    for (uint16_t canId : ROUTED_STD_IDS)
+    {
+        bool cacheable = true;
+        for (uint16_t uncached : UNCACHED_STD_IDS)
+        {
+            cacheable = cacheable && canId != uncached;
+        }
+        if (cacheable)
+        {
+            payloadCache.addId(canId);
+        }
+    }
+
     Serial.println("[VehicleManager] Domain managers initialized:");
     Serial.println("[VehicleManager]   - BatteryManager (0x5CA, 0x59E, 0x483 + BAP)");
     Serial.println("[VehicleManager]   - ClimateManager (0x66E, 0x5E1 + BAP)");
     Serial.println("[VehicleManager]   - BodyManager (0x3D0, 0x3D1, 0x583)");
     Serial.println("[VehicleManager]   - DriveManager (0x3C0, 0x0FD, 0x6B2)");
-    Serial.println("[VehicleManager]   - GpsManager (0x484, 0x485, 0x486)");
+    Serial.println("[VehicleManager]   - GpsManager (0x484, 0x485, 0x486, 0x1A5554A8)");
     Serial.println("[VehicleManager]   - RangeManager (0x5F5, 0x5F7)");
-    Serial.println("[VehicleManager]   - BatteryControlChannel (0x17332510 BAP RX)");
+    Serial.printf("[VehicleManager]   - BapChannelRouter (%u RX IDs: BatteryControl 0x17332510, DoorLocking, ENI; %u B)\r\n",
+                  (unsigned)bapRouter.getRouteCount(), (unsigned)BapChannelRouter::footprintBytes());
     Serial.println("[VehicleManager]   - Wake State Machine (integrated)");
     Serial.println("[VehicleManager]   - ChargingProfileManager (high-level charging/climate API)");
     Serial.println("[VehicleManager] Thread-safe state access enabled (CAN task on Core 0)");
@@ -67,11 +159,43 @@ bool VehicleManager::setup()
 
 void VehicleManager::loop()
 {
-    // Update wake state machine using services
-    wakeController.loop(activityTracker.isActive());
+    // Update wake state machine using services (a wake ends early once BAP answers)
+    bool canActive = activityTracker.isActive();
+    wakeController.setBapReady(bapDiscovery.isReady());
+    wakeController.loop(canActive);
+    
+    // Bus up after a requested wake: BAP-Config (and function list unless cached)
+    // per device. A vehicle that wakes on its own is left alone; its requests are
+    // not filtered until the next requested wake.
+    WakeController::WakeState wakeState = wakeController.getState();
+    if (wakeState == WakeController::WakeState::WAKING && canActive && !bapDiscovery.isStarted())
+    {
+        bapDiscovery.start();
+    }
+    bapDiscovery.loop();
+    
+    // Vehicle woke on our request: refresh BAP state in one pipelined round-trip
+    if (wakeState == WakeController::WakeState::AWAKE && lastWakeState == WakeController::WakeState::WAKING)
+    {
+        batteryControlChannel.refreshState();
+    }
+    if (wakeState == WakeController::WakeState::ASLEEP && lastWakeState != WakeController::WakeState::ASLEEP)
+    {
+        bapCache.clear();
+        bapDiscovery.reset();
+    }
+    lastWakeState = wakeState;
+    
+    // BAP request retries, timeouts and response callbacks
+    bapClient.loop();
+    
+    // BAP frames: group assignment and paced, interleaved hand-over to the TX scheduler
+    bapTx.loop();
     
     // Update profile manager state machine
     profileManager.loop();
+    
+    checkRecorderTriggers();
 
     // Periodic statistics logging (from main loop on Core 1)
     if (millis() - lastLogTime > LOG_INTERVAL)
@@ -96,30 +220,53 @@ uint32_t VehicleManager::getFrameCount()
 }
 
 // =============================================================================
-// CAN Frame Processing (called from CAN task on Core 0)
+// CAN Frame Processing (called from CAN decode task on Core 0)
 // =============================================================================
 
 void VehicleManager::onCanFrame(uint32_t canId, const uint8_t *data, uint8_t dlc, bool extended)
 {
-    // Acquire mutex with 10ms timeout (CAN task runs at high priority)
-    if (xSemaphoreTake(stateMutex, pdMS_TO_TICKS(10)) != pdTRUE)
-    {
-        // Mutex timeout - skip this frame to avoid blocking CAN task
-        // This should be rare; indicates main loop is holding mutex too long
-        unhandledFrames++;
-        return;
-    }
+    // Block until the mutex is free. This runs on the decode task, not the
+    // CAN RX task: while we wait, RX keeps draining TWAI into CanManager's
+    // ring, so contention delays decoding instead of dropping frames.
+    xSemaphoreTake(stateMutex, portMAX_DELAY);
 
     // Count every frame and mark activity
     activityTracker.onCanActivity();
+    routeFrame(canId, data, dlc, extended);
+
+    xSemaphoreGive(stateMutex);
+}
+
+void VehicleManager::onCanFrames(const CanRxFrame *frames, size_t count)
+{
+    // One lock acquisition for the whole batch (see onCanFrame for blocking rationale)
+    xSemaphoreTake(stateMutex, portMAX_DELAY);
+
+    activityTracker.onCanActivity(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        routeFrame(frames[i].canId, frames[i].data, frames[i].dlc, frames[i].extended);
+    }
+
+    xSemaphoreGive(stateMutex);
+}
 
-    // Extended frames: only BAP
+void VehicleManager::routeFrame(uint32_t canId, const uint8_t *data, uint8_t dlc, bool extended)
+{
+    // Extended frames: BAP and the extended broadcasts of the routing table
     if (extended)
     {
-        // Route all BAP frames (0x1733xxxx range) to BatteryControlChannel
+        if (VehicleMessages::extendedDomainOf(canId) == VehicleMessages::Domain::Gps)
+        {
+            gpsManager.processCanFrame(canId, data, dlc);
+            gpsFrames++;
+            return;
+        }
+
+        // BAP frames (0x1733xxxx range): RX CAN ID table lookup, per-route assembly
         if ((canId & 0xFFFF0000) == 0x17330000)
         {
-            if (batteryControlChannel.processFrame(canId, data, dlc))
+            if (bapRouter.processFrame(canId, data, dlc))
             {
                 bapFrames++;
             }
@@ -132,56 +279,168 @@ void VehicleManager::onCanFrame(uint32_t canId, const uint8_t *data, uint8_t dlc
         {
             unhandledFrames++;
         }
-        xSemaphoreGive(stateMutex);
         return;
     }
 
-    // Standard frames: O(1) switch routing to domain managers
-    switch (canId)
+    // Server-configured signals (bitmap reject for all other IDs)
+    bool custom = customSignalTable.process(canId, data, dlc);
+    if (custom)
     {
-    case 0x0FD:
-    case 0x3C0:
-    case 0x6B2:
-        driveManager.processCanFrame(canId, data, dlc);
+        customFrames++;
+    }
+
+    // Unchanged payload: domains only refresh counters and timestamps
+    bool unchanged = payloadCache.unchanged(canId, data, dlc);
+
+    // Standard frames: O(1) switch routing to domain managers by the
+    // generated routing table
+    switch (VehicleMessages::domainOf(canId))
+    {
+    case VehicleMessages::Domain::Drive:
+        if (unchanged)
+        {
+            driveManager.refreshCanFrame(canId, dlc);
+        }
+        else
+        {
+            driveManager.processCanFrame(canId, data, dlc);
+        }
         driveFrames++;
         break;
-    case 0x3D0:
-    case 0x3D1:
-    case 0x583:
-        bodyManager.processCanFrame(canId, data, dlc);
+    case VehicleMessages::Domain::Body:
+        if (unchanged)
+        {
+            bodyManager.refreshCanFrame(canId, dlc);
+        }
+        else
+        {
+            bodyManager.processCanFrame(canId, data, dlc);
+        }
         bodyFrames++;
         break;
-    case 0x484:
-    case 0x485:
-    case 0x486:
-        gpsManager.processCanFrame(canId, data, dlc);
+    case VehicleMessages::Domain::Gps:
+        if (unchanged)
+        {
+            gpsManager.refreshCanFrame(canId, dlc);
+        }
+        else
+        {
+            gpsManager.processCanFrame(canId, data, dlc);
+        }
         gpsFrames++;
         break;
-    case 0x483:
-    case 0x59E:
-    case 0x5CA:
-        batteryManager.processCanFrame(canId, data, dlc);
+    case VehicleMessages::Domain::Battery:
+        if (unchanged)
+        {
+            batteryManager.refreshCanFrame(canId, dlc);
+        }
+        else
+        {
+            batteryManager.processCanFrame(canId, data, dlc);
+        }
         batteryFrames++;
         break;
-    case 0x5E1:
-    case 0x66E:
-        climateManager.processCanFrame(canId, data, dlc);
+    case VehicleMessages::Domain::Climate:
+        if (unchanged)
+        {
+            climateManager.refreshCanFrame(canId, dlc);
+        }
+        else
+        {
+            climateManager.processCanFrame(canId, data, dlc);
+        }
         climateFrames++;
         break;
-    case 0x5F5:
-    case 0x5F7:
-        rangeManager.processCanFrame(canId, data, dlc);
+    case VehicleMessages::Domain::Range:
+        if (unchanged)
+        {
+            rangeManager.refreshCanFrame(canId, dlc);
+        }
+        else
+        {
+            rangeManager.processCanFrame(canId, data, dlc);
+        }
         rangeFrames++;
         break;
+    case VehicleMessages::Domain::None:
     default:
-        unhandledFrames++;
+        if (!custom)
+        {
+            unhandledFrames++;
+        }
         break;
     }
+}
+
+// =============================================================================
+// Custom Signals (server-configured decoder table)
+// =============================================================================
+
+bool VehicleManager::setCustomSignals(const CustomSignalTable::Signal *signals, size_t count, const char **error)
+{
+    if (!CustomSignalTable::validate(signals, count, error))
+    {
+        return false;
+    }
 
+    // The decode task reads the table with the mutex held
+    xSemaphoreTake(stateMutex, portMAX_DELAY);
+    customSignalTable.assign(signals, count);
     xSemaphoreGive(stateMutex);
+
+    if (!customSignalTable.save())
+    {
+        Serial.println("[VehicleManager] Custom signals: NVS write failed (table active until reboot)");
+    }
+    applyAcceptanceFilter();
+
+    Serial.printf("[VehicleManager] Custom signals: %u configured (%u CAN IDs, frame cost %u/%u)\r\n",
+                  (unsigned)count, (unsigned)customSignalTable.idCount(),
+                  CustomSignalTable::frameCost(signals, count), CustomSignalTable::FRAME_COST_BUDGET);
+    return true;
+}
+
+void VehicleManager::applyAcceptanceFilter()
+{
+    if (!canManager)
+    {
+        return;
+    }
+
+    // Routed IDs plus custom signal IDs that no domain routes already
+    static constexpr size_t ROUTED_COUNT = sizeof(ROUTED_STD_IDS) / sizeof(ROUTED_STD_IDS[0]);
+    uint16_t stdIds[ROUTED_COUNT + CustomSignalTable::MAX_IDS];
+    size_t stdCount = 0;
+    for (uint16_t canId : ROUTED_STD_IDS)
+    {
+        stdIds[stdCount++] = canId;
+    }
+    for (size_t i = 0; i < customSignalTable.idCount(); i++)
+    {
+        uint16_t canId = customSignalTable.getId(i);
+        if (VehicleMessages::domainOf(canId) == VehicleMessages::Domain::None)
+        {
+            stdIds[stdCount++] = canId;
+        }
+    }
+
+    // BAP ranges plus one exact-match range per extended broadcast
+    CanFilterPlanner::ExtRange extRanges[ROUTED_EXT_RANGE_COUNT + ROUTED_EXT_ID_COUNT];
+    size_t extCount = 0;
+    for (const CanFilterPlanner::ExtRange& range : ROUTED_EXT_RANGES)
+    {
+        extRanges[extCount++] = range;
+    }
+    for (size_t i = 0; i < ROUTED_EXT_ID_COUNT; i++)
+    {
+        extRanges[extCount++] = { ROUTED_EXT_IDS[i], 0x1FFFFFFF };
+    }
+
+    canManager->setAcceptanceIds(stdIds, stdCount, extRanges, extCount);
 }
 
-bool VehicleManager::sendCanFrame(uint32_t canId, const uint8_t *data, uint8_t dlc, bool extended)
+bool VehicleManager::sendCanFrame(uint32_t canId, const uint8_t *data, uint8_t dlc, bool extended,
+                                  CanTxPriority priority, CanTxCallback onComplete)
 {
     if (!canManager)
     {
@@ -195,38 +454,99 @@ bool VehicleManager::sendCanFrame(uint32_t canId, const uint8_t *data, uint8_t d
         return false;
     }
 
-    // Build TWAI message
-    twai_message_t message;
-    message.identifier = canId;
-    message.extd = extended ? 1 : 0;
-    message.rtr = 0;
-    message.data_length_code = dlc;
-    memcpy(message.data, data, dlc);
+    // Queue only - the CAN TX task sends it and reports through onComplete
+    if (!canManager->transmit(canId, data, dlc, extended, priority, std::move(onComplete)))
+    {
+        Serial.printf("[VehicleManager] TX rejected: ID:0x%03lX (queue full)\r\n", canId);
+        return false;
+    }
 
-    // Send with 100ms timeout
-    esp_err_t result = twai_transmit(&message, pdMS_TO_TICKS(100));
+    // Debug logging (disabled - uncomment for CAN frame debugging)
+    // Serial.printf("[VehicleManager] TX: ID:0x%03lX [%d]", canId, dlc);
+    // for (int i = 0; i < dlc; i++)
+    // {
+    //     Serial.printf(" %02X", data[i]);
+    // }
+    // Serial.println();
+    return true;
+}
 
-    if (result == ESP_OK)
+uint8_t VehicleManager::sendBapMessage(uint32_t canId, uint8_t opcode, uint8_t deviceId, uint8_t functionId,
+                                       const uint8_t *payload, uint8_t payloadLen,
+                                       CanTxCallback onComplete)
+{
+    if (!canManager || !canManager->isRunning())
     {
-        // Debug logging (disabled - uncomment for CAN frame debugging)
-        // Serial.printf("[VehicleManager] TX: ID:0x%03lX [%d]", canId, dlc);
-        // for (int i = 0; i < dlc; i++)
-        // {
-        //     Serial.printf(" %02X", data[i]);
-        // }
-        // Serial.println();
-        return true;
+        Serial.println("[VehicleManager] CAN not running - cannot send BAP message");
+        return 0;
     }
-    else if (result == ESP_ERR_TIMEOUT)
+
+    // Function not in the FSG's list: fail now instead of timing out on the bus
+    if (!bapDiscovery.isSupported(deviceId, functionId))
     {
-        Serial.println("[VehicleManager] TX timeout - no ACK");
-        return false;
+        Serial.printf("[VehicleManager] TX rejected: BAP 0x%02X/0x%02X not supported by the FSG\r\n",
+                      deviceId, functionId);
+        return 0;
     }
-    else
+
+    uint8_t frameCount = bapTx.send(canId, opcode, deviceId, functionId, payload, payloadLen, std::move(onComplete));
+    if (frameCount == 0)
     {
-        Serial.printf("[VehicleManager] TX failed: %s\r\n", esp_err_to_name(result));
-        return false;
+        Serial.printf("[VehicleManager] TX rejected: BAP 0x%08lX %u bytes (too long or %u messages queued)\r\n",
+                      canId, payloadLen, BapTransmitter::MAX_MESSAGES);
+        return 0;
+    }
+
+    // Hand the first frames over now rather than on the next loop
+    bapTx.loop();
+    return frameCount;
+}
+
+void VehicleManager::checkRecorderTriggers()
+{
+    if (!canManager)
+    {
+        return;
     }
+
+    uint32_t continuationErrors = bapRouter.getContinuationErrors();
+    uint32_t wakeAttempts, keepAlives, wakeFailed;
+    wakeController.getStats(wakeAttempts, keepAlives, wakeFailed);
+    uint8_t chargingStatus = batteryManager.getState().chargingStatus;
+
+    // First pass only captures baselines
+    if (recorderTriggersInitialized)
+    {
+        CanFlightRecorder &recorder = canManager->recorder();
+
+        if (chargingStatus != lastChargingStatus)
+        {
+            BapChargeStatus status = static_cast<BapChargeStatus>(chargingStatus);
+            bool aborted = status == BapChargeStatus::ABORTED_TEMP_LOW ||
+                           status == BapChargeStatus::ABORTED_DEVICE_ERROR ||
+                           status == BapChargeStatus::ABORTED_NO_POWER ||
+                           status == BapChargeStatus::ABORTED_NOT_IN_PARK;
+            if (aborted)
+            {
+                recorder.trigger(CanFlightRecorder::Trigger::CHARGE_ABORTED);
+            }
+            // No-op if the abort trigger already fired
+            recorder.trigger(CanFlightRecorder::Trigger::CHARGE_STATUS);
+        }
+        if (continuationErrors > lastContinuationErrors)
+        {
+            recorder.trigger(CanFlightRecorder::Trigger::BAP_CONTINUATION_ERROR);
+        }
+        if (wakeFailed > lastWakeFailed)
+        {
+            recorder.trigger(CanFlightRecorder::Trigger::WAKE_FAILED);
+        }
+    }
+
+    lastContinuationErrors = continuationErrors;
+    lastWakeFailed = wakeFailed;
+    lastChargingStatus = chargingStatus;
+    recorderTriggersInitialized = true;
 }
 
 void VehicleManager::logStatistics()
@@ -237,6 +557,8 @@ void VehicleManager::logStatistics()
     // Get CanManager's count for comparison
     uint32_t canMgrCount = canManager ? canManager->getMessageCount() : 0;
     uint32_t canMgrMissed = canManager ? canManager->getMissedCount() : 0;
+    uint32_t ringOverflows = canManager ? canManager->getRingOverflows() : 0;
+    uint32_t ringDepth = canManager ? canManager->getRingDepth() : 0;
 
     Serial.println("[VehicleManager] === Vehicle Status ===");
 
@@ -244,14 +566,140 @@ void VehicleManager::logStatistics()
     uint32_t processedByDomains = bodyFrames + batteryFrames + driveFrames + climateFrames + gpsFrames + rangeFrames + bapFrames + unhandledFrames;
     Serial.printf("[VehicleManager] CanManager received: %lu (TWAI missed: %lu)\r\n", canMgrCount, canMgrMissed);
     Serial.printf("[VehicleManager] ActivityTracker: %lu frames | Domains processed: %lu\r\n", totalFrameCount, processedByDomains);
-    if (canMgrCount > totalFrameCount)
+    if (canManager)
+    {
+        Serial.printf("[VehicleManager] Decode ring: depth:%lu high-water:%lu/%lu overflows:%lu latency avg:%luus max:%luus\r\n",
+                      ringDepth, canManager->getRingHighWater(), canManager->getRingCapacity(), ringOverflows,
+                      canManager->getDecodeLatencyAvgUs(), canManager->getDecodeLatencyMaxUs());
+        Serial.printf("[VehicleManager] Decode batches: %lu (avg %.1f frames, max %lu) sink:%s %lu cycles/frame\r\n",
+                      canManager->getDecodeBatches(), canManager->getAvgBatchSize(), canManager->getMaxBatchSize(),
+                      canManager->isSinkStatic() ? "static" : "runtime", canManager->getSinkCyclesPerFrame());
+    }
+    if (canManager)
+    {
+        const CanBusLoad &load = canManager->busLoad();
+        const CanBusLoad::Window &w1 = load.getWindow(0);
+        const CanBusLoad::Window &w10 = load.getWindow(1);
+        const CanBusLoad::Window &w60 = load.getWindow(2);
+        Serial.printf("[VehicleManager] Bus load: 1s:%.1f%% 10s:%.1f%% 60s:%.1f%% (worst-case %.1f%%) peak:%lu fps missed 60s:%lu\r\n",
+                      load.loadPercent(w1, false), load.loadPercent(w10, false), load.loadPercent(w60, false),
+                      load.loadPercent(w60, true), load.getPeakFramesPerSecond(), w60.missed);
+    }
+    if (canManager)
+    {
+        CanFlightRecorder &recorder = canManager->recorder();
+        Serial.printf("[VehicleManager] Flight recorder: %s trigger:%s frames:%lu retained:%lums captures:%lu\r\n",
+                      CanFlightRecorder::stateName(recorder.getState()),
+                      CanFlightRecorder::triggerName(recorder.getTriggerReason()),
+                      recorder.getRecordedFrames(), recorder.getRetainedMs(), recorder.getCaptureCount());
+    }
+    if (canManager)
     {
-        Serial.printf("[VehicleManager] FRAME LOSS: %lu frames lost between CanManager and VehicleManager (mutex timeout?)\r\n",
-                      canMgrCount - totalFrameCount);
+        CanTxScheduler &tx = canManager->scheduler();
+        Serial.printf("[VehicleManager] CAN TX: sent:%lu expired:%lu noAck:%lu driver:%lu full:%lu aborted:%lu retries:%lu queue high-water:%lu max delay:%lums\r\n",
+                      tx.getSent(), tx.getResultCount(CanTxResult::EXPIRED), tx.getResultCount(CanTxResult::NO_ACK),
+                      tx.getResultCount(CanTxResult::DRIVER_ERROR), tx.getResultCount(CanTxResult::QUEUE_FULL),
+                      tx.getResultCount(CanTxResult::SEQUENCE_ABORTED), tx.getAttemptFailures(),
+                      tx.getQueueHighWater(), tx.getMaxQueueDelayMs());
+    }
+    uint32_t wakeAttempts, keepAlives, wakeFailed;
+    wakeController.getStats(wakeAttempts, keepAlives, wakeFailed);
+    uint32_t keepAliveFailures = wakeController.getKeepAliveFailures();
+    Serial.printf("[VehicleManager] Wake: %s attempts:%lu failed:%lu keep-alives sent:%lu failed:%lu (last %s)\r\n",
+                  wakeController.getStateName(), wakeAttempts, wakeFailed, keepAlives, keepAliveFailures,
+                  keepAliveFailures ? CanTxScheduler::resultName(wakeController.getLastKeepAliveFailure()) : "-");
+    // Frames still queued in the ring are in flight, not lost
+    if (canMgrCount > totalFrameCount + ringDepth)
+    {
+        Serial.printf("[VehicleManager] FRAME LOSS: %lu frames lost between CanManager and VehicleManager (ring overflow: %lu)\r\n",
+                      canMgrCount - totalFrameCount - ringDepth, ringOverflows);
     }
 
-    Serial.printf("[VehicleManager] Domain breakdown: body:%lu batt:%lu drv:%lu clim:%lu gps:%lu rng:%lu bap:%lu unhandled:%lu\r\n",
-                  bodyFrames, batteryFrames, driveFrames, climateFrames, gpsFrames, rangeFrames, bapFrames, unhandledFrames);
+    Serial.printf("[VehicleManager] Domain breakdown: body:%lu batt:%lu drv:%lu clim:%lu gps:%lu rng:%lu bap:%lu custom:%lu unhandled:%lu\r\n",
+                  bodyFrames, batteryFrames, driveFrames, climateFrames, gpsFrames, rangeFrames, bapFrames, customFrames, unhandledFrames);
+    if (customSignalTable.size() > 0)
+    {
+        Serial.printf("[VehicleManager] Custom signals: %u signals on %u IDs, frames:%lu decoded:%lu short:%lu\r\n",
+                      (unsigned)customSignalTable.size(), (unsigned)customSignalTable.idCount(),
+                      customSignalTable.getFramesMatched(), customSignalTable.getSignalsDecoded(),
+                      customSignalTable.getShortFrames());
+    }
+    // BAP routes: traffic, reassembly and channel statistics per RX CAN ID
+    Serial.printf("[VehicleManager] BAP routes: %u, unrouted frames:%lu, %u B\r\n",
+                  (unsigned)bapRouter.getRouteCount(), bapRouter.getUnroutedFrames(),
+                  (unsigned)BapChannelRouter::footprintBytes());
+    for (uint8_t i = 0; i < bapRouter.getRouteCount(); i++)
+    {
+        const BapChannelRouter::Route &route = bapRouter.getRoute(i);
+        if (route.frames == 0)
+        {
+            continue;
+        }
+        const BapChannelRouter::Assembler &bap = route.assembler;
+        Serial.printf("[VehicleManager]   0x%08lX %s: frames:%lu msgs:%lu ignored:%lu long:%lu pending:%u (max %u) buffered max:%u B contErrors:%lu timeouts:%lu restarts:%lu overflows:%lu\r\n",
+                      route.canId, route.channel->getName(), route.frames, route.messages, route.ignored,
+                      bap.longMessagesDecoded, bap.getPendingCount(), bap.maxPendingCount, bap.maxBufferedBytes,
+                      bap.continuationErrors, bap.timeoutEvictions, bap.staleReplacements, bap.pendingOverflows);
+    }
+    Serial.printf("[VehicleManager] BAP TX: msgs:%lu failed:%lu frames:%lu groups max:%u waits:%lu rejects:%lu max:%lums gap:%luus\r\n",
+                  bapTx.getMessagesSent(), bapTx.getMessagesFailed(), bapTx.getFramesSent(),
+                  bapTx.getMaxConcurrentLong(), bapTx.getGroupWaits(), bapTx.getSinkRejects(),
+                  bapTx.getMaxMessageMs(), bapTx.getInterFrameGapUs());
+    // BAP client: round-trip statistics per device/function
+    for (uint8_t i = 0; i < bapClient.getFunctionStatsCount(); i++)
+    {
+        const BapClient::FunctionStats &fs = bapClient.getFunctionStats(i);
+        Serial.printf("[VehicleManager]   BAP 0x%02X/0x%02X: req:%lu ok:%lu err:%lu timeouts:%lu retries:%lu rtt avg:%lums max:%lums last:%lums\r\n",
+                      fs.deviceId, fs.functionId, fs.requests, fs.ok, fs.errors, fs.timeouts, fs.retries,
+                      fs.avgMs(), fs.maxMs, fs.lastMs);
+    }
+    // BAP discovery: function lists per device, NVS cache hits and discovery time
+    for (uint8_t i = 0; i < bapDiscovery.getDeviceCount(); i++)
+    {
+        const BapDiscovery::Device &d = bapDiscovery.getDevice(i);
+        Serial.printf("[VehicleManager] BAP discovery 0x%02X: %s functions:%u fingerprint:0x%08lX hits:%lu misses:%lu mismatches:%lu failures:%lu rejected:%lu invalidated:%lu last:%lums (%s)\r\n",
+                      d.deviceId, BapDiscovery::phaseName(d.phase), d.known ? __builtin_popcountll(d.functionMask) : 0,
+                      d.fingerprint, d.hits, d.misses, d.mismatches, d.failures, d.rejected, d.invalidations, d.lastMs,
+                      d.lastFromCache ? "NVS" : "bus");
+    }
+    // BAP property cache: GETs answered from pushed values
+    Serial.printf("[VehicleManager] BAP cache: hits:%lu misses:%lu\r\n", bapCache.getHits(), bapCache.getMisses());
+    for (uint8_t i = 0; i < bapCache.getPropertyCount(); i++)
+    {
+        const BapPropertyCache::Property &p = bapCache.getProperty(i);
+        Serial.printf("[VehicleManager]   0x%02X/0x%02X: %s age:%lums heartbeat:%lums updates:%lu hits:%lu misses:%lu\r\n",
+                      p.deviceId, p.functionId, p.valid ? "valid" : "empty", p.valid ? millis() - p.arrivalMs : 0UL,
+                      p.heartbeatPeriodMs, p.updates, p.hits, p.misses);
+    }
+    const BapMonitorChannel *monitors[] = { &doorLockingChannel, &eniChannel };
+    for (const BapMonitorChannel *monitor : monitors)
+    {
+        if (monitor->getMessageCount() > 0)
+        {
+            Serial.printf("[VehicleManager]   %s (LSG 0x%02X): %lu msgs, %u functions (mask 0x%016llX), errors:%lu\r\n",
+                          monitor->getName(), monitor->getDeviceId(), monitor->getMessageCount(),
+                          monitor->getFunctionCount(), (unsigned long long)monitor->getFunctionsSeen(),
+                          monitor->getErrorCount());
+        }
+    }
+
+    // Payload cache: frames that skipped decode (unchanged payload), per ID
+    {
+        uint32_t hits = payloadCache.getTotalHits();
+        uint32_t total = hits + payloadCache.getTotalMisses();
+        Serial.printf("[VehicleManager] Payload cache: %lu/%lu unchanged (%.1f%%)\r\n",
+                      hits, total, total ? hits * 100.0f / total : 0.0f);
+
+        char line[256];
+        size_t len = 0;
+        line[0] = '\0';
+        for (size_t i = 0; i < payloadCache.size() && len < sizeof(line); i++)
+        {
+            len += snprintf(line + len, sizeof(line) - len, " 0x%03X:%.0f%%",
+                            payloadCache.getId(i), payloadCache.getHitRatio(i) * 100.0f);
+        }
+        Serial.printf("[VehicleManager] Payload cache hit ratio:%s\r\n", line);
+    }
 
     Serial.printf("[VehicleManager] Vehicle awake: %s\r\n", activityTracker.isActive() ? "YES" : "NO");
 
@@ -276,10 +724,10 @@ void VehicleManager::logStatistics()
         const BatteryManager::State& battState = batteryManager.getState();
         Serial.printf("[VehicleManager] BatteryManager: frames=0x5CA:%lu 0x59E:%lu 0x483:%lu callbacks=plug:%lu charge:%lu\r\n",
                       bms07, bms06, motorHybrid06, plugCallbacks, chargeCallbacks);
-        Serial.printf("[VehicleManager] Battery: SOC=%.0f%% (source:%s) energy=%.0f/%.0fWh plugged:%s charging:%s\r\n",
+        Serial.printf("[VehicleManager] Battery: SOC=%u%% (source:%s) energy=%.0f/%.0fWh plugged:%s charging:%s\r\n",
                       battState.soc,
                       battState.socSource == DataSource::BAP ? "BAP" : battState.socSource == DataSource::CAN_STD ? "CAN" : "none",
-                      battState.energyWh, battState.maxEnergyWh,
+                      battState.energyWh(), battState.maxEnergyWh(),
                       battState.plugState.isPlugged() ? "YES" : "no",
                       battState.charging ? "YES" : "no");
     }
@@ -296,7 +744,7 @@ void VehicleManager::logStatistics()
                             driveState.ignition == IgnitionState::ON ? "ON" :
                             driveState.ignition == IgnitionState::START ? "START" : "UNKNOWN";
         Serial.printf("[VehicleManager] Drive: ignition:%s speed:%.1fkm/h odometer:%lukm\r\n",
-                      ignStr, driveState.speedKmh, driveState.odometerKm);
+                      ignStr, driveState.speedKmh(), driveState.odometerKm);
     }
 
     // ClimateManager stats
@@ -308,9 +756,9 @@ void VehicleManager::logStatistics()
         Serial.printf("[VehicleManager] ClimateManager: frames=0x66E:%lu 0x5E1:%lu callbacks=%lu\r\n",
                       klima03, klimaSensor02, climateCallbacks);
         Serial.printf("[VehicleManager] Climate: inside=%.1f°C (source:%s) outside=%.1f°C active:%s\r\n",
-                      climState.insideTemp,
+                      climState.insideTemp(),
                       climState.insideTempSource == DataSource::BAP ? "BAP" : climState.insideTempSource == DataSource::CAN_STD ? "CAN" : "none",
-                      climState.outsideTemp,
+                      climState.outsideTemp(),
                       climState.climateActive ? "YES" : "no");
     }
     
@@ -319,11 +767,11 @@ void VehicleManager::logStatistics()
         uint32_t navData01Frames, navData02Frames, navPos01Frames;
         gpsManager.getFrameCounts(navData01Frames, navData02Frames, navPos01Frames);
         const GpsManager::State& gpsState = gpsManager.getState();
-        Serial.printf("[VehicleManager] GpsManager: frames=0x484:%lu 0x485:%lu 0x486:%lu\r\n",
-                      navData01Frames, navData02Frames, navPos01Frames);
+        Serial.printf("[VehicleManager] GpsManager: frames=0x484:%lu 0x485:%lu 0x486:%lu 0x1A5554A8:%lu\r\n",
+                      navData01Frames, navData02Frames, navPos01Frames, gpsManager.getMapMatchedCount());
         Serial.printf("[VehicleManager] GPS: fix:%s sats:%d pos:%.6f,%.6f\r\n",
                       gpsState.fixTypeStr(), gpsState.satellites,
-                      gpsState.latitude, gpsState.longitude);
+                      gpsState.latitude(), gpsState.longitude());
     }
     
     // RangeManager stats
@@ -349,9 +797,9 @@ void VehicleManager::logStatistics()
     }
 
     // BAP Charge detail (from BatteryManager)
-    if (battState.socSource == DataSource::BAP || battState.chargingUpdate > 0)
+    if (battState.socSource == DataSource::BAP || battState.chargingUpdate.valid())
     {
-        Serial.printf("[VehicleManager] BAP Charge: SOC=%.0f%% mode=%d status=%d amps=%d target=%d%% time=%dmin\r\n",
+        Serial.printf("[VehicleManager] BAP Charge: SOC=%u%% mode=%d status=%d amps=%d target=%d%% time=%dmin\r\n",
                       battState.soc,
                       battState.chargingMode,
                       battState.chargingStatus,
@@ -366,7 +814,7 @@ void VehicleManager::logStatistics()
     {
         Serial.printf("[VehicleManager] BAP Climate Detail: heat:%d cool:%d vent:%d defrost:%d temp:%.1f°C time:%dmin\r\n",
                       climState.heating, climState.cooling, climState.ventilation, climState.autoDefrost,
-                      climState.insideTemp, climState.climateTimeMin);
+                      climState.insideTemp(), climState.climateTimeMin);
     }
 
     Serial.println("[VehicleManager] ======================");
@@ -4,11 +4,21 @@
 #include <freertos/FreeRTOS.h>
 #include <freertos/semphr.h>
 #include "VehicleTypes.h"
+#include "bap/BapChannelRouter.h"
+#include "bap/BapClient.h"
+#include "bap/BapDiscovery.h"
+#include "bap/BapPropertyCache.h"
+#include "bap/BapTransmitter.h"
 #include "bap/channels/BatteryControlChannel.h"
+#include "bap/channels/BapMonitorChannel.h"
 #include "ChargingProfileManager.h"
 #include "../core/IModule.h"  // For ActivityCallback
+#include "../modules/ICanFrameSink.h"
+#include "../modules/CanTxScheduler.h"
 #include "services/ActivityTracker.h"
 #include "services/WakeController.h"
+#include "services/PayloadCache.h"
+#include "services/CustomSignalTable.h"
 
 // Domain-based architecture
 #include "domains/BatteryManager.h"
@@ -34,7 +44,7 @@ class CanManager;
  * - Holds the shared VehicleState (thread-safe via mutex)
  * 
  * Thread Safety:
- * - CAN frames are processed from CAN task on Core 0
+ * - CAN frames are processed from the CAN decode task on Core 0
  * - State is read from main loop on Core 1
  * - Mutex protects all state access
  * 
@@ -47,15 +57,19 @@ class CanManager;
  * - RangeDomain: range estimation from cluster
  * 
  * BAP Architecture:
- * - BapChannelRouter: routes BAP messages to channels
+ * - BapChannelRouter: RX CAN ID table, one assembler per ID, routes
+ *   complete BAP messages to channels
  * - BatteryControlChannel: BAP protocol for Battery Control (Device 0x25)
+ * - BapMonitorChannel: passive Door Locking (0x0D) and ENI (0x37) channels
+ * - BapDiscovery: function list and BAP-Config per device after requested wakes,
+ *   cached in NVS; ends the wake's BAP init wait once the FSGs answer
  * 
  * Wake State Machine:
  * - Managed by WakeController service
  * - States: ASLEEP, WAKE_REQUESTED, WAKING, AWAKE
  * - Non-blocking state transitions in loop()
  */
-class VehicleManager {
+class VehicleManager : public ICanFrameSink {
 public:
     /**
      * Construct the vehicle manager.
@@ -77,8 +91,8 @@ public:
     void loop();
     
     /**
-     * Process an incoming CAN frame. Called by CanManager from CAN task on Core 0.
-     * Thread-safe: acquires mutex internally.
+     * Process an incoming CAN frame. Called by CanManager from decode task on Core 0.
+     * Thread-safe: acquires mutex internally (blocking - never drops frames).
      * @param canId The CAN identifier
      * @param data Frame data (8 bytes max)
      * @param dlc Data length code
@@ -87,14 +101,39 @@ public:
     void onCanFrame(uint32_t canId, const uint8_t* data, uint8_t dlc, bool extended);
     
     /**
-     * Send a CAN frame.
+     * Process a batch of CAN frames (ICanFrameSink). Called by CanManager from decode task on Core 0.
+     * Thread-safe: acquires mutex once for the whole batch.
+     * @param frames First frame of the batch
+     * @param count Number of frames
+     */
+    void onCanFrames(const CanRxFrame* frames, size_t count) override;
+    
+    /**
+     * Send a CAN frame (non-blocking, via CanManager's TX scheduler).
      * @param canId The CAN identifier
      * @param data Frame data
      * @param dlc Data length code (1-8)
      * @param extended true for extended (29-bit) ID
-     * @return true if frame was queued for transmission
+     * @param priority TX class; BAP requests use BAP_START
+     * @param onComplete Called from the main loop with the outcome (optional)
+     * @return true if frame was queued for transmission (not yet sent)
+     */
+    bool sendCanFrame(uint32_t canId, const uint8_t* data, uint8_t dlc, bool extended = false,
+                      CanTxPriority priority = CanTxPriority::COMMAND,
+                      CanTxCallback onComplete = nullptr);
+    
+    /**
+     * Send a complete BAP message through the BapTransmitter.
+     * A long message gets a free BAP group of its CAN ID, so concurrent long
+     * messages go out interleaved instead of one after another. Functions
+     * the FSG's discovered function list does not contain are not sent.
+     * @param canId BAP TX CAN ID (extended)
+     * @param onComplete Called once from the main loop (optional)
+     * @return Number of frames queued, or 0 on error or unsupported function
      */
-    bool sendCanFrame(uint32_t canId, const uint8_t* data, uint8_t dlc, bool extended = false);
+    uint8_t sendBapMessage(uint32_t canId, uint8_t opcode, uint8_t deviceId, uint8_t functionId,
+                           const uint8_t* payload, uint8_t payloadLen,
+                           CanTxCallback onComplete = nullptr);
     
     // =========================================================================
     // State access (thread-safe via ActivityTracker)
@@ -114,11 +153,41 @@ public:
     // Domain access (for command sending - use from main loop only)
     // =========================================================================
     
+    /**
+     * Get the CAN manager (RX statistics/profiling).
+     */
+    CanManager* can() { return canManager; }
+    
     /**
      * Get the Battery Control channel (charging/climate control via BAP protocol).
      */
     BatteryControlChannel& batteryControl() { return batteryControlChannel; }
     
+    /**
+     * Get the BAP channel router (per-route statistics, read from main loop).
+     */
+    const BapChannelRouter& bapChannels() const { return bapRouter; }
+    
+    /**
+     * Get the BAP client (correlated GET/SET_GET requests, main loop only).
+     */
+    BapClient& bap() { return bapClient; }
+    
+    /**
+     * Get the BAP property cache (last pushed values, heartbeat freshness).
+     */
+    BapPropertyCache& bapProperties() { return bapCache; }
+    
+    /**
+     * Get the BAP discovery (function lists per device, NVS-cached).
+     */
+    BapDiscovery& bapFunctions() { return bapDiscovery; }
+    
+    /**
+     * Get the BAP transmitter (group assignment, pacing, TX statistics).
+     */
+    BapTransmitter& bapTransmitter() { return bapTx; }
+    
     /**
      * Get the charging profile manager (high-level charging/climate API).
      */
@@ -129,6 +198,25 @@ public:
      */
     WakeController& wake() { return wakeController; }
     
+    /**
+     * Get the per-ID payload cache (unchanged-frame fast path, hit ratios).
+     */
+    PayloadCache& frameCache() { return payloadCache; }
+    
+    /**
+     * Get the server-configured signal table (read from main loop only).
+     */
+    const CustomSignalTable& customSignals() const { return customSignalTable; }
+    
+    /**
+     * Replace the custom signal table: validate, swap under the state mutex,
+     * persist to NVS and reopen the acceptance filter for the new IDs.
+     * Call from the main loop.
+     * @param error Set to the validation failure reason
+     * @return false if the table was rejected (the old table stays active)
+     */
+    bool setCustomSignals(const CustomSignalTable::Signal* signals, size_t count, const char** error);
+    
     /**
      * Get the new BatteryManager (domain-based architecture).
      * NOTE: Running in parallel with old BatteryDomain for testing.
@@ -244,6 +332,13 @@ private:
     
     // BAP infrastructure
     BatteryControlChannel batteryControlChannel;
+    BapMonitorChannel doorLockingChannel;
+    BapMonitorChannel eniChannel;
+    BapChannelRouter bapRouter;
+    BapClient bapClient;
+    BapDiscovery bapDiscovery;
+    BapPropertyCache bapCache;
+    BapTransmitter bapTx;
     
     // Charging profile manager (high-level API for charging/climate)
     ChargingProfileManager profileManager;
@@ -251,10 +346,21 @@ private:
     // Services
     ActivityTracker activityTracker;
     WakeController wakeController;
+    PayloadCache payloadCache;
+    CustomSignalTable customSignalTable;
     
     // Configuration
     bool verbose = false;
     
+    // Flight recorder trigger sources (polled from main loop)
+    uint32_t lastContinuationErrors = 0;
+    uint32_t lastWakeFailed = 0;
+    uint8_t lastChargingStatus = 0;
+    bool recorderTriggersInitialized = false;
+    
+    // Wake transition tracking (state refresh once the vehicle is awake)
+    WakeController::WakeState lastWakeState = WakeController::WakeState::ASLEEP;
+    
     // Statistics (accessed from CAN task - use volatile)
     unsigned long lastLogTime = 0;
     static constexpr unsigned long LOG_INTERVAL = 10000;  // Log stats every 10s
@@ -267,8 +373,25 @@ private:
     volatile uint32_t gpsFrames = 0;
     volatile uint32_t rangeFrames = 0;
     volatile uint32_t bapFrames = 0;
+    volatile uint32_t customFrames = 0;     // Standard frames with custom signals
     volatile uint32_t unhandledFrames = 0;
     
+    /**
+     * Route one frame to its domain. Caller must hold stateMutex.
+     */
+    void routeFrame(uint32_t canId, const uint8_t* data, uint8_t dlc, bool extended);
+    
+    /**
+     * Plan the hardware acceptance filter for routed and custom signal IDs.
+     */
+    void applyAcceptanceFilter();
+    
+    /**
+     * Fire flight recorder triggers on charge status transitions,
+     * BAP continuation errors and failed wakes.
+     */
+    void checkRecorderTriggers();
+    
     /**
      * Log statistics to serial (called periodically).
      */
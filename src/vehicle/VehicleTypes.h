@@ -19,6 +19,26 @@ enum class DataSource : uint8_t {
     COMPUTED = 3    // Derived/calculated value
 };
 
+/**
+ * Freshness stamp - when a signal was last received, in 2 bytes
+ *
+ * Holds seconds since boot + 1 (0 = never received). Ages are computed with
+ * 16-bit wrap-around arithmetic, so they are exact for ~18 hours, far beyond
+ * any staleness timeout used on received signals.
+ */
+struct Freshness {
+    uint16_t stamp = 0;
+    
+    static uint16_t now() {
+        uint16_t sec = (uint16_t)(millis() / 1000 + 1);
+        return sec != 0 ? sec : 1;
+    }
+    
+    void touch() { stamp = now(); }
+    bool valid() const { return stamp != 0; }
+    uint16_t ageSec() const { return (uint16_t)(now() - stamp); }
+};
+
 /**
  * Lock state enumeration
  */
@@ -35,10 +55,10 @@ struct DoorState {
     bool open = false;              // Door physically open
     bool locked = false;            // Door lock engaged
     uint8_t windowPosition = 0;     // Window position 0-200 (0.5% scale, 0=closed, 200=fully open)
-    unsigned long lastUpdate = 0;   // Timestamp of last update
+    Freshness lastUpdate;           // Last frame for this door
     
-    bool isStale(unsigned long timeout = 10000) const {
-        return (millis() - lastUpdate) > timeout;
+    bool isStale(uint16_t timeoutSec = 10) const {
+        return !lastUpdate.valid() || lastUpdate.ageSec() > timeoutSec;
     }
     
     float windowPercent() const {
@@ -65,7 +85,7 @@ struct PlugState {
     uint8_t lockState = 0;         // 0=unlocked, 1=locked, 2=error
     uint8_t supplyState = 0x0F;    // 0=inactive, 1=active, 2=station connected, F=init
     uint8_t plugState = 0x0F;      // 0=unplugged, 1=plugged, F=init
-    unsigned long lastUpdate = 0;
+    Freshness lastUpdate;
     
     bool isPlugged() const { return plugState == 0x01; }
     bool hasSupply() const { return supplyState == 0x01 || supplyState == 0x02; }
@@ -121,40 +141,79 @@ enum class RangeTendency : uint8_t {
 
 /**
  * Lightweight structs for BAP callbacks
- * These are minimal data structures passed in callbacks from BatteryControlChannel
+ *
+ * Passed by BatteryControlChannel on the CAN task: decoded values only, no
+ * sources or timestamps. `changed` flags the fields that differ from the
+ * previous message of the function (all of them on the first one); the
+ * other fields repeat the last value. changed == 0 means the FSG confirmed
+ * the state (HeartbeatStatus, repeated STATUS) - refresh freshness only.
  */
 
 /**
- * Battery state for BAP callbacks (from function 0x11)
+ * Plug state update (from function 0x10)
  */
-struct BatteryState {
-    float soc = 0.0f;
-    DataSource socSource = DataSource::NONE;
-    unsigned long socUpdate = 0;
+struct PlugStateUpdate {
+    struct Field {
+        static constexpr uint8_t LOCK_SETUP = 1 << 0;
+        static constexpr uint8_t LOCK_STATE = 1 << 1;
+        static constexpr uint8_t SUPPLY_STATE = 1 << 2;
+        static constexpr uint8_t PLUG_STATE = 1 << 3;
+        static constexpr uint8_t ALL = 0x0F;
+    };
+    
+    uint8_t changed = 0;
+    uint8_t lockSetup = 0;
+    uint8_t lockState = 0;
+    uint8_t supplyState = 0x0F;
+    uint8_t plugState = 0x0F;
+};
+
+/**
+ * Charge state update (from function 0x11)
+ */
+struct ChargeStateUpdate {
+    struct Field {
+        static constexpr uint8_t SOC = 1 << 0;
+        static constexpr uint8_t CHARGING = 1 << 1;
+        static constexpr uint8_t MODE = 1 << 2;
+        static constexpr uint8_t STATUS = 1 << 3;
+        static constexpr uint8_t AMPS = 1 << 4;
+        static constexpr uint8_t TARGET_SOC = 1 << 5;
+        static constexpr uint8_t REMAINING_TIME = 1 << 6;
+        static constexpr uint8_t ALL = 0x7F;
+    };
+    
+    uint8_t changed = 0;
+    uint8_t soc = 0;                // Percent (BAP reports whole percent)
+    bool charging = false;
     uint8_t chargingMode = 0;
     uint8_t chargingStatus = 0;
     uint8_t chargingAmps = 0;
     uint8_t targetSoc = 0;
     uint8_t remainingTimeMin = 0;
-    bool charging = false;
-    DataSource chargingSource = DataSource::NONE;
-    unsigned long chargingUpdate = 0;
-    unsigned long chargingDetailsUpdate = 0;
 };
 
 /**
- * Climate state for BAP callbacks (from function 0x12)
+ * Climate state update (from function 0x12)
  */
-struct ClimateState {
+struct ClimateStateUpdate {
+    struct Field {
+        static constexpr uint8_t CLIMATE_ACTIVE = 1 << 0;
+        static constexpr uint8_t HEATING = 1 << 1;
+        static constexpr uint8_t COOLING = 1 << 2;
+        static constexpr uint8_t VENTILATION = 1 << 3;
+        static constexpr uint8_t AUTO_DEFROST = 1 << 4;
+        static constexpr uint8_t INSIDE_TEMP = 1 << 5;
+        static constexpr uint8_t CLIMATE_TIME = 1 << 6;
+        static constexpr uint8_t ALL = 0x7F;
+    };
+    
+    uint8_t changed = 0;
     bool climateActive = false;
     bool heating = false;
     bool cooling = false;
     bool ventilation = false;
     bool autoDefrost = false;
-    float insideTemp = 0.0f;
+    int16_t insideTempDeci = 0;     // 0.1 C, only reported while climate is active
     uint16_t climateTimeMin = 0;
-    DataSource climateActiveSource = DataSource::NONE;
-    DataSource insideTempSource = DataSource::NONE;
-    unsigned long climateActiveUpdate = 0;
-    unsigned long insideTempUpdate = 0;
 };
@@ -7,5 +7,5 @@ bool BapChannel::sendBapFrame(VehicleManager* mgr, const uint8_t* data, uint8_t
     }
     
     // Send as extended frame to this channel's TX CAN ID
-    return mgr->sendCanFrame(getTxCanId(), data, len, true);
+    return mgr->sendCanFrame(getTxCanId(), data, len, true, CanTxPriority::BAP_START);
 }
@@ -22,8 +22,12 @@ class VehicleManager;
  * ```
  * CAN Frame → BapChannelRouter → BapChannel (this interface)
  *                                      ↓
- *                          BatteryControlChannel, DoorLockingChannel, etc.
+ *                          BatteryControlChannel, BapMonitorChannel, etc.
  * ```
+ * 
+ * The router owns the frame assemblers (one per RX CAN ID) and calls
+ * processMessage() with complete messages. A new device only needs a
+ * channel registered with BapChannelRouter::addChannel().
  */
 class BapChannel {
 public:
@@ -51,9 +55,16 @@ public:
      */
     virtual uint32_t getRxCanId() const = 0;
     
+    /**
+     * All CAN IDs the FSG sends on (responses, alternate responses, status
+     * broadcasts). The router adds one route per ID.
+     * Default: getRxCanId() only.
+     */
+    virtual uint8_t getRxCanIdCount() const { return 1; }
+    virtual uint32_t getRxCanIdAt(uint8_t index) const { return getRxCanId(); }
+    
     /**
      * Check if this channel handles a specific CAN ID
-     * Used by BapChannelRouter to route incoming frames
      */
     virtual bool handlesCanId(uint32_t canId) const = 0;
     
@@ -72,10 +83,11 @@ public:
      * Called by BapChannelRouter after message assembly is complete.
      * The channel should parse the message and update its state.
      * 
-     * @param msg Complete BAP message (short or reassembled long)
+     * @param msg Complete BAP message (short or reassembled long). The payload
+     *            is only valid during the call; copy what must be kept.
      * @return true if message was handled successfully
      */
-    virtual bool processMessage(const BapProtocol::BapMessage& msg) = 0;
+    virtual bool processMessage(const BapProtocol::BapMessageView& msg) = 0;
     
 protected:
     /**
@@ -0,0 +1,68 @@
+#include "BapChannelRouter.h"
+
+BapChannelRouter::BapChannelRouter() {
+    for (uint8_t i = 0; i < HASH_SIZE; i++) {
+        table[i] = NO_ROUTE;
+    }
+}
+
+bool BapChannelRouter::addChannel(BapChannel* channel) {
+    if (!channel) {
+        return false;
+    }
+
+    uint8_t count = channel->getRxCanIdCount();
+    if (routeCount + count > MAX_ROUTES) {
+        return false;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        if (findRoute(channel->getRxCanIdAt(i)) != NO_ROUTE) {
+            return false;  // Each RX ID belongs to one channel
+        }
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        uint32_t canId = channel->getRxCanIdAt(i);
+        Route& route = routes[routeCount];
+        route.canId = canId;
+        route.channel = channel;
+
+        uint8_t bucket = hashOf(canId);
+        while (table[bucket] != NO_ROUTE) {
+            bucket = (bucket + 1) & (HASH_SIZE - 1);
+        }
+        table[bucket] = routeCount++;
+    }
+    return true;
+}
+
+bool BapChannelRouter::processFrame(uint32_t canId, const uint8_t* data, uint8_t dlc) {
+    uint8_t index = findRoute(canId);
+    if (index == NO_ROUTE) {
+        unroutedFrames++;
+        return false;
+    }
+
+    Route& route = routes[index];
+    route.frames++;
+
+    // Complete message: a view into the frame or the route's assembler slot
+    BapProtocol::BapMessageView msg;
+    if (route.assembler.processFrame(data, dlc, msg)) {
+        route.messages++;
+        messageObservers(canId, msg);
+        if (!route.channel->processMessage(msg)) {
+            route.ignored++;
+        }
+        route.assembler.release();
+    }
+    return true;
+}
+
+uint32_t BapChannelRouter::getContinuationErrors() const {
+    uint32_t errors = 0;
+    for (uint8_t i = 0; i < routeCount; i++) {
+        errors += routes[i].assembler.continuationErrors;
+    }
+    return errors;
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <Arduino.h>
+#include "BapChannel.h"
+#include "../protocols/BapProtocol.h"
+#include "../../core/Delegate.h"
+
+/**
+ * BapChannelRouter - Routes BAP frames (0x1733xxxx) to their channels
+ *
+ * Each RX CAN ID of a registered channel gets a route with its own
+ * assembler. Concurrent devices, and the response and status streams of
+ * one device, never share pending slots or BAP groups.
+ *
+ * A route carries one sender, which keeps at most one long message in
+ * flight per BAP group, so its assembler has GROUP_COUNT slots instead of
+ * the 16 of a shared BapFrameAssembler (a start beyond that counts as a
+ * pending overflow).
+ *
+ * Lookup is O(1): an open-addressed table (HASH_SIZE entries, twice
+ * MAX_ROUTES) keyed by the RX CAN ID. The hash mixes the LSG byte with the
+ * ID suffix, so the documented IDs land in distinct buckets; a collision
+ * costs one more probe.
+ *
+ * Usage:
+ *   router.addChannel(&batteryControlChannel);   // at construction/setup
+ *   router.processFrame(canId, data, dlc);       // CAN task, per BAP frame
+ *
+ * Message observers see every complete message before its channel does, in
+ * the order they were added (BapDiscovery captures BAP-Config and function
+ * lists, BapClient matches responses to requests, BapPropertyCache stores
+ * values).
+ *
+ * Thread Safety:
+ * - addChannel() before CAN frames are routed
+ * - processFrame() from the CAN decode task with the VehicleManager mutex held
+ * - Statistics reads from the main loop (counters are volatile)
+ */
+class BapChannelRouter {
+public:
+    static constexpr uint8_t MAX_ROUTES = 8;
+    static constexpr uint8_t HASH_SIZE = 16;
+    static constexpr uint8_t NO_ROUTE = 0xFF;
+    static constexpr uint8_t MAX_OBSERVERS = 3;
+
+    using Assembler = BapProtocol::BasicBapFrameAssembler<BapProtocol::BapFrameAssembler::GROUP_COUNT>;
+
+    /**
+     * One RX CAN ID with its assembler and counters.
+     */
+    struct Route {
+        uint32_t canId = 0;
+        BapChannel* channel = nullptr;
+        Assembler assembler;
+        volatile uint32_t frames = 0;       // Frames received on this ID
+        volatile uint32_t messages = 0;     // Complete messages delivered
+        volatile uint32_t ignored = 0;      // Messages the channel did not handle
+    };
+
+    using MessageObserver = Delegate<void(uint32_t, const BapProtocol::BapMessageView&)>;
+
+    BapChannelRouter();
+
+    /**
+     * Add an observer for complete messages on any route (CAN task; the view
+     * is only valid during the call). Add before CAN frames are routed.
+     * @return false if MAX_OBSERVERS are registered
+     */
+    bool addMessageObserver(const MessageObserver& observer) { return messageObservers.add(observer); }
+
+    /**
+     * Register a channel for all of its RX CAN IDs.
+     * @return false if the route table is full or an ID is already routed
+     */
+    bool addChannel(BapChannel* channel);
+
+    /**
+     * Assemble a BAP frame and deliver complete messages to its channel.
+     * @return true if the CAN ID has a route
+     */
+    bool processFrame(uint32_t canId, const uint8_t* data, uint8_t dlc);
+
+    /**
+     * Channel registered for an RX CAN ID, or nullptr.
+     */
+    BapChannel* channelFor(uint32_t canId) const {
+        uint8_t route = findRoute(canId);
+        return route == NO_ROUTE ? nullptr : routes[route].channel;
+    }
+
+    // Route access (statistics)
+    uint8_t getRouteCount() const { return routeCount; }
+    const Route& getRoute(uint8_t index) const { return routes[index]; }
+
+    /**
+     * BAP frames on IDs without a route (other ASGs' requests, unknown LSGs).
+     */
+    uint32_t getUnroutedFrames() const { return unroutedFrames; }
+
+    /**
+     * Continuation errors of all routes.
+     */
+    uint32_t getContinuationErrors() const;
+
+    /**
+     * Static RAM of the routes (assemblers included).
+     */
+    static constexpr size_t footprintBytes() { return sizeof(Route) * MAX_ROUTES; }
+
+private:
+    Route routes[MAX_ROUTES];
+    uint8_t routeCount = 0;
+    uint8_t table[HASH_SIZE];           // Route index per bucket, or NO_ROUTE
+    volatile uint32_t unroutedFrames = 0;
+    DelegateList<void(uint32_t, const BapProtocol::BapMessageView&), MAX_OBSERVERS> messageObservers;
+
+    static uint8_t hashOf(uint32_t canId) {
+        // 0x1733LLSS: LSG byte xor suffix byte
+        return (uint8_t)((canId ^ (canId >> 8)) & (HASH_SIZE - 1));
+    }
+
+    uint8_t findRoute(uint32_t canId) const {
+        uint8_t bucket = hashOf(canId);
+        for (uint8_t probe = 0; probe < HASH_SIZE; probe++) {
+            uint8_t route = table[bucket];
+            if (route == NO_ROUTE || routes[route].canId == canId) {
+                return route;
+            }
+            bucket = (bucket + 1) & (HASH_SIZE - 1);
+        }
+        return NO_ROUTE;
+    }
+
+    static_assert((HASH_SIZE & (HASH_SIZE - 1)) == 0, "HASH_SIZE must be a power of two");
+    static_assert(HASH_SIZE > MAX_ROUTES, "table needs free buckets to end probes");
+};
@@ -0,0 +1,290 @@
+#include "BapClient.h"
+#include "../VehicleManager.h"
+
+using namespace BapProtocol;
+
+BapClient::BapClient(VehicleManager* mgr)
+    : manager(mgr)
+{
+}
+
+// =============================================================================
+// Requests (main loop)
+// =============================================================================
+
+uint16_t BapClient::request(uint32_t txCanId, uint8_t opcode, uint8_t deviceId, uint8_t functionId,
+                            const uint8_t* payload, uint8_t payloadLen,
+                            ResponseCallback callback, const Options& options) {
+    if (payloadLen > MAX_PAYLOAD_SIZE || options.maxAttempts == 0) {
+        return NO_REQUEST;
+    }
+
+    // One outstanding request per function: the answer carries no request ID
+    uint8_t slot = MAX_OUTSTANDING;
+    for (uint8_t i = 0; i < MAX_OUTSTANDING; i++) {
+        const Request& r = requests[i];
+        if (r.state == SlotState::FREE) {
+            slot = slot == MAX_OUTSTANDING ? i : slot;
+        } else if (r.deviceId == deviceId && r.functionId == functionId) {
+            Serial.printf("[BapClient] Rejected 0x%02X/0x%02X: request %u outstanding\r\n",
+                          deviceId, functionId, r.handle);
+            return NO_REQUEST;
+        }
+    }
+    if (slot == MAX_OUTSTANDING) {
+        Serial.printf("[BapClient] Rejected 0x%02X/0x%02X: %u requests outstanding\r\n",
+                      deviceId, functionId, MAX_OUTSTANDING);
+        return NO_REQUEST;
+    }
+
+    Request& r = requests[slot];
+    r.handle = nextHandle++;
+    if (nextHandle == NO_REQUEST) {
+        nextHandle = 1;
+    }
+    r.txCanId = txCanId;
+    r.opcode = opcode;
+    r.deviceId = deviceId;
+    r.functionId = functionId;
+    r.payloadLen = payloadLen;
+    if (payloadLen > 0) {
+        memcpy(r.payload, payload, payloadLen);
+    }
+    r.attempts = 0;
+    r.options = options;
+    r.attemptTimeoutMs = options.attemptTimeoutMs;
+    r.callback = std::move(callback);
+    r.responseOpcode = 0;
+    r.errorCode = 0;
+    r.heartbeatMs = 0;
+    r.firstSendMs = millis();
+
+    // Pushed value fresh enough: complete from loop() without touching the bus
+    if (opcode == OpCode::GET &&
+        manager->bapProperties().isFresh(deviceId, functionId, options.maxAgeMs)) {
+        r.responseOpcode = OpCode::STATUS;
+        r.responseMs = r.firstSendMs;
+        r.lastSendMs = r.firstSendMs;
+        r.state = SlotState::RESPONDED;
+        return r.handle;
+    }
+
+    // Visible to onMessage() before the request can be answered, and only
+    // after the fields it matches on
+    __sync_synchronize();
+    r.state = SlotState::WAITING;
+    if (!send(slot)) {
+        r.state = SlotState::FREE;
+        r.handle = NO_REQUEST;
+        r.callback = nullptr;
+        return NO_REQUEST;
+    }
+
+    FunctionStats* stats = statsFor(deviceId, functionId);
+    if (stats) {
+        stats->requests++;
+    }
+    return r.handle;
+}
+
+bool BapClient::cancel(uint16_t handle) {
+    for (uint8_t i = 0; i < MAX_OUTSTANDING; i++) {
+        if (handle != NO_REQUEST && requests[i].handle == handle && requests[i].state != SlotState::FREE) {
+            finish(i, Result::CANCELLED, millis());
+            return true;
+        }
+    }
+    return false;
+}
+
+bool BapClient::isPending(uint16_t handle) const {
+    for (uint8_t i = 0; i < MAX_OUTSTANDING; i++) {
+        if (handle != NO_REQUEST && requests[i].handle == handle && requests[i].state != SlotState::FREE) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint8_t BapClient::getOutstandingCount() const {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < MAX_OUTSTANDING; i++) {
+        count += requests[i].state != SlotState::FREE ? 1 : 0;
+    }
+    return count;
+}
+
+bool BapClient::send(uint8_t slot) {
+    Request& r = requests[slot];
+    r.attempts++;
+    r.txFailed = false;
+    r.lastSendMs = millis();
+
+    // TX completions run on the main loop; a late one for a reused slot is ignored
+    uint16_t handle = r.handle;
+    uint8_t frames = manager->sendBapMessage(r.txCanId, r.opcode, r.deviceId, r.functionId,
+                                             r.payload, r.payloadLen,
+                                             [this, slot, handle](CanTxResult result) {
+        if (result != CanTxResult::SENT && requests[slot].handle == handle) {
+            requests[slot].txFailed = true;
+        }
+    });
+    if (frames == 0) {
+        r.txFailed = true;
+        return false;
+    }
+    return true;
+}
+
+// =============================================================================
+// Retries, timeouts and callbacks (main loop)
+// =============================================================================
+
+void BapClient::loop() {
+    uint32_t now = millis();
+
+    for (uint8_t i = 0; i < MAX_OUTSTANDING; i++) {
+        Request& r = requests[i];
+
+        if (r.state == SlotState::RESPONDED) {
+            __sync_synchronize();
+            finish(i, r.responseOpcode == OpCode::ERROR ? Result::ERROR : Result::OK, now);
+            continue;
+        }
+        if (r.state != SlotState::WAITING) {
+            continue;
+        }
+
+        Result failure = r.txFailed ? Result::TX_FAILED : Result::TIMEOUT;
+        if (now - r.firstSendMs >= r.options.deadlineMs) {
+            finish(i, failure, now);
+            continue;
+        }
+
+        // A HeartbeatStatus for the function means the FSG is still working on it
+        uint32_t lastSign = r.lastSendMs;
+        if (r.heartbeatMs != 0 && (int32_t)(r.heartbeatMs - lastSign) > 0) {
+            lastSign = r.heartbeatMs;
+        }
+        if (!r.txFailed && now - lastSign < r.attemptTimeoutMs) {
+            continue;
+        }
+
+        if (r.attempts >= r.options.maxAttempts) {
+            finish(i, failure, now);
+            continue;
+        }
+
+        // Retry with backoff
+        r.attemptTimeoutMs *= 2;
+        FunctionStats* stats = statsFor(r.deviceId, r.functionId);
+        if (stats) {
+            stats->retries++;
+        }
+        send(i);
+    }
+}
+
+void BapClient::finish(uint8_t slot, Result result, uint32_t now) {
+    Request& r = requests[slot];
+
+    Response response;
+    response.handle = r.handle;
+    response.result = result;
+    response.deviceId = r.deviceId;
+    response.functionId = r.functionId;
+    response.attempts = r.attempts;
+    response.cached = r.attempts == 0;
+    response.totalMs = now - r.firstSendMs;
+    if (result == Result::OK || result == Result::ERROR) {
+        response.opcode = r.responseOpcode;
+        response.errorCode = r.errorCode;
+        response.latencyMs = r.responseMs - r.lastSendMs;
+    }
+
+    // Cache answers are counted by BapPropertyCache, not as round-trips
+    FunctionStats* stats = response.cached ? nullptr : statsFor(r.deviceId, r.functionId);
+    if (stats) {
+        switch (result) {
+            case Result::OK:
+                stats->ok++;
+                stats->lastMs = response.latencyMs;
+                stats->sumMs += response.latencyMs;
+                if (response.latencyMs > stats->maxMs) {
+                    stats->maxMs = response.latencyMs;
+                }
+                break;
+            case Result::ERROR:
+                stats->errors++;
+                break;
+            case Result::TIMEOUT:
+            case Result::TX_FAILED:
+                stats->timeouts++;
+                break;
+            case Result::CANCELLED:
+                break;
+        }
+    }
+
+    // Free the slot first, so the callback may issue the next request
+    ResponseCallback callback = std::move(r.callback);
+    r.callback = nullptr;
+    r.handle = NO_REQUEST;
+    r.state = SlotState::FREE;
+
+    if (callback) {
+        callback(response);
+    }
+}
+
+BapClient::FunctionStats* BapClient::statsFor(uint8_t deviceId, uint8_t functionId) {
+    for (uint8_t i = 0; i < functionStatsCount; i++) {
+        if (functionStats[i].deviceId == deviceId && functionStats[i].functionId == functionId) {
+            return &functionStats[i];
+        }
+    }
+    if (functionStatsCount == MAX_FUNCTION_STATS) {
+        return nullptr;
+    }
+    FunctionStats& stats = functionStats[functionStatsCount++];
+    stats.deviceId = deviceId;
+    stats.functionId = functionId;
+    return &stats;
+}
+
+// =============================================================================
+// Response matching (CAN task)
+// =============================================================================
+
+void BapClient::onMessage(uint32_t rxCanId, const BapMessageView& msg) {
+    (void)rxCanId;
+
+    // RESET answers a BAP-Config GET
+    bool answer = msg.opcode == OpCode::STATUS || msg.opcode == OpCode::ACK || msg.opcode == OpCode::ERROR ||
+                  msg.opcode == OpCode::RESET;
+    if (!answer && msg.opcode != OpCode::HEARTBEAT) {
+        return;
+    }
+
+    for (uint8_t i = 0; i < MAX_OUTSTANDING; i++) {
+        Request& r = requests[i];
+        if (r.state != SlotState::WAITING) {
+            continue;
+        }
+        __sync_synchronize();
+        if (r.deviceId != msg.deviceId || r.functionId != msg.functionId) {
+            continue;
+        }
+
+        if (!answer) {
+            r.heartbeatMs = millis();
+            return;
+        }
+        r.responseOpcode = msg.opcode;
+        r.errorCode = (msg.opcode == OpCode::ERROR && msg.payloadLen > 0) ? msg.payload[0] : 0;
+        r.responseMs = millis();
+        __sync_synchronize();
+        r.state = SlotState::RESPONDED;
+        return;
+    }
+}
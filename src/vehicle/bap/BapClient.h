@@ -0,0 +1,193 @@
+#pragma once
+
+#include <Arduino.h>
+#include <functional>
+#include "../protocols/BapProtocol.h"
+#include "../../modules/CanTxScheduler.h"
+
+// Forward declaration
+class VehicleManager;
+
+/**
+ * BapClient - Asynchronous BAP requests with response correlation
+ *
+ * Issues GET/SET_GET requests and matches the FSG's answer by device and
+ * function ID: STATUS, ACK or RESET (the BAP-Config answer) completes a
+ * request, ERROR fails it, and a HeartbeatStatus for the function counts
+ * as "still working" (it restarts the attempt timer without completing).
+ * BAP has no transaction IDs, so only one request per device/function may
+ * be outstanding; requests to different functions are pipelined, all on
+ * the bus at once.
+ *
+ * An attempt that gets no answer within its timeout is sent again, with
+ * the timeout doubled each time, until maxAttempts or the deadline. The
+ * outcome goes to the request's callback, from loop() on the main loop.
+ * Round-trip latency (last send to answer) is recorded per function.
+ *
+ * A GET with Options::maxAgeMs set is answered from the BapPropertyCache
+ * when the pushed value is fresh enough: nothing is sent, and the callback
+ * still runs from loop() with Response::cached set.
+ *
+ * Usage:
+ *   uint16_t handle = client.get(0x17332501, 0x25, 0x10,
+ *       [](const BapClient::Response& r) { ... });
+ *   if (handle == BapClient::NO_REQUEST) { ...rejected... }
+ *
+ * Thread Safety:
+ * - get()/setGet()/request()/cancel()/loop() from the main loop only
+ * - onMessage() from the CAN decode task (BapChannelRouter observer). It only
+ *   moves a WAITING request to RESPONDED; loop() owns every other transition.
+ */
+class BapClient {
+public:
+    static constexpr uint8_t MAX_OUTSTANDING = 8;
+    static constexpr uint8_t MAX_FUNCTION_STATS = 16;
+    static constexpr uint8_t MAX_PAYLOAD_SIZE = 127;       // Longest BAP message payload
+    static constexpr uint16_t NO_REQUEST = 0;
+
+    enum class Result : uint8_t {
+        OK,                 // STATUS/ACK received
+        ERROR,              // ERROR received (errorCode holds payload byte 0)
+        TIMEOUT,            // No answer after all attempts or at the deadline
+        TX_FAILED,          // Last attempt could not be sent
+        CANCELLED
+    };
+
+    struct Options {
+        uint16_t attemptTimeoutMs;          // First attempt; doubled per retry
+        uint8_t maxAttempts;
+        uint16_t deadlineMs;                // From the first send
+        uint32_t maxAgeMs;                  // GET only: accept a cached value this old (0 = always send)
+
+        // Constructor, not member initializers: Options() is a default argument below
+        Options() : attemptTimeoutMs(1000), maxAttempts(3), deadlineMs(5000), maxAgeMs(0) {}
+    };
+
+    struct Response {
+        uint16_t handle = NO_REQUEST;
+        Result result = Result::TIMEOUT;
+        uint8_t deviceId = 0;
+        uint8_t functionId = 0;
+        uint8_t opcode = 0;                 // Response opcode (0 if none)
+        uint8_t errorCode = 0;
+        uint8_t attempts = 0;               // 0 if answered from the cache
+        bool cached = false;                // Value already in BapPropertyCache, nothing sent
+        uint32_t latencyMs = 0;             // Last send to answer
+        uint32_t totalMs = 0;               // First send to completion
+    };
+
+    using ResponseCallback = std::function<void(const Response&)>;
+
+    /**
+     * Round-trip statistics of one device/function.
+     */
+    struct FunctionStats {
+        uint8_t deviceId = 0;
+        uint8_t functionId = 0;
+        uint32_t requests = 0;
+        uint32_t ok = 0;
+        uint32_t errors = 0;
+        uint32_t timeouts = 0;
+        uint32_t retries = 0;
+        uint32_t lastMs = 0;
+        uint32_t maxMs = 0;
+        uint32_t sumMs = 0;                 // Over ok responses
+
+        uint32_t avgMs() const { return ok ? sumMs / ok : 0; }
+    };
+
+    explicit BapClient(VehicleManager* mgr);
+
+    /**
+     * Send a GET and wait for the STATUS.
+     * @return Request handle, or NO_REQUEST if rejected (function already
+     *         outstanding, table full, CAN not running)
+     */
+    uint16_t get(uint32_t txCanId, uint8_t deviceId, uint8_t functionId,
+                 ResponseCallback callback = nullptr, const Options& options = Options()) {
+        return request(txCanId, BapProtocol::OpCode::GET, deviceId, functionId, nullptr, 0,
+                       std::move(callback), options);
+    }
+
+    /**
+     * Send a SET_GET and wait for the STATUS.
+     */
+    uint16_t setGet(uint32_t txCanId, uint8_t deviceId, uint8_t functionId,
+                    const uint8_t* payload, uint8_t payloadLen,
+                    ResponseCallback callback = nullptr, const Options& options = Options()) {
+        return request(txCanId, BapProtocol::OpCode::SET_GET, deviceId, functionId, payload, payloadLen,
+                       std::move(callback), options);
+    }
+
+    uint16_t request(uint32_t txCanId, uint8_t opcode, uint8_t deviceId, uint8_t functionId,
+                     const uint8_t* payload, uint8_t payloadLen,
+                     ResponseCallback callback, const Options& options);
+
+    /**
+     * Drop a request; its callback gets CANCELLED.
+     */
+    bool cancel(uint16_t handle);
+
+    /**
+     * Check if a request is still waiting for its answer.
+     */
+    bool isPending(uint16_t handle) const;
+
+    /**
+     * Retries, timeouts and callbacks. Call from VehicleManager::loop().
+     */
+    void loop();
+
+    /**
+     * Complete BAP message from any route (CAN task, BapChannelRouter observer).
+     */
+    void onMessage(uint32_t rxCanId, const BapProtocol::BapMessageView& msg);
+
+    // Statistics
+    uint8_t getOutstandingCount() const;
+    uint8_t getFunctionStatsCount() const { return functionStatsCount; }
+    const FunctionStats& getFunctionStats(uint8_t index) const { return functionStats[index]; }
+
+private:
+    enum class SlotState : uint8_t {
+        FREE,
+        WAITING,            // Sent, waiting for the answer
+        RESPONDED           // Answer stored by onMessage(), callback pending
+    };
+
+    struct Request {
+        volatile SlotState state = SlotState::FREE;
+        uint16_t handle = NO_REQUEST;
+        uint32_t txCanId = 0;
+        uint8_t opcode = 0;
+        uint8_t deviceId = 0;
+        uint8_t functionId = 0;
+        uint8_t payloadLen = 0;
+        uint8_t attempts = 0;
+        bool txFailed = false;              // Set by the TX completion (main loop)
+        Options options;
+        uint32_t firstSendMs = 0;
+        uint32_t lastSendMs = 0;
+        uint32_t attemptTimeoutMs = 0;
+        ResponseCallback callback;
+
+        // Written by onMessage() before state becomes RESPONDED
+        volatile uint8_t responseOpcode = 0;
+        volatile uint8_t errorCode = 0;
+        volatile uint32_t responseMs = 0;
+        volatile uint32_t heartbeatMs = 0;  // Latest HeartbeatStatus for the function
+
+        uint8_t payload[MAX_PAYLOAD_SIZE];  // Kept for retries
+    };
+
+    VehicleManager* manager;
+    Request requests[MAX_OUTSTANDING];
+    uint16_t nextHandle = 1;
+
+    FunctionStats functionStats[MAX_FUNCTION_STATS];
+    uint8_t functionStatsCount = 0;
+
+    bool send(uint8_t slot);
+    void finish(uint8_t slot, Result result, uint32_t now);
+    FunctionStats* statsFor(uint8_t deviceId, uint8_t functionId);
+};
@@ -0,0 +1,386 @@
+#include "BapDiscovery.h"
+#include "../VehicleManager.h"
+#include <Preferences.h>
+#include <cstring>
+
+using namespace BapProtocol;
+
+/**
+ * NVS record: header followed by `count` entries. A layout change bumps the
+ * version; records of another version are ignored (full discovery).
+ */
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t count;
+    uint8_t reserved[2];
+} BapDiscoveryRecordHeader;
+
+typedef struct {
+    uint8_t deviceId;
+    uint8_t functionCount;
+    uint8_t reserved[2];
+    uint32_t fingerprint;
+    uint64_t functionMask;
+} BapDiscoveryRecordEntry;
+
+static constexpr uint32_t RECORD_MAGIC = 0x42415044;  // "BAPD"
+static constexpr uint8_t RECORD_VERSION = 1;
+static constexpr const char* NVS_NAMESPACE = "bapdisc";
+static constexpr const char* NVS_KEY = "devices";
+
+BapDiscovery::BapDiscovery(VehicleManager* mgr)
+    : manager(mgr)
+{
+}
+
+bool BapDiscovery::addDevice(uint8_t deviceId, uint32_t txCanId) {
+    if (deviceCount == MAX_DEVICES || find(deviceId)) {
+        return false;
+    }
+    Device& device = devices[deviceCount++];
+    device.deviceId = deviceId;
+    device.txCanId = txCanId;
+    return true;
+}
+
+BapDiscovery::Device* BapDiscovery::find(uint8_t deviceId) {
+    for (uint8_t i = 0; i < deviceCount; i++) {
+        if (devices[i].deviceId == deviceId) {
+            return &devices[i];
+        }
+    }
+    return nullptr;
+}
+
+const char* BapDiscovery::phaseName(Phase phase) {
+    switch (phase) {
+        case Phase::IDLE:       return "idle";
+        case Phase::CONFIG:     return "config";
+        case Phase::FUNCTIONS:  return "functions";
+        case Phase::DONE:       return "done";
+        case Phase::FAILED:     return "failed";
+    }
+    return "unknown";
+}
+
+// =============================================================================
+// Discovery (main loop)
+// =============================================================================
+
+BapClient::Options BapDiscovery::requestOptions() {
+    // Attempts of 250, 500 and 1000 ms fit in the BAP init wait this replaces
+    BapClient::Options options;
+    options.attemptTimeoutMs = 250;
+    options.maxAttempts = 3;
+    options.deadlineMs = 2000;
+    return options;
+}
+
+void BapDiscovery::start() {
+    if (started) {
+        return;
+    }
+    started = true;
+    for (uint8_t i = 0; i < deviceCount; i++) {
+        requestConfig(i);
+    }
+}
+
+void BapDiscovery::reset() {
+    started = false;
+    for (uint8_t i = 0; i < deviceCount; i++) {
+        devices[i].phase = Phase::IDLE;
+    }
+}
+
+bool BapDiscovery::isReady() const {
+    if (!started) {
+        return false;
+    }
+    for (uint8_t i = 0; i < deviceCount; i++) {
+        if (devices[i].phase != Phase::DONE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BapDiscovery::isSupported(uint8_t deviceId, uint8_t functionId) {
+    Device* device = find(deviceId);
+    if (!device || device->phase != Phase::DONE || device->stale || !listDenies(*device, functionId)) {
+        return true;
+    }
+    device->rejected++;
+    return false;
+}
+
+bool BapDiscovery::listDenies(const Device& device, uint8_t functionId) {
+    if (!device.known || functionId == FUNCTION_BAP_CONFIG || functionId == FUNCTION_LIST ||
+        functionId >= device.functionCount) {
+        return false;
+    }
+    return !(device.functionMask & (1ULL << functionId));
+}
+
+void BapDiscovery::loop() {
+    bool dropped = false;
+    for (uint8_t i = 0; i < deviceCount; i++) {
+        Device& device = devices[i];
+        if (!device.stale) {
+            continue;
+        }
+        __sync_synchronize();
+        uint8_t functionId = device.staleFunction;
+        device.stale = false;
+        if (!device.known) {
+            continue;
+        }
+        device.known = false;
+        device.invalidations++;
+        dropped = true;
+        Serial.printf("[BapDiscovery] 0x%02X: status for function 0x%02X, unsupported in the stored list - list dropped\r\n",
+                      device.deviceId, functionId);
+    }
+    if (dropped && !save()) {
+        Serial.println("[BapDiscovery] NVS write failed (stale list kept until the next discovery)");
+    }
+}
+
+void BapDiscovery::requestConfig(uint8_t index) {
+    Device& device = devices[index];
+    device.phase = Phase::CONFIG;
+    device.startMs = millis();
+    device.configLen = 0;
+
+    uint16_t handle = manager->bap().get(device.txCanId, device.deviceId, FUNCTION_BAP_CONFIG,
+        [this, index](const BapClient::Response& response) { onConfigResponse(index, response); },
+        requestOptions());
+    if (handle == BapClient::NO_REQUEST) {
+        device.phase = Phase::FAILED;
+        device.failures++;
+    }
+}
+
+void BapDiscovery::requestFunctionList(uint8_t index) {
+    Device& device = devices[index];
+    device.phase = Phase::FUNCTIONS;
+    device.listLen = 0;
+
+    uint16_t handle = manager->bap().get(device.txCanId, device.deviceId, FUNCTION_LIST,
+        [this, index](const BapClient::Response& response) { onFunctionListResponse(index, response); },
+        requestOptions());
+    if (handle == BapClient::NO_REQUEST) {
+        device.phase = Phase::FAILED;
+        device.failures++;
+    }
+}
+
+void BapDiscovery::onConfigResponse(uint8_t index, const BapClient::Response& response) {
+    Device& device = devices[index];
+    if (device.phase != Phase::CONFIG) {
+        return;  // Reset while the request was outstanding
+    }
+    if (response.result != BapClient::Result::OK) {
+        fail(index, "BAP-Config", response);
+        return;
+    }
+
+    __sync_synchronize();
+    uint32_t fingerprint = fingerprintOf(device.config, device.configLen);
+
+    if (device.known && fingerprint == device.fingerprint) {
+        device.phase = Phase::DONE;
+        device.lastMs = millis() - device.startMs;
+        device.lastFromCache = true;
+        device.hits++;
+        Serial.printf("[BapDiscovery] 0x%02X: fingerprint 0x%08lX matches, %u functions from NVS (%lums)\r\n",
+                      device.deviceId, fingerprint, __builtin_popcountll(device.functionMask), device.lastMs);
+        return;
+    }
+
+    if (device.known) {
+        device.mismatches++;
+        Serial.printf("[BapDiscovery] 0x%02X: fingerprint 0x%08lX, stored 0x%08lX - discovering again\r\n",
+                      device.deviceId, fingerprint, device.fingerprint);
+        device.known = false;
+    }
+    device.fingerprint = fingerprint;
+    requestFunctionList(index);
+}
+
+void BapDiscovery::onFunctionListResponse(uint8_t index, const BapClient::Response& response) {
+    Device& device = devices[index];
+    if (device.phase != Phase::FUNCTIONS) {
+        return;
+    }
+    if (response.result != BapClient::Result::OK) {
+        fail(index, "FunctionList", response);
+        return;
+    }
+
+    // Bit 7 of byte 0 is function 0
+    __sync_synchronize();
+    uint64_t mask = 0;
+    uint8_t len = device.listLen;
+    for (uint8_t i = 0; i < len; i++) {
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            if (device.list[i] & (0x80 >> bit)) {
+                mask |= 1ULL << (i * 8 + bit);
+            }
+        }
+    }
+
+    device.functionMask = mask;
+    device.functionCount = len * 8;
+    device.stale = false;
+    device.known = true;
+    device.phase = Phase::DONE;
+    device.lastMs = millis() - device.startMs;
+    device.lastFromCache = false;
+    device.misses++;
+    Serial.printf("[BapDiscovery] 0x%02X: %u functions (mask 0x%016llX, fingerprint 0x%08lX) discovered in %lums\r\n",
+                  device.deviceId, __builtin_popcountll(mask), (unsigned long long)mask, device.fingerprint,
+                  device.lastMs);
+
+    if (!save()) {
+        Serial.println("[BapDiscovery] NVS write failed (discovered again on the next wake)");
+    }
+}
+
+void BapDiscovery::fail(uint8_t index, const char* what, const BapClient::Response& response) {
+    Device& device = devices[index];
+    device.phase = Phase::FAILED;
+    device.failures++;
+    if (response.result == BapClient::Result::ERROR) {
+        Serial.printf("[BapDiscovery] 0x%02X: %s error 0x%02X - all functions allowed\r\n",
+                      device.deviceId, what, response.errorCode);
+    } else {
+        Serial.printf("[BapDiscovery] 0x%02X: %s not answered after %u attempts - all functions allowed\r\n",
+                      device.deviceId, what, response.attempts);
+    }
+}
+
+uint32_t BapDiscovery::fingerprintOf(const uint8_t* config, uint8_t len) {
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (uint8_t i = 0; i < len; i++) {
+        hash ^= config[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// =============================================================================
+// Answer capture (CAN task)
+// =============================================================================
+
+void BapDiscovery::onMessage(uint32_t rxCanId, const BapMessageView& msg) {
+    (void)rxCanId;
+
+    Device* device = find(msg.deviceId);
+    if (!device) {
+        return;
+    }
+
+    bool config = msg.functionId == FUNCTION_BAP_CONFIG &&
+                  (msg.opcode == OpCode::RESET || msg.opcode == OpCode::STATUS);
+    bool list = msg.functionId == FUNCTION_LIST && msg.opcode == OpCode::STATUS;
+    if (!config && !list) {
+        // The FSG reports a function its stored list says it lacks
+        if ((msg.opcode == OpCode::STATUS || msg.opcode == OpCode::HEARTBEAT) &&
+            listDenies(*device, msg.functionId)) {
+            device->staleFunction = msg.functionId;
+            __sync_synchronize();
+            device->stale = true;
+        }
+        return;
+    }
+
+    // Stored before BapClient sees the message and completes the request
+    if (config) {
+        uint8_t len = msg.payloadLen < MAX_CONFIG_SIZE ? msg.payloadLen : MAX_CONFIG_SIZE;
+        memcpy(device->config, msg.payload, len);
+        __sync_synchronize();
+        device->configLen = len;
+    } else {
+        uint8_t len = msg.payloadLen < sizeof(device->list) ? msg.payloadLen : sizeof(device->list);
+        memcpy(device->list, msg.payload, len);
+        __sync_synchronize();
+        device->listLen = len;
+    }
+}
+
+// =============================================================================
+// Persistence (NVS)
+// =============================================================================
+
+uint8_t BapDiscovery::load() {
+    Preferences prefs;
+    if (!prefs.begin(NVS_NAMESPACE, true)) {
+        return 0;
+    }
+
+    uint8_t buffer[sizeof(BapDiscoveryRecordHeader) + sizeof(BapDiscoveryRecordEntry) * MAX_DEVICES];
+    size_t length = prefs.getBytesLength(NVS_KEY);
+    if (length < sizeof(BapDiscoveryRecordHeader) || length > sizeof(buffer)) {
+        prefs.end();
+        return 0;
+    }
+    prefs.getBytes(NVS_KEY, buffer, length);
+    prefs.end();
+
+    BapDiscoveryRecordHeader header;
+    memcpy(&header, buffer, sizeof(header));
+    if (header.magic != RECORD_MAGIC || header.version != RECORD_VERSION ||
+        length != sizeof(header) + sizeof(BapDiscoveryRecordEntry) * header.count) {
+        Serial.println("[BapDiscovery] Ignoring NVS record (unknown layout)");
+        return 0;
+    }
+
+    uint8_t loaded = 0;
+    for (uint8_t i = 0; i < header.count; i++) {
+        BapDiscoveryRecordEntry entry;
+        memcpy(&entry, buffer + sizeof(header) + sizeof(entry) * i, sizeof(entry));
+        Device* device = find(entry.deviceId);
+        if (!device || entry.functionCount > MAX_FUNCTIONS) {
+            continue;
+        }
+        device->known = true;
+        device->fingerprint = entry.fingerprint;
+        device->functionCount = entry.functionCount;
+        device->functionMask = entry.functionMask;
+        loaded++;
+    }
+    return loaded;
+}
+
+bool BapDiscovery::save() const {
+    uint8_t buffer[sizeof(BapDiscoveryRecordHeader) + sizeof(BapDiscoveryRecordEntry) * MAX_DEVICES];
+    BapDiscoveryRecordHeader header = {};
+    header.magic = RECORD_MAGIC;
+    header.version = RECORD_VERSION;
+    for (uint8_t i = 0; i < deviceCount; i++) {
+        const Device& device = devices[i];
+        if (!device.known) {
+            continue;
+        }
+        BapDiscoveryRecordEntry entry = {};
+        entry.deviceId = device.deviceId;
+        entry.functionCount = device.functionCount;
+        entry.fingerprint = device.fingerprint;
+        entry.functionMask = device.functionMask;
+        memcpy(buffer + sizeof(header) + sizeof(entry) * header.count, &entry, sizeof(entry));
+        header.count++;
+    }
+    memcpy(buffer, &header, sizeof(header));
+
+    Preferences prefs;
+    if (!prefs.begin(NVS_NAMESPACE, false)) {
+        return false;
+    }
+    size_t length = sizeof(header) + sizeof(BapDiscoveryRecordEntry) * header.count;
+    bool ok = prefs.putBytes(NVS_KEY, buffer, length) == length;
+    prefs.end();
+    return ok;
+}
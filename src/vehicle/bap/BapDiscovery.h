@@ -0,0 +1,180 @@
+#pragma once
+
+#include <Arduino.h>
+#include "BapClient.h"
+#include "../protocols/BapProtocol.h"
+
+// Forward declaration
+class VehicleManager;
+
+/**
+ * BapDiscovery - Function list and BAP-Config of each FSG, cached in NVS
+ *
+ * After a requested wake (WAKING; a vehicle that wakes on its own is not
+ * queried) each registered device is asked for its BAP-Config (0x02,
+ * protocol version and capabilities; answered with RESET or STATUS) and its
+ * FunctionList (0x03, one bit per supported function, bit 7 of byte 0 is
+ * function 0). The BAP-Config answer is hashed (FNV-1a) into the device's
+ * fingerprint: it changes with the FSG and its software, so it identifies
+ * the vehicle the stored function list belongs to.
+ *
+ * The result is persisted to NVS. On later wakes only the BAP-Config is
+ * read: a matching fingerprint is a cache hit and the FunctionList GET is
+ * skipped; a different one discards the stored list and discovers again.
+ * The first answer also shows the FSG is talking BAP, so the wake ends as
+ * soon as every device is done (WakeController::setBapReady) instead of
+ * after the fixed BAP init wait.
+ *
+ * Once a device is done, isSupported() lets VehicleManager::sendBapMessage
+ * reject requests for functions the FSG does not list, instead of letting
+ * them time out on the bus. Unknown devices, functions beyond the list and
+ * devices not yet discovered on this wake are always allowed.
+ *
+ * A STATUS or HeartbeatStatus for a function the list marks unsupported
+ * means the list is stale (e.g. an FSG update that kept its BAP-Config):
+ * loop() drops it from RAM and NVS, so nothing is rejected and the next
+ * wake discovers the device again.
+ *
+ * Usage:
+ *   discovery.addDevice(0x25, 0x17332501);       // at construction
+ *   discovery.load();                            // setup
+ *   discovery.start();                           // bus up while WAKING
+ *   discovery.loop();                            // every main loop
+ *   if (discovery.isReady()) { ...wake done... }
+ *   discovery.reset();                           // vehicle asleep
+ *
+ * Thread Safety:
+ * - addDevice() before CAN frames are routed
+ * - onMessage() from the CAN decode task (BapChannelRouter observer, ahead of
+ *   BapClient so the answer is stored before the request completes)
+ * - Everything else from the main loop
+ */
+class BapDiscovery {
+public:
+    static constexpr uint8_t MAX_DEVICES = 4;
+    static constexpr uint8_t MAX_CONFIG_SIZE = 8;
+    static constexpr uint8_t MAX_FUNCTIONS = 64;             // Function IDs are 6 bits
+
+    // Standard functions, same ID on every device (BAP_PROTOCOL.md)
+    static constexpr uint8_t FUNCTION_BAP_CONFIG = 0x02;
+    static constexpr uint8_t FUNCTION_LIST = 0x03;
+
+    enum class Phase : uint8_t {
+        IDLE,               // Not started on this wake
+        CONFIG,             // BAP-Config GET outstanding
+        FUNCTIONS,          // FunctionList GET outstanding
+        DONE,               // Function list valid for this wake
+        FAILED              // No answer; all functions allowed
+    };
+
+    /**
+     * Discovery state of one device (snapshot for statistics).
+     */
+    struct Device {
+        uint8_t deviceId = 0;
+        uint32_t txCanId = 0;
+        Phase phase = Phase::IDLE;
+
+        // Stored (NVS) or discovered function list
+        bool known = false;
+        uint32_t fingerprint = 0;
+        uint8_t functionCount = 0;          // Functions covered by the list
+        uint64_t functionMask = 0;          // Bit n: function n supported
+
+        uint32_t startMs = 0;
+        uint32_t lastMs = 0;                // Duration of the last discovery
+        bool lastFromCache = false;
+
+        uint32_t hits = 0;                  // Fingerprint matched, list from NVS
+        uint32_t misses = 0;                // Full discoveries
+        uint32_t mismatches = 0;            // Stored list for another fingerprint
+        uint32_t failures = 0;
+        uint32_t rejected = 0;              // Requests for unsupported functions
+        uint32_t invalidations = 0;         // Lists dropped after a status for an unlisted function
+
+        // Written by onMessage() before BapClient completes the request
+        volatile uint8_t configLen = 0;
+        volatile uint8_t listLen = 0;
+
+        // Written by onMessage(), handled by loop()
+        volatile bool stale = false;
+        volatile uint8_t staleFunction = 0;
+        uint8_t config[MAX_CONFIG_SIZE];
+        uint8_t list[MAX_FUNCTIONS / 8];
+    };
+
+    explicit BapDiscovery(VehicleManager* mgr);
+
+    /**
+     * Register a device for discovery.
+     * @return false if the table is full
+     */
+    bool addDevice(uint8_t deviceId, uint32_t txCanId);
+
+    /**
+     * Load stored function lists from NVS.
+     * @return Number of devices with a stored list
+     */
+    uint8_t load();
+
+    /**
+     * Persist the known function lists to NVS.
+     */
+    bool save() const;
+
+    /**
+     * Start discovery of all devices (no-op if already started on this wake).
+     */
+    void start();
+
+    /**
+     * Forget this wake's results; the next start() discovers again.
+     */
+    void reset();
+
+    /**
+     * Drop function lists onMessage() found stale (main loop; writes NVS).
+     */
+    void loop();
+
+    bool isStarted() const { return started; }
+
+    /**
+     * Check if every device finished discovery successfully on this wake.
+     */
+    bool isReady() const;
+
+    /**
+     * Check if a request may be sent; counts a rejection.
+     * @return false only if the device's list says the function is unsupported
+     */
+    bool isSupported(uint8_t deviceId, uint8_t functionId);
+
+    /**
+     * Complete BAP message from any route (CAN task, BapChannelRouter observer).
+     */
+    void onMessage(uint32_t rxCanId, const BapProtocol::BapMessageView& msg);
+
+    // Statistics
+    uint8_t getDeviceCount() const { return deviceCount; }
+    const Device& getDevice(uint8_t index) const { return devices[index]; }
+
+    static const char* phaseName(Phase phase);
+
+private:
+    VehicleManager* manager;
+    Device devices[MAX_DEVICES];
+    uint8_t deviceCount = 0;
+    bool started = false;
+
+    Device* find(uint8_t deviceId);
+    static bool listDenies(const Device& device, uint8_t functionId);
+    void requestConfig(uint8_t index);
+    void requestFunctionList(uint8_t index);
+    void onConfigResponse(uint8_t index, const BapClient::Response& response);
+    void onFunctionListResponse(uint8_t index, const BapClient::Response& response);
+    void fail(uint8_t index, const char* what, const BapClient::Response& response);
+
+    static uint32_t fingerprintOf(const uint8_t* config, uint8_t len);
+    static BapClient::Options requestOptions();
+};
@@ -0,0 +1,136 @@
+#include "BapPropertyCache.h"
+
+using namespace BapProtocol;
+
+bool BapPropertyCache::addProperty(uint8_t deviceId, uint8_t functionId) {
+    if (find(deviceId, functionId)) {
+        return true;
+    }
+    if (propertyCount >= MAX_PROPERTIES) {
+        return false;
+    }
+    Property& property = properties[propertyCount++];
+    property.deviceId = deviceId;
+    property.functionId = functionId;
+    return true;
+}
+
+BapPropertyCache::Property* BapPropertyCache::find(uint8_t deviceId, uint8_t functionId) {
+    for (uint8_t i = 0; i < propertyCount; i++) {
+        if (properties[i].deviceId == deviceId && properties[i].functionId == functionId) {
+            return &properties[i];
+        }
+    }
+    return nullptr;
+}
+
+const BapPropertyCache::Property* BapPropertyCache::find(uint8_t deviceId, uint8_t functionId) const {
+    return const_cast<BapPropertyCache*>(this)->find(deviceId, functionId);
+}
+
+// =============================================================================
+// Lookups (main loop)
+// =============================================================================
+
+bool BapPropertyCache::isFresh(uint8_t deviceId, uint8_t functionId, uint32_t maxAgeMs) {
+    if (maxAgeMs == 0) {
+        return false;
+    }
+
+    Property* property = find(deviceId, functionId);
+    bool fresh = false;
+    if (property && property->valid) {
+        uint32_t limit = maxAgeMs;
+        uint32_t period = property->heartbeatPeriodMs;
+        if (period != 0 && period + period / 2 < limit) {
+            limit = period + period / 2;
+        }
+        fresh = millis() - property->arrivalMs <= limit;
+    }
+
+    if (fresh) {
+        hits++;
+        property->hits++;
+    } else {
+        misses++;
+        if (property) {
+            property->misses++;
+        }
+    }
+    return fresh;
+}
+
+int BapPropertyCache::read(uint8_t deviceId, uint8_t functionId, uint8_t* dest, uint8_t maxLen,
+                           uint32_t* ageMs) const {
+    const Property* property = find(deviceId, functionId);
+    if (!property) {
+        return -1;
+    }
+
+    // Retry if onMessage() rewrote the entry while we copied it
+    uint32_t sequence;
+    uint8_t len;
+    uint32_t arrivalMs;
+    do {
+        sequence = property->sequence;
+        __sync_synchronize();
+        if (!property->valid) {
+            return -1;
+        }
+        len = property->payloadLen < maxLen ? property->payloadLen : maxLen;
+        memcpy(dest, property->payload, len);
+        arrivalMs = property->arrivalMs;
+        __sync_synchronize();
+    } while ((sequence & 1) || sequence != property->sequence);
+
+    if (ageMs) {
+        *ageMs = millis() - arrivalMs;
+    }
+    return len;
+}
+
+void BapPropertyCache::clear() {
+    for (uint8_t i = 0; i < propertyCount; i++) {
+        // The learned period stays: it belongs to the FSG, not to the value
+        properties[i].valid = false;
+        properties[i].lastHeartbeatMs = 0;
+    }
+}
+
+// =============================================================================
+// Updates (CAN task)
+// =============================================================================
+
+void BapPropertyCache::onMessage(uint32_t rxCanId, const BapMessageView& msg) {
+    (void)rxCanId;
+
+    if (msg.opcode != OpCode::STATUS && msg.opcode != OpCode::HEARTBEAT) {
+        return;
+    }
+    Property* property = find(msg.deviceId, msg.functionId);
+    if (!property) {
+        return;
+    }
+
+    uint32_t now = millis();
+    if (msg.opcode == OpCode::HEARTBEAT) {
+        uint32_t interval = now - property->lastHeartbeatMs;
+        if (property->lastHeartbeatMs != 0 && interval > 0 && interval <= MAX_HEARTBEAT_PERIOD_MS) {
+            uint32_t period = property->heartbeatPeriodMs;
+            property->heartbeatPeriodMs = period ? (period * 3 + interval) / 4 : interval;
+        }
+        property->lastHeartbeatMs = now;
+    }
+
+    uint8_t len = msg.payloadLen < MAX_PAYLOAD_SIZE ? msg.payloadLen : MAX_PAYLOAD_SIZE;
+    property->sequence++;
+    __sync_synchronize();
+    memcpy(property->payload, msg.payload, len);
+    property->payloadLen = len;
+    property->opcode = msg.opcode;
+    property->arrivalMs = now;
+    property->valid = true;
+    __sync_synchronize();
+    property->sequence++;
+    property->updates++;
+}
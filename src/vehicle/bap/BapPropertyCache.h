@@ -0,0 +1,101 @@
+#pragma once
+
+#include <Arduino.h>
+#include "../protocols/BapProtocol.h"
+
+/**
+ * BapPropertyCache - Last value of selected BAP properties, with freshness
+ *
+ * The FSG pushes STATUS on change and HeartbeatStatus periodically for
+ * the functions it streams (Battery Control: plug, charge, climate). For
+ * each registered device/function the cache keeps the latest payload, its
+ * opcode and arrival time, and learns the heartbeat period from the
+ * intervals between HeartbeatStatus messages.
+ *
+ * isFresh() tells a caller whether a GET would only fetch what the car
+ * already sent: the value is fresh if it is at most maxAgeMs old and, once
+ * a heartbeat period is known, not older than period + period/2 (a missed
+ * heartbeat means the stream stopped, so the value is re-read).
+ *
+ * Usage:
+ *   cache.addProperty(0x25, Function::PLUG_STATE);              // at construction
+ *   if (!cache.isFresh(0x25, Function::PLUG_STATE)) { ...GET... }
+ *
+ * Thread Safety:
+ * - addProperty() before CAN frames are routed
+ * - onMessage() from the CAN decode task (BapChannelRouter observer)
+ * - isFresh()/read()/getters/clear() from the main loop. read() retries
+ *   while onMessage() is rewriting the entry (per-entry sequence count).
+ */
+class BapPropertyCache {
+public:
+    static constexpr uint8_t MAX_PROPERTIES = 8;
+    static constexpr uint8_t MAX_PAYLOAD_SIZE = BapProtocol::BapFrameAssembler::MAX_PAYLOAD_SIZE;
+    static constexpr uint32_t DEFAULT_MAX_AGE_MS = 30000;          // Without a learned heartbeat
+    static constexpr uint32_t MAX_HEARTBEAT_PERIOD_MS = 60000;     // Longer gaps are not heartbeats
+
+    /**
+     * Cached state of one device/function (snapshot for statistics).
+     */
+    struct Property {
+        uint8_t deviceId = 0;
+        uint8_t functionId = 0;
+        volatile bool valid = false;
+        volatile uint8_t opcode = 0;                // STATUS or HEARTBEAT
+        volatile uint8_t payloadLen = 0;
+        volatile uint32_t arrivalMs = 0;
+        volatile uint32_t lastHeartbeatMs = 0;
+        volatile uint32_t heartbeatPeriodMs = 0;    // Smoothed; 0 until two heartbeats
+        volatile uint32_t updates = 0;
+        volatile uint32_t sequence = 0;             // Odd while onMessage() writes
+        uint32_t hits = 0;
+        uint32_t misses = 0;
+        uint8_t payload[MAX_PAYLOAD_SIZE];
+    };
+
+    /**
+     * Register a device/function for caching.
+     * @return false if the table is full
+     */
+    bool addProperty(uint8_t deviceId, uint8_t functionId);
+
+    /**
+     * Check if the cached value can stand in for a GET; counts a hit or miss.
+     * @param maxAgeMs Caller's limit (0 = always re-read, not counted)
+     */
+    bool isFresh(uint8_t deviceId, uint8_t functionId, uint32_t maxAgeMs = DEFAULT_MAX_AGE_MS);
+
+    /**
+     * Copy the cached payload.
+     * @param ageMs Age of the value (optional)
+     * @return Payload length, or -1 if nothing is cached
+     */
+    int read(uint8_t deviceId, uint8_t functionId, uint8_t* dest, uint8_t maxLen,
+             uint32_t* ageMs = nullptr) const;
+
+    /**
+     * Drop all values (vehicle asleep: nothing cached is current any more).
+     */
+    void clear();
+
+    /**
+     * Complete BAP message from any route (CAN task, BapChannelRouter observer).
+     */
+    void onMessage(uint32_t rxCanId, const BapProtocol::BapMessageView& msg);
+
+    // Statistics
+    uint32_t getHits() const { return hits; }
+    uint32_t getMisses() const { return misses; }
+    uint8_t getPropertyCount() const { return propertyCount; }
+    const Property& getProperty(uint8_t index) const { return properties[index]; }
+
+private:
+    Property properties[MAX_PROPERTIES];
+    uint8_t propertyCount = 0;
+
+    uint32_t hits = 0;
+    uint32_t misses = 0;
+
+    Property* find(uint8_t deviceId, uint8_t functionId);
+    const Property* find(uint8_t deviceId, uint8_t functionId) const;
+};
@@ -0,0 +1,255 @@
+#include "BapTransmitter.h"
+
+using namespace BapProtocol;
+
+BapTransmitter::BapTransmitter(FrameSink sink)
+    : sink(std::move(sink))
+{
+}
+
+uint8_t BapTransmitter::send(uint32_t canId, uint8_t opcode, uint8_t deviceId, uint8_t functionId,
+                             const uint8_t* payload, uint8_t payloadLen, CanTxCallback onComplete) {
+    if (payloadLen > MAX_PAYLOAD_SIZE) {
+        return 0;
+    }
+
+    uint8_t slot = MAX_MESSAGES;
+    for (uint8_t i = 0; i < MAX_MESSAGES; i++) {
+        if (messages[i].state == MessageState::FREE) {
+            slot = i;
+            break;
+        }
+    }
+    if (slot == MAX_MESSAGES) {
+        return 0;
+    }
+
+    Message& msg = messages[slot];
+    msg.id = nextId++;
+    if (nextId == 0) {
+        nextId = 1;
+    }
+    msg.canId = canId;
+    msg.opcode = opcode;
+    msg.deviceId = deviceId;
+    msg.functionId = functionId;
+    msg.group = NO_GROUP;
+    msg.payloadLen = payloadLen;
+    if (payloadLen > 0) {
+        memcpy(msg.payload, payload, payloadLen);
+    }
+
+    // Short: one frame. Long: start (4 bytes) + continuations (7 bytes each)
+    msg.frameCount = payloadLen <= 6 ? 1 : 1 + (payloadLen - 4 + 6) / 7;
+    msg.nextFrame = 0;
+    msg.framesDone = 0;
+    msg.inFlight = 0;
+    msg.waitCounted = false;
+    msg.queuedMs = millis();
+    msg.onComplete = std::move(onComplete);
+    msg.state = msg.frameCount > 1 ? MessageState::WAITING_GROUP : MessageState::ACTIVE;
+    messageCount++;
+    return msg.frameCount;
+}
+
+uint8_t BapTransmitter::getActiveCount() const {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < MAX_MESSAGES; i++) {
+        count += messages[i].state == MessageState::ACTIVE ? 1 : 0;
+    }
+    return count;
+}
+
+// =============================================================================
+// Scheduling (main loop)
+// =============================================================================
+
+void BapTransmitter::loop(uint32_t nowUs) {
+    if (messageCount == 0) {
+        return;
+    }
+
+    // Messages still handing over frames past their deadline
+    uint32_t nowMs = millis();
+    for (uint8_t i = 0; i < MAX_MESSAGES; i++) {
+        Message& msg = messages[i];
+        if (msg.state != MessageState::FREE && msg.nextFrame < msg.frameCount &&
+            nowMs - msg.queuedMs > MESSAGE_DEADLINE_MS) {
+            finish(i, CanTxResult::EXPIRED);
+        }
+    }
+
+    assignGroups();
+
+    // Round-robin: one frame per message per pass, resuming after the last served
+    while (true) {
+        if (interFrameGapUs > 0 && anyFrameSent && nowUs - lastFrameUs < interFrameGapUs) {
+            return;
+        }
+
+        uint8_t slot = MAX_MESSAGES;
+        for (uint8_t n = 1; n <= MAX_MESSAGES; n++) {
+            uint8_t i = (cursor + n) % MAX_MESSAGES;
+            const Message& msg = messages[i];
+            if (msg.state == MessageState::ACTIVE && msg.nextFrame < msg.frameCount &&
+                msg.inFlight < MAX_FRAMES_IN_FLIGHT) {
+                slot = i;
+                break;
+            }
+        }
+        if (slot == MAX_MESSAGES) {
+            return;
+        }
+
+        cursor = slot;
+        if (!handOver(slot)) {
+            return;  // Sink full, retry on the next loop
+        }
+        lastFrameUs = nowUs;
+        anyFrameSent = true;
+
+        if (interFrameGapUs > 0) {
+            return;
+        }
+    }
+}
+
+void BapTransmitter::assignGroups() {
+    // Oldest waiting message first, so a busy CAN ID cannot starve one
+    bool considered[MAX_MESSAGES] = {};
+    while (true) {
+        uint8_t oldest = MAX_MESSAGES;
+        for (uint8_t i = 0; i < MAX_MESSAGES; i++) {
+            const Message& msg = messages[i];
+            if (msg.state == MessageState::WAITING_GROUP && !considered[i] &&
+                (oldest == MAX_MESSAGES || (int32_t)(msg.id - messages[oldest].id) < 0)) {
+                oldest = i;
+            }
+        }
+        if (oldest == MAX_MESSAGES) {
+            break;
+        }
+        considered[oldest] = true;
+
+        Message& msg = messages[oldest];
+        uint8_t group = freeGroup(msg.canId);
+        if (group == NO_GROUP) {
+            if (!msg.waitCounted) {
+                msg.waitCounted = true;
+                groupWaits++;
+            }
+            continue;
+        }
+        msg.group = group;
+        msg.state = MessageState::ACTIVE;
+    }
+
+    uint8_t concurrentLong = 0;
+    for (uint8_t i = 0; i < MAX_MESSAGES; i++) {
+        concurrentLong += messages[i].state == MessageState::ACTIVE && messages[i].group != NO_GROUP ? 1 : 0;
+    }
+    if (concurrentLong > maxConcurrentLong) {
+        maxConcurrentLong = concurrentLong;
+    }
+}
+
+uint8_t BapTransmitter::freeGroup(uint32_t canId) const {
+    uint8_t used = 0;
+    for (uint8_t i = 0; i < MAX_MESSAGES; i++) {
+        const Message& msg = messages[i];
+        if (msg.state == MessageState::ACTIVE && msg.group != NO_GROUP && msg.canId == canId) {
+            used |= 1 << msg.group;
+        }
+    }
+    uint8_t available = ~used & ((1 << GROUP_COUNT) - 1);
+    return available ? __builtin_ctz(available) : NO_GROUP;
+}
+
+bool BapTransmitter::handOver(uint8_t slot) {
+    Message& msg = messages[slot];
+    uint8_t index = msg.nextFrame;
+
+    CanTxFrame frame;
+    encodeFrame(msg, index, frame);
+
+    // Counted before the sink call, in case it completes synchronously
+    msg.nextFrame++;
+    msg.inFlight++;
+
+    uint32_t id = msg.id;
+    CanTxPriority priority = index == 0 ? CanTxPriority::BAP_START : CanTxPriority::BAP_CONTINUATION;
+    if (!sink(frame, priority, [this, slot, id](CanTxResult result) { onFrameComplete(slot, id, result); })) {
+        if (msg.id == id) {
+            msg.nextFrame--;
+            msg.inFlight--;
+        }
+        sinkRejects++;
+        return false;
+    }
+    return true;
+}
+
+void BapTransmitter::encodeFrame(const Message& msg, uint8_t index, CanTxFrame& frame) const {
+    frame.canId = msg.canId;
+    frame.extended = true;
+    frame.dlc = 8;
+
+    if (msg.group == NO_GROUP) {
+        encodeShortMessage(frame.data, msg.opcode, msg.deviceId, msg.functionId, msg.payload, msg.payloadLen);
+    } else if (index == 0) {
+        encodeLongStart(frame.data, msg.opcode, msg.deviceId, msg.functionId, msg.payloadLen, msg.payload, msg.group);
+    } else {
+        // Continuation n carries payload bytes 4+7(n-1)..; its index wraps at 16
+        uint8_t offset = 4 + 7 * (index - 1);
+        uint8_t chunkLen = msg.payloadLen - offset > 7 ? 7 : msg.payloadLen - offset;
+        encodeLongContinuation(frame.data, msg.payload + offset, chunkLen, msg.group, (index - 1) & 0x0F);
+    }
+}
+
+// =============================================================================
+// Completion (main loop, from the sink's callbacks)
+// =============================================================================
+
+void BapTransmitter::onFrameComplete(uint8_t slot, uint32_t id, CanTxResult result) {
+    Message& msg = messages[slot];
+    if (msg.state == MessageState::FREE || msg.id != id) {
+        return;  // Message already finished (earlier frame failed)
+    }
+
+    msg.inFlight--;
+    if (result != CanTxResult::SENT) {
+        finish(slot, result);
+        return;
+    }
+
+    framesSent++;
+    if (++msg.framesDone == msg.frameCount) {
+        finish(slot, CanTxResult::SENT);
+    }
+}
+
+void BapTransmitter::finish(uint8_t slot, CanTxResult result) {
+    Message& msg = messages[slot];
+
+    if (result == CanTxResult::SENT) {
+        messagesSent++;
+    } else {
+        messagesFailed++;
+    }
+    uint32_t elapsedMs = millis() - msg.queuedMs;
+    if (elapsedMs > maxMessageMs) {
+        maxMessageMs = elapsedMs;
+    }
+
+    // Free the slot (and group) first, so the callback may send the next message
+    CanTxCallback callback = std::move(msg.onComplete);
+    msg.onComplete = nullptr;
+    msg.state = MessageState::FREE;
+    msg.group = NO_GROUP;
+    msg.id = 0;
+    messageCount--;
+
+    if (callback) {
+        callback(result);
+    }
+}
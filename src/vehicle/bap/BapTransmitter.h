@@ -0,0 +1,141 @@
+#pragma once
+
+#include <Arduino.h>
+#include <functional>
+#include "../protocols/BapProtocol.h"
+#include "../../modules/CanTxScheduler.h"
+
+/**
+ * BapTransmitter - Concurrent BAP message transmission over BAP groups
+ *
+ * A long message occupies one of the four BAP groups of its CAN ID from the
+ * start frame to the last continuation; the receiver reassembles each group
+ * separately. Every concurrent long message on a CAN ID gets its own group,
+ * so several messages (e.g. a PROFILES_ARRAY write and a climate command)
+ * are on the bus at the same time instead of queueing behind each other.
+ * A fifth long message on the same ID waits for a group to become free.
+ * Short messages need no group.
+ *
+ * Frames are handed to the sink (CanManager's TX scheduler on the device)
+ * round-robin over the active messages, one frame per message per pass, so
+ * continuation frames of different messages interleave fairly. At most
+ * MAX_FRAMES_IN_FLIGHT frames of a message are queued at once; the
+ * scheduler keeps frames of one CAN ID in order. With an inter-frame gap
+ * set, consecutive frames are handed over at least that far apart.
+ *
+ * The 4-bit continuation index counts 0..15 and wraps to 0, so the longest
+ * message (127 bytes: start + 18 continuations) reuses indices 0 and 1.
+ *
+ * Each message's onComplete gets SENT after its last frame, or the first
+ * failure (remaining frames are not handed over). A message that cannot be
+ * handed over completely within MESSAGE_DEADLINE_MS fails as EXPIRED.
+ *
+ * Usage:
+ *   BapTransmitter tx(sink);
+ *   tx.send(0x17332501, OpCode::SET_GET, 0x25, 0x19, payload, len, onComplete);
+ *   tx.loop();                                   // main loop
+ *
+ * Thread Safety:
+ * - All methods from the main loop; the sink's completion callbacks must
+ *   run there too (CanManager::loop() does)
+ */
+class BapTransmitter {
+public:
+    static constexpr uint8_t MAX_MESSAGES = 8;              // Queued or in transmission
+    static constexpr uint8_t GROUP_COUNT = 4;               // 2-bit group in the control byte
+    static constexpr uint8_t MAX_FRAMES_IN_FLIGHT = 4;      // Per message, handed to the sink
+    static constexpr uint8_t MAX_PAYLOAD_SIZE = 127;
+    static constexpr uint32_t MESSAGE_DEADLINE_MS = 2000;   // Send to last frame handed over
+    static constexpr uint8_t NO_GROUP = 0xFF;
+
+    /**
+     * Hand one frame to the CAN layer.
+     * @return false if rejected (retried on a later pass; onComplete not called)
+     */
+    using FrameSink = std::function<bool(const CanTxFrame& frame, CanTxPriority priority, CanTxCallback onComplete)>;
+
+    explicit BapTransmitter(FrameSink sink);
+
+    /**
+     * Queue a BAP message. Frames go out from loop().
+     * @param onComplete Outcome of the whole message (optional)
+     * @return Number of frames, or 0 if rejected (payload too long, table full)
+     */
+    uint8_t send(uint32_t canId, uint8_t opcode, uint8_t deviceId, uint8_t functionId,
+                 const uint8_t* payload, uint8_t payloadLen, CanTxCallback onComplete = nullptr);
+
+    /**
+     * Minimum time between two frames handed to the sink (0 = no pacing).
+     */
+    void setInterFrameGapUs(uint32_t gapUs) { interFrameGapUs = gapUs; }
+    uint32_t getInterFrameGapUs() const { return interFrameGapUs; }
+
+    /**
+     * Assign groups, hand frames to the sink, expire stuck messages.
+     */
+    void loop() { loop(micros()); }
+    void loop(uint32_t nowUs);
+
+    // Queue state
+    uint8_t getActiveCount() const;
+    uint8_t getQueuedCount() const { return messageCount; }
+
+    // Statistics
+    uint32_t getMessagesSent() const { return messagesSent; }
+    uint32_t getMessagesFailed() const { return messagesFailed; }
+    uint32_t getFramesSent() const { return framesSent; }
+    uint32_t getSinkRejects() const { return sinkRejects; }
+    uint32_t getGroupWaits() const { return groupWaits; }        // Long messages that waited for a group
+    uint8_t getMaxConcurrentLong() const { return maxConcurrentLong; }
+    uint32_t getMaxMessageMs() const { return maxMessageMs; }    // send() to completion
+
+private:
+    enum class MessageState : uint8_t {
+        FREE,
+        WAITING_GROUP,      // Long message, all groups of its CAN ID in use
+        ACTIVE              // Frames being handed over / in flight
+    };
+
+    struct Message {
+        MessageState state = MessageState::FREE;
+        uint32_t id = 0;                // Ties late frame completions to this use of the slot
+        uint32_t canId = 0;
+        uint8_t opcode = 0;
+        uint8_t deviceId = 0;
+        uint8_t functionId = 0;
+        uint8_t group = NO_GROUP;
+        uint8_t payloadLen = 0;
+        uint8_t frameCount = 0;
+        uint8_t nextFrame = 0;          // Next frame to hand to the sink
+        uint8_t framesDone = 0;         // Frames reported SENT
+        uint8_t inFlight = 0;
+        bool waitCounted = false;
+        uint32_t queuedMs = 0;
+        CanTxCallback onComplete;
+        uint8_t payload[MAX_PAYLOAD_SIZE];
+    };
+
+    FrameSink sink;
+    Message messages[MAX_MESSAGES];
+    uint8_t messageCount = 0;
+    uint32_t nextId = 1;
+    uint8_t cursor = 0;                 // Round-robin position
+    uint32_t interFrameGapUs = 0;
+    uint32_t lastFrameUs = 0;
+    bool anyFrameSent = false;
+
+    uint32_t messagesSent = 0;
+    uint32_t messagesFailed = 0;
+    uint32_t framesSent = 0;
+    uint32_t sinkRejects = 0;
+    uint32_t groupWaits = 0;
+    uint8_t maxConcurrentLong = 0;
+    uint32_t maxMessageMs = 0;
+
+    void assignGroups();
+    uint8_t freeGroup(uint32_t canId) const;
+    bool handOver(uint8_t slot);
+    void encodeFrame(const Message& msg, uint8_t index, CanTxFrame& frame) const;
+    void onFrameComplete(uint8_t slot, uint32_t id, CanTxResult result);
+    void finish(uint8_t slot, CanTxResult result);
+};
@@ -0,0 +1,39 @@
+#include "BapMonitorChannel.h"
+
+using namespace BapProtocol;
+
+BapMonitorChannel::BapMonitorChannel(const char* name, uint8_t deviceId, uint32_t txCanId,
+                                     const uint32_t* rxCanIds, uint8_t rxCount)
+    : name(name), deviceId(deviceId), txCanId(txCanId), rxCount(0)
+{
+    for (uint8_t i = 0; i < rxCount && i < MAX_RX_IDS; i++) {
+        this->rxCanIds[this->rxCount++] = rxCanIds[i];
+    }
+}
+
+bool BapMonitorChannel::handlesCanId(uint32_t canId) const {
+    for (uint8_t i = 0; i < rxCount; i++) {
+        if (rxCanIds[i] == canId) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool BapMonitorChannel::processMessage(const BapMessageView& msg) {
+    if (msg.deviceId != deviceId) {
+        foreign++;
+        return false;
+    }
+
+    messages++;
+    if (msg.isError()) {
+        errors++;
+    }
+
+    uint8_t function = msg.functionId & 0x3F;
+    functionsSeen |= 1ULL << function;
+    lastOpcode[function] = msg.opcode;
+    lastLength[function] = msg.payloadLen;
+    return true;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <Arduino.h>
+#include "../BapChannel.h"
+#include "../../protocols/BapProtocol.h"
+
+/**
+ * BapMonitorChannel - Passive channel for an LSG without a decoder yet
+ *
+ * Receives the complete messages of a device (e.g. Door Locking 0x0D,
+ * ENI 0x37 from CAN_IDS.md) through BapChannelRouter and records which
+ * functions are active, with the opcode and length of the latest message
+ * per function. Enough to see from the statistics log what a device sends
+ * before writing a real channel for it; no state is decoded and nothing
+ * is sent.
+ *
+ * Thread Safety:
+ * - processMessage() from the CAN decode task (via BapChannelRouter)
+ * - Getters from the main loop
+ */
+class BapMonitorChannel : public BapChannel {
+public:
+    static constexpr uint8_t MAX_RX_IDS = 4;
+    static constexpr uint8_t FUNCTION_COUNT = 64;   // 6-bit function ID
+
+    /**
+     * @param name Channel name for logging (static string)
+     * @param deviceId LSG ID
+     * @param txCanId ASG to FSG CAN ID
+     * @param rxCanIds FSG to ASG CAN IDs (responses, status broadcasts)
+     * @param rxCount Number of RX IDs (at most MAX_RX_IDS)
+     */
+    BapMonitorChannel(const char* name, uint8_t deviceId, uint32_t txCanId,
+                      const uint32_t* rxCanIds, uint8_t rxCount);
+
+    // BapChannel interface
+    uint8_t getDeviceId() const override { return deviceId; }
+    uint32_t getTxCanId() const override { return txCanId; }
+    uint32_t getRxCanId() const override { return rxCanIds[0]; }
+    uint8_t getRxCanIdCount() const override { return rxCount; }
+    uint32_t getRxCanIdAt(uint8_t index) const override { return rxCanIds[index]; }
+    bool handlesCanId(uint32_t canId) const override;
+    const char* getName() const override { return name; }
+    bool processMessage(const BapProtocol::BapMessageView& msg) override;
+
+    // Function activity
+    uint64_t getFunctionsSeen() const { return functionsSeen; }
+    uint8_t getFunctionCount() const { return __builtin_popcountll(functionsSeen); }
+    uint8_t getLastOpcode(uint8_t functionId) const { return lastOpcode[functionId & 0x3F]; }
+    uint8_t getLastLength(uint8_t functionId) const { return lastLength[functionId & 0x3F]; }
+
+    // Statistics
+    uint32_t getMessageCount() const { return messages; }
+    uint32_t getErrorCount() const { return errors; }
+    uint32_t getForeignCount() const { return foreign; }
+
+private:
+    const char* name;
+    uint8_t deviceId;
+    uint32_t txCanId;
+    uint32_t rxCanIds[MAX_RX_IDS];
+    uint8_t rxCount;
+
+    volatile uint64_t functionsSeen = 0;
+    uint8_t lastOpcode[FUNCTION_COUNT] = {};
+    uint8_t lastLength[FUNCTION_COUNT] = {};
+
+    volatile uint32_t messages = 0;
+    volatile uint32_t errors = 0;       // OpCode::ERROR responses
+    volatile uint32_t foreign = 0;      // Messages with another device ID
+};
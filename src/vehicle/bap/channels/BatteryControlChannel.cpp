@@ -11,29 +11,6 @@ BatteryControlChannel::BatteryControlChannel(VehicleManager* mgr)
 {
 }
 
-// =============================================================================
-// Frame Processing (for new domain-based architecture)
-// =============================================================================
-
-bool BatteryControlChannel::processFrame(uint32_t canId, const uint8_t* data, uint8_t dlc) {
-    // This method is called directly from VehicleManager in the new architecture
-    // (bypassing BapChannelRouter)
-    
-    if (canId != CAN_ID_RX) {
-        return false;  // Not our channel
-    }
-    
-    // Assemble multi-frame BAP message
-    BapProtocol::BapMessage msg;
-    if (frameAssembler.processFrame(data, dlc, msg)) {
-        // Complete message assembled - process it
-        return processMessage(msg);
-    }
-    
-    // Frame accepted but message not complete yet (waiting for continuation frames)
-    return true;
-}
-
 // =============================================================================
 // BapChannel interface implementation
 // =============================================================================
@@ -43,7 +20,7 @@ bool BatteryControlChannel::handlesCanId(uint32_t canId) const {
     return canId == CAN_ID_RX;
 }
 
-bool BatteryControlChannel::processMessage(const BapProtocol::BapMessage& msg) {
+bool BatteryControlChannel::processMessage(const BapProtocol::BapMessageView& msg) {
     // Only process response opcodes (we don't care about requests from other modules)
     // OpCodes 0x03-0x07 are responses/indications
     if (msg.opcode < OpCode::HEARTBEAT) {
@@ -122,16 +99,24 @@ void BatteryControlChannel::processPlugState(const uint8_t* payload, uint8_t len
     
     PlugStateData decoded = decodePlugState(payload, len);
     
-    // Build PlugState structure to pass to callbacks
-    PlugState plugData;
-    plugData.lockSetup = decoded.lockSetup;
-    plugData.lockState = decoded.lockState;
-    plugData.supplyState = static_cast<uint8_t>(decoded.supplyState);
-    plugData.plugState = static_cast<uint8_t>(decoded.plugState);
-    plugData.lastUpdate = millis();
-    
-    // Notify subscribers (pass by const reference)
-    notifyPlugStateCallbacks(plugData);
+    PlugStateUpdate update;
+    update.lockSetup = decoded.lockSetup;
+    update.lockState = decoded.lockState;
+    update.supplyState = static_cast<uint8_t>(decoded.supplyState);
+    update.plugState = static_cast<uint8_t>(decoded.plugState);
+    
+    // Fields that differ from the last message (all on the first)
+    typedef PlugStateUpdate::Field Field;
+    const PlugStateUpdate& last = lastPlugState;
+    bool seen = plugStateSeen;
+    update.changed = (!seen || update.lockSetup != last.lockSetup ? Field::LOCK_SETUP : 0) |
+                     (!seen || update.lockState != last.lockState ? Field::LOCK_STATE : 0) |
+                     (!seen || update.supplyState != last.supplyState ? Field::SUPPLY_STATE : 0) |
+                     (!seen || update.plugState != last.plugState ? Field::PLUG_STATE : 0);
+    lastPlugState = update;
+    plugStateSeen = true;
+    
+    plugStateSubscribers(update);
     
     // NO SERIAL OUTPUT - This runs on CAN task (Core 0)
 }
@@ -146,31 +131,29 @@ void BatteryControlChannel::processChargeState(const uint8_t* payload, uint8_t l
     
     ChargeStateData decoded = decodeChargeState(payload, len);
     
-    // Build BatteryState structure to pass to callbacks
-    BatteryState batteryData;
-    
-    // Update unified SOC field (BAP source - takes priority over CAN)
-    batteryData.soc = decoded.socPercent;
-    batteryData.socSource = DataSource::BAP;
-    batteryData.socUpdate = millis();
-    
-    // Update unified charging field (BAP source - more detailed than CAN)
-    batteryData.charging = (decoded.chargeMode != ChargeMode::OFF && 
-                        decoded.chargeMode != ChargeMode::INIT &&
-                        decoded.chargeStatus == ChargeStatus::RUNNING);
-    batteryData.chargingSource = DataSource::BAP;
-    batteryData.chargingUpdate = millis();
-    
-    // Store detailed charging info
-    batteryData.chargingMode = static_cast<uint8_t>(decoded.chargeMode);
-    batteryData.chargingStatus = static_cast<uint8_t>(decoded.chargeStatus);
-    batteryData.chargingAmps = decoded.chargingAmps;
-    batteryData.targetSoc = decoded.targetSoc;
-    batteryData.remainingTimeMin = decoded.remainingTimeMin;
-    batteryData.chargingDetailsUpdate = millis();
-    
-    // Notify subscribers (new architecture)
-    notifyChargeStateCallbacks(batteryData);
+    ChargeStateUpdate update;
+    update.soc = decoded.socPercent;
+    update.charging = decoded.isCharging();
+    update.chargingMode = static_cast<uint8_t>(decoded.chargeMode);
+    update.chargingStatus = static_cast<uint8_t>(decoded.chargeStatus);
+    update.chargingAmps = decoded.chargingAmps;
+    update.targetSoc = decoded.targetSoc;
+    update.remainingTimeMin = decoded.remainingTimeMin;
+    
+    typedef ChargeStateUpdate::Field Field;
+    const ChargeStateUpdate& last = lastChargeState;
+    bool seen = chargeStateSeen;
+    update.changed = (!seen || update.soc != last.soc ? Field::SOC : 0) |
+                     (!seen || update.charging != last.charging ? Field::CHARGING : 0) |
+                     (!seen || update.chargingMode != last.chargingMode ? Field::MODE : 0) |
+                     (!seen || update.chargingStatus != last.chargingStatus ? Field::STATUS : 0) |
+                     (!seen || update.chargingAmps != last.chargingAmps ? Field::AMPS : 0) |
+                     (!seen || update.targetSoc != last.targetSoc ? Field::TARGET_SOC : 0) |
+                     (!seen || update.remainingTimeMin != last.remainingTimeMin ? Field::REMAINING_TIME : 0);
+    lastChargeState = update;
+    chargeStateSeen = true;
+    
+    chargeStateSubscribers(update);
 }
 
 void BatteryControlChannel::processClimateState(const uint8_t* payload, uint8_t len) {
@@ -181,28 +164,31 @@ void BatteryControlChannel::processClimateState(const uint8_t* payload, uint8_t
     
     ClimateStateData decoded = decodeClimateState(payload, len);
     
-    // Build ClimateState structure
-    ClimateState climateData;
-    
-    // Update unified climate fields (BAP source - provides detailed mode info)
-    climateData.climateActive = decoded.climateActive;
-    climateData.climateActiveSource = DataSource::BAP;
-    climateData.heating = decoded.heating;
-    climateData.cooling = decoded.cooling;
-    climateData.ventilation = decoded.ventilation;
-    climateData.autoDefrost = decoded.autoDefrost;
-    climateData.climateTimeMin = decoded.climateTimeMin;
-    climateData.climateActiveUpdate = millis();
-    
-    // Update inside temperature if climate is active (BAP priority)
-    if (decoded.climateActive) {
-        climateData.insideTemp = decoded.currentTempC;
-        climateData.insideTempSource = DataSource::BAP;
-        climateData.insideTempUpdate = millis();
-    }
-    
-    // Notify subscribers (new architecture)
-    notifyClimateStateCallbacks(climateData);
+    ClimateStateUpdate update;
+    update.climateActive = decoded.climateActive;
+    update.heating = decoded.heating;
+    update.cooling = decoded.cooling;
+    update.ventilation = decoded.ventilation;
+    update.autoDefrost = decoded.autoDefrost;
+    update.climateTimeMin = decoded.climateTimeMin;
+    
+    // Inside temperature only while climate is active (BAP priority over CAN)
+    update.insideTempDeci = decoded.climateActive ? decoded.currentTempDeci : 0;
+    
+    typedef ClimateStateUpdate::Field Field;
+    const ClimateStateUpdate& last = lastClimateState;
+    bool seen = climateStateSeen;
+    update.changed = (!seen || update.climateActive != last.climateActive ? Field::CLIMATE_ACTIVE : 0) |
+                     (!seen || update.heating != last.heating ? Field::HEATING : 0) |
+                     (!seen || update.cooling != last.cooling ? Field::COOLING : 0) |
+                     (!seen || update.ventilation != last.ventilation ? Field::VENTILATION : 0) |
+                     (!seen || update.autoDefrost != last.autoDefrost ? Field::AUTO_DEFROST : 0) |
+                     (!seen || update.insideTempDeci != last.insideTempDeci ? Field::INSIDE_TEMP : 0) |
+                     (!seen || update.climateTimeMin != last.climateTimeMin ? Field::CLIMATE_TIME : 0);
+    lastClimateState = update;
+    climateStateSeen = true;
+    
+    climateStateSubscribers(update);
     
     // NO SERIAL OUTPUT - This runs on CAN task (Core 0)
 }
@@ -284,9 +270,9 @@ BatteryControlChannel::ClimateStateData BatteryControlChannel::decodeClimateStat
     data.fuelBasedHeating = (mode & 0x20) != 0;
     
     // Byte 1: current temperature (raw)
-    // Formula: (raw + 100) / 10
+    // Formula: (raw + 100) / 10, kept in 0.1 C
     if (len >= 2) {
-        data.currentTempC = (payload[1] + 100) / 10.0f;
+        data.currentTempDeci = payload[1] + 100;
     }
     
     // Byte 2: temperature unit
@@ -307,85 +293,73 @@ BatteryControlChannel::ClimateStateData BatteryControlChannel::decodeClimateStat
     return data;
 }
 
-// =============================================================================
-// Command builders (device-specific)
-// =============================================================================
-
-uint8_t BatteryControlChannel::buildGetRequest(uint8_t* dest, uint8_t functionId) {
-    return encodeShortMessage(dest, OpCode::GET, DEVICE_ID, functionId);
-}
-
 // =============================================================================
 // Command methods
 // =============================================================================
 
-bool BatteryControlChannel::sendBapFrame(const uint8_t* data, uint8_t len) {
+bool BatteryControlChannel::requestState(uint8_t functionId, uint32_t maxAgeMs,
+                                         BapClient::ResponseCallback callback) {
     if (!manager) {
         Serial.println("[BatteryControl] No manager - cannot send");
         return false;
     }
     
-    // Send as extended frame to TX channel
-    return manager->sendCanFrame(CAN_ID_TX, data, len, true);
+    // The STATUS is decoded by processMessage(); the client only tracks the
+    // round-trip, or answers from the property cache without sending
+    BapClient::Options options;
+    options.maxAgeMs = maxAgeMs;
+    return manager->bap().get(CAN_ID_TX, DEVICE_ID, functionId, std::move(callback), options) != BapClient::NO_REQUEST;
 }
 
-bool BatteryControlChannel::requestPlugState() {
-    uint8_t frame[8];
-    buildGetRequest(frame, Function::PLUG_STATE);
-    
+bool BatteryControlChannel::requestPlugState(uint32_t maxAgeMs) {
     Serial.println("[BatteryControl] Requesting PlugState...");
-    return sendBapFrame(frame, 8);
+    return requestState(Function::PLUG_STATE, maxAgeMs);
 }
 
-bool BatteryControlChannel::requestChargeState() {
-    uint8_t frame[8];
-    buildGetRequest(frame, Function::CHARGE_STATE);
-    
+bool BatteryControlChannel::requestChargeState(uint32_t maxAgeMs) {
     Serial.println("[BatteryControl] Requesting ChargeState...");
-    return sendBapFrame(frame, 8);
+    return requestState(Function::CHARGE_STATE, maxAgeMs);
 }
 
-bool BatteryControlChannel::requestClimateState() {
-    uint8_t frame[8];
-    buildGetRequest(frame, Function::CLIMATE_STATE);
-    
+bool BatteryControlChannel::requestClimateState(uint32_t maxAgeMs) {
     Serial.println("[BatteryControl] Requesting ClimateState...");
-    return sendBapFrame(frame, 8);
+    return requestState(Function::CLIMATE_STATE, maxAgeMs);
 }
 
-// =============================================================================
-// Callback Notifications (for new domain-based architecture)
-// =============================================================================
-
-void BatteryControlChannel::notifyPlugStateCallbacks(const PlugState& plugData) {
-    // Called from CAN thread - keep FAST (just data copying)
-    if (plugStateCallbacks.empty()) return;
-    
-    for (const auto& callback : plugStateCallbacks) {
-        if (callback) {
-            callback(plugData);
-        }
+uint8_t BatteryControlChannel::refreshState() {
+    if (refreshPending > 0) {
+        Serial.printf("[BatteryControl] State refresh already running (%u pending)\r\n", refreshPending);
+        return 0;
     }
+    
+    // Callbacks run from BapClient::loop(), never before the last request is issued
+    auto onResponse = [this](const BapClient::Response& response) { onRefreshResponse(response); };
+    
+    uint8_t issued = 0;
+    uint32_t maxAgeMs = BapPropertyCache::DEFAULT_MAX_AGE_MS;
+    issued += requestState(Function::PLUG_STATE, maxAgeMs, onResponse) ? 1 : 0;
+    issued += requestState(Function::CHARGE_STATE, maxAgeMs, onResponse) ? 1 : 0;
+    issued += requestState(Function::CLIMATE_STATE, maxAgeMs, onResponse) ? 1 : 0;
+    issued += manager && manager->profiles().requestAllProfiles(maxAgeMs, onResponse) ? 1 : 0;
+    
+    refreshPending = issued;
+    refreshIssued = issued;
+    refreshOk = 0;
+    refreshCached = 0;
+    refreshStartMs = millis();
+    Serial.printf("[BatteryControl] State refresh: %u requests issued\r\n", issued);
+    return issued;
 }
 
-void BatteryControlChannel::notifyChargeStateCallbacks(const BatteryState& batteryData) {
-    // Called from CAN thread - keep FAST (just data copying)
-    if (chargeStateCallbacks.empty()) return;
-    
-    for (const auto& callback : chargeStateCallbacks) {
-        if (callback) {
-            callback(batteryData);
-        }
+void BatteryControlChannel::onRefreshResponse(const BapClient::Response& response) {
+    if (response.result == BapClient::Result::OK) {
+        refreshOk++;
     }
-}
-
-void BatteryControlChannel::notifyClimateStateCallbacks(const ClimateState& climateData) {
-    // Called from CAN thread - keep FAST (just data copying)
-    if (climateStateCallbacks.empty()) return;
-    
-    for (const auto& callback : climateStateCallbacks) {
-        if (callback) {
-            callback(climateData);
-        }
+    if (response.cached) {
+        refreshCached++;
+    }
+    if (refreshPending > 0 && --refreshPending == 0) {
+        Serial.printf("[BatteryControl] State refresh: %u/%u answered (%u from cache) in %lums\r\n",
+                      refreshOk, refreshIssued, refreshCached, millis() - refreshStartMs);
     }
 }
@@ -1,9 +1,10 @@
 #pragma once
 
 #include <Arduino.h>
-#include <vector>
-#include <functional>
 #include "../BapChannel.h"
+#include "../BapClient.h"
+#include "../BapPropertyCache.h"
+#include "../../../core/Delegate.h"
 #include "../../VehicleTypes.h"
 #include "../../protocols/BapProtocol.h"
 
@@ -21,7 +22,7 @@ class VehicleManager;
  * 
  * Architecture:
  * ```
- * CAN Frame → BapChannelRouter → BatteryControlChannel
+ * CAN Frame → BapChannelRouter (assembly) → BatteryControlChannel
  *                                      ↓
  *                                 VehicleState (updates)
  * ```
@@ -137,7 +138,7 @@ public:
         bool cooling = false;
         bool ventilation = false;
         bool fuelBasedHeating = false;
-        float currentTempC = 0.0f;
+        int16_t currentTempDeci = 0;       // 0.1 C
         uint8_t tempUnit = 0;
         uint16_t climateTimeMin = 0;
         uint8_t climateState = 0;
@@ -169,66 +170,55 @@ public:
     uint32_t getRxCanId() const override { return CAN_ID_RX; }
     bool handlesCanId(uint32_t canId) const override;
     const char* getName() const override { return "BatteryControl"; }
-    bool processMessage(const BapProtocol::BapMessage& msg) override;
+    bool processMessage(const BapProtocol::BapMessageView& msg) override;
     
     // =========================================================================
-    // Callback Registration (for new domain-based architecture)
+    // Subscriber Registration (domain managers, at setup)
     // =========================================================================
     
     /**
-     * Callback types for domain subscribers.
-     * Domains register these callbacks to be notified when state updates occur.
-     * Callbacks are called from CAN thread (Core 0) - keep them FAST!
+     * Subscribers are called from the CAN task (Core 0) - keep them FAST!
+     * Each gets only the decoded fields and a bitmask of those that changed
+     * since the previous message (see PlugStateUpdate), so it can skip
+     * updates that do not concern it. The lists are fixed arrays of
+     * object pointer + stub (Delegate): nothing on the notify path allocates.
+     * @return false if all MAX_SUBSCRIBERS slots are taken
      */
-    using PlugStateCallback = std::function<void(const PlugState&)>;
-    using ChargeStateCallback = std::function<void(const BatteryState&)>;  // Pass full battery state for charge info
-    using ClimateStateCallback = std::function<void(const ClimateState&)>;
+    static constexpr size_t MAX_SUBSCRIBERS = 4;
     
-    /**
-     * Register callback for plug state updates (function 0x10).
-     * Called whenever plug state changes (plug/unplug, lock/unlock, supply changes).
-     * @param callback Function to call with new plug state
-     */
-    void onPlugState(PlugStateCallback callback) {
-        plugStateCallbacks.push_back(callback);
+    template<typename T, void (T::*Method)(const PlugStateUpdate&)>
+    bool bindPlugState(T* subscriber) {
+        return plugStateSubscribers.add(Delegate<void(const PlugStateUpdate&)>::bind<T, Method>(subscriber));
     }
     
-    /**
-     * Register callback for charge state updates (function 0x11).
-     * Called whenever charging state changes (SOC, current, status, mode).
-     * @param callback Function to call with updated battery state
-     */
-    void onChargeState(ChargeStateCallback callback) {
-        chargeStateCallbacks.push_back(callback);
+    template<typename T, void (T::*Method)(const ChargeStateUpdate&)>
+    bool bindChargeState(T* subscriber) {
+        return chargeStateSubscribers.add(Delegate<void(const ChargeStateUpdate&)>::bind<T, Method>(subscriber));
     }
     
-    /**
-     * Register callback for climate state updates (function 0x12).
-     * Called whenever climate state changes (on/off, temp, heating/cooling).
-     * @param callback Function to call with updated climate state
-     */
-    void onClimateState(ClimateStateCallback callback) {
-        climateStateCallbacks.push_back(callback);
+    template<typename T, void (T::*Method)(const ClimateStateUpdate&)>
+    bool bindClimateState(T* subscriber) {
+        return climateStateSubscribers.add(Delegate<void(const ClimateStateUpdate&)>::bind<T, Method>(subscriber));
     }
     
-    /**
-     * Process a CAN frame directly (for new architecture).
-     * Alternative to using BapChannelRouter - allows domain managers to
-     * route directly to this channel from VehicleManager.
-     * @param canId CAN ID (must match RX ID)
-     * @param data Frame data
-     * @param dlc Data length code
-     * @return true if frame was processed
-     */
-    bool processFrame(uint32_t canId, const uint8_t* data, uint8_t dlc);
-    
     // =========================================================================
     // State Request Methods
     // =========================================================================
     
-    bool requestPlugState();
-    bool requestChargeState();
-    bool requestClimateState();
+    // GETs go through the BapClient (retried, answered by the STATUS). No
+    // GET is sent while the pushed value is at most maxAgeMs old and within
+    // its heartbeat period (0 = always send).
+    bool requestPlugState(uint32_t maxAgeMs = BapPropertyCache::DEFAULT_MAX_AGE_MS);
+    bool requestChargeState(uint32_t maxAgeMs = BapPropertyCache::DEFAULT_MAX_AGE_MS);
+    bool requestClimateState(uint32_t maxAgeMs = BapPropertyCache::DEFAULT_MAX_AGE_MS);
+    
+    /**
+     * Refresh plug, charge, climate and profiles with all four GETs on the
+     * bus at once (fresh cached values are not re-read); the outcome is
+     * logged when the last one completes.
+     * @return Number of requests issued (0 if a refresh is still running)
+     */
+    uint8_t refreshState();
     
     // =========================================================================
     // Statistics
@@ -245,13 +235,18 @@ public:
 private:
     VehicleManager* manager;
     
-    // BAP frame assembly
-    BapProtocol::BapFrameAssembler frameAssembler;
+    // Subscribers (bound at setup, called from the CAN task)
+    DelegateList<void(const PlugStateUpdate&), MAX_SUBSCRIBERS> plugStateSubscribers;
+    DelegateList<void(const ChargeStateUpdate&), MAX_SUBSCRIBERS> chargeStateSubscribers;
+    DelegateList<void(const ClimateStateUpdate&), MAX_SUBSCRIBERS> climateStateSubscribers;
     
-    // Callback subscribers (for new domain-based architecture)
-    std::vector<PlugStateCallback> plugStateCallbacks;
-    std::vector<ChargeStateCallback> chargeStateCallbacks;
-    std::vector<ClimateStateCallback> climateStateCallbacks;
+    // Last notified values, for the change bitmasks (CAN task only)
+    PlugStateUpdate lastPlugState;
+    ChargeStateUpdate lastChargeState;
+    ClimateStateUpdate lastClimateState;
+    bool plugStateSeen = false;
+    bool chargeStateSeen = false;
+    bool climateStateSeen = false;
     
     // Statistics
     volatile uint32_t plugFrames = 0;
@@ -262,18 +257,17 @@ private:
     volatile uint32_t ignoredRequests = 0;
     volatile uint32_t decodeErrors = 0;
     
+    // State refresh in flight (main loop only)
+    uint8_t refreshPending = 0;
+    uint8_t refreshIssued = 0;
+    uint8_t refreshOk = 0;
+    uint8_t refreshCached = 0;
+    uint32_t refreshStartMs = 0;
+    
     // =========================================================================
     // Internal methods
     // =========================================================================
     
-    /**
-     * Notify all registered callbacks (for new domain-based architecture).
-     * Called after state is updated. Keep FAST - just data copying.
-     */
-    void notifyPlugStateCallbacks(const PlugState& plugData);
-    void notifyChargeStateCallbacks(const BatteryState& batteryData);
-    void notifyClimateStateCallbacks(const ClimateState& climateData);
-    
     void processPlugState(const uint8_t* payload, uint8_t len);
     void processChargeState(const uint8_t* payload, uint8_t len);
     void processClimateState(const uint8_t* payload, uint8_t len);
@@ -282,7 +276,6 @@ private:
     ChargeStateData decodeChargeState(const uint8_t* payload, uint8_t len);
     ClimateStateData decodeClimateState(const uint8_t* payload, uint8_t len);
     
-    uint8_t buildGetRequest(uint8_t* dest, uint8_t functionId);
-    
-    bool sendBapFrame(const uint8_t* data, uint8_t len);
+    bool requestState(uint8_t functionId, uint32_t maxAgeMs, BapClient::ResponseCallback callback = nullptr);
+    void onRefreshResponse(const BapClient::Response& response);
 };
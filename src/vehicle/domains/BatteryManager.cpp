@@ -40,14 +40,10 @@ bool BatteryManager::setup() {
     Serial.println("[BatteryManager] Registering BAP callbacks...");
     
     // Plug state callback (function 0x10)
-    bapChannel->onPlugState([this](const PlugState& plug) {
-        this->onPlugStateUpdate(plug);
-    });
+    bapChannel->bindPlugState<BatteryManager, &BatteryManager::onPlugStateUpdate>(this);
     
     // Charge state callback (function 0x11)
-    bapChannel->onChargeState([this](const BatteryState& battery) {
-        this->onChargeStateUpdate(battery);
-    });
+    bapChannel->bindChargeState<BatteryManager, &BatteryManager::onChargeStateUpdate>(this);
     
     Serial.println("[BatteryManager] Initialized:");
     Serial.println("[BatteryManager]   - CAN IDs: 0x5CA (BMS_07), 0x59E (BMS_06), 0x483 (Motor_Hybrid_06)");
@@ -89,6 +85,36 @@ void BatteryManager::processCanFrame(uint32_t canId, const uint8_t* data, uint8_
     }
 }
 
+void BatteryManager::refreshCanFrame(uint32_t canId, uint8_t dlc) {
+    // Unchanged payload: same counters and timestamps as processCanFrame(), no decode
+    if (dlc < 8) {
+        return;
+    }
+    
+    switch (canId) {
+        case CAN_ID_BMS_07:
+            bms07Count++;
+            state.energyUpdate.touch();
+            if (state.chargingSource != DataSource::BAP) {
+                state.chargingUpdate.touch();
+            }
+            break;
+            
+        case CAN_ID_BMS_06:
+            bms06Count++;
+            state.tempUpdate.touch();
+            break;
+            
+        case CAN_ID_MOTOR_HYBRID_06:
+            motorHybrid06Count++;
+            state.powerUpdate.touch();
+            break;
+            
+        default:
+            break;
+    }
+}
+
 void BatteryManager::onWakeComplete() {
     // Optional: Request initial BAP state after wake
     // For now, BAP channel will send updates automatically
@@ -108,21 +134,20 @@ void BatteryManager::processBMS07(const uint8_t* data) {
     // BMS_07 (0x5CA) - Charging status and energy content
     bms07Count++;
     
-    BroadcastDecoder::BMS07Data decoded = BroadcastDecoder::decodeBMS07(data);
+    BroadcastDecoder::Bms07Raw decoded = BroadcastDecoder::decodeBms07Raw(data);
     
-    // Update CAN-sourced fields
-    state.energyWh = decoded.energyWh;
-    state.maxEnergyWh = decoded.maxEnergyWh;
+    // Update CAN-sourced fields (raw; converted on read)
+    state.energyRaw = decoded.energy;
+    state.maxEnergyRaw = decoded.maxEnergy;
     state.chargingActive = decoded.chargingActive;
-    state.balancingActive = decoded.balancingActive;
-    state.energyUpdate = millis();
-    state.balancingUpdate = millis();
+    state.balancingActive = decoded.balancingActive != 0;
+    state.energyUpdate.touch();
     
     // Update unified charging field (CAN source - BAP will override if available)
     if (state.chargingSource != DataSource::BAP) {
         state.charging = decoded.chargingActive;
         state.chargingSource = DataSource::CAN_STD;
-        state.chargingUpdate = millis();
+        state.chargingUpdate.touch();
     }
     
     // NO SERIAL OUTPUT - This runs on CAN task (Core 0)
@@ -132,10 +157,8 @@ void BatteryManager::processBMS06(const uint8_t* data) {
     // BMS_06 (0x59E) - Battery temperature
     bms06Count++;
     
-    float temp = BroadcastDecoder::decodeBMS06Temperature(data);
-    
-    state.temperature = temp;
-    state.tempUpdate = millis();
+    state.temperatureRaw = BroadcastDecoder::decodeBms06Raw(data).temperature;
+    state.tempUpdate.touch();
     
     // NO SERIAL OUTPUT - This runs on CAN task (Core 0)
 }
@@ -144,10 +167,8 @@ void BatteryManager::processMotorHybrid06(const uint8_t* data) {
     // Motor_Hybrid_06 (0x483) - Power meter for charging/climate
     motorHybrid06Count++;
     
-    BroadcastDecoder::MotorHybrid06Data decoded = BroadcastDecoder::decodeMotorHybrid06(data);
-    
-    state.powerKw = decoded.powerKw;
-    state.powerUpdate = millis();
+    state.powerRaw = BroadcastDecoder::decodeMotorHybrid06Raw(data).chargeGrenze;
+    state.powerUpdate.touch();
     
     // NO SERIAL OUTPUT - This runs on CAN task (Core 0)
 }
@@ -156,37 +177,50 @@ void BatteryManager::processMotorHybrid06(const uint8_t* data) {
 // BAP Callback Handlers
 // =============================================================================
 
-void BatteryManager::onPlugStateUpdate(const PlugState& plug) {
+void BatteryManager::onPlugStateUpdate(const PlugStateUpdate& plug) {
     // Called from CAN thread via BatteryControlChannel callback
-    // Keep FAST - just copy data
+    // Keep FAST - copy only when something changed
     plugCallbackCount++;
     
-    state.plugState = plug;
+    if (plug.changed != 0) {
+        state.plugState.lockSetup = plug.lockSetup;
+        state.plugState.lockState = plug.lockState;
+        state.plugState.supplyState = plug.supplyState;
+        state.plugState.plugState = plug.plugState;
+    }
     state.plugStateSource = DataSource::BAP;
-    state.plugStateUpdate = millis();
+    state.plugStateUpdate.touch();
+    state.plugState.lastUpdate = state.plugStateUpdate;
     
     // NO SERIAL OUTPUT - This runs on CAN task (Core 0)
 }
 
-void BatteryManager::onChargeStateUpdate(const BatteryState& battery) {
+void BatteryManager::onChargeStateUpdate(const ChargeStateUpdate& charge) {
     // Called from CAN thread via BatteryControlChannel callback
-    // Keep FAST - just copy data
+    // Keep FAST - copy changed fields, refresh freshness on every update
     chargeCallbackCount++;
+    typedef ChargeStateUpdate::Field Field;
     
     // BAP SOC takes priority over CAN
-    state.soc = battery.soc;
+    if (charge.changed & Field::SOC) {
+        state.soc = charge.soc;
+    }
     state.socSource = DataSource::BAP;
-    state.socUpdate = millis();
+    state.socUpdate.touch();
     
-    // BAP charging info is more detailed than CAN
-    state.charging = battery.charging;
+    // BAP charging info is more detailed than CAN (which stops writing once BAP has)
+    if (charge.changed & Field::CHARGING) {
+        state.charging = charge.charging;
+    }
+    if (charge.changed & (Field::MODE | Field::STATUS | Field::AMPS | Field::TARGET_SOC | Field::REMAINING_TIME)) {
+        state.chargingMode = charge.chargingMode;
+        state.chargingStatus = charge.chargingStatus;
+        state.chargingAmps = charge.chargingAmps;
+        state.targetSoc = charge.targetSoc;
+        state.remainingTimeMin = charge.remainingTimeMin;
+    }
     state.chargingSource = DataSource::BAP;
-    state.chargingMode = battery.chargingMode;
-    state.chargingStatus = battery.chargingStatus;
-    state.chargingAmps = battery.chargingAmps;
-    state.targetSoc = battery.targetSoc;
-    state.remainingTimeMin = battery.remainingTimeMin;
-    state.chargingUpdate = millis();
+    state.chargingUpdate = state.socUpdate;
     
     // NO SERIAL OUTPUT - This runs on CAN task (Core 0)
 }
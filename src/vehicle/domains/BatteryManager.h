@@ -3,7 +3,7 @@
 #include <Arduino.h>
 #include "../IDomain.h"
 #include "../VehicleTypes.h"
-#include "../protocols/BroadcastDecoder.h"
+#include "../protocols/VehicleMessages.h"
 
 // Forward declarations
 class VehicleManager;
@@ -42,32 +42,32 @@ public:
      */
     struct State {
         // === From Standard CAN ===
+        // Raw signal values as decoded; converted to physical units on read
         
         // BMS_07 (0x5CA) - Energy and charging
-        float energyWh = 0.0f;
-        float maxEnergyWh = 0.0f;
+        uint16_t energyRaw = 0;           // 50 Wh/bit
+        uint16_t maxEnergyRaw = 0;        // 50 Wh/bit
         bool chargingActive = false;      // CAN broadcast
         bool balancingActive = false;
-        unsigned long energyUpdate = 0;
-        unsigned long balancingUpdate = 0;
+        Freshness energyUpdate;
         
         // BMS_06 (0x59E) - Temperature
-        float temperature = 0.0f;
-        unsigned long tempUpdate = 0;
+        uint8_t temperatureRaw = 0;       // 0.5 C/bit, -40 C offset
+        Freshness tempUpdate;
         
         // Motor_Hybrid_06 (0x483) - Power
-        float powerKw = 0.0f;
-        unsigned long powerUpdate = 0;
+        uint16_t powerRaw = 0;            // 0.01 kW/bit
+        Freshness powerUpdate;
         
         // === From BAP (via BatteryControlChannel) ===
         
         // Plug state (function 0x10)
         PlugState plugState;
         DataSource plugStateSource = DataSource::NONE;
-        unsigned long plugStateUpdate = 0;
+        Freshness plugStateUpdate;
         
         // Charge state (function 0x11)
-        float soc = 0.0f;                 // BAP provides more accurate SOC
+        uint8_t soc = 0;                  // Percent; BAP provides more accurate SOC
         DataSource socSource = DataSource::NONE;
         uint8_t chargingMode = 0;         // BAP detailed charging mode
         uint8_t chargingStatus = 0;       // BAP detailed charging status
@@ -76,8 +76,15 @@ public:
         uint8_t remainingTimeMin = 0;
         bool charging = false;             // Unified (BAP overrides CAN)
         DataSource chargingSource = DataSource::NONE;
-        unsigned long chargingUpdate = 0;
-        unsigned long socUpdate = 0;
+        Freshness chargingUpdate;
+        Freshness socUpdate;
+        
+        // === Physical values ===
+        
+        float energyWh() const { return (float)BroadcastDecoder::Bms07Raw::energyPhysical(energyRaw); }
+        float maxEnergyWh() const { return (float)BroadcastDecoder::Bms07Raw::maxEnergyPhysical(maxEnergyRaw); }
+        float temperature() const { return (float)BroadcastDecoder::Bms06Raw::temperaturePhysical(temperatureRaw); }
+        float powerKw() const { return powerRaw * 0.01f; }
         
         // === Computed ===
         
@@ -85,8 +92,8 @@ public:
          * Calculate energy percentage (current/max)
          */
         float energyPercent() const {
-            if (maxEnergyWh > 0) {
-                return (energyWh / maxEnergyWh) * 100.0f;
+            if (maxEnergyRaw > 0) {
+                return (energyRaw * 100.0f) / maxEnergyRaw;
             }
             return 0.0f;
         }
@@ -95,7 +102,7 @@ public:
          * Check if state is valid (has received data)
          */
         bool isValid() const {
-            return energyUpdate > 0 || socUpdate > 0;
+            return energyUpdate.valid() || socUpdate.valid();
         }
     };
 
@@ -113,6 +120,7 @@ public:
     bool setup() override;
     void loop() override;
     void processCanFrame(uint32_t canId, const uint8_t* data, uint8_t dlc) override;
+    void refreshCanFrame(uint32_t canId, uint8_t dlc) override;
     void onWakeComplete() override;
     bool isBusy() const override;
 
@@ -134,22 +142,22 @@ public:
     /**
      * Get charge state information.
      */
-    float getSoc() const { return state.soc; }
+    uint8_t getSoc() const { return state.soc; }
     bool isCharging() const { return state.charging; }
     bool isPlugged() const { return state.plugState.isPlugged(); }
     
     /**
      * Get energy information.
      */
-    float getEnergyWh() const { return state.energyWh; }
-    float getMaxEnergyWh() const { return state.maxEnergyWh; }
+    float getEnergyWh() const { return state.energyWh(); }
+    float getMaxEnergyWh() const { return state.maxEnergyWh(); }
     float getEnergyPercent() const { return state.energyPercent(); }
     
     /**
      * Get power information.
      */
-    float getPowerKw() const { return state.powerKw; }
-    float getTemperature() const { return state.temperature; }
+    float getPowerKw() const { return state.powerKw(); }
+    float getTemperature() const { return state.temperature(); }
     
     // =========================================================================
     // Command Interface (NEW - Phase 2: Uses domain state machine)
@@ -272,6 +280,6 @@ private:
     void processMotorHybrid06(const uint8_t* data);
     
     // BAP callback handlers (registered in setup)
-    void onPlugStateUpdate(const PlugState& plug);
-    void onChargeStateUpdate(const BatteryState& battery);
+    void onPlugStateUpdate(const PlugStateUpdate& plug);
+    void onChargeStateUpdate(const ChargeStateUpdate& charge);
 };
@@ -65,6 +65,33 @@ void BodyManager::processCanFrame(uint32_t canId, const uint8_t* data, uint8_t d
     }
 }
 
+void BodyManager::refreshCanFrame(uint32_t canId, uint8_t dlc) {
+    // Unchanged payload: same counters and timestamps as processCanFrame(), no decode
+    if (dlc < 8) {
+        return;
+    }
+    
+    switch (canId) {
+        case CAN_ID_DRIVER_DOOR:
+            driverDoorCount++;
+            state.driverDoor.lastUpdate.touch();
+            break;
+            
+        case CAN_ID_PASSENGER_DOOR:
+            passengerDoorCount++;
+            state.passengerDoor.lastUpdate.touch();
+            break;
+            
+        case CAN_ID_LOCK_STATUS:
+            lockStatusCount++;
+            state.centralLockUpdate.touch();
+            break;
+            
+        default:
+            break;
+    }
+}
+
 void BodyManager::onWakeComplete() {
     // No special action needed after wake
 }
@@ -87,7 +114,7 @@ void BodyManager::processDriverDoor(const uint8_t* data) {
     state.driverDoor.open = decoded.doorOpen;
     state.driverDoor.locked = decoded.doorLocked;
     state.driverDoor.windowPosition = decoded.windowPos;
-    state.driverDoor.lastUpdate = millis();
+    state.driverDoor.lastUpdate.touch();
     
     // NO SERIAL OUTPUT - This runs on CAN task (Core 0)
 }
@@ -101,7 +128,7 @@ void BodyManager::processPassengerDoor(const uint8_t* data) {
     state.passengerDoor.open = decoded.doorOpen;
     state.passengerDoor.locked = decoded.doorLocked;
     state.passengerDoor.windowPosition = decoded.windowPos;
-    state.passengerDoor.lastUpdate = millis();
+    state.passengerDoor.lastUpdate.touch();
     
     // NO SERIAL OUTPUT - This runs on CAN task (Core 0)
 }
@@ -118,7 +145,7 @@ void BodyManager::processLockStatus(const uint8_t* data) {
     
     // Update lock state
     state.centralLock = decoded.isLocked ? LockState::LOCKED : LockState::UNLOCKED;
-    state.centralLockUpdate = millis();
+    state.centralLockUpdate.touch();
     
     // NO SERIAL OUTPUT - This runs on CAN task (Core 0)
 }
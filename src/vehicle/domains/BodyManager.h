@@ -37,7 +37,7 @@ public:
     struct State {
         // === Central Lock Status (ZV_02 0x583) ===
         LockState centralLock = LockState::UNKNOWN;
-        unsigned long centralLockUpdate = 0;
+        Freshness centralLockUpdate;
         
         // === Individual Doors ===
         DoorState driverDoor;       // Front left (TSG_FT_01 0x3D0)
@@ -47,7 +47,7 @@ public:
         
         // === Trunk/Hatch ===
         bool trunkOpen = false;
-        unsigned long trunkUpdate = 0;
+        Freshness trunkUpdate;
         
         // === Raw Debug Data ===
         uint8_t zv02_byte2 = 0;     // For debugging lock state parsing
@@ -69,7 +69,7 @@ public:
         }
         
         bool isValid() const {
-            return centralLockUpdate > 0 || driverDoor.lastUpdate > 0;
+            return centralLockUpdate.valid() || driverDoor.lastUpdate.valid();
         }
     };
 
@@ -87,6 +87,7 @@ public:
     bool setup() override;
     void loop() override;
     void processCanFrame(uint32_t canId, const uint8_t* data, uint8_t dlc) override;
+    void refreshCanFrame(uint32_t canId, uint8_t dlc) override;
     void onWakeComplete() override;
     bool isBusy() const override;
 
@@ -40,9 +40,7 @@ bool ClimateManager::setup() {
     Serial.println("[ClimateManager] Registering BAP callback (SHARED channel)...");
     
     // Climate state callback (function 0x12)
-    bapChannel->onClimateState([this](const ClimateState& climate) {
-        this->onClimateStateUpdate(climate);
-    });
+    bapChannel->bindClimateState<ClimateManager, &ClimateManager::onClimateStateUpdate>(this);
     
     Serial.println("[ClimateManager] Initialized:");
     Serial.println("[ClimateManager]   - CAN IDs: 0x66E (Klima_03), 0x5E1 (Klima_Sensor_02)");
@@ -81,6 +79,25 @@ void ClimateManager::processCanFrame(uint32_t canId, const uint8_t* data, uint8_
     }
 }
 
+void ClimateManager::refreshCanFrame(uint32_t canId, uint8_t dlc) {
+    // Unchanged payload: same counters and timestamps as processCanFrame(), no decode
+    if (dlc < 8) {
+        return;
+    }
+    
+    switch (canId) {
+        case CAN_ID_KLIMA_SENSOR_02:
+            klimaSensor02Count++;
+            state.outsideTempUpdate.touch();
+            break;
+            
+        default:
+            // Klima_03 is not cached: whether its inside temperature applies
+            // depends on BAP freshness, not only on the payload
+            break;
+    }
+}
+
 void ClimateManager::onWakeComplete() {
     // Optional: Request initial BAP state after wake
     // For now, BAP channel will send updates automatically
@@ -101,15 +118,15 @@ void ClimateManager::processKlima03(const uint8_t* data) {
     // Note: CAN climate active flags are unreliable - use BAP only for active status
     klima03Count++;
     
-    BroadcastDecoder::KlimaData decoded = BroadcastDecoder::decodeKlima03(data);
+    BroadcastDecoder::Klima03Raw decoded = BroadcastDecoder::decodeKlima03Raw(data);
     
     // Update inside temperature (CAN source - only if BAP hasn't updated recently)
     // BAP takes priority when climate is actively controlled
     if (state.insideTempSource != DataSource::BAP || 
-        (millis() - state.insideTempUpdate) > 5000) {
-        state.insideTemp = decoded.insideTemp;
+        state.insideTempUpdate.ageSec() > 5) {
+        state.insideTempDeci = (int16_t)(decoded.insideTemp * 5 - 500);  // 0.5 C, -50 C -> 0.1 C
         state.insideTempSource = DataSource::CAN_STD;
-        state.insideTempUpdate = millis();
+        state.insideTempUpdate.touch();
     }
     
     // NO SERIAL OUTPUT - This runs on CAN task (Core 0)
@@ -120,11 +137,8 @@ void ClimateManager::processKlimaSensor02(const uint8_t* data) {
     // BCM1_Aussen_Temp_ungef: Byte 0, scale 0.5, offset -50
     klimaSensor02Count++;
     
-    uint8_t rawTemp = data[0];
-    float outsideTemp = rawTemp * 0.5f - 50.0f;
-    
-    state.outsideTemp = outsideTemp;
-    state.outsideTempUpdate = millis();
+    state.outsideTempRaw = BroadcastDecoder::decodeKlimaSensor02Raw(data).outsideTemp;
+    state.outsideTempUpdate.touch();
     
     // NO SERIAL OUTPUT - This runs on CAN task (Core 0)
 }
@@ -133,26 +147,32 @@ void ClimateManager::processKlimaSensor02(const uint8_t* data) {
 // BAP Callback Handler
 // =============================================================================
 
-void ClimateManager::onClimateStateUpdate(const ClimateState& climate) {
+void ClimateManager::onClimateStateUpdate(const ClimateStateUpdate& climate) {
     // Called from CAN thread via BatteryControlChannel callback
-    // Keep FAST - just copy data
+    // Keep FAST - copy changed fields, refresh freshness on every update
     climateCallbackCount++;
+    typedef ClimateStateUpdate::Field Field;
     
     // BAP climate state is authoritative
-    state.climateActive = climate.climateActive;
+    if (climate.changed & (Field::ALL & ~Field::INSIDE_TEMP)) {
+        state.climateActive = climate.climateActive;
+        state.heating = climate.heating;
+        state.cooling = climate.cooling;
+        state.ventilation = climate.ventilation;
+        state.autoDefrost = climate.autoDefrost;
+        state.climateTimeMin = climate.climateTimeMin;
+    }
     state.climateActiveSource = DataSource::BAP;
-    state.heating = climate.heating;
-    state.cooling = climate.cooling;
-    state.ventilation = climate.ventilation;
-    state.autoDefrost = climate.autoDefrost;
-    state.climateTimeMin = climate.climateTimeMin;
-    state.climateActiveUpdate = millis();
-    
-    // Also update inside temp if provided by BAP (more accurate during active climate)
-    if (climate.insideTemp > 0.0f) {
-        state.insideTemp = climate.insideTemp;
+    state.climateActiveUpdate.touch();
+    
+    // Also update inside temp if provided by BAP (more accurate during active
+    // climate); CAN takes over once it goes stale, so re-copy after that
+    if (climate.insideTempDeci > 0) {
+        if ((climate.changed & Field::INSIDE_TEMP) || state.insideTempSource != DataSource::BAP) {
+            state.insideTempDeci = climate.insideTempDeci;
+        }
         state.insideTempSource = DataSource::BAP;
-        state.insideTempUpdate = millis();
+        state.insideTempUpdate = state.climateActiveUpdate;
     }
     
     // NO SERIAL OUTPUT - This runs on CAN task (Core 0)
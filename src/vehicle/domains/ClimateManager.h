@@ -3,7 +3,7 @@
 #include <Arduino.h>
 #include "../IDomain.h"
 #include "../VehicleTypes.h"
-#include "../protocols/BroadcastDecoder.h"
+#include "../protocols/VehicleMessages.h"
 
 // Forward declarations
 class VehicleManager;
@@ -44,13 +44,14 @@ public:
         // === From Standard CAN ===
         
         // Klima_03 (0x66E) - Inside temperature
-        float insideTemp = 0.0f;
+        // Kept in 0.1 C so CAN (0.5 C steps) and BAP (0.1 C) share one field
+        int16_t insideTempDeci = 0;
         DataSource insideTempSource = DataSource::NONE;
-        unsigned long insideTempUpdate = 0;
+        Freshness insideTempUpdate;
         
         // Klima_Sensor_02 (0x5E1) - Outside temperature
-        float outsideTemp = 0.0f;
-        unsigned long outsideTempUpdate = 0;
+        uint8_t outsideTempRaw = 0;        // 0.5 C/bit, -50 C offset
+        Freshness outsideTempUpdate;
         
         // === From BAP (via BatteryControlChannel function 0x12) ===
         
@@ -62,7 +63,12 @@ public:
         bool ventilation = false;
         bool autoDefrost = false;
         uint16_t climateTimeMin = 0;       // Remaining time in minutes
-        unsigned long climateActiveUpdate = 0;
+        Freshness climateActiveUpdate;
+        
+        // === Physical values ===
+        
+        float insideTemp() const { return insideTempDeci * 0.1f; }
+        float outsideTemp() const { return (float)BroadcastDecoder::KlimaSensor02Raw::outsideTempPhysical(outsideTempRaw); }
         
         // === Computed ===
         
@@ -77,7 +83,7 @@ public:
          * Check if state is valid (has received data)
          */
         bool isValid() const {
-            return insideTempUpdate > 0 || outsideTempUpdate > 0;
+            return insideTempUpdate.valid() || outsideTempUpdate.valid();
         }
     };
 
@@ -95,6 +101,7 @@ public:
     bool setup() override;
     void loop() override;
     void processCanFrame(uint32_t canId, const uint8_t* data, uint8_t dlc) override;
+    void refreshCanFrame(uint32_t canId, uint8_t dlc) override;
     void onWakeComplete() override;
     bool isBusy() const override;
 
@@ -111,8 +118,8 @@ public:
     /**
      * Get temperature information.
      */
-    float getInsideTemp() const { return state.insideTemp; }
-    float getOutsideTemp() const { return state.outsideTemp; }
+    float getInsideTemp() const { return state.insideTemp(); }
+    float getOutsideTemp() const { return state.outsideTemp(); }
     
     /**
      * Get climate control status (BAP-only).
@@ -244,5 +251,5 @@ private:
     void processKlimaSensor02(const uint8_t* data);
     
     // BAP callback handler (registered in setup)
-    void onClimateStateUpdate(const ClimateState& climate);
+    void onClimateStateUpdate(const ClimateStateUpdate& climate);
 };
@@ -46,6 +46,31 @@ void DriveManager::processCanFrame(uint32_t canId, const uint8_t* data, uint8_t
     }
 }
 
+void DriveManager::refreshCanFrame(uint32_t canId, uint8_t dlc) {
+    // Unchanged payload: same counters and timestamps as processCanFrame(), no decode
+    switch (canId) {
+        case CAN_ID_IGNITION:
+            if (dlc >= 4) {
+                ignitionCount++;
+                state.ignitionUpdate.touch();
+            }
+            break;
+        case CAN_ID_SPEED:
+            if (dlc >= 8) {
+                speedCount++;
+                state.speedUpdate.touch();
+            }
+            break;
+        case CAN_ID_DIAGNOSE:
+            if (dlc >= 8) {
+                diagnoseCount++;
+                state.odometerUpdate.touch();
+                state.timeUpdate.touch();
+            }
+            break;
+    }
+}
+
 void DriveManager::onWakeComplete() {}
 bool DriveManager::isBusy() const { return false; }
 
@@ -56,7 +81,7 @@ void DriveManager::processIgnition(const uint8_t* data) {
     state.keyInserted = decoded.keyInserted;
     state.ignitionOn = decoded.ignitionOn;
     state.startRequested = decoded.startRequested;
-    state.ignitionUpdate = millis();
+    state.ignitionUpdate.touch();
     
     if (decoded.startRequested) state.ignition = IgnitionState::START;
     else if (decoded.ignitionOn) state.ignition = IgnitionState::ON;
@@ -66,8 +91,8 @@ void DriveManager::processIgnition(const uint8_t* data) {
 
 void DriveManager::processSpeed(const uint8_t* data) {
     speedCount++;
-    state.speedKmh = BroadcastDecoder::decodeSpeed(data);
-    state.speedUpdate = millis();
+    state.speedRaw = BroadcastDecoder::decodeEsp21Raw(data).speed;
+    state.speedUpdate.touch();
 }
 
 void DriveManager::processDiagnose(const uint8_t* data) {
@@ -75,12 +100,12 @@ void DriveManager::processDiagnose(const uint8_t* data) {
     auto decoded = BroadcastDecoder::decodeDiagnose(data);
     
     state.odometerKm = decoded.odometerKm;
-    state.odometerUpdate = millis();
+    state.odometerUpdate.touch();
     state.year = decoded.year;
     state.month = decoded.month;
     state.day = decoded.day;
     state.hour = decoded.hour;
     state.minute = decoded.minute;
     state.second = decoded.second;
-    state.timeUpdate = millis();
+    state.timeUpdate.touch();
 }
@@ -3,7 +3,7 @@
 #include <Arduino.h>
 #include "../IDomain.h"
 #include "../VehicleTypes.h"
-#include "../protocols/BroadcastDecoder.h"
+#include "../protocols/VehicleMessages.h"
 
 // Forward declaration
 class VehicleManager;
@@ -39,15 +39,15 @@ public:
         bool keyInserted = false;
         bool ignitionOn = false;
         bool startRequested = false;
-        unsigned long ignitionUpdate = 0;
+        Freshness ignitionUpdate;
         
         // === Speed (ESP_21 0x0FD) ===
-        float speedKmh = 0.0f;
-        unsigned long speedUpdate = 0;
+        uint16_t speedRaw = 0;             // 0.01 km/h per bit
+        Freshness speedUpdate;
         
         // === Odometer & Time (Diagnose_01 0x6B2) ===
         uint32_t odometerKm = 0;
-        unsigned long odometerUpdate = 0;
+        Freshness odometerUpdate;
         
         uint16_t year = 0;
         uint8_t month = 0;
@@ -55,20 +55,24 @@ public:
         uint8_t hour = 0;
         uint8_t minute = 0;
         uint8_t second = 0;
-        unsigned long timeUpdate = 0;
+        Freshness timeUpdate;
         
         // === Helper Methods ===
         
+        float speedKmh() const {
+            return (float)BroadcastDecoder::Esp21Raw::speedPhysical(speedRaw);
+        }
+        
         bool isOn() const {
             return ignition == IgnitionState::ON || ignition == IgnitionState::START;
         }
         
         bool isMoving() const {
-            return speedKmh > 1.0f;
+            return speedRaw > 100;  // > 1 km/h
         }
         
         bool isValid() const {
-            return ignitionUpdate > 0 || speedUpdate > 0;
+            return ignitionUpdate.valid() || speedUpdate.valid();
         }
     };
 
@@ -86,6 +90,7 @@ public:
     bool setup() override;
     void loop() override;
     void processCanFrame(uint32_t canId, const uint8_t* data, uint8_t dlc) override;
+    void refreshCanFrame(uint32_t canId, uint8_t dlc) override;
     void onWakeComplete() override;
     bool isBusy() const override;
 
@@ -109,7 +114,7 @@ public:
     /**
      * Get speed information.
      */
-    float getSpeedKmh() const { return state.speedKmh; }
+    float getSpeedKmh() const { return state.speedKmh(); }
     bool isMoving() const { return state.isMoving(); }
     
     /**
@@ -21,6 +21,7 @@ bool GpsManager::setup() {
     Serial.println("[GpsManager] Initializing...");
     Serial.println("[GpsManager] Initialized:");
     Serial.println("[GpsManager]   - CAN IDs: 0x486 (NavPos_01), 0x485 (NavData_02), 0x484 (NavData_01)");
+    Serial.println("[GpsManager]   - Extended: 0x1A5554A8 (NavPos_02_Map_Matched, multiplexed)");
     Serial.println("[GpsManager]   - Data: position, altitude, satellites, heading, DOP");
     Serial.println("[GpsManager]   - Read-only domain (no commands)");
     return true;
@@ -41,6 +42,29 @@ void GpsManager::processCanFrame(uint32_t canId, const uint8_t* data, uint8_t dl
         case CAN_ID_NAV_DATA_01:
             processNavData01(data);
             break;
+        case CAN_ID_NAV_POS_02:
+            processNavPos02(data);
+            break;
+    }
+}
+
+void GpsManager::refreshCanFrame(uint32_t canId, uint8_t dlc) {
+    // Unchanged payload: same counters and timestamps as processCanFrame(), no decode
+    if (dlc < 8) return;
+    
+    switch (canId) {
+        case CAN_ID_NAV_POS_01:
+            navPos01Count++;
+            state.positionUpdate.touch();
+            break;
+        case CAN_ID_NAV_DATA_02:
+            navData02Count++;
+            state.altitudeUpdate.touch();
+            break;
+        case CAN_ID_NAV_DATA_01:
+            navData01Count++;
+            state.headingUpdate.touch();
+            break;
     }
 }
 
@@ -49,32 +73,50 @@ bool GpsManager::isBusy() const { return false; }
 
 void GpsManager::processNavPos01(const uint8_t* data) {
     navPos01Count++;
-    auto decoded = BroadcastDecoder::decodeNavPos01(data);
-    state.latitude = decoded.latitude;
-    state.longitude = decoded.longitude;
+    auto decoded = BroadcastDecoder::decodeNavPos01Raw(data);
+    state.latitudeRaw = decoded.latitude;
+    state.longitudeRaw = decoded.longitude;
+    state.latSouth = decoded.latSouth;
+    state.longWest = decoded.longWest;
     state.satellites = decoded.satellites;
     state.fixType = decoded.fixType;
-    state.positionUpdate = millis();
+    state.positionUpdate.touch();
 }
 
 void GpsManager::processNavData02(const uint8_t* data) {
     navData02Count++;
-    auto decoded = BroadcastDecoder::decodeNavData02(data);
-    state.altitude = decoded.altitude;
+    auto decoded = BroadcastDecoder::decodeNavData02Raw(data);
+    state.altitudeRaw = decoded.altitude;
     state.utcTime = decoded.utcTime;
     state.satsInUse = decoded.satsInUse;
     state.satsInView = decoded.satsInView;
-    state.accuracy = decoded.accuracy;
-    state.altitudeUpdate = millis();
+    state.accuracyRaw = decoded.accuracy;
+    state.altitudeUpdate.touch();
 }
 
 void GpsManager::processNavData01(const uint8_t* data) {
     navData01Count++;
-    auto decoded = BroadcastDecoder::decodeNavData01(data);
-    state.heading = decoded.heading;
-    state.hdop = decoded.hdop;
-    state.vdop = decoded.vdop;
-    state.pdop = decoded.pdop;
+    auto decoded = BroadcastDecoder::decodeNavData01Raw(data);
+    state.headingRaw = decoded.heading;
+    state.hdopRaw = decoded.hdop;
+    state.vdopRaw = decoded.vdop;
+    state.pdopRaw = decoded.pdop;
     state.gpsInit = decoded.gpsInit;
-    state.headingUpdate = millis();
+    state.headingUpdate.touch();
+}
+
+void GpsManager::processNavPos02(const uint8_t* data) {
+    navPos02Count++;
+    // Decodes only the page selected by POS_Mux; other pages keep their last value
+    if (!BroadcastDecoder::decodeNavPos02MapMatchedRaw(data, state.mapMatched)) {
+        return;
+    }
+    switch (state.mapMatched.mux) {
+        case 0:
+            state.mapPositionUpdate.touch();
+            break;
+        case 1:
+            state.mapHeadingUpdate.touch();
+            break;
+    }
 }
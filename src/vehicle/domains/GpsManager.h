@@ -3,7 +3,7 @@
 #include <Arduino.h>
 #include "../IDomain.h"
 #include "../VehicleTypes.h"
-#include "../protocols/BroadcastDecoder.h"
+#include "../protocols/VehicleMessages.h"
 
 // Forward declaration
 class VehicleManager;
@@ -13,6 +13,7 @@ class VehicleManager;
  * 
  * Encapsulates ALL GPS data sources from infotainment:
  * - Standard CAN frames (11-bit): 0x486 (NavPos_01), 0x485 (NavData_02), 0x484 (NavData_01)
+ * - Extended CAN frame (29-bit): 0x1A5554A8 (NavPos_02_Map_Matched, multiplexed)
  * 
  * Implements new domain-based architecture:
  * - Owns complete GPS state (position, altitude, satellites, DOP)
@@ -34,34 +35,77 @@ public:
      */
     struct State {
         // === Position (NavPos_01 0x486) ===
-        double latitude = 0.0;
-        double longitude = 0.0;
+        // Raw signal values as decoded; converted to physical units on read
+        uint32_t latitudeRaw = 0;          // 1e-6 deg per bit, sign in latSouth
+        uint32_t longitudeRaw = 0;         // 1e-6 deg per bit, sign in longWest
+        bool latSouth = false;
+        bool longWest = false;
         uint8_t satellites = 0;
         uint8_t fixType = 0;  // 0=none, 1=2D, 2=3D, 3=DGPS
-        unsigned long positionUpdate = 0;
+        Freshness positionUpdate;
         
         // === Altitude (NavData_02 0x485) ===
-        float altitude = 0.0f;
+        uint16_t altitudeRaw = 0;          // 2 m per bit, -500 m offset
         uint32_t utcTime = 0;
         uint8_t satsInUse = 0;
         uint8_t satsInView = 0;
-        uint8_t accuracy = 0;
-        unsigned long altitudeUpdate = 0;
+        uint8_t accuracyRaw = 0;           // 2 m per bit
+        Freshness altitudeUpdate;
         
         // === Heading & DOP (NavData_01 0x484) ===
-        float heading = 0.0f;
-        float hdop = 0.0f;
-        float vdop = 0.0f;
-        float pdop = 0.0f;
+        uint16_t headingRaw = 0;           // 0.1 deg per bit
+        uint16_t hdopRaw = 0;              // 0.025 per bit
+        uint16_t vdopRaw = 0;
+        uint16_t pdopRaw = 0;
         bool gpsInit = false;
-        unsigned long headingUpdate = 0;
+        Freshness headingUpdate;
+        
+        // === Map-matched position (NavPos_02_Map_Matched 0x1A5554A8) ===
+        // Multiplexed: each frame carries one page, the struct keeps the
+        // last value of every page
+        BroadcastDecoder::NavPos02MapMatchedRaw mapMatched;
+        Freshness mapPositionUpdate;       // Page 0 (lat/long)
+        Freshness mapHeadingUpdate;        // Page 1 (heading, sync age, UTC)
+        
+        // === Physical values ===
+        
+        double latitude() const {
+            double deg = BroadcastDecoder::NavPos01Raw::latitudePhysical(latitudeRaw);
+            return latSouth ? -deg : deg;
+        }
+        double longitude() const {
+            double deg = BroadcastDecoder::NavPos01Raw::longitudePhysical(longitudeRaw);
+            return longWest ? -deg : deg;
+        }
+        float altitude() const { return (float)BroadcastDecoder::NavData02Raw::altitudePhysical(altitudeRaw); }
+        uint8_t accuracy() const { return (uint8_t)BroadcastDecoder::NavData02Raw::accuracyPhysical(accuracyRaw); }
+        float heading() const { return (float)BroadcastDecoder::NavData01Raw::headingPhysical(headingRaw); }
+        float hdop() const { return (float)BroadcastDecoder::NavData01Raw::hdopPhysical(hdopRaw); }
+        float vdop() const { return (float)BroadcastDecoder::NavData01Raw::vdopPhysical(vdopRaw); }
+        float pdop() const { return (float)BroadcastDecoder::NavData01Raw::pdopPhysical(pdopRaw); }
+        
+        double mapLatitude() const {
+            double deg = BroadcastDecoder::NavPos02MapMatchedPositionRaw::latitudePhysical(mapMatched.position.latitude);
+            return mapMatched.position.latSouth ? -deg : deg;
+        }
+        double mapLongitude() const {
+            double deg = BroadcastDecoder::NavPos02MapMatchedPositionRaw::longitudePhysical(mapMatched.position.longitude);
+            return mapMatched.position.longWest ? -deg : deg;
+        }
+        float mapHeading() const {
+            return (float)BroadcastDecoder::NavPos02MapMatchedHeadingRaw::headingPhysical(mapMatched.heading.heading);
+        }
         
         // === Helper Methods ===
         
         bool hasFix() const { return fixType >= 2; }
         
         bool isValid() const {
-            return hasFix() && (millis() - positionUpdate) < 30000;
+            return hasFix() && positionUpdate.valid() && positionUpdate.ageSec() < 30;
+        }
+        
+        bool isMapMatchedValid() const {
+            return mapPositionUpdate.valid() && mapPositionUpdate.ageSec() < 30;
         }
         
         const char* fixTypeStr() const {
@@ -82,15 +126,16 @@ public:
     bool setup() override;
     void loop() override;
     void processCanFrame(uint32_t canId, const uint8_t* data, uint8_t dlc) override;
+    void refreshCanFrame(uint32_t canId, uint8_t dlc) override;
     void onWakeComplete() override;
     bool isBusy() const override;
 
     // Public API
     const State& getState() const { return state; }
-    double getLatitude() const { return state.latitude; }
-    double getLongitude() const { return state.longitude; }
-    float getAltitude() const { return state.altitude; }
-    float getHeading() const { return state.heading; }
+    double getLatitude() const { return state.latitude(); }
+    double getLongitude() const { return state.longitude(); }
+    float getAltitude() const { return state.altitude(); }
+    float getHeading() const { return state.heading(); }
     uint8_t getSatellites() const { return state.satellites; }
     bool hasFix() const { return state.hasFix(); }
     bool isValid() const { return state.isValid(); }
@@ -101,6 +146,7 @@ public:
         data02 = navData02Count;
         data01 = navData01Count;
     }
+    uint32_t getMapMatchedCount() const { return navPos02Count; }
 
 private:
     VehicleManager* vehicleManager;
@@ -111,12 +157,15 @@ private:
     static constexpr uint32_t CAN_ID_NAV_POS_01 = 0x486;
     static constexpr uint32_t CAN_ID_NAV_DATA_02 = 0x485;
     static constexpr uint32_t CAN_ID_NAV_DATA_01 = 0x484;
+    static constexpr uint32_t CAN_ID_NAV_POS_02 = 0x1A5554A8;   // Extended
     
     volatile uint32_t navPos01Count = 0;
     volatile uint32_t navData02Count = 0;
     volatile uint32_t navData01Count = 0;
+    volatile uint32_t navPos02Count = 0;
     
     void processNavPos01(const uint8_t* data);
     void processNavData02(const uint8_t* data);
     void processNavData01(const uint8_t* data);
+    void processNavPos02(const uint8_t* data);
 };
@@ -41,12 +41,28 @@ void RangeManager::processCanFrame(uint32_t canId, const uint8_t* data, uint8_t
     }
 }
 
+void RangeManager::refreshCanFrame(uint32_t canId, uint8_t dlc) {
+    // Unchanged payload: same counters and timestamps as processCanFrame(), no decode
+    if (dlc < 8) return;
+    
+    switch (canId) {
+        case CAN_ID_REICHWEITE_01:
+            reichweite01Count++;
+            state.rangeUpdate.touch();
+            break;
+        case CAN_ID_REICHWEITE_02:
+            reichweite02Count++;
+            state.displayUpdate.touch();
+            break;
+    }
+}
+
 void RangeManager::onWakeComplete() {}
 bool RangeManager::isBusy() const { return false; }
 
 void RangeManager::processReichweite01(const uint8_t* data) {
     reichweite01Count++;
-    auto decoded = BroadcastDecoder::decodeReichweite01(data);
+    auto decoded = BroadcastDecoder::decodeReichweite01Raw(data);
     
     // Skip invalid values (2045-2047)
     if (decoded.totalRange < State::INVALID_RANGE) {
@@ -56,8 +72,8 @@ void RangeManager::processReichweite01(const uint8_t* data) {
         state.electricRangeKm = decoded.electricRange;
     }
     
-    state.consumptionKwh100km = decoded.consumption;
-    state.rangeUpdate = millis();
+    state.consumptionRaw = decoded.consumption;
+    state.rangeUpdate.touch();
 }
 
 void RangeManager::processReichweite02(const uint8_t* data) {
@@ -71,5 +87,5 @@ void RangeManager::processReichweite02(const uint8_t* data) {
     
     state.tendency = static_cast<RangeTendency>(decoded.tendency);
     state.reserveWarning = decoded.reserveWarning;
-    state.displayUpdate = millis();
+    state.displayUpdate.touch();
 }
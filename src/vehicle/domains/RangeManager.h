@@ -3,7 +3,7 @@
 #include <Arduino.h>
 #include "../IDomain.h"
 #include "../VehicleTypes.h"
-#include "../protocols/BroadcastDecoder.h"
+#include "../protocols/VehicleMessages.h"
 
 // Forward declaration
 class VehicleManager;
@@ -36,17 +36,21 @@ public:
         // === Range Data (Reichweite_01 0x5F5) ===
         uint16_t totalRangeKm = 0;
         uint16_t electricRangeKm = 0;
-        uint16_t consumptionKwh100km = 0;
-        unsigned long rangeUpdate = 0;
+        uint16_t consumptionRaw = 0;       // 0.1 kWh/100km per bit
+        Freshness rangeUpdate;
         
         // === Display Data (Reichweite_02 0x5F7) ===
         uint16_t displayRangeKm = 0;
         RangeTendency tendency = RangeTendency::STABLE;
         bool reserveWarning = false;
-        unsigned long displayUpdate = 0;
+        Freshness displayUpdate;
         
         // === Helper Methods ===
         
+        float consumptionKwh100km() const {
+            return (float)BroadcastDecoder::Reichweite01Raw::consumptionPhysical(consumptionRaw);
+        }
+        
         bool isValid() const {
             return totalRangeKm < INVALID_RANGE && totalRangeKm > 0;
         }
@@ -70,6 +74,7 @@ public:
     bool setup() override;
     void loop() override;
     void processCanFrame(uint32_t canId, const uint8_t* data, uint8_t dlc) override;
+    void refreshCanFrame(uint32_t canId, uint8_t dlc) override;
     void onWakeComplete() override;
     bool isBusy() const override;
 
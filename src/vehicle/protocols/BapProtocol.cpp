@@ -94,8 +94,8 @@ uint8_t encodeLongStart(uint8_t* dest, uint8_t opcode, uint8_t deviceId,
     // Format: [1][0][GG][0000] = 0x80 | (group << 4)
     dest[0] = 0x80 | ((group & 0x03) << 4);
     
-    // Byte 1: total length (includes 2-byte header)
-    dest[1] = totalPayloadLen + 2;
+    // Byte 1: payload length (BAP header not included, as BapFrameAssembler reads it)
+    dest[1] = totalPayloadLen;
     
     // Bytes 2-3: BAP header
     encodeHeader(dest + 2, opcode, deviceId, functionId);
@@ -134,28 +134,70 @@ uint8_t encodeLongContinuation(uint8_t* dest, const uint8_t* payload,
     return 8;
 }
 
+uint8_t encodeMessage(uint8_t frames[][8], uint8_t opcode, uint8_t deviceId, uint8_t functionId,
+                      const uint8_t* payload, uint8_t payloadLen, uint8_t group) {
+    if (payloadLen > 127) {
+        return 0;
+    }
+    
+    // Short message: payload ≤ 6 bytes
+    if (payloadLen <= 6) {
+        encodeShortMessage(frames[0], opcode, deviceId, functionId, payload, payloadLen);
+        return 1;
+    }
+    
+    // Long message: start frame carries the first 4 bytes of payload
+    encodeLongStart(frames[0], opcode, deviceId, functionId, payloadLen, payload, group);
+    uint8_t frameCount = 1;
+    
+    // Continuation frames (7 bytes of payload each)
+    uint8_t payloadOffset = 4;
+    uint8_t contIndex = 0;
+    
+    while (payloadOffset < payloadLen) {
+        uint8_t chunkLen = (payloadLen - payloadOffset > 7) ? 7 : (payloadLen - payloadOffset);
+        encodeLongContinuation(frames[frameCount], payload + payloadOffset, chunkLen, group, contIndex);
+        frameCount++;
+        payloadOffset += chunkLen;
+        contIndex = (contIndex + 1) & 0x0F;  // Wrap at 16
+    }
+    
+    return frameCount;
+}
+
 // =============================================================================
-// BAP Frame Assembler Implementation (Backward Search Approach)
+// BAP Frame Assembler Implementation (Per-Group Lists, Timed Eviction)
 // =============================================================================
 
-bool BapFrameAssembler::processFrame(const uint8_t* data, uint8_t dlc, BapMessage& outMsg) {
+template<size_t MaxPending>
+BasicBapFrameAssembler<MaxPending>::BasicBapFrameAssembler() {
+    reset();
+}
+
+template<size_t MaxPending>
+bool BasicBapFrameAssembler<MaxPending>::processFrame(const uint8_t* data, uint8_t dlc, BapMessageView& outMsg, uint32_t nowMs) {
+    // The previous message's view ends here
+    release();
+    
     if (dlc < 2) {
         return false;
     }
     
+    // Periodic sweep so a lost continuation does not hold its slot forever
+    if (pendingCount > 0 && nowMs - lastSweepMs >= SWEEP_INTERVAL_MS) {
+        expireStale(nowMs);
+    }
+    
     // Decode the frame header
     BapHeader header = decodeHeader(data, dlc);
     
     if (!header.isLong) {
-        // Short message - complete in single frame
+        // Short message - complete in single frame, payload read in place
         outMsg.opcode = header.opcode;
         outMsg.deviceId = header.deviceId;
         outMsg.functionId = header.functionId;
         outMsg.payloadLen = getShortPayloadLength(dlc);
-        
-        if (outMsg.payloadLen > 0) {
-            memcpy(outMsg.payload, getShortPayload(data), outMsg.payloadLen);
-        }
+        outMsg.payload = getShortPayload(data);
         
         shortMessagesDecoded++;
         return true;
@@ -170,32 +212,19 @@ bool BapFrameAssembler::processFrame(const uint8_t* data, uint8_t dlc, BapMessag
         uint8_t payloadLength = header.totalLength;
         
         // Add new pending message
-        int8_t idx = addPendingMessage(header.group, header.opcode, 
-                                        header.deviceId, header.functionId, payloadLength);
-        if (idx < 0) {
+        uint8_t slot = addPendingMessage(header.group, header.opcode, 
+                                         header.deviceId, header.functionId, payloadLength, nowMs);
+        if (slot == NO_SLOT) {
             pendingOverflows++;
             return false;  // No room for more pending messages
         }
         
-        PendingMessage& pm = pending[idx];
-        
         // Copy first chunk of payload (bytes 4-7, up to 4 bytes)
         uint8_t firstChunkLen = (dlc > 4) ? (dlc - 4) : 0;
-        if (firstChunkLen > 0 && pm.assembledLength + firstChunkLen <= MAX_PAYLOAD_SIZE) {
-            memcpy(pm.buffer + pm.assembledLength, data + 4, firstChunkLen);
-            pm.assembledLength += firstChunkLen;
-        }
         
         // Check if message is complete (small long message that fits in start frame)
-        if (pm.assembledLength >= pm.expectedLength) {
-            outMsg.opcode = pm.opcode;
-            outMsg.deviceId = pm.deviceId;
-            outMsg.functionId = pm.functionId;
-            outMsg.payloadLen = pm.expectedLength;
-            memcpy(outMsg.payload, pm.buffer, pm.expectedLength);
-            
-            removePendingMessage(idx);
-            longMessagesDecoded++;
+        if (appendPayload(pending[slot], data + 4, firstChunkLen)) {
+            completeMessage(slot, outMsg);
             return true;
         }
         
@@ -205,42 +234,29 @@ bool BapFrameAssembler::processFrame(const uint8_t* data, uint8_t dlc, BapMessag
         // Long message CONTINUATION frame
         longContFrames++;
         
-        // Search for pending message matching group and expecting this index
-        int8_t idx = findPendingMessage(header.group, header.index);
-        if (idx < 0) {
+        // Search the group for the pending message expecting this index
+        uint8_t slot = findPendingMessage(header.group, header.index);
+        if (slot == NO_SLOT) {
             continuationErrors++;
             return false;  // No matching start frame found
         }
         
-        PendingMessage& pm = pending[idx];
-        
-        // Append payload (bytes 1-7, up to 7 bytes)
-        uint8_t chunkLen = (dlc > 1) ? (dlc - 1) : 0;
-        
-        // Limit to only copy what's needed to reach expectedLength
-        uint8_t remaining = pm.expectedLength - pm.assembledLength;
-        if (chunkLen > remaining) {
-            chunkLen = remaining;
-        }
-        
-        if (chunkLen > 0 && pm.assembledLength + chunkLen <= MAX_PAYLOAD_SIZE) {
-            memcpy(pm.buffer + pm.assembledLength, data + 1, chunkLen);
-            pm.assembledLength += chunkLen;
+        PendingMessage& pm = pending[slot];
+        if (nowMs - pm.lastFrameMs >= PENDING_TIMEOUT_MS) {
+            // Too late to belong to this message: drop both
+            removePendingMessage(slot);
+            timeoutEvictions++;
+            continuationErrors++;
+            return false;
         }
+        pm.lastFrameMs = nowMs;
         
         // Increment expected index for next continuation (wraps at 16)
         pm.nextExpectedIndex = (pm.nextExpectedIndex + 1) & 0x0F;
         
-        // Check if message is complete
-        if (pm.assembledLength >= pm.expectedLength) {
-            outMsg.opcode = pm.opcode;
-            outMsg.deviceId = pm.deviceId;
-            outMsg.functionId = pm.functionId;
-            outMsg.payloadLen = pm.expectedLength;
-            memcpy(outMsg.payload, pm.buffer, pm.expectedLength);
-            
-            removePendingMessage(idx);
-            longMessagesDecoded++;
+        // Append payload (bytes 1-7, up to 7 bytes) and check if message is complete
+        if (appendPayload(pm, data + 1, dlc - 1)) {
+            completeMessage(slot, outMsg);
             return true;
         }
         
@@ -248,89 +264,173 @@ bool BapFrameAssembler::processFrame(const uint8_t* data, uint8_t dlc, BapMessag
     }
 }
 
-int8_t BapFrameAssembler::findPendingMessage(uint8_t group, uint8_t index) {
-    // Search backwards through ALL slots to find one matching group
-    // and expecting this specific continuation index
-    for (int8_t i = MAX_PENDING_MESSAGES - 1; i >= 0; i--) {
-        if (pending[i].active && 
-            pending[i].group == group &&
-            pending[i].nextExpectedIndex == index &&
-            pending[i].assembledLength < pending[i].expectedLength) {
-            return i;
+template<size_t MaxPending>
+bool BasicBapFrameAssembler<MaxPending>::appendPayload(PendingMessage& pm, const uint8_t* chunk, uint8_t chunkLen) {
+    // Limit to only copy what's needed to reach expectedLength
+    uint8_t remaining = pm.expectedLength - pm.assembledLength;
+    if (chunkLen > remaining) {
+        chunkLen = remaining;
+    }
+    
+    if (chunkLen > 0 && pm.assembledLength + chunkLen <= MAX_PAYLOAD_SIZE) {
+        memcpy(pm.buffer + pm.assembledLength, chunk, chunkLen);
+        pm.assembledLength += chunkLen;
+        bufferedBytes += chunkLen;
+        if (bufferedBytes > maxBufferedBytes) {
+            maxBufferedBytes = bufferedBytes;
         }
     }
-    return -1;  // Not found
+    
+    return pm.assembledLength >= pm.expectedLength;
 }
 
-int8_t BapFrameAssembler::addPendingMessage(uint8_t group, uint8_t opcode,
-                                             uint8_t deviceId, uint8_t functionId,
-                                             uint8_t expectedLength) {
-    // Find first inactive slot (reuse freed slots)
-    int8_t idx = -1;
-    for (uint8_t i = 0; i < MAX_PENDING_MESSAGES; i++) {
-        if (!pending[i].active) {
-            idx = i;
+template<size_t MaxPending>
+void BasicBapFrameAssembler<MaxPending>::completeMessage(uint8_t slot, BapMessageView& outMsg) {
+    unlinkPendingMessage(slot);
+    deliveredSlot = slot;
+    
+    const PendingMessage& pm = pending[slot];
+    outMsg.opcode = pm.opcode;
+    outMsg.deviceId = pm.deviceId;
+    outMsg.functionId = pm.functionId;
+    outMsg.payloadLen = pm.assembledLength;
+    outMsg.payload = pm.buffer;
+    
+    longMessagesDecoded++;
+}
+
+template<size_t MaxPending>
+void BasicBapFrameAssembler<MaxPending>::freeDeliveredSlot() {
+    freeSlot(deliveredSlot);
+    deliveredSlot = NO_SLOT;
+}
+
+template<size_t MaxPending>
+uint8_t BasicBapFrameAssembler<MaxPending>::findPendingMessage(uint8_t group, uint8_t index) const {
+    // Newest first, like the backward search over all slots this replaces
+    for (uint8_t slot = groupHead[group]; slot != NO_SLOT; slot = pending[slot].next) {
+        if (pending[slot].nextExpectedIndex == index) {
+            return slot;
+        }
+    }
+    return NO_SLOT;  // Not found
+}
+
+template<size_t MaxPending>
+uint8_t BasicBapFrameAssembler<MaxPending>::addPendingMessage(uint8_t group, uint8_t opcode,
+                                                              uint8_t deviceId, uint8_t functionId,
+                                                              uint8_t expectedLength, uint32_t nowMs) {
+    // A new start for a function still pending in this group means its
+    // previous message was cut short: replace it
+    for (uint8_t slot = groupHead[group]; slot != NO_SLOT; slot = pending[slot].next) {
+        if (pending[slot].deviceId == deviceId && pending[slot].functionId == functionId) {
+            removePendingMessage(slot);
+            staleReplacements++;
             break;
         }
     }
     
-    if (idx < 0) {
-        return -1;  // All slots full
+    if (freeSlots == 0 && expireStale(nowMs) == 0) {
+        return NO_SLOT;  // All slots full
     }
     
-    pending[idx].active = true;
-    pending[idx].group = group;
-    pending[idx].nextExpectedIndex = 0;  // First continuation has index 0
-    pending[idx].opcode = opcode;
-    pending[idx].deviceId = deviceId;
-    pending[idx].functionId = functionId;
-    pending[idx].expectedLength = expectedLength;
-    pending[idx].assembledLength = 0;
+    uint8_t slot = __builtin_ctz(freeSlots);
+    freeSlots &= ~(1u << slot);
     
-    // Count active entries
-    pendingCount = 0;
-    for (uint8_t i = 0; i < MAX_PENDING_MESSAGES; i++) {
-        if (pending[i].active) {
-            pendingCount++;
-        }
-    }
+    PendingMessage& pm = pending[slot];
+    pm.group = group;
+    pm.nextExpectedIndex = 0;  // First continuation has index 0
+    pm.opcode = opcode;
+    pm.deviceId = deviceId;
+    pm.functionId = functionId;
+    pm.expectedLength = expectedLength;
+    pm.assembledLength = 0;
+    pm.lastFrameMs = nowMs;
+    pm.next = groupHead[group];
+    groupHead[group] = slot;
+    
+    pendingCount++;
     
     // Track high water mark
     if (pendingCount > maxPendingCount) {
         maxPendingCount = pendingCount;
     }
     
-    return idx;
+    return slot;
 }
 
-void BapFrameAssembler::removePendingMessage(uint8_t index) {
-    if (index >= MAX_PENDING_MESSAGES) {
+template<size_t MaxPending>
+void BasicBapFrameAssembler<MaxPending>::removePendingMessage(uint8_t slot) {
+    if (slot >= MAX_PENDING_MESSAGES || (freeSlots & (1u << slot)) || slot == deliveredSlot) {
         return;
     }
     
-    // Just mark as inactive - slot can be reused by addPendingMessage
-    pending[index].active = false;
-    pending[index].assembledLength = 0;
+    unlinkPendingMessage(slot);
+    freeSlot(slot);
+}
+
+template<size_t MaxPending>
+void BasicBapFrameAssembler<MaxPending>::unlinkPendingMessage(uint8_t slot) {
+    // Unlink from the group list (at most MAX_PENDING_MESSAGES entries, usually one)
+    uint8_t* link = &groupHead[pending[slot].group];
+    while (*link != slot) {
+        link = &pending[*link].next;
+    }
+    *link = pending[slot].next;
+    pending[slot].next = NO_SLOT;
+    pendingCount--;
+}
+
+template<size_t MaxPending>
+void BasicBapFrameAssembler<MaxPending>::freeSlot(uint8_t slot) {
+    bufferedBytes -= pending[slot].assembledLength;
+    pending[slot].assembledLength = 0;
+    freeSlots |= 1u << slot;
+}
+
+template<size_t MaxPending>
+uint8_t BasicBapFrameAssembler<MaxPending>::expireStale(uint32_t nowMs) {
+    lastSweepMs = nowMs;
     
-    // Count actual active entries
-    pendingCount = 0;
-    for (uint8_t i = 0; i < MAX_PENDING_MESSAGES; i++) {
-        if (pending[i].active) {
-            pendingCount++;
+    uint8_t evicted = 0;
+    uint16_t used = ~freeSlots & ((1u << MAX_PENDING_MESSAGES) - 1);
+    if (deliveredSlot != NO_SLOT) {
+        used &= ~(1u << deliveredSlot);  // Complete, only waiting for release()
+    }
+    while (used) {
+        uint8_t slot = __builtin_ctz(used);
+        used &= used - 1;
+        if (nowMs - pending[slot].lastFrameMs >= PENDING_TIMEOUT_MS) {
+            removePendingMessage(slot);
+            timeoutEvictions++;
+            evicted++;
         }
     }
+    return evicted;
 }
 
-void BapFrameAssembler::reset() {
+template<size_t MaxPending>
+void BasicBapFrameAssembler<MaxPending>::reset() {
     for (uint8_t i = 0; i < MAX_PENDING_MESSAGES; i++) {
-        pending[i].active = false;
         pending[i].assembledLength = 0;
+        pending[i].next = NO_SLOT;
+    }
+    for (uint8_t g = 0; g < GROUP_COUNT; g++) {
+        groupHead[g] = NO_SLOT;
     }
+    freeSlots = (1u << MAX_PENDING_MESSAGES) - 1;
+    deliveredSlot = NO_SLOT;
     pendingCount = 0;
+    bufferedBytes = 0;
 }
 
-bool BapFrameAssembler::isAssemblingLongMessage() const {
+template<size_t MaxPending>
+bool BasicBapFrameAssembler<MaxPending>::isAssemblingLongMessage() const {
     return pendingCount > 0;
 }
 
+// Shared stream and per-route (BapChannelRouter, one slot per group) sizes
+template class BasicBapFrameAssembler<BapFrameAssembler::MAX_PENDING_MESSAGES>;
+template class BasicBapFrameAssembler<BapFrameAssembler::GROUP_COUNT>;
+
 } // namespace BapProtocol
@@ -145,6 +145,7 @@ uint8_t encodeShortMessage(uint8_t* dest, uint8_t opcode, uint8_t deviceId,
 
 /**
  * Encode a long BAP message start frame
+ * @param totalPayloadLen Payload length, written to byte 1 (BAP header not included)
  * @param group Message group (0-3) for interleaved streams
  * Returns: frame length (always 8)
  */
@@ -161,6 +162,22 @@ uint8_t encodeLongStart(uint8_t* dest, uint8_t opcode, uint8_t deviceId,
 uint8_t encodeLongContinuation(uint8_t* dest, const uint8_t* payload, 
                                 uint8_t payloadLen, uint8_t group = 0, uint8_t index = 0);
 
+/**
+ * Frames needed for the largest long message (127-byte payload):
+ * start frame (4 bytes) + 18 continuations (7 bytes each)
+ */
+static constexpr uint8_t MAX_MESSAGE_FRAMES = 19;
+
+/**
+ * Encode a complete BAP message into frames, short or long as needed
+ * @param frames Destination, at least MAX_MESSAGE_FRAMES frames of 8 bytes
+ * @param payloadLen Payload length (0-127)
+ * @param group Message group for long messages (0-3)
+ * Returns: number of frames written (each 8 bytes), or 0 if payload too long
+ */
+uint8_t encodeMessage(uint8_t frames[][8], uint8_t opcode, uint8_t deviceId, uint8_t functionId,
+                      const uint8_t* payload, uint8_t payloadLen, uint8_t group = 0);
+
 // =============================================================================
 // Generic Command Builders
 // =============================================================================
@@ -202,6 +219,10 @@ inline uint8_t buildSetGetRequest(uint8_t* dest, uint8_t deviceId, uint8_t funct
  * @param group Message group for long messages (0-3)
  * @return Number of frames sent, or 0 on error
  * 
+ * Each frame is handed to sendFrame separately, in the given group; to send
+ * concurrently with other long messages (group assigned, frames paced and
+ * interleaved) use VehicleManager::sendBapMessage (BapTransmitter) instead.
+ * 
  * This function automatically:
  * - Uses short message format if payload ≤ 6 bytes
  * - Uses long message format (start + continuations) if payload > 6 bytes
@@ -217,39 +238,13 @@ inline uint8_t buildSetGetRequest(uint8_t* dest, uint8_t deviceId, uint8_t funct
 template<typename SendFunc>
 inline uint8_t sendBapMessage(SendFunc sendFrame, uint8_t opcode, uint8_t deviceId, uint8_t functionId,
                               const uint8_t* payload, uint8_t payloadLen, uint8_t group = 0) {
-    // Short message: payload ≤ 6 bytes
-    if (payloadLen <= 6) {
-        uint8_t frame[8];
-        encodeShortMessage(frame, opcode, deviceId, functionId, payload, payloadLen);
-        return sendFrame(frame, 8) ? 1 : 0;
-    }
-    
-    // Long message: payload > 6 bytes
-    uint8_t frameCount = 0;
-    uint8_t frame[8];
-    
-    // Send start frame (contains first 4 bytes of payload)
-    encodeLongStart(frame, opcode, deviceId, functionId, payloadLen, payload, group);
-    if (!sendFrame(frame, 8)) {
-        return 0;
-    }
-    frameCount++;
-    
-    // Send continuation frames (7 bytes of payload each)
-    uint8_t payloadOffset = 4;  // First 4 bytes already in start frame
-    uint8_t contIndex = 0;
+    uint8_t frames[MAX_MESSAGE_FRAMES][8];
+    uint8_t frameCount = encodeMessage(frames, opcode, deviceId, functionId, payload, payloadLen, group);
     
-    while (payloadOffset < payloadLen) {
-        uint8_t chunkLen = (payloadLen - payloadOffset > 7) ? 7 : (payloadLen - payloadOffset);
-        encodeLongContinuation(frame, payload + payloadOffset, chunkLen, group, contIndex);
-        
-        if (!sendFrame(frame, 8)) {
-            return 0;  // Failed to send continuation
+    for (uint8_t i = 0; i < frameCount; i++) {
+        if (!sendFrame(frames[i], 8)) {
+            return 0;
         }
-        
-        frameCount++;
-        payloadOffset += chunkLen;
-        contIndex = (contIndex + 1) & 0x0F;  // Wrap at 16
     }
     
     return frameCount;
@@ -260,14 +255,19 @@ inline uint8_t sendBapMessage(SendFunc sendFrame, uint8_t opcode, uint8_t device
 // =============================================================================
 
 /**
- * Complete BAP message (after reassembly if needed)
+ * Complete BAP message (after reassembly if needed), as a view.
+ * 
+ * The payload is not copied: it points into the CAN frame (short messages)
+ * or into the assembler's slot (long messages). It is valid until the
+ * assembler's next processFrame() or release() call, so handlers that keep
+ * payload bytes must copy them.
  */
-struct BapMessage {
+struct BapMessageView {
     uint8_t opcode = 0;
     uint8_t deviceId = 0;
     uint8_t functionId = 0;
-    uint8_t payloadLen = 0;   // Moved BEFORE payload to prevent overflow corruption
-    uint8_t payload[128];     // Reassembled payload - must match MAX_PAYLOAD_SIZE
+    uint8_t payloadLen = 0;
+    const uint8_t* payload = nullptr;
     
     bool isValid() const { return payloadLen > 0 || (deviceId != 0 && functionId != 0); }
     bool isResponse() const { return opcode >= OpCode::HEARTBEAT; }
@@ -284,35 +284,85 @@ struct BapMessage {
  *   BapFrameAssembler assembler;
  *   
  *   // For each CAN frame received:
- *   BapMessage msg;
+ *   BapMessageView msg;
  *   if (assembler.processFrame(data, dlc, msg)) {
- *       // Complete message ready - handle it
+ *       // Complete message ready - handle it, then hand the slot back
  *       handleMessage(msg.functionId, msg.opcode, msg.payload, msg.payloadLen);
+ *       assembler.release();
  *   }
  *   // If returns false, either invalid frame or waiting for more data (long msg)
  * 
  * Implementation note:
- *   Uses backward search approach (like VW BAP Analyser) to handle interleaved
- *   long messages. Multiple incomplete messages can coexist, and continuations
- *   search backwards to find their matching start frame.
+ *   Continuation frames carry only the 2-bit group and a 4-bit index, so
+ *   pending messages are kept in one list per group, newest first (the
+ *   backward search of the VW BAP Analyser). A continuation checks only its
+ *   group's list, normally a single entry, for the message expecting its
+ *   index. Several messages may be in flight in one group as long as their
+ *   device/function differ; a new start for the same device/function in the
+ *   same group replaces the old one (staleReplacements).
+ * 
+ *   Free slots are a bitmask, so allocation and release are O(1). Each slot
+ *   records the time of its last frame; a message that gets no frame for
+ *   PENDING_TIMEOUT_MS is evicted (timeoutEvictions) instead of holding its
+ *   slot forever after a lost continuation.
+ * 
+ *   A completed long message stays in its slot (unlinked from its group)
+ *   while the caller reads the view, so the payload is assembled once and
+ *   never copied again. release() frees the slot; the next processFrame()
+ *   frees it too if the caller did not.
+ *
+ *   Slots cost MAX_PAYLOAD_SIZE bytes each, so the slot count is a template
+ *   parameter: BapFrameAssembler has 16 for a stream mixing many senders,
+ *   BapChannelRouter's per-route assemblers one per group. The methods are
+ *   instantiated for these two sizes in BapProtocol.cpp.
  */
-class BapFrameAssembler {
+template<size_t MaxPending>
+class BasicBapFrameAssembler {
 public:
     static constexpr size_t MAX_PAYLOAD_SIZE = 128;    // Max payload buffer size
-    static constexpr size_t MAX_PENDING_MESSAGES = 16; // Max concurrent incomplete long messages
+    static constexpr size_t MAX_PENDING_MESSAGES = MaxPending; // Max concurrent incomplete long messages
+    static constexpr uint8_t GROUP_COUNT = 4;          // 2-bit group in the control byte
+    static constexpr uint32_t PENDING_TIMEOUT_MS = 1000;  // Evict after this long without a frame
+    
+    BasicBapFrameAssembler();
     
     /**
      * Process a CAN frame and attempt to produce a complete BAP message.
      * 
      * @param data Raw CAN frame data
      * @param dlc Data length code
-     * @param outMsg Output: complete message if returns true
+     * @param outMsg Output: view of the complete message if returns true
+     *               (valid until the next processFrame() or release())
      * @return true if a complete message is ready, false if waiting for more frames
      * 
      * NOTE: This runs on CAN task (Core 0) - NO Serial output allowed!
      * Use the counter variables below for debugging from main loop.
      */
-    bool processFrame(const uint8_t* data, uint8_t dlc, BapMessage& outMsg);
+    bool processFrame(const uint8_t* data, uint8_t dlc, BapMessageView& outMsg) {
+        return processFrame(data, dlc, outMsg, millis());
+    }
+    
+    /**
+     * As above, with the frame's arrival time (ms) given by the caller.
+     */
+    bool processFrame(const uint8_t* data, uint8_t dlc, BapMessageView& outMsg, uint32_t nowMs);
+    
+    /**
+     * Free the slot of the last delivered long message (no-op otherwise).
+     * Invalidates the view processFrame() returned.
+     */
+    void release() {
+        if (deliveredSlot != NO_SLOT) {
+            freeDeliveredSlot();
+        }
+    }
+    
+    /**
+     * Evict pending messages without a frame for PENDING_TIMEOUT_MS.
+     * processFrame() calls this on its own; exposed for idle channels.
+     * @return Number of messages evicted
+     */
+    uint8_t expireStale(uint32_t nowMs);
     
     /**
      * Reset assembler state (e.g., after timeout or error)
@@ -329,6 +379,17 @@ public:
      */
     uint8_t getPendingCount() const { return pendingCount; }
     
+    /**
+     * Payload bytes held by pending messages and the delivered one
+     * (the slots themselves are static).
+     */
+    uint16_t getBufferedBytes() const { return bufferedBytes; }
+    
+    /**
+     * Static RAM of one assembler (all slots), for the memory report.
+     */
+    static constexpr size_t footprintBytes() { return sizeof(PendingMessage) * MAX_PENDING_MESSAGES; }
+    
     // Statistics counters (read from main loop for logging)
     volatile uint32_t shortMessagesDecoded = 0;
     volatile uint32_t longMessagesDecoded = 0;
@@ -336,13 +397,17 @@ public:
     volatile uint32_t longStartFrames = 0;      // Long message start frames seen
     volatile uint32_t longContFrames = 0;       // Continuation frames seen
     volatile uint32_t pendingOverflows = 0;     // Start frames dropped due to full pending list
-    volatile uint32_t staleReplacements = 0;    // Stale pending entries replaced by new starts
+    volatile uint32_t staleReplacements = 0;    // Pending entries replaced by a new start (same group/device/function)
+    volatile uint32_t timeoutEvictions = 0;     // Pending entries evicted after PENDING_TIMEOUT_MS
     volatile uint8_t maxPendingCount = 0;       // High water mark for pending count
+    volatile uint16_t maxBufferedBytes = 0;     // High water mark for getBufferedBytes()
     
 private:
+    static constexpr uint8_t NO_SLOT = 0xFF;
+    static constexpr uint32_t SWEEP_INTERVAL_MS = PENDING_TIMEOUT_MS / 4;
+    
     // Pending incomplete long message
     struct PendingMessage {
-        bool active = false;
         uint8_t group = 0;              // Message group (0-3), from bits 5-4 of control byte
         uint8_t nextExpectedIndex = 0;  // Next continuation index expected (0-15)
         uint8_t opcode = 0;
@@ -350,28 +415,58 @@ private:
         uint8_t functionId = 0;
         uint8_t expectedLength = 0;     // Total payload length expected
         uint8_t assembledLength = 0;    // Bytes assembled so far
+        uint8_t next = NO_SLOT;         // Next (older) slot of the same group
+        uint32_t lastFrameMs = 0;       // Arrival of the start or latest continuation
         uint8_t buffer[MAX_PAYLOAD_SIZE];
     };
     
+    static_assert(MAX_PENDING_MESSAGES >= 1 && MAX_PENDING_MESSAGES <= 16, "freeSlots is a 16-bit mask");
+    
     PendingMessage pending[MAX_PENDING_MESSAGES];
+    uint8_t groupHead[GROUP_COUNT];     // Newest pending slot per group
+    uint16_t freeSlots;                 // Bit per free slot
     uint8_t pendingCount = 0;
+    uint16_t bufferedBytes = 0;
+    uint32_t lastSweepMs = 0;
+    uint8_t deliveredSlot = NO_SLOT;    // Completed message the caller is reading
+    
+    /**
+     * Find the pending message of a group expecting a continuation index.
+     * Returns slot or NO_SLOT.
+     */
+    uint8_t findPendingMessage(uint8_t group, uint8_t index) const;
     
     /**
-     * Find a pending message by group and expected index.
-     * Returns index or -1 if not found.
+     * Add a new pending message at the head of its group, replacing one with
+     * the same device/function. Returns slot or NO_SLOT if full.
      */
-    int8_t findPendingMessage(uint8_t group, uint8_t index);
+    uint8_t addPendingMessage(uint8_t group, uint8_t opcode, uint8_t deviceId,
+                              uint8_t functionId, uint8_t expectedLength, uint32_t nowMs);
     
     /**
-     * Add a new pending message. Returns index or -1 if full.
+     * Unlink a pending message from its group and free its slot
      */
-    int8_t addPendingMessage(uint8_t group, uint8_t opcode, uint8_t deviceId,
-                             uint8_t functionId, uint8_t expectedLength);
+    void removePendingMessage(uint8_t slot);
+    
+    void unlinkPendingMessage(uint8_t slot);
+    void freeSlot(uint8_t slot);
     
     /**
-     * Remove a pending message by index (shifts remaining entries)
+     * Append payload bytes (clamped to the expected length).
+     * @return true if the message is complete
      */
-    void removePendingMessage(uint8_t index);
+    bool appendPayload(PendingMessage& pm, const uint8_t* chunk, uint8_t chunkLen);
+    
+    /**
+     * Unlink a completed message from its group and point the view at its
+     * buffer. The slot stays allocated until release().
+     */
+    void completeMessage(uint8_t slot, BapMessageView& outMsg);
+    
+    void freeDeliveredSlot();
 };
 
+// Assembler for a stream of many senders (one slot per concurrent long message)
+using BapFrameAssembler = BasicBapFrameAssembler<16>;
+
 } // namespace BapProtocol
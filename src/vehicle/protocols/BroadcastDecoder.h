@@ -1,6 +1,8 @@
 #pragma once
 
 #include <Arduino.h>
+#include <cstring>
+#include "SignalCodec.h"
 
 /**
  * BroadcastDecoder - Utility functions for extracting signals from CAN frames
@@ -14,6 +16,36 @@
  */
 namespace BroadcastDecoder {
 
+/**
+ * Load the 8-byte payload as one little-endian 64-bit word.
+ * Bit n of the word is DBC bit n (byte n/8, bit n%8); a frame decoder loads
+ * once and extracts all of its signals from the word.
+ *
+ * @param data Pointer to CAN frame data (8 bytes, also for shorter DLCs)
+ * @return Payload word
+ */
+inline uint64_t loadFrameLE(const uint8_t* data) {
+    uint64_t frame;
+    memcpy(&frame, data, sizeof(frame));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    frame = __builtin_bswap64(frame);
+#endif
+    return frame;
+}
+
+/**
+ * Extract an Intel/Little-endian signal from a loaded payload word.
+ * Branch-free: one shift and one mask.
+ *
+ * @param frame Payload word from loadFrameLE()
+ * @param startBit Starting bit position (0-63)
+ * @param length Number of bits (1-32)
+ * @return Raw unsigned value (bits past the end of the frame read as 0)
+ */
+inline uint32_t extractSignalLE(uint64_t frame, uint8_t startBit, uint8_t length) {
+    return (uint32_t)((frame >> (startBit & 63)) & ((1ULL << length) - 1));
+}
+
 /**
  * Extract a signal from CAN data (Intel/Little-endian byte order).
  * This is the most common format in VW CAN messages.
@@ -28,56 +60,39 @@ namespace BroadcastDecoder {
  *   Then multiply by 0.05 to get percentage
  */
 inline uint32_t extractSignalLE(const uint8_t* data, uint8_t startBit, uint8_t length) {
-    uint32_t result = 0;
-    
-    for (uint8_t i = 0; i < length; i++) {
-        uint8_t bitPos = startBit + i;
-        uint8_t byteIdx = bitPos / 8;
-        uint8_t bitIdx = bitPos % 8;
-        
-        if (byteIdx < 8) {
-            if (data[byteIdx] & (1 << bitIdx)) {
-                result |= (1UL << i);
-            }
-        }
-    }
-    
-    return result;
+    return extractSignalLE(loadFrameLE(data), startBit, length);
 }
 
 /**
  * Extract a signal from CAN data (Motorola/Big-endian byte order).
  * Less common in VW, but some signals use this format.
+ *
+ * In the byte-swapped (big-endian) payload word, Motorola bit numbering
+ * becomes contiguous: DBC bit b sits at word bit (7 - b/8)*8 + b%8 and the
+ * signal runs downwards from there, so one shift and one mask extract it.
  * 
  * @param data Pointer to CAN frame data (8 bytes)
- * @param startBit Starting bit position (MSB position in Motorola notation)
+ * @param startBit Starting bit position (MSB position in Motorola notation, 0-63)
  * @param length Number of bits (1-32)
- * @return Raw unsigned value
+ * @return Raw unsigned value (bits past the end of the frame read as 0)
  */
 inline uint32_t extractSignalBE(const uint8_t* data, uint8_t startBit, uint8_t length) {
-    // Motorola byte order: start bit is MSB, bits counted down across bytes
-    uint32_t result = 0;
-    
-    uint8_t byteIdx = startBit / 8;
-    uint8_t bitIdx = startBit % 8;
-    
-    for (uint8_t i = 0; i < length; i++) {
-        if (byteIdx < 8) {
-            if (data[byteIdx] & (1 << bitIdx)) {
-                result |= (1UL << (length - 1 - i));
-            }
-        }
-        
-        // Move to next bit (going right/down in Motorola order)
-        if (bitIdx == 0) {
-            bitIdx = 7;
-            byteIdx++;
-        } else {
-            bitIdx--;
-        }
-    }
-    
-    return result;
+    uint64_t frame = __builtin_bswap64(loadFrameLE(data));
+    int msb = (7 - (startBit >> 3)) * 8 + (startBit & 7);
+    int lsb = msb - length + 1;
+    uint64_t aligned = lsb >= 0 ? frame >> lsb : frame << -lsb;
+    return (uint32_t)(aligned & ((1ULL << length) - 1));
+}
+
+/**
+ * Extract a single bit from a loaded payload word.
+ *
+ * @param frame Payload word from loadFrameLE()
+ * @param bitPos Bit position (0-63)
+ * @return true if bit is set
+ */
+inline bool extractBit(uint64_t frame, uint8_t bitPos) {
+    return (frame >> (bitPos & 63)) & 1;
 }
 
 /**
@@ -149,227 +164,154 @@ inline float applyScaleOffsetSigned(uint32_t raw, uint8_t bits, float scale, flo
 
 // ============================================================================
 // VW-specific signal extraction helpers
-// These match the signal definitions from the DBC files
+// These match the signal definitions from the DBC files. Each message is one
+// signal table (see SignalCodec.h); struct, descriptors and the unrolled
+// decoder are generated from it.
+//
+// SIG(type, field, dbcName, startBit, length, order, sign, scale, offset, unit)
 // ============================================================================
 
 /**
  * BMS_01 (0x191) - Core battery data
  */
-struct BMS01Data {
-    float current;      // BMS_IstStrom_02: A (negative = discharge)
-    float voltage;      // BMS_IstSpannung: V
-    float socHiRes;     // BMS_SOC_HiRes: %
-};
+#define BMS_01_SIGNALS(SIG, FIELD) \
+    SIG(float, current,   "BMS_IstStrom_02", 12, 12, INTEL, UNSIGNED, 1.0f,  -2047.0f, "A") /* negative = discharge */ \
+    SIG(float, voltage,   "BMS_IstSpannung", 24, 12, INTEL, UNSIGNED, 0.25f, 0.0f,     "V") \
+    SIG(float, socHiRes,  "BMS_SOC_HiRes",   47, 11, INTEL, UNSIGNED, 0.05f, 0.0f,     "%")
+BROADCAST_MESSAGE(BMS01Data, BMS_01_SIGNALS)
 
 inline BMS01Data decodeBMS01(const uint8_t* data) {
     BMS01Data result;
-    
-    // BMS_IstStrom_02: bits 12|12@LE, scale=1.0, offset=-2047 A
-    uint32_t rawCurrent = extractSignalLE(data, 12, 12);
-    result.current = applyScaleOffset(rawCurrent, 1.0f, -2047.0f);
-    
-    // BMS_IstSpannung: bits 24|12@LE, scale=0.25, offset=0 V
-    uint32_t rawVoltage = extractSignalLE(data, 24, 12);
-    result.voltage = applyScaleOffset(rawVoltage, 0.25f, 0.0f);
-    
-    // BMS_SOC_HiRes: bits 47|11@LE, scale=0.05, offset=0 %
-    uint32_t rawSoc = extractSignalLE(data, 47, 11);
-    result.socHiRes = applyScaleOffset(rawSoc, 0.05f, 0.0f);
-    
+    decodeSignals(loadFrameLE(data), result);
     return result;
 }
 
 /**
  * BMS_10 (0x509) - Usable SOC and energy
  */
-struct BMS10Data {
-    float energyWh;         // BMS_Energieinhalt_HiRes: Wh
-    float maxEnergyWh;      // BMS_MaxEnergieinhalt_HiRes: Wh
-    float usableSoc;        // BMS_NutzbarerSOC: %
-};
+#define BMS_10_SIGNALS(SIG, FIELD) \
+    SIG(float, energyWh,    "BMS_Energieinhalt_HiRes",    0,  15, INTEL, UNSIGNED, 4.0f, 0.0f, "Wh") \
+    SIG(float, maxEnergyWh, "BMS_MaxEnergieinhalt_HiRes", 15, 15, INTEL, UNSIGNED, 4.0f, 0.0f, "Wh") \
+    SIG(float, usableSoc,   "BMS_NutzbarerSOC",           30, 8,  INTEL, UNSIGNED, 0.5f, 0.0f, "%")
+BROADCAST_MESSAGE(BMS10Data, BMS_10_SIGNALS)
 
 inline BMS10Data decodeBMS10(const uint8_t* data) {
     BMS10Data result;
-    
-    // BMS_Energieinhalt_HiRes: bits 0|15@LE, scale=4.0, offset=0 Wh
-    uint32_t rawEnergy = extractSignalLE(data, 0, 15);
-    result.energyWh = applyScaleOffset(rawEnergy, 4.0f, 0.0f);
-    
-    // BMS_MaxEnergieinhalt_HiRes: bits 15|15@LE, scale=4.0, offset=0 Wh
-    uint32_t rawMaxEnergy = extractSignalLE(data, 15, 15);
-    result.maxEnergyWh = applyScaleOffset(rawMaxEnergy, 4.0f, 0.0f);
-    
-    // BMS_NutzbarerSOC: bits 30|8@LE, scale=0.5, offset=0 %
-    uint32_t rawSoc = extractSignalLE(data, 30, 8);
-    result.usableSoc = applyScaleOffset(rawSoc, 0.5f, 0.0f);
-    
+    decodeSignals(loadFrameLE(data), result);
     return result;
 }
 
 /**
  * BMS_07 (0x5CA) - Charging status
+ * BMS_Balancing_Aktiv is 2 bits (0=off, 1-3=active).
  */
-struct BMS07Data {
-    bool chargingActive;    // BMS_Ladevorgang_aktiv
-    bool balancingActive;   // BMS_Balancing_Aktiv
-    float energyWh;         // BMS_Energieinhalt (low-res)
-    float maxEnergyWh;      // BMS_MaxEnergieinhalt (low-res)
-};
+#define BMS_07_SIGNALS(SIG, FIELD) \
+    SIG(bool,  chargingActive,  "BMS_Ladevorgang_aktiv", 23, 1,  INTEL, UNSIGNED, 1,     0,    "") \
+    SIG(bool,  balancingActive, "BMS_Balancing_Aktiv",   30, 2,  INTEL, UNSIGNED, 1,     0,    "") \
+    SIG(float, energyWh,        "BMS_Energieinhalt",     12, 11, INTEL, UNSIGNED, 50.0f, 0.0f, "Wh") /* low-res */ \
+    SIG(float, maxEnergyWh,     "BMS_MaxEnergieinhalt",  32, 11, INTEL, UNSIGNED, 50.0f, 0.0f, "Wh") /* low-res */
+BROADCAST_MESSAGE(BMS07Data, BMS_07_SIGNALS)
 
 inline BMS07Data decodeBMS07(const uint8_t* data) {
     BMS07Data result;
-    
-    // BMS_Ladevorgang_aktiv: bit 23
-    result.chargingActive = extractBit(data, 23);
-    
-    // BMS_Balancing_Aktiv: bits 30|2@LE (0=off, 1-3=active)
-    uint32_t rawBalancing = extractSignalLE(data, 30, 2);
-    result.balancingActive = (rawBalancing > 0);
-    
-    // BMS_Energieinhalt: bits 12|11@LE, scale=50, offset=0 Wh
-    uint32_t rawEnergy = extractSignalLE(data, 12, 11);
-    result.energyWh = applyScaleOffset(rawEnergy, 50.0f, 0.0f);
-    
-    // BMS_MaxEnergieinhalt: bits 32|11@LE, scale=50, offset=0 Wh
-    uint32_t rawMaxEnergy = extractSignalLE(data, 32, 11);
-    result.maxEnergyWh = applyScaleOffset(rawMaxEnergy, 50.0f, 0.0f);
-    
+    decodeSignals(loadFrameLE(data), result);
     return result;
 }
 
 /**
  * BMS_06 (0x59E) - Battery temperature
  */
+#define BMS_06_SIGNALS(SIG, FIELD) \
+    SIG(float, temperature, "BMS_Temperatur", 16, 8, INTEL, UNSIGNED, 0.5f, -40.0f, "C")
+BROADCAST_MESSAGE(BMS06Data, BMS_06_SIGNALS)
+
 inline float decodeBMS06Temperature(const uint8_t* data) {
-    // BMS_Temperatur: bits 16|8@LE, scale=0.5, offset=-40 C
-    uint32_t raw = extractSignalLE(data, 16, 8);
-    return applyScaleOffset(raw, 0.5f, -40.0f);
+    BMS06Data result;
+    decodeSignals(loadFrameLE(data), result);
+    return result.temperature;
 }
 
 /**
  * DCDC_01 (0x2AE) - DC-DC converter
  */
-struct DCDC01Data {
-    float hvVoltage;        // DC_IstSpannung_HV: V
-    float lvVoltage;        // DC_IstSpannung_NV: V  
-    float lvCurrent;        // DC_IstStrom_NV: A
-};
+#define DCDC_01_SIGNALS(SIG, FIELD) \
+    SIG(float, hvVoltage, "DC_IstSpannung_HV", 12, 12, INTEL, UNSIGNED, 0.25f, 0.0f,    "V") \
+    SIG(float, lvVoltage, "DC_IstSpannung_NV", 56, 8,  INTEL, UNSIGNED, 0.1f,  0.0f,    "V") \
+    SIG(float, lvCurrent, "DC_IstStrom_NV",    34, 10, INTEL, UNSIGNED, 1.0f,  -511.0f, "A")
+BROADCAST_MESSAGE(DCDC01Data, DCDC_01_SIGNALS)
 
 inline DCDC01Data decodeDCDC01(const uint8_t* data) {
     DCDC01Data result;
-    
-    // DC_IstSpannung_HV: bits 12|12@LE, scale=0.25, offset=0 V
-    uint32_t rawHV = extractSignalLE(data, 12, 12);
-    result.hvVoltage = applyScaleOffset(rawHV, 0.25f, 0.0f);
-    
-    // DC_IstSpannung_NV: bits 56|8@LE, scale=0.1, offset=0 V
-    uint32_t rawLV = extractSignalLE(data, 56, 8);
-    result.lvVoltage = applyScaleOffset(rawLV, 0.1f, 0.0f);
-    
-    // DC_IstStrom_NV: bits 34|10@LE, scale=1.0, offset=-511 A
-    uint32_t rawCurrent = extractSignalLE(data, 34, 10);
-    result.lvCurrent = applyScaleOffset(rawCurrent, 1.0f, -511.0f);
-    
+    decodeSignals(loadFrameLE(data), result);
     return result;
 }
 
 /**
  * Klemmen_Status_01 (0x3C0) - Ignition status
  */
-struct IgnitionData {
-    bool keyInserted;       // ZAS_Kl_S (bit 16)
-    bool ignitionOn;        // ZAS_Kl_15 (bit 17)
-    bool startRequested;    // ZAS_Kl_50 (bit 19)
-};
+#define KLEMMEN_STATUS_01_SIGNALS(SIG, FIELD) \
+    SIG(bool, keyInserted,    "ZAS_Kl_S",  16, 1, INTEL, UNSIGNED, 1, 0, "") \
+    SIG(bool, ignitionOn,     "ZAS_Kl_15", 17, 1, INTEL, UNSIGNED, 1, 0, "") \
+    SIG(bool, startRequested, "ZAS_Kl_50", 19, 1, INTEL, UNSIGNED, 1, 0, "")
+BROADCAST_MESSAGE(IgnitionData, KLEMMEN_STATUS_01_SIGNALS)
 
 inline IgnitionData decodeIgnition(const uint8_t* data) {
     IgnitionData result;
-    
-    result.keyInserted = extractBit(data, 16);      // ZAS_Kl_S
-    result.ignitionOn = extractBit(data, 17);       // ZAS_Kl_15
-    result.startRequested = extractBit(data, 19);   // ZAS_Kl_50
-    
+    decodeSignals(loadFrameLE(data), result);
     return result;
 }
 
 /**
  * ESP_21 (0x0FD) - Vehicle speed
  */
+#define ESP_21_SIGNALS(SIG, FIELD) \
+    SIG(float, speedKmh, "ESP_v_Signal", 32, 16, INTEL, UNSIGNED, 0.01f, 0.0f, "km/h")
+BROADCAST_MESSAGE(SpeedData, ESP_21_SIGNALS)
+
 inline float decodeSpeed(const uint8_t* data) {
-    // ESP_v_Signal: bits 32|16@LE, scale=0.01, offset=0 km/h
-    uint32_t raw = extractSignalLE(data, 32, 16);
-    return applyScaleOffset(raw, 0.01f, 0.0f);
+    SpeedData result;
+    decodeSignals(loadFrameLE(data), result);
+    return result.speedKmh;
 }
 
 /**
  * Diagnose_01 (0x6B2) - Odometer and time
  */
-struct DiagnoseData {
-    uint32_t odometerKm;    // KBI_Kilometerstand (20 bits)
-    uint16_t year;          // UH_Jahr
-    uint8_t month;          // UH_Monat
-    uint8_t day;            // UH_Tag
-    uint8_t hour;           // UH_Stunde
-    uint8_t minute;         // UH_Minute
-    uint8_t second;         // UH_Sekunde
-};
+#define DIAGNOSE_01_SIGNALS(SIG, FIELD) \
+    SIG(uint32_t, odometerKm, "KBI_Kilometerstand", 8,  20, INTEL, UNSIGNED, 1, 0,    "km") \
+    SIG(uint16_t, year,       "UH_Jahr",            28, 7,  INTEL, UNSIGNED, 1, 2000, "") \
+    SIG(uint8_t,  month,      "UH_Monat",           35, 4,  INTEL, UNSIGNED, 1, 0,    "") \
+    SIG(uint8_t,  day,        "UH_Tag",             39, 5,  INTEL, UNSIGNED, 1, 0,    "") \
+    SIG(uint8_t,  hour,       "UH_Stunde",          44, 5,  INTEL, UNSIGNED, 1, 0,    "") \
+    SIG(uint8_t,  minute,     "UH_Minute",          49, 6,  INTEL, UNSIGNED, 1, 0,    "") \
+    SIG(uint8_t,  second,     "UH_Sekunde",         55, 6,  INTEL, UNSIGNED, 1, 0,    "")
+BROADCAST_MESSAGE(DiagnoseData, DIAGNOSE_01_SIGNALS)
 
 inline DiagnoseData decodeDiagnose(const uint8_t* data) {
     DiagnoseData result;
-    
-    // KBI_Kilometerstand: bits 8|20@LE
-    result.odometerKm = extractSignalLE(data, 8, 20);
-    
-    // UH_Jahr: bits 28|7@LE, offset=2000
-    result.year = extractSignalLE(data, 28, 7) + 2000;
-    
-    // UH_Monat: bits 35|4@LE
-    result.month = extractSignalLE(data, 35, 4);
-    
-    // UH_Tag: bits 39|5@LE
-    result.day = extractSignalLE(data, 39, 5);
-    
-    // UH_Stunde: bits 44|5@LE
-    result.hour = extractSignalLE(data, 44, 5);
-    
-    // UH_Minute: bits 49|6@LE
-    result.minute = extractSignalLE(data, 49, 6);
-    
-    // UH_Sekunde: bits 55|6@LE
-    result.second = extractSignalLE(data, 55, 6);
-    
+    decodeSignals(loadFrameLE(data), result);
     return result;
 }
 
 /**
- * TSG_FT_01 (0x3D0) - Driver door module
+ * TSG_FT_01 (0x3D0) / TSG_BT_01 (0x3D1) - Driver and passenger door modules
+ * (same layout). FH_Oeffnung: 0-200 = 0-100%.
  */
-struct DoorModuleData {
-    bool doorOpen;          // Tuer_geoeffnet (bit 0)
-    bool doorLocked;        // verriegelt (bit 1)
-    uint8_t windowPos;      // FH_Oeffnung (byte 3, 0-200 = 0-100%)
-};
+#define TSG_01_SIGNALS(SIG, FIELD) \
+    SIG(bool,    doorOpen,   "Tuer_geoeffnet", 0,  1, INTEL, UNSIGNED, 1, 0, "") \
+    SIG(bool,    doorLocked, "verriegelt",     1,  1, INTEL, UNSIGNED, 1, 0, "") \
+    SIG(uint8_t, windowPos,  "FH_Oeffnung",    24, 8, INTEL, UNSIGNED, 1, 0, "")
+BROADCAST_MESSAGE(DoorModuleData, TSG_01_SIGNALS)
 
 inline DoorModuleData decodeDriverDoor(const uint8_t* data) {
     DoorModuleData result;
-    
-    result.doorOpen = extractBit(data, 0);
-    result.doorLocked = extractBit(data, 1);
-    result.windowPos = extractByte(data, 3);  // Window position in byte 3
-    
+    decodeSignals(loadFrameLE(data), result);
     return result;
 }
 
-/**
- * TSG_BT_01 (0x3D1) - Passenger door module
- */
 inline DoorModuleData decodePassengerDoor(const uint8_t* data) {
     DoorModuleData result;
-    
-    result.doorOpen = extractBit(data, 0);
-    result.doorLocked = extractBit(data, 1);
-    result.windowPos = extractByte(data, 3);
-    
+    decodeSignals(loadFrameLE(data), result);
     return result;
 }
 
@@ -380,17 +322,15 @@ inline DoorModuleData decodePassengerDoor(const uint8_t* data) {
  * - Locked: byte 2 = 0x0A or 0x08, byte 7 = 0x80
  * - Unlocked: byte 2 = 0x80, byte 7 = 0x40
  */
-struct LockStatusData {
-    uint8_t byte2;          // Lock state byte
-    uint8_t byte7;          // Additional lock state
-    bool isLocked;          // Interpreted lock state
-};
+#define ZV_02_SIGNALS(SIG, FIELD) \
+    SIG(uint8_t, byte2, "ZV_02_Byte2", 16, 8, INTEL, UNSIGNED, 1, 0, "") /* Lock state byte */ \
+    SIG(uint8_t, byte7, "ZV_02_Byte7", 56, 8, INTEL, UNSIGNED, 1, 0, "") /* Additional lock state */ \
+    FIELD(bool, isLocked)                                                /* Interpreted lock state */
+BROADCAST_MESSAGE(LockStatusData, ZV_02_SIGNALS)
 
 inline LockStatusData decodeLockStatus(const uint8_t* data) {
     LockStatusData result;
-    
-    result.byte2 = extractByte(data, 2);
-    result.byte7 = extractByte(data, 7);
+    decodeSignals(loadFrameLE(data), result);
     
     // Interpret based on observed patterns
     // Locked: byte2 low nibble is 0x0A/0x08, byte7 = 0x80
@@ -410,25 +350,15 @@ inline LockStatusData decodeLockStatus(const uint8_t* data) {
 /**
  * Klima_03 (0x66E) - Climate status
  */
-struct KlimaData {
-    float insideTemp;           // KL_Innen_Temp: C
-    bool standbyHeatingActive;  // KL_STH_aktiv
-    bool standbyVentActive;     // KL_STL_aktiv
-};
+#define KLIMA_03_SIGNALS(SIG, FIELD) \
+    SIG(float, insideTemp,           "KL_Innen_Temp", 32, 8, INTEL, UNSIGNED, 0.5f, -50.0f, "C") \
+    SIG(bool,  standbyHeatingActive, "KL_STH_aktiv",  1,  1, INTEL, UNSIGNED, 1,    0,      "") \
+    SIG(bool,  standbyVentActive,    "KL_STL_aktiv",  0,  1, INTEL, UNSIGNED, 1,    0,      "")
+BROADCAST_MESSAGE(KlimaData, KLIMA_03_SIGNALS)
 
 inline KlimaData decodeKlima03(const uint8_t* data) {
     KlimaData result;
-    
-    // KL_Innen_Temp: bits 32|8@LE, scale=0.5, offset=-50 C
-    uint32_t rawTemp = extractSignalLE(data, 32, 8);
-    result.insideTemp = applyScaleOffset(rawTemp, 0.5f, -50.0f);
-    
-    // KL_STL_aktiv: bit 0
-    result.standbyVentActive = extractBit(data, 0);
-    
-    // KL_STH_aktiv: bit 1  
-    result.standbyHeatingActive = extractBit(data, 1);
-    
+    decodeSignals(loadFrameLE(data), result);
     return result;
 }
 
@@ -438,38 +368,21 @@ inline KlimaData decodeKlima03(const uint8_t* data) {
 
 /**
  * NavPos_01 (0x486) - GPS Position
+ * Latitude/longitude are magnitudes; the direction bits give the sign.
+ * NP_Fix: 0=none, 1=2D, 2=3D, 3=DGPS
  */
-struct NavPosData {
-    double latitude;        // NP_LatDegree: degrees
-    double longitude;       // NP_LongDegree: degrees
-    bool latSouth;          // NP_LatDirection: 0=North, 1=South
-    bool longWest;          // NP_LongDirection: 0=East, 1=West
-    uint8_t satellites;     // NP_Sat: count
-    uint8_t fixType;        // NP_Fix: 0=none, 1=2D, 2=3D, 3=DGPS
-};
+#define NAV_POS_01_SIGNALS(SIG, FIELD) \
+    SIG(double,  latitude,   "NP_LatDegree",     0,  27, INTEL, UNSIGNED, 0.000001, 0.0, "deg") \
+    SIG(double,  longitude,  "NP_LongDegree",    27, 28, INTEL, UNSIGNED, 0.000001, 0.0, "deg") \
+    SIG(bool,    latSouth,   "NP_LatDirection",  55, 1,  INTEL, UNSIGNED, 1,        0,   "") /* 0=North, 1=South */ \
+    SIG(bool,    longWest,   "NP_LongDirection", 56, 1,  INTEL, UNSIGNED, 1,        0,   "") /* 0=East, 1=West */ \
+    SIG(uint8_t, satellites, "NP_Sat",           57, 5,  INTEL, UNSIGNED, 1,        0,   "") \
+    SIG(uint8_t, fixType,    "NP_Fix",           62, 2,  INTEL, UNSIGNED, 1,        0,   "")
+BROADCAST_MESSAGE(NavPosData, NAV_POS_01_SIGNALS)
 
 inline NavPosData decodeNavPos01(const uint8_t* data) {
     NavPosData result;
-    
-    // NP_LatDegree: bits 0-26 (27 bits), scale 0.000001°
-    uint32_t rawLat = extractSignalLE(data, 0, 27);
-    result.latitude = rawLat * 0.000001;
-    
-    // NP_LongDegree: bits 27-54 (28 bits), scale 0.000001°
-    uint32_t rawLong = extractSignalLE(data, 27, 28);
-    result.longitude = rawLong * 0.000001;
-    
-    // NP_LatDirection: bit 55 (0=North, 1=South)
-    result.latSouth = extractBit(data, 55);
-    
-    // NP_LongDirection: bit 56 (0=East, 1=West)
-    result.longWest = extractBit(data, 56);
-    
-    // NP_Sat: bits 57-61 (5 bits)
-    result.satellites = extractSignalLE(data, 57, 5);
-    
-    // NP_Fix: bits 62-63 (2 bits)
-    result.fixType = extractSignalLE(data, 62, 2);
+    decodeSignals(loadFrameLE(data), result);
     
     // Apply direction signs
     if (result.latSouth) result.latitude = -result.latitude;
@@ -481,77 +394,37 @@ inline NavPosData decodeNavPos01(const uint8_t* data) {
 /**
  * NavData_02 (0x485) - Altitude, UTC, Satellites
  */
-struct NavData02Data {
-    uint8_t satsInUse;      // ND_SatInUse: satellites in fix
-    uint8_t satsInView;     // ND_SatInView: satellites visible
-    float altitude;         // NP_Altitude: meters
-    uint32_t utcTime;       // ND_UTC: Unix timestamp
-    bool accuracyOK;        // Accuracy_OK flag
-    uint8_t accuracy;       // Horizontal accuracy in meters
-};
+#define NAV_DATA_02_SIGNALS(SIG, FIELD) \
+    SIG(uint8_t,  satsInUse,  "ND_SatInUse",  0,  5,  INTEL, UNSIGNED, 1,    0,       "") \
+    SIG(uint8_t,  satsInView, "ND_SatInView", 8,  5,  INTEL, UNSIGNED, 1,    0,       "") \
+    SIG(float,    altitude,   "NP_Altitude",  20, 12, INTEL, UNSIGNED, 2.0f, -500.0f, "m") \
+    SIG(uint32_t, utcTime,    "ND_UTC",       32, 32, INTEL, UNSIGNED, 1,    0,       "s") /* Unix timestamp */ \
+    SIG(bool,     accuracyOK, "Accuracy_OK",  5,  1,  INTEL, UNSIGNED, 1,    0,       "") \
+    SIG(uint8_t,  accuracy,   "Accuracy",     13, 7,  INTEL, UNSIGNED, 2,    0,       "m") /* Horizontal */
+BROADCAST_MESSAGE(NavData02Data, NAV_DATA_02_SIGNALS)
 
 inline NavData02Data decodeNavData02(const uint8_t* data) {
     NavData02Data result;
-    
-    // ND_SatInUse: bits 0-4 (5 bits)
-    result.satsInUse = extractSignalLE(data, 0, 5);
-    
-    // Accuracy_OK: bit 5
-    result.accuracyOK = extractBit(data, 5);
-    
-    // ND_SatInView: bits 8-12 (5 bits)
-    result.satsInView = extractSignalLE(data, 8, 5);
-    
-    // Accuracy: bits 13-19 (7 bits), scale 2m
-    result.accuracy = extractSignalLE(data, 13, 7) * 2;
-    
-    // NP_Altitude: bits 20-31 (12 bits), scale 2, offset -500m
-    uint32_t rawAlt = extractSignalLE(data, 20, 12);
-    result.altitude = applyScaleOffset(rawAlt, 2.0f, -500.0f);
-    
-    // ND_UTC: bits 32-63 (32 bits) - Unix timestamp
-    result.utcTime = extractSignalLE(data, 32, 32);
-    
+    decodeSignals(loadFrameLE(data), result);
     return result;
 }
 
 /**
  * NavData_01 (0x484) - Heading and DOP values
  */
-struct NavData01Data {
-    float vdop;             // ND_VDOP: Vertical DOP
-    float tdop;             // ND_TDOP: Time DOP
-    float hdop;             // ND_HDOP: Horizontal DOP
-    float gdop;             // ND_GDOP: Geometric DOP
-    float pdop;             // ND_PDOP: Position DOP
-    float heading;          // ND_Heading: degrees (0-359.9)
-    bool gpsInit;           // ND_Init: GPS initialized
-};
+#define NAV_DATA_01_SIGNALS(SIG, FIELD) \
+    SIG(float, vdop,    "ND_VDOP",    0,  10, INTEL, UNSIGNED, 0.025f, 0.0f, "") \
+    SIG(float, tdop,    "ND_TDOP",    10, 10, INTEL, UNSIGNED, 0.025f, 0.0f, "") \
+    SIG(float, hdop,    "ND_HDOP",    20, 10, INTEL, UNSIGNED, 0.025f, 0.0f, "") \
+    SIG(float, gdop,    "ND_GDOP",    30, 10, INTEL, UNSIGNED, 0.025f, 0.0f, "") \
+    SIG(float, pdop,    "ND_PDOP",    40, 10, INTEL, UNSIGNED, 0.025f, 0.0f, "") \
+    SIG(float, heading, "ND_Heading", 50, 12, INTEL, UNSIGNED, 0.1f,   0.0f, "deg") /* 0-359.9 */ \
+    SIG(bool,  gpsInit, "ND_Init",    62, 1,  INTEL, UNSIGNED, 1,      0,    "")
+BROADCAST_MESSAGE(NavData01Data, NAV_DATA_01_SIGNALS)
 
 inline NavData01Data decodeNavData01(const uint8_t* data) {
     NavData01Data result;
-    
-    // ND_VDOP: bits 0-9 (10 bits), scale 0.025
-    result.vdop = extractSignalLE(data, 0, 10) * 0.025f;
-    
-    // ND_TDOP: bits 10-19 (10 bits), scale 0.025
-    result.tdop = extractSignalLE(data, 10, 10) * 0.025f;
-    
-    // ND_HDOP: bits 20-29 (10 bits), scale 0.025
-    result.hdop = extractSignalLE(data, 20, 10) * 0.025f;
-    
-    // ND_GDOP: bits 30-39 (10 bits), scale 0.025
-    result.gdop = extractSignalLE(data, 30, 10) * 0.025f;
-    
-    // ND_PDOP: bits 40-49 (10 bits), scale 0.025
-    result.pdop = extractSignalLE(data, 40, 10) * 0.025f;
-    
-    // ND_Heading: bits 50-61 (12 bits), scale 0.1°
-    result.heading = extractSignalLE(data, 50, 12) * 0.1f;
-    
-    // ND_Init: bit 62
-    result.gpsInit = extractBit(data, 62);
-    
+    decodeSignals(loadFrameLE(data), result);
     return result;
 }
 
@@ -561,77 +434,42 @@ inline NavData01Data decodeNavData01(const uint8_t* data) {
 
 /**
  * Reichweite_01 (0x5F5) - Range data from instrument cluster
+ * RW_Prim_Reichweitenv_Einheit: 0=kWh/100km, 1=km/kWh
  */
-struct Reichweite01Data {
-    uint16_t maxDisplayRange;   // RW_Gesamt_Reichweite_Max_Anzeige (km)
-    uint16_t totalRange;        // RW_Gesamt_Reichweite (km)
-    uint16_t electricRange;     // RW_Primaer_Reichweite (km)
-    float consumption;          // RW_Prim_Reichweitenverbrauch
-    uint8_t consumptionUnit;    // 0=kWh/100km, 1=km/kWh
-    uint8_t reserveWarning2;    // RW_Reservewarnung_2_aktiv
-};
+#define REICHWEITE_01_SIGNALS(SIG, FIELD) \
+    SIG(uint16_t, maxDisplayRange, "RW_Gesamt_Reichweite_Max_Anzeige", 0,  11, INTEL, UNSIGNED, 1,    0,    "km") \
+    SIG(uint16_t, totalRange,      "RW_Gesamt_Reichweite",             29, 11, INTEL, UNSIGNED, 1,    0,    "km") \
+    SIG(uint16_t, electricRange,   "RW_Primaer_Reichweite",            53, 11, INTEL, UNSIGNED, 1,    0,    "km") \
+    SIG(float,    consumption,     "RW_Prim_Reichweitenverbrauch",     40, 11, INTEL, UNSIGNED, 0.1f, 0.0f, "") \
+    SIG(uint8_t,  consumptionUnit, "RW_Prim_Reichweitenv_Einheit",     51, 2,  INTEL, UNSIGNED, 1,    0,    "") \
+    SIG(uint8_t,  reserveWarning2, "RW_Reservewarnung_2_aktiv",        16, 2,  INTEL, UNSIGNED, 1,    0,    "")
+BROADCAST_MESSAGE(Reichweite01Data, REICHWEITE_01_SIGNALS)
 
 inline Reichweite01Data decodeReichweite01(const uint8_t* data) {
     Reichweite01Data result;
-    
-    // RW_Gesamt_Reichweite_Max_Anzeige: bits 0-10 (11 bits), scale 1 km
-    result.maxDisplayRange = extractSignalLE(data, 0, 11);
-    
-    // RW_Reservewarnung_2_aktiv: bits 16-17 (2 bits)
-    result.reserveWarning2 = extractSignalLE(data, 16, 2);
-    
-    // RW_Gesamt_Reichweite: bits 29-39 (11 bits), scale 1 km
-    result.totalRange = extractSignalLE(data, 29, 11);
-    
-    // RW_Prim_Reichweitenverbrauch: bits 40-50 (11 bits), scale 0.1
-    result.consumption = extractSignalLE(data, 40, 11) * 0.1f;
-    
-    // RW_Prim_Reichweitenv_Einheit: bits 51-52 (2 bits)
-    result.consumptionUnit = extractSignalLE(data, 51, 2);
-    
-    // RW_Primaer_Reichweite: bits 53-63 (11 bits), scale 1 km
-    result.electricRange = extractSignalLE(data, 53, 11);
-    
+    decodeSignals(loadFrameLE(data), result);
     return result;
 }
 
 /**
  * Reichweite_02 (0x5F7) - Range display data
+ * RW_Tendenz: 0=stable, 1=increasing, 2=decreasing
+ * RW_Reichweite_Einheit_Anzeige: 0=km, 1=miles
+ * RW_Sekundaer_Reichweite_Anzeige: N/A for BEV
  */
-struct Reichweite02Data {
-    uint8_t tendency;           // RW_Tendenz: 0=stable, 1=increasing, 2=decreasing
-    uint8_t textIndex;          // RW_Texte
-    bool reserveWarning;        // RW_Reservewarnung_aktiv
-    bool displayInMiles;        // RW_Reichweite_Einheit_Anzeige: 0=km, 1=miles
-    uint16_t displayTotalRange; // RW_Gesamt_Reichweite_Anzeige (km)
-    uint16_t displayElectricRange; // RW_Primaer_Reichweite_Anzeige (km)
-    uint16_t displaySecondaryRange; // RW_Sekundaer_Reichweite_Anzeige (N/A for BEV)
-};
+#define REICHWEITE_02_SIGNALS(SIG, FIELD) \
+    SIG(uint8_t,  tendency,              "RW_Tendenz",                      0,  3,  INTEL, UNSIGNED, 1, 0, "") \
+    SIG(uint8_t,  textIndex,             "RW_Texte",                        3,  2,  INTEL, UNSIGNED, 1, 0, "") \
+    SIG(bool,     reserveWarning,        "RW_Reservewarnung_aktiv",         5,  1,  INTEL, UNSIGNED, 1, 0, "") \
+    SIG(bool,     displayInMiles,        "RW_Reichweite_Einheit_Anzeige",   6,  1,  INTEL, UNSIGNED, 1, 0, "") \
+    SIG(uint16_t, displayTotalRange,     "RW_Gesamt_Reichweite_Anzeige",    7,  11, INTEL, UNSIGNED, 1, 0, "km") \
+    SIG(uint16_t, displayElectricRange,  "RW_Primaer_Reichweite_Anzeige",   18, 11, INTEL, UNSIGNED, 1, 0, "km") \
+    SIG(uint16_t, displaySecondaryRange, "RW_Sekundaer_Reichweite_Anzeige", 29, 11, INTEL, UNSIGNED, 1, 0, "km")
+BROADCAST_MESSAGE(Reichweite02Data, REICHWEITE_02_SIGNALS)
 
 inline Reichweite02Data decodeReichweite02(const uint8_t* data) {
     Reichweite02Data result;
-    
-    // RW_Tendenz: bits 0-2 (3 bits)
-    result.tendency = extractSignalLE(data, 0, 3);
-    
-    // RW_Texte: bits 3-4 (2 bits)
-    result.textIndex = extractSignalLE(data, 3, 2);
-    
-    // RW_Reservewarnung_aktiv: bit 5
-    result.reserveWarning = extractBit(data, 5);
-    
-    // RW_Reichweite_Einheit_Anzeige: bit 6
-    result.displayInMiles = extractBit(data, 6);
-    
-    // RW_Gesamt_Reichweite_Anzeige: bits 7-17 (11 bits), scale 1 km
-    result.displayTotalRange = extractSignalLE(data, 7, 11);
-    
-    // RW_Primaer_Reichweite_Anzeige: bits 18-28 (11 bits), scale 1 km
-    result.displayElectricRange = extractSignalLE(data, 18, 11);
-    
-    // RW_Sekundaer_Reichweite_Anzeige: bits 29-39 (11 bits), scale 1 km
-    result.displaySecondaryRange = extractSignalLE(data, 29, 11);
-    
+    decodeSignals(loadFrameLE(data), result);
     return result;
 }
 
@@ -649,25 +487,16 @@ inline Reichweite02Data decodeReichweite02(const uint8_t* data) {
  * - During AC charging: actual charging power from grid (741 ≈ 7.4kW)
  * - During climate: HVAC power consumption (up to ~10kW for cold start)
  */
-struct MotorHybrid06Data {
-    uint16_t powermeterGrenze;      // Mo_Powermeter_Grenze: general limit
-    uint16_t chargeGrenze;          // MO_Powermeter_Charge_Grenze: charge/climate power
-    uint16_t strategicLimit;        // MO_Powermeter_Grenze_strategisch
-    float powerKw;                  // Converted to kW (~10W per unit)
-};
+#define MOTOR_HYBRID_06_SIGNALS(SIG, FIELD) \
+    SIG(uint16_t, powermeterGrenze, "Mo_Powermeter_Grenze",             0,  12, INTEL, UNSIGNED, 1, 0, "") \
+    SIG(uint16_t, chargeGrenze,     "MO_Powermeter_Charge_Grenze",      18, 10, INTEL, UNSIGNED, 1, 0, "") \
+    SIG(uint16_t, strategicLimit,   "MO_Powermeter_Grenze_strategisch", 28, 12, INTEL, UNSIGNED, 1, 0, "") \
+    FIELD(float, powerKw)                                               /* Converted to kW (~10W per unit) */
+BROADCAST_MESSAGE(MotorHybrid06Data, MOTOR_HYBRID_06_SIGNALS)
 
 inline MotorHybrid06Data decodeMotorHybrid06(const uint8_t* data) {
     MotorHybrid06Data result;
-    
-    // Mo_Powermeter_Grenze: bits 0|12@LE, scale=1
-    result.powermeterGrenze = extractSignalLE(data, 0, 12);
-    
-    // MO_Powermeter_Charge_Grenze: bits 18|10@LE, scale=1
-    // This is the key signal for charging/climate power
-    result.chargeGrenze = extractSignalLE(data, 18, 10);
-    
-    // MO_Powermeter_Grenze_strategisch: bits 28|12@LE, scale=1
-    result.strategicLimit = extractSignalLE(data, 28, 12);
+    decodeSignals(loadFrameLE(data), result);
     
     // Convert to kW: approximately 10W per unit
     // 741 units ≈ 7.4kW (matches e-Golf's 7.2kW AC charging max)
@@ -0,0 +1,322 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * SignalCodec - Compile-time CAN signal descriptors and generated decoders
+ *
+ * A broadcast message is described once, as an X-macro table of its signals:
+ *
+ *   #define KLIMA_03_SIGNALS(SIG, FIELD) \
+ *       SIG(float, insideTemp, "KL_Innen_Temp", 32, 8, INTEL, UNSIGNED, 0.5f, -50.0f, "C") \
+ *       SIG(bool, standbyVentActive, "KL_STL_aktiv", 0, 1, INTEL, UNSIGNED, 1, 0, "")
+ *   BROADCAST_MESSAGE(KlimaData, KLIMA_03_SIGNALS)
+ *
+ * SIG(type, field, dbcName, startBit, length, order, sign, scale, offset, unit)
+ *   startBit/length/order follow DBC notation (start|length@order).
+ *   Scale and offset are applied in the type of their literals, so integer
+ *   literals keep integer math (no float on the CAN task for counters/IDs).
+ * FIELD(type, field)
+ *   A struct member that is filled in by hand-written code after decode
+ *   (derived values such as a sign applied from a direction bit).
+ *
+ * BROADCAST_MESSAGE generates from the one table:
+ * - struct Name with one member per SIG/FIELD, in table order
+ * - MessageLayout<Name>: signal count and the SignalDesc table (name, unit,
+ *   scale/offset as metadata for logging and tooling)
+ * - decodeSignals(frame, Name&): one SignalExtract<start, length, ...> per
+ *   signal, fully unrolled with every shift and mask a constant
+ * - static_asserts: each signal lies inside the 8-byte frame and no two
+ *   signals share a bit
+ *
+ * Adding a signal is one table line; a wrong bit offset that collides with
+ * a neighbour or runs off the frame fails the build.
+ *
+ * BROADCAST_RAW_MESSAGE takes the same table but stores the raw integer of
+ * each signal (no scale/offset math at decode time). SIG's type must be a
+ * fixed-width integer of the signal's signedness, wide enough for its length.
+ * The struct also gets a static <field>Physical(raw) per signal that applies
+ * the table's scale and offset, so raw values can be stored as-is and
+ * converted only where they are read. The tables generated by tools/dbc_codegen
+ * use this form.
+ *
+ * BROADCAST_MUX_MESSAGE describes a multiplexed message: a selector signal
+ * picks which page layout occupies the rest of the frame.
+ *
+ *   #define NAV_POS_02_SELECTOR(SIG) SIG(uint8_t, mux, "POS_Mux", 0, 2, INTEL, UNSIGNED, 1, 0, "")
+ *   #define NAV_POS_02_PAGES(PAGE) \
+ *       PAGE(0, position, NavPos02PositionRaw) \
+ *       PAGE(1, heading, NavPos02HeadingRaw)
+ *   BROADCAST_MUX_MESSAGE(NavPos02Raw, NAV_POS_02_SIGNALS, NAV_POS_02_SELECTOR, NAV_POS_02_PAGES)
+ *
+ * PAGE(value, member, Struct) names a BROADCAST_RAW_MESSAGE struct per
+ * selector value. The generated struct holds the selector, the signals of
+ * the SIGNALS table (decoded from every frame) and one member per page.
+ * decodeSignals() decodes only the page of the frame's selector value,
+ * found with one load from a table indexed by that value, and leaves the
+ * other pages as they were. A struct that is kept across frames is
+ * therefore a cache of the last value of every page (pagesSeen has one bit
+ * per page received).
+ */
+namespace BroadcastDecoder {
+
+enum class ByteOrder : uint8_t {
+    INTEL,      // @1, little-endian: startBit is the LSB
+    MOTOROLA    // @0, big-endian: startBit is the MSB (DBC sawtooth numbering)
+};
+
+enum class Signedness : uint8_t {
+    UNSIGNED,
+    SIGNED      // Two's complement over the signal length
+};
+
+/**
+ * Signal descriptor (metadata; decoding uses the template parameters).
+ */
+struct SignalDesc {
+    const char* name;       // DBC signal name
+    uint8_t startBit;
+    uint8_t length;
+    ByteOrder order;
+    Signedness sign;
+    float scale;
+    float offset;
+    const char* unit;
+};
+
+// =============================================================================
+// Compile-time checks
+// =============================================================================
+
+/**
+ * Bit position of a Motorola signal's LSB in the byte-swapped payload word
+ * (may be negative when the signal runs off the end of the frame).
+ */
+constexpr int motorolaLsb(uint8_t startBit, uint8_t length) {
+    return (7 - startBit / 8) * 8 + startBit % 8 - length + 1;
+}
+
+constexpr bool signalFits(uint8_t startBit, uint8_t length, ByteOrder order) {
+    return length >= 1 && length <= 32 && startBit < 64 &&
+           (order == ByteOrder::INTEL ? startBit + length <= 64 : motorolaLsb(startBit, length) >= 0);
+}
+
+constexpr uint64_t byteSwap64(uint64_t value) {
+    return __builtin_bswap64(value);
+}
+
+/**
+ * Frame bits covered by a signal, in DBC (Intel) bit numbering.
+ */
+constexpr uint64_t signalMask(const SignalDesc& signal) {
+    return signal.order == ByteOrder::INTEL
+        ? ((1ULL << signal.length) - 1) << signal.startBit
+        : byteSwap64(((1ULL << signal.length) - 1) << motorolaLsb(signal.startBit, signal.length));
+}
+
+constexpr bool signalsFit(const SignalDesc* signals, size_t count) {
+    return count == 0 ||
+           (signalFits(signals[0].startBit, signals[0].length, signals[0].order) && signalsFit(signals + 1, count - 1));
+}
+
+constexpr bool signalsOverlap(const SignalDesc* signals, size_t count, uint64_t used = 0) {
+    return count != 0 &&
+           ((signalMask(signals[0]) & used) != 0 || signalsOverlap(signals + 1, count - 1, used | signalMask(signals[0])));
+}
+
+// =============================================================================
+// Extraction
+// =============================================================================
+
+/**
+ * Raw value of one signal from the little-endian payload word.
+ * All shifts and masks are compile-time constants.
+ */
+template<uint8_t StartBit, uint8_t Length, ByteOrder Order, Signedness Sign>
+struct SignalExtract {
+    static_assert(signalFits(StartBit, Length, Order), "CAN signal length must be 1-32 bits and lie inside the 8-byte frame");
+
+    using Raw = typename std::conditional<Sign == Signedness::SIGNED, int32_t, uint32_t>::type;
+
+    static constexpr uint64_t MASK = (1ULL << Length) - 1;
+
+    static Raw extract(uint64_t frame) {
+        uint32_t raw = Order == ByteOrder::INTEL
+            ? (uint32_t)((frame >> StartBit) & MASK)
+            : (uint32_t)((__builtin_bswap64(frame) >> (motorolaLsb(StartBit, Length) & 63)) & MASK);
+        return Sign == Signedness::SIGNED
+            ? (Raw)(int32_t)(raw << (32 - Length)) >> (32 - Length)   // Sign-extend
+            : (Raw)raw;
+    }
+};
+
+/**
+ * Signal layout of a generated message struct (specialized by BROADCAST_MESSAGE).
+ */
+template<typename Message>
+struct MessageLayout;
+
+// =============================================================================
+// Multiplexed messages
+// =============================================================================
+
+/**
+ * Compile-time index list (C++11 has no std::index_sequence).
+ */
+template<size_t... Index>
+struct IndexList {};
+
+template<size_t Count, size_t... Index>
+struct MakeIndexList : MakeIndexList<Count - 1, Count - 1, Index...> {};
+
+template<size_t... Index>
+struct MakeIndexList<0, Index...> {
+    typedef IndexList<Index...> type;
+};
+
+/**
+ * Page decoder for every selector value of a BROADCAST_MUX_MESSAGE
+ * (nullptr where no page is defined), built at compile time from the
+ * message's pageDecoder().
+ */
+template<typename Message, typename Values = typename MakeIndexList<Message::SELECTOR_VALUES>::type>
+struct MuxPageTable;
+
+template<typename Message, size_t... Values>
+struct MuxPageTable<Message, IndexList<Values...>> {
+    static constexpr typename Message::PageDecoder DECODERS[sizeof...(Values)] = { Message::pageDecoder(Values)... };
+};
+
+template<typename Message, size_t... Values>
+constexpr typename Message::PageDecoder MuxPageTable<Message, IndexList<Values...>>::DECODERS[sizeof...(Values)];
+
+/**
+ * Physical value of a raw signal (BROADCAST_RAW_MESSAGE fields).
+ */
+inline float toPhysical(int64_t raw, const SignalDesc& signal) {
+    return (float)raw * signal.scale + signal.offset;
+}
+
+} // namespace BroadcastDecoder
+
+// =============================================================================
+// Generator macros
+// =============================================================================
+
+#define BROADCAST_SIG_FIELD(type, field, ...) type field;
+#define BROADCAST_FIELD(type, field) type field;
+#define BROADCAST_SIG_COUNT(...) + 1
+#define BROADCAST_SKIP(...)
+#define BROADCAST_SIG_DESC(type, field, dbcName, startBit, length, order, sign, scale, offset, unit) \
+    { dbcName, startBit, length, ::BroadcastDecoder::ByteOrder::order, ::BroadcastDecoder::Signedness::sign, \
+      static_cast<float>(scale), static_cast<float>(offset), unit },
+#define BROADCAST_SIG_DECODE(type, field, dbcName, startBit, length, order, sign, scale, offset, unit) \
+    out.field = static_cast<type>( \
+        ::BroadcastDecoder::SignalExtract<startBit, length, ::BroadcastDecoder::ByteOrder::order, \
+                                          ::BroadcastDecoder::Signedness::sign>::extract(frame) * (scale) + (offset));
+
+#define BROADCAST_SIG_DECODE_RAW(type, field, dbcName, startBit, length, order, sign, scale, offset, unit) \
+    static_assert(std::is_integral<type>::value && sizeof(type) * 8 >= length && \
+                  std::is_signed<type>::value == (::BroadcastDecoder::Signedness::sign == ::BroadcastDecoder::Signedness::SIGNED), \
+                  dbcName ": raw field must be a fixed-width integer of the signal's width and signedness"); \
+    out.field = static_cast<type>( \
+        ::BroadcastDecoder::SignalExtract<startBit, length, ::BroadcastDecoder::ByteOrder::order, \
+                                          ::BroadcastDecoder::Signedness::sign>::extract(frame));
+
+#define BROADCAST_SIG_PHYSICAL(type, field, dbcName, startBit, length, order, sign, scale, offset, unit) \
+    static constexpr double field##Physical(type raw) { return raw * (double)(scale) + (double)(offset); }
+
+#define BROADCAST_MESSAGE_WITH(Name, SIGNALS, DECODE, MEMBERS) \
+    struct Name { \
+        SIGNALS(BROADCAST_SIG_FIELD, BROADCAST_FIELD) \
+        SIGNALS(MEMBERS, BROADCAST_SKIP) \
+    }; \
+    template<> \
+    struct MessageLayout<Name> { \
+        static constexpr size_t SIGNAL_COUNT = 0 SIGNALS(BROADCAST_SIG_COUNT, BROADCAST_SKIP); \
+        static const SignalDesc* signals() { \
+            static constexpr SignalDesc TABLE[] = { SIGNALS(BROADCAST_SIG_DESC, BROADCAST_SKIP) }; \
+            static_assert(signalsFit(TABLE, SIGNAL_COUNT), #Name ": signal outside the 8-byte frame"); \
+            static_assert(!signalsOverlap(TABLE, SIGNAL_COUNT), #Name ": signals overlap"); \
+            return TABLE; \
+        } \
+    }; \
+    inline void decodeSignals(uint64_t frame, Name& out) { \
+        SIGNALS(DECODE, BROADCAST_SKIP) \
+    }
+
+#define BROADCAST_MUX_SELECTOR_NAME(type, field, ...) field
+#define BROADCAST_MUX_SELECTOR_VALUES(type, field, dbcName, startBit, length, ...) (1U << (length))
+#define BROADCAST_MUX_SELECTOR_CHECK(type, field, dbcName, startBit, length, ...) \
+    static_assert(length <= 8, dbcName ": mux selector wider than 8 bits");
+#define BROADCAST_MUX_PAGE_INDEX(value, page, Struct) page##Page,
+#define BROADCAST_MUX_PAGE_FIELD(value, page, Struct) Struct page;
+#define BROADCAST_MUX_PAGE_DECODE(value, page, Struct) \
+    static void decode_##page(uint64_t frame, Self& out) { \
+        decodeSignals(frame, out.page); \
+        out.pagesSeen |= 1U << page##Page; \
+    }
+#define BROADCAST_MUX_PAGE_SELECT(value, page, Struct) mux == (value) ? &Self::decode_##page :
+#define BROADCAST_MUX_PAGE_CHECK(value, page, Struct) \
+    static_assert((value) < SELECTOR_VALUES, #page ": mux value does not fit the selector");
+
+/**
+ * Generate the message struct, its layout and decodeSignals() from a signal
+ * table (see top of file). Use inside namespace BroadcastDecoder.
+ */
+#define BROADCAST_MESSAGE(Name, SIGNALS) BROADCAST_MESSAGE_WITH(Name, SIGNALS, BROADCAST_SIG_DECODE, BROADCAST_SKIP)
+
+/**
+ * As BROADCAST_MESSAGE, but decodeSignals() stores raw integers and the
+ * struct gets <field>Physical(raw) converters.
+ */
+#define BROADCAST_RAW_MESSAGE(Name, SIGNALS) BROADCAST_MESSAGE_WITH(Name, SIGNALS, BROADCAST_SIG_DECODE_RAW, BROADCAST_SIG_PHYSICAL)
+
+/**
+ * Multiplexed message (see top of file). SELECTOR holds the one SIG of the
+ * mux selector; SIGNALS the signals present in every frame (may be empty).
+ * decodeSignals() returns false if the selector value has no page.
+ */
+#define BROADCAST_MUX_MESSAGE(Name, SIGNALS, SELECTOR, PAGES) \
+    struct Name { \
+        typedef Name Self; \
+        typedef void (*PageDecoder)(uint64_t frame, Name& out); \
+        enum Page : uint8_t { PAGES(BROADCAST_MUX_PAGE_INDEX) PAGE_COUNT }; \
+        static constexpr size_t SELECTOR_VALUES = SELECTOR(BROADCAST_MUX_SELECTOR_VALUES); \
+        PAGES(BROADCAST_MUX_PAGE_CHECK) \
+        SELECTOR(BROADCAST_SIG_FIELD) \
+        SIGNALS(BROADCAST_SIG_FIELD, BROADCAST_FIELD) \
+        PAGES(BROADCAST_MUX_PAGE_FIELD) \
+        uint32_t pagesSeen = 0; \
+        SELECTOR(BROADCAST_SIG_PHYSICAL) \
+        SIGNALS(BROADCAST_SIG_PHYSICAL, BROADCAST_SKIP) \
+        PAGES(BROADCAST_MUX_PAGE_DECODE) \
+        static constexpr PageDecoder pageDecoder(size_t mux) { return PAGES(BROADCAST_MUX_PAGE_SELECT) nullptr; } \
+        bool hasPage(Page page) const { return (pagesSeen & (1U << page)) != 0; } \
+    }; \
+    SELECTOR(BROADCAST_MUX_SELECTOR_CHECK) \
+    static_assert(Name::PAGE_COUNT <= 32, #Name ": more than 32 mux pages"); \
+    template<> \
+    struct MessageLayout<Name> { \
+        static constexpr size_t SIGNAL_COUNT = 1 SIGNALS(BROADCAST_SIG_COUNT, BROADCAST_SKIP); \
+        static const SignalDesc* signals() { \
+            static constexpr SignalDesc TABLE[] = { \
+                SELECTOR(BROADCAST_SIG_DESC) SIGNALS(BROADCAST_SIG_DESC, BROADCAST_SKIP) \
+            }; \
+            static_assert(signalsFit(TABLE, SIGNAL_COUNT), #Name ": signal outside the 8-byte frame"); \
+            static_assert(!signalsOverlap(TABLE, SIGNAL_COUNT), #Name ": signals overlap"); \
+            return TABLE; \
+        } \
+    }; \
+    inline bool decodeSignals(uint64_t frame, Name& out) { \
+        SELECTOR(BROADCAST_SIG_DECODE_RAW) \
+        SIGNALS(BROADCAST_SIG_DECODE_RAW, BROADCAST_SKIP) \
+        Name::PageDecoder decode = MuxPageTable<Name>::DECODERS[out.SELECTOR(BROADCAST_MUX_SELECTOR_NAME)]; \
+        if (decode == nullptr) { \
+            return false; \
+        } \
+        decode(frame, out); \
+        return true; \
+    }
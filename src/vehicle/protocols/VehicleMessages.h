@@ -0,0 +1,523 @@
+#pragma once
+
+// Generated by tools/dbc_codegen/dbc_codegen.py - do not edit.
+// Inputs:    docs/canbus-reverse-engineering/extracted_hcan_signals.md, docs/canbus-reverse-engineering/extracted_mqb_signals.md, tools/dbc_codegen/comfort_supplement.dbc
+// Selection: tools/dbc_codegen/selection.txt
+// Regenerate with: make -C tools/dbc_codegen
+
+#include "BroadcastDecoder.h"
+
+/**
+ * VehicleMessages - Raw decoders and routing table for the broadcast messages
+ * selected in tools/dbc_codegen/selection.txt
+ *
+ * Decoders store the raw integer of every signal. Each struct has a static
+ * <field>Physical(raw) converter, and its SignalDesc table
+ * (MessageLayout<Struct>::signals()) carries scale, offset and unit.
+ */
+namespace BroadcastDecoder {
+
+// ============================================================================
+// Drive
+// ============================================================================
+
+/**
+ * ESP_21 (0x0FD) - DLC 8, Gateway_MQB
+ */
+#define ESP_21_RAW_SIGNALS(SIG, FIELD) \
+    SIG(uint16_t, speed, "ESP_v_Signal", 32, 16, INTEL, UNSIGNED, 0.01, 0, "km/h")
+BROADCAST_RAW_MESSAGE(Esp21Raw, ESP_21_RAW_SIGNALS)
+
+inline Esp21Raw decodeEsp21Raw(const uint8_t* data) {
+    Esp21Raw result;
+    decodeSignals(loadFrameLE(data), result);
+    return result;
+}
+
+/**
+ * Klemmen_Status_01 (0x3C0) - DLC 4, Gateway
+ */
+#define KLEMMEN_STATUS_01_RAW_SIGNALS(SIG, FIELD) \
+    SIG(uint8_t, keyInserted,    "ZAS_Kl_S",  16, 1, INTEL, UNSIGNED, 1, 0, "") \
+    SIG(uint8_t, ignitionOn,     "ZAS_Kl_15", 17, 1, INTEL, UNSIGNED, 1, 0, "") \
+    SIG(uint8_t, startRequested, "ZAS_Kl_50", 19, 1, INTEL, UNSIGNED, 1, 0, "")
+BROADCAST_RAW_MESSAGE(KlemmenStatus01Raw, KLEMMEN_STATUS_01_RAW_SIGNALS)
+
+inline KlemmenStatus01Raw decodeKlemmenStatus01Raw(const uint8_t* data) {
+    KlemmenStatus01Raw result;
+    decodeSignals(loadFrameLE(data), result);
+    return result;
+}
+
+/**
+ * Diagnose_01 (0x6B2) - DLC 8, Gateway_MQB
+ */
+#define DIAGNOSE_01_RAW_SIGNALS(SIG, FIELD) \
+    SIG(uint32_t, odometer, "KBI_Kilometerstand", 8,  20, INTEL, UNSIGNED, 1, 0,    "km") \
+    SIG(uint8_t,  year,     "UH_Jahr",            28, 7,  INTEL, UNSIGNED, 1, 2000, "Year") \
+    SIG(uint8_t,  month,    "UH_Monat",           35, 4,  INTEL, UNSIGNED, 1, 0,    "Month") \
+    SIG(uint8_t,  day,      "UH_Tag",             39, 5,  INTEL, UNSIGNED, 1, 0,    "Day") \
+    SIG(uint8_t,  hour,     "UH_Stunde",          44, 5,  INTEL, UNSIGNED, 1, 0,    "h") \
+    SIG(uint8_t,  minute,   "UH_Minute",          49, 6,  INTEL, UNSIGNED, 1, 0,    "min") \
+    SIG(uint8_t,  second,   "UH_Sekunde",         55, 6,  INTEL, UNSIGNED, 1, 0,    "s")
+BROADCAST_RAW_MESSAGE(Diagnose01Raw, DIAGNOSE_01_RAW_SIGNALS)
+
+inline Diagnose01Raw decodeDiagnose01Raw(const uint8_t* data) {
+    Diagnose01Raw result;
+    decodeSignals(loadFrameLE(data), result);
+    return result;
+}
+
+// ============================================================================
+// Body
+// ============================================================================
+
+/**
+ * TSG_FT_01 (0x3D0) - DLC 8, Gateway
+ * Driver door module. Door bits and window position from traces.
+ */
+#define TSG_FT_01_RAW_SIGNALS(SIG, FIELD) \
+    SIG(uint8_t, doorOpen,   "FT_Tuer_geoeffnet", 0,  1, INTEL, UNSIGNED, 1, 0, "") \
+    SIG(uint8_t, doorLocked, "FT_verriegelt",     1,  1, INTEL, UNSIGNED, 1, 0, "") \
+    SIG(uint8_t, windowPos,  "FT_FH_Oeffnung",    24, 8, INTEL, UNSIGNED, 1, 0, "")
+BROADCAST_RAW_MESSAGE(TsgFt01Raw, TSG_FT_01_RAW_SIGNALS)
+
+inline TsgFt01Raw decodeTsgFt01Raw(const uint8_t* data) {
+    TsgFt01Raw result;
+    decodeSignals(loadFrameLE(data), result);
+    return result;
+}
+
+/**
+ * TSG_BT_01 (0x3D1) - DLC 8, Gateway
+ * Passenger door module, same layout as TSG_FT_01.
+ */
+#define TSG_BT_01_RAW_SIGNALS(SIG, FIELD) \
+    SIG(uint8_t, doorOpen,   "BT_Tuer_geoeffnet", 0,  1, INTEL, UNSIGNED, 1, 0, "") \
+    SIG(uint8_t, doorLocked, "BT_verriegelt",     1,  1, INTEL, UNSIGNED, 1, 0, "") \
+    SIG(uint8_t, windowPos,  "BT_FH_Oeffnung",    24, 8, INTEL, UNSIGNED, 1, 0, "")
+BROADCAST_RAW_MESSAGE(TsgBt01Raw, TSG_BT_01_RAW_SIGNALS)
+
+inline TsgBt01Raw decodeTsgBt01Raw(const uint8_t* data) {
+    TsgBt01Raw result;
+    decodeSignals(loadFrameLE(data), result);
+    return result;
+}
+
+/**
+ * ZV_02 (0x583) - DLC 8, BCM
+ * Central locking. Mapping differs from the DBC; raw bytes 2 and 7 carry the lock state.
+ */
+#define ZV_02_RAW_SIGNALS(SIG, FIELD) \
+    SIG(uint8_t, byte2, "ZV_02_Byte2", 16, 8, INTEL, UNSIGNED, 1, 0, "") \
+    SIG(uint8_t, byte7, "ZV_02_Byte7", 56, 8, INTEL, UNSIGNED, 1, 0, "")
+BROADCAST_RAW_MESSAGE(Zv02Raw, ZV_02_RAW_SIGNALS)
+
+inline Zv02Raw decodeZv02Raw(const uint8_t* data) {
+    Zv02Raw result;
+    decodeSignals(loadFrameLE(data), result);
+    return result;
+}
+
+// ============================================================================
+// Gps
+// ============================================================================
+
+/**
+ * NavData_01 (0x484) - DLC 8, Infotainment
+ */
+#define NAV_DATA_01_RAW_SIGNALS(SIG, FIELD) \
+    SIG(uint16_t, vdop,    "ND_VDOP",    0,  10, INTEL, UNSIGNED, 0.025, 0, "") \
+    SIG(uint16_t, tdop,    "ND_TDOP",    10, 10, INTEL, UNSIGNED, 0.025, 0, "") \
+    SIG(uint16_t, hdop,    "ND_HDOP",    20, 10, INTEL, UNSIGNED, 0.025, 0, "") \
+    SIG(uint16_t, gdop,    "ND_GDOP",    30, 10, INTEL, UNSIGNED, 0.025, 0, "") \
+    SIG(uint16_t, pdop,    "ND_PDOP",    40, 10, INTEL, UNSIGNED, 0.025, 0, "") \
+    SIG(uint16_t, heading, "ND_Heading", 50, 12, INTEL, UNSIGNED, 0.1,   0, "deg") \
+    SIG(uint8_t,  gpsInit, "ND_Init",    62, 1,  INTEL, UNSIGNED, 1,     0, "")
+BROADCAST_RAW_MESSAGE(NavData01Raw, NAV_DATA_01_RAW_SIGNALS)
+
+inline NavData01Raw decodeNavData01Raw(const uint8_t* data) {
+    NavData01Raw result;
+    decodeSignals(loadFrameLE(data), result);
+    return result;
+}
+
+/**
+ * NavData_02 (0x485) - DLC 8, Infotainment
+ */
+#define NAV_DATA_02_RAW_SIGNALS(SIG, FIELD) \
+    SIG(uint8_t,  satsInUse,  "ND_SatInUse",  0,  5,  INTEL, UNSIGNED, 1, 0,    "") \
+    SIG(uint8_t,  accuracyOK, "Accuracy_OK",  5,  1,  INTEL, UNSIGNED, 1, 0,    "") \
+    SIG(uint8_t,  satsInView, "ND_SatInView", 8,  5,  INTEL, UNSIGNED, 1, 0,    "") \
+    SIG(uint8_t,  accuracy,   "Accuracy",     13, 7,  INTEL, UNSIGNED, 2, 0,    "m") \
+    SIG(uint16_t, altitude,   "NP_Altitude",  20, 12, INTEL, UNSIGNED, 2, -500, "m") \
+    SIG(uint32_t, utcTime,    "ND_UTC",       32, 32, INTEL, UNSIGNED, 1, 0,    "s") /* Unix timestamp */
+BROADCAST_RAW_MESSAGE(NavData02Raw, NAV_DATA_02_RAW_SIGNALS)
+
+inline NavData02Raw decodeNavData02Raw(const uint8_t* data) {
+    NavData02Raw result;
+    decodeSignals(loadFrameLE(data), result);
+    return result;
+}
+
+/**
+ * NavPos_01 (0x486) - DLC 8, Infotainment
+ */
+#define NAV_POS_01_RAW_SIGNALS(SIG, FIELD) \
+    SIG(uint32_t, latitude,   "NP_LatDegree",     0,  27, INTEL, UNSIGNED, 1e-06, 0, "deg") \
+    SIG(uint32_t, longitude,  "NP_LongDegree",    27, 28, INTEL, UNSIGNED, 1e-06, 0, "deg") \
+    SIG(uint8_t,  latSouth,   "NP_LatDirection",  55, 1,  INTEL, UNSIGNED, 1,     0, "") /* 0=North, 1=South */ \
+    SIG(uint8_t,  longWest,   "NP_LongDirection", 56, 1,  INTEL, UNSIGNED, 1,     0, "") /* 0=East, 1=West */ \
+    SIG(uint8_t,  satellites, "NP_Sat",           57, 5,  INTEL, UNSIGNED, 1,     0, "") \
+    SIG(uint8_t,  fixType,    "NP_Fix",           62, 2,  INTEL, UNSIGNED, 1,     0, "") /* 0=none, 1=2D, 2=3D, 3=DGPS */
+BROADCAST_RAW_MESSAGE(NavPos01Raw, NAV_POS_01_RAW_SIGNALS)
+
+inline NavPos01Raw decodeNavPos01Raw(const uint8_t* data) {
+    NavPos01Raw result;
+    decodeSignals(loadFrameLE(data), result);
+    return result;
+}
+
+/**
+ * NavPos_02_Map_Matched (0x1A5554A8, extended) - DLC 8, Infotainment
+ * Map-matched position (OCU_FEATURES.md).
+ * Multiplexed on POS_Mux: 0 = position, 1 = heading
+ */
+#define NAV_POS_02_MAP_MATCHED_RAW_POSITION_SIGNALS(SIG, FIELD) \
+    SIG(uint32_t, latitude,  "POS_LatDegree",     8,  27, INTEL, UNSIGNED, 1e-06, 0, "deg") \
+    SIG(uint32_t, longitude, "POS_LongDegree",    36, 28, INTEL, UNSIGNED, 1e-06, 0, "deg") \
+    SIG(uint8_t,  latSouth,  "POS_LatDirection",  7,  1,  INTEL, UNSIGNED, 1,     0, "") /* 0=North, 1=South */ \
+    SIG(uint8_t,  longWest,  "POS_LongDirection", 35, 1,  INTEL, UNSIGNED, 1,     0, "") /* 0=East, 1=West */
+BROADCAST_RAW_MESSAGE(NavPos02MapMatchedPositionRaw, NAV_POS_02_MAP_MATCHED_RAW_POSITION_SIGNALS)
+
+#define NAV_POS_02_MAP_MATCHED_RAW_HEADING_SIGNALS(SIG, FIELD) \
+    SIG(uint16_t, heading,      "POS_Heading",       4,  12, INTEL, UNSIGNED, 0.1, 0, "deg") \
+    SIG(uint16_t, lastSyncSec,  "POS_Last_GPS_Sync", 16, 14, INTEL, UNSIGNED, 1,   0, "s") /* Seconds since the last GPS fix */ \
+    SIG(uint32_t, utcReference, "POS_UTC_REF",       32, 32, INTEL, UNSIGNED, 1,   0, "s")
+BROADCAST_RAW_MESSAGE(NavPos02MapMatchedHeadingRaw, NAV_POS_02_MAP_MATCHED_RAW_HEADING_SIGNALS)
+
+#define NAV_POS_02_MAP_MATCHED_RAW_SELECTOR(SIG) \
+    SIG(uint8_t, mux, "POS_Mux", 0, 2, INTEL, UNSIGNED, 1, 0, "")
+#define NAV_POS_02_MAP_MATCHED_RAW_SIGNALS(SIG, FIELD)
+#define NAV_POS_02_MAP_MATCHED_RAW_PAGES(PAGE) \
+    PAGE(0, position, NavPos02MapMatchedPositionRaw) \
+    PAGE(1, heading,  NavPos02MapMatchedHeadingRaw)
+BROADCAST_MUX_MESSAGE(NavPos02MapMatchedRaw, NAV_POS_02_MAP_MATCHED_RAW_SIGNALS, NAV_POS_02_MAP_MATCHED_RAW_SELECTOR, NAV_POS_02_MAP_MATCHED_RAW_PAGES)
+
+/**
+ * Decode the frame's page into cache (the other pages keep their last value).
+ * @return false if the selector value has no page
+ */
+inline bool decodeNavPos02MapMatchedRaw(const uint8_t* data, NavPos02MapMatchedRaw& cache) {
+    return decodeSignals(loadFrameLE(data), cache);
+}
+
+// ============================================================================
+// Battery
+// ============================================================================
+
+/**
+ * Motor_Hybrid_06 (0x483) - DLC 8, Gateway
+ * Power meter limits, forwarded from powertrain CAN. Charge limit is ~10 W per unit.
+ */
+#define MOTOR_HYBRID_06_RAW_SIGNALS(SIG, FIELD) \
+    SIG(uint16_t, powermeterGrenze, "Mo_Powermeter_Grenze",             0,  12, INTEL, UNSIGNED, 1, 0, "") \
+    SIG(uint16_t, chargeGrenze,     "MO_Powermeter_Charge_Grenze",      18, 10, INTEL, UNSIGNED, 1, 0, "") \
+    SIG(uint16_t, strategicLimit,   "MO_Powermeter_Grenze_strategisch", 28, 12, INTEL, UNSIGNED, 1, 0, "")
+BROADCAST_RAW_MESSAGE(MotorHybrid06Raw, MOTOR_HYBRID_06_RAW_SIGNALS)
+
+inline MotorHybrid06Raw decodeMotorHybrid06Raw(const uint8_t* data) {
+    MotorHybrid06Raw result;
+    decodeSignals(loadFrameLE(data), result);
+    return result;
+}
+
+/**
+ * BMS_06 (0x59E) - DLC 8, BMC_MLBevo
+ */
+#define BMS_06_RAW_SIGNALS(SIG, FIELD) \
+    SIG(uint8_t, temperature, "BMS_Temperatur", 16, 8, INTEL, UNSIGNED, 0.5, -40, "C")
+BROADCAST_RAW_MESSAGE(Bms06Raw, BMS_06_RAW_SIGNALS)
+
+inline Bms06Raw decodeBms06Raw(const uint8_t* data) {
+    Bms06Raw result;
+    decodeSignals(loadFrameLE(data), result);
+    return result;
+}
+
+/**
+ * BMS_07 (0x5CA) - DLC 8, BMC_MLBevo
+ */
+#define BMS_07_RAW_SIGNALS(SIG, FIELD) \
+    SIG(uint16_t, energy,          "BMS_Energieinhalt",     12, 11, INTEL, UNSIGNED, 50, 0, "Wh") \
+    SIG(uint8_t,  chargingActive,  "BMS_Ladevorgang_aktiv", 23, 1,  INTEL, UNSIGNED, 1,  0, "") \
+    SIG(uint8_t,  balancingActive, "BMS_Balancing_Aktiv",   30, 2,  INTEL, UNSIGNED, 1,  0, "") \
+    SIG(uint16_t, maxEnergy,       "BMS_MaxEnergieinhalt",  32, 11, INTEL, UNSIGNED, 50, 0, "Wh")
+BROADCAST_RAW_MESSAGE(Bms07Raw, BMS_07_RAW_SIGNALS)
+
+inline Bms07Raw decodeBms07Raw(const uint8_t* data) {
+    Bms07Raw result;
+    decodeSignals(loadFrameLE(data), result);
+    return result;
+}
+
+// ============================================================================
+// Climate
+// ============================================================================
+
+/**
+ * Klima_Sensor_02 (0x5E1) - DLC 8, Gateway
+ */
+#define KLIMA_SENSOR_02_RAW_SIGNALS(SIG, FIELD) \
+    SIG(uint8_t, outsideTemp, "BCM1_Aussen_Temp_ungef", 0, 8, INTEL, UNSIGNED, 0.5, -50, "C")
+BROADCAST_RAW_MESSAGE(KlimaSensor02Raw, KLIMA_SENSOR_02_RAW_SIGNALS)
+
+inline KlimaSensor02Raw decodeKlimaSensor02Raw(const uint8_t* data) {
+    KlimaSensor02Raw result;
+    decodeSignals(loadFrameLE(data), result);
+    return result;
+}
+
+/**
+ * Klima_03 (0x66E) - DLC 8, Gateway
+ */
+#define KLIMA_03_RAW_SIGNALS(SIG, FIELD) \
+    SIG(uint8_t, standbyVentActive,    "KL_STL_aktiv",  0,  1, INTEL, UNSIGNED, 1,   0,   "") \
+    SIG(uint8_t, standbyHeatingActive, "KL_STH_aktiv",  1,  1, INTEL, UNSIGNED, 1,   0,   "") \
+    SIG(uint8_t, insideTemp,           "KL_Innen_Temp", 32, 8, INTEL, UNSIGNED, 0.5, -50, "C")
+BROADCAST_RAW_MESSAGE(Klima03Raw, KLIMA_03_RAW_SIGNALS)
+
+inline Klima03Raw decodeKlima03Raw(const uint8_t* data) {
+    Klima03Raw result;
+    decodeSignals(loadFrameLE(data), result);
+    return result;
+}
+
+// ============================================================================
+// Range
+// ============================================================================
+
+/**
+ * Reichweite_01 (0x5F5) - DLC 8, Gateway
+ */
+#define REICHWEITE_01_RAW_SIGNALS(SIG, FIELD) \
+    SIG(uint16_t, maxDisplayRange, "RW_Gesamt_Reichweite_Max_Anzeige", 0,  11, INTEL, UNSIGNED, 1,   0, "") \
+    SIG(uint16_t, totalRange,      "RW_Gesamt_Reichweite",             29, 11, INTEL, UNSIGNED, 1,   0, "km") \
+    SIG(uint16_t, consumption,     "RW_Prim_Reichweitenverbrauch",     40, 11, INTEL, UNSIGNED, 0.1, 0, "") \
+    SIG(uint8_t,  consumptionUnit, "RW_Prim_Reichweitenv_Einheit",     51, 2,  INTEL, UNSIGNED, 1,   0, "") \
+    SIG(uint16_t, electricRange,   "RW_Primaer_Reichweite",            53, 11, INTEL, UNSIGNED, 1,   0, "km") /* Reichweite der primären Antriebsart */
+BROADCAST_RAW_MESSAGE(Reichweite01Raw, REICHWEITE_01_RAW_SIGNALS)
+
+inline Reichweite01Raw decodeReichweite01Raw(const uint8_t* data) {
+    Reichweite01Raw result;
+    decodeSignals(loadFrameLE(data), result);
+    return result;
+}
+
+/**
+ * Reichweite_02 (0x5F7) - DLC 8, Gateway
+ */
+#define REICHWEITE_02_RAW_SIGNALS(SIG, FIELD) \
+    SIG(uint8_t,  displayInMiles,        "RW_Reichweite_Einheit_Anzeige",   6,  1,  INTEL, UNSIGNED, 1, 0, "") \
+    SIG(uint16_t, displayTotalRange,     "RW_Gesamt_Reichweite_Anzeige",    7,  11, INTEL, UNSIGNED, 1, 0, "") \
+    SIG(uint16_t, displayElectricRange,  "RW_Primaer_Reichweite_Anzeige",   18, 11, INTEL, UNSIGNED, 1, 0, "") \
+    SIG(uint16_t, displaySecondaryRange, "RW_Sekundaer_Reichweite_Anzeige", 29, 11, INTEL, UNSIGNED, 1, 0, "")
+BROADCAST_RAW_MESSAGE(Reichweite02Raw, REICHWEITE_02_RAW_SIGNALS)
+
+inline Reichweite02Raw decodeReichweite02Raw(const uint8_t* data) {
+    Reichweite02Raw result;
+    decodeSignals(loadFrameLE(data), result);
+    return result;
+}
+
+} // namespace BroadcastDecoder
+
+namespace VehicleMessages {
+
+/**
+ * VehicleManager domain that receives a message.
+ */
+enum class Domain : uint8_t {
+    None,
+    Drive,
+    Body,
+    Gps,
+    Battery,
+    Climate,
+    Range,
+};
+
+struct Route {
+    uint32_t canId;                 // Extended IDs are above 0x7FF
+    uint8_t dlc;
+    Domain domain;
+    const char* name;
+};
+
+static constexpr Route ROUTES[] = {
+    { 0x0FD,      8, Domain::Drive,   "ESP_21" },
+    { 0x3C0,      4, Domain::Drive,   "Klemmen_Status_01" },
+    { 0x6B2,      8, Domain::Drive,   "Diagnose_01" },
+    { 0x3D0,      8, Domain::Body,    "TSG_FT_01" },
+    { 0x3D1,      8, Domain::Body,    "TSG_BT_01" },
+    { 0x583,      8, Domain::Body,    "ZV_02" },
+    { 0x484,      8, Domain::Gps,     "NavData_01" },
+    { 0x485,      8, Domain::Gps,     "NavData_02" },
+    { 0x486,      8, Domain::Gps,     "NavPos_01" },
+    { 0x1A5554A8, 8, Domain::Gps,     "NavPos_02_Map_Matched" },
+    { 0x483,      8, Domain::Battery, "Motor_Hybrid_06" },
+    { 0x59E,      8, Domain::Battery, "BMS_06" },
+    { 0x5CA,      8, Domain::Battery, "BMS_07" },
+    { 0x5E1,      8, Domain::Climate, "Klima_Sensor_02" },
+    { 0x66E,      8, Domain::Climate, "Klima_03" },
+    { 0x5F5,      8, Domain::Range,   "Reichweite_01" },
+    { 0x5F7,      8, Domain::Range,   "Reichweite_02" },
+};
+static constexpr size_t ROUTE_COUNT = sizeof(ROUTES) / sizeof(ROUTES[0]);
+
+// Standard IDs routed by VehicleManager (hardware acceptance filter input)
+static constexpr uint16_t ROUTED_STD_IDS[] = {
+    0x0FD, 0x3C0, 0x6B2,    // Drive
+    0x3D0, 0x3D1, 0x583,    // Body
+    0x484, 0x485, 0x486,    // Gps
+    0x483, 0x59E, 0x5CA,    // Battery
+    0x5E1, 0x66E,           // Climate
+    0x5F5, 0x5F7,           // Range
+};
+
+// Extended IDs routed by VehicleManager (BAP is routed separately)
+static constexpr uint32_t ROUTED_EXT_IDS[] = {
+    0x1A5554A8,             // Gps
+};
+static constexpr size_t ROUTED_EXT_ID_COUNT = 1;
+
+/**
+ * Domain of a standard CAN ID (Domain::None if not routed).
+ */
+inline Domain domainOf(uint32_t canId) {
+    switch (canId) {
+    case 0x0FD:
+    case 0x3C0:
+    case 0x6B2:
+        return Domain::Drive;
+    case 0x3D0:
+    case 0x3D1:
+    case 0x583:
+        return Domain::Body;
+    case 0x484:
+    case 0x485:
+    case 0x486:
+        return Domain::Gps;
+    case 0x483:
+    case 0x59E:
+    case 0x5CA:
+        return Domain::Battery;
+    case 0x5E1:
+    case 0x66E:
+        return Domain::Climate;
+    case 0x5F5:
+    case 0x5F7:
+        return Domain::Range;
+    default:
+        return Domain::None;
+    }
+}
+
+/**
+ * Domain of an extended CAN ID (Domain::None if not routed).
+ */
+inline Domain extendedDomainOf(uint32_t canId) {
+    switch (canId) {
+    case 0x1A5554A8:
+        return Domain::Gps;
+    default:
+        return Domain::None;
+    }
+}
+
+/**
+ * Decode a routed frame and pass the raw struct to handler(const Struct&).
+ * Multiplexed messages pass a struct holding only the frame's page.
+ * @return false if the ID is not routed, the frame is shorter than its DLC
+ *         or its mux value has no page
+ */
+template<typename Handler>
+inline bool decode(uint32_t canId, const uint8_t* data, uint8_t dlc, Handler& handler) {
+    switch (canId) {
+    case 0x0FD:
+        if (dlc < 8) return false;
+        handler(BroadcastDecoder::decodeEsp21Raw(data));
+        return true;
+    case 0x3C0:
+        if (dlc < 4) return false;
+        handler(BroadcastDecoder::decodeKlemmenStatus01Raw(data));
+        return true;
+    case 0x6B2:
+        if (dlc < 8) return false;
+        handler(BroadcastDecoder::decodeDiagnose01Raw(data));
+        return true;
+    case 0x3D0:
+        if (dlc < 8) return false;
+        handler(BroadcastDecoder::decodeTsgFt01Raw(data));
+        return true;
+    case 0x3D1:
+        if (dlc < 8) return false;
+        handler(BroadcastDecoder::decodeTsgBt01Raw(data));
+        return true;
+    case 0x583:
+        if (dlc < 8) return false;
+        handler(BroadcastDecoder::decodeZv02Raw(data));
+        return true;
+    case 0x484:
+        if (dlc < 8) return false;
+        handler(BroadcastDecoder::decodeNavData01Raw(data));
+        return true;
+    case 0x485:
+        if (dlc < 8) return false;
+        handler(BroadcastDecoder::decodeNavData02Raw(data));
+        return true;
+    case 0x486:
+        if (dlc < 8) return false;
+        handler(BroadcastDecoder::decodeNavPos01Raw(data));
+        return true;
+    case 0x1A5554A8: {
+        if (dlc < 8) return false;
+        BroadcastDecoder::NavPos02MapMatchedRaw message;
+        if (!BroadcastDecoder::decodeNavPos02MapMatchedRaw(data, message)) return false;
+        handler(message);
+        return true;
+    }
+    case 0x483:
+        if (dlc < 8) return false;
+        handler(BroadcastDecoder::decodeMotorHybrid06Raw(data));
+        return true;
+    case 0x59E:
+        if (dlc < 8) return false;
+        handler(BroadcastDecoder::decodeBms06Raw(data));
+        return true;
+    case 0x5CA:
+        if (dlc < 8) return false;
+        handler(BroadcastDecoder::decodeBms07Raw(data));
+        return true;
+    case 0x5E1:
+        if (dlc < 8) return false;
+        handler(BroadcastDecoder::decodeKlimaSensor02Raw(data));
+        return true;
+    case 0x66E:
+        if (dlc < 8) return false;
+        handler(BroadcastDecoder::decodeKlima03Raw(data));
+        return true;
+    case 0x5F5:
+        if (dlc < 8) return false;
+        handler(BroadcastDecoder::decodeReichweite01Raw(data));
+        return true;
+    case 0x5F7:
+        if (dlc < 8) return false;
+        handler(BroadcastDecoder::decodeReichweite02Raw(data));
+        return true;
+    default:
+        return false;
+    }
+}
+
+} // namespace VehicleMessages
@@ -19,6 +19,12 @@ void ActivityTracker::onCanActivity() {
     frameCount++;
 }
 
+void ActivityTracker::onCanActivity(uint32_t frames) {
+    // Called once per decode batch from CAN task (Core 0)
+    lastActivity = millis();
+    frameCount += frames;
+}
+
 bool ActivityTracker::isActive(uint32_t timeoutMs) const {
     unsigned long now = millis();
     unsigned long elapsed = now - lastActivity;
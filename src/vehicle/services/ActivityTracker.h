@@ -31,6 +31,13 @@ public:
      */
     void onCanActivity();
 
+    /**
+     * Notify of a batch of CAN frames (one timestamp for the whole batch).
+     * Thread-safe: can be called from CAN task.
+     * @param frames Number of frames in the batch
+     */
+    void onCanActivity(uint32_t frames);
+
     /**
      * Check if CAN bus is currently active.
      * @param timeoutMs How long since last activity is still considered active (default: 5000ms)
@@ -0,0 +1,292 @@
+#include "CustomSignalTable.h"
+#include <Preferences.h>
+#include <cmath>
+#include <cstring>
+
+/**
+ * NVS record: header followed by `count` Signal entries. A layout change
+ * bumps the version; records of another version load as an empty table.
+ */
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t count;
+    uint8_t reserved[2];
+} CustomSignalRecordHeader;
+
+static constexpr uint32_t RECORD_MAGIC = 0x43534754;  // "CSGT"
+static constexpr uint8_t RECORD_VERSION = 1;
+static constexpr const char* NVS_NAMESPACE = "customsig";
+static constexpr const char* NVS_KEY = "table";
+
+static bool isKeyChar(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+/**
+ * Payload bytes a signal needs (frames with a shorter DLC skip it).
+ */
+static uint8_t signalMinDlc(const CustomSignalTable::Signal& signal) {
+    if (signal.order == BroadcastDecoder::ByteOrder::INTEL) {
+        return (signal.startBit + signal.length - 1) / 8 + 1;
+    }
+    // Motorola: the LSB is the last byte the signal touches
+    return 8 - BroadcastDecoder::motorolaLsb(signal.startBit, signal.length) / 8;
+}
+
+CustomSignalTable::CustomSignalTable() {
+    clear();
+}
+
+void CustomSignalTable::clear() {
+    memset(idBitmap, 0, sizeof(idBitmap));
+    count = 0;
+    ids = 0;
+}
+
+// =============================================================================
+// Validation
+// =============================================================================
+
+uint8_t CustomSignalTable::frameCost(const Signal* signals, size_t count) {
+    // Distinct IDs and the busiest ID's signal count
+    uint16_t seen[MAX_SIGNALS];
+    uint8_t perId[MAX_SIGNALS];
+    size_t distinct = 0;
+    uint8_t busiest = 0;
+    for (size_t i = 0; i < count && i < MAX_SIGNALS; i++) {
+        size_t slot = 0;
+        while (slot < distinct && seen[slot] != signals[i].canId) {
+            slot++;
+        }
+        if (slot == distinct) {
+            seen[distinct] = signals[i].canId;
+            perId[distinct] = 0;
+            distinct++;
+        }
+        perId[slot]++;
+        if (perId[slot] > busiest) {
+            busiest = perId[slot];
+        }
+    }
+
+    // Binary search over n IDs takes at most floor(log2(n)) + 1 steps
+    uint8_t steps = 0;
+    for (size_t n = distinct; n > 0; n >>= 1) {
+        steps++;
+    }
+    return steps + busiest;
+}
+
+bool CustomSignalTable::validate(const Signal* signals, size_t count, const char** error) {
+    const char* reason = nullptr;
+
+    if (count > MAX_SIGNALS) {
+        reason = "too many signals";
+    }
+
+    for (size_t i = 0; i < count && !reason; i++) {
+        const Signal& signal = signals[i];
+        size_t keyLength = strnlen(signal.key, KEY_SIZE);
+
+        if (signal.canId >= STD_ID_COUNT) {
+            reason = "CAN ID must be a standard (11-bit) ID";
+        } else if (signal.order != BroadcastDecoder::ByteOrder::INTEL &&
+                   signal.order != BroadcastDecoder::ByteOrder::MOTOROLA) {
+            reason = "invalid byte order";
+        } else if (signal.sign != BroadcastDecoder::Signedness::UNSIGNED &&
+                   signal.sign != BroadcastDecoder::Signedness::SIGNED) {
+            reason = "invalid signedness";
+        } else if (!BroadcastDecoder::signalFits(signal.startBit, signal.length, signal.order)) {
+            reason = "signal must be 1-32 bits inside the 8-byte frame";
+        } else if (!std::isfinite(signal.scale) || signal.scale == 0.0f || !std::isfinite(signal.offset)) {
+            reason = "scale must be finite and non-zero, offset finite";
+        } else if (keyLength == 0 || keyLength >= KEY_SIZE) {
+            reason = "key must be 1-15 characters";
+        } else {
+            for (size_t c = 0; c < keyLength && !reason; c++) {
+                if (!isKeyChar(signal.key[c])) {
+                    reason = "key may only contain letters, digits and '_'";
+                }
+            }
+            for (size_t j = 0; j < i && !reason; j++) {
+                if (strncmp(signals[j].key, signal.key, KEY_SIZE) == 0) {
+                    reason = "duplicate key";
+                }
+            }
+        }
+    }
+
+    if (!reason) {
+        size_t distinct = 0;
+        for (size_t i = 0; i < count; i++) {
+            bool first = true;
+            for (size_t j = 0; j < i; j++) {
+                first = first && signals[j].canId != signals[i].canId;
+            }
+            distinct += first ? 1 : 0;
+        }
+        if (distinct > MAX_IDS) {
+            reason = "too many CAN IDs";
+        } else if (frameCost(signals, count) > FRAME_COST_BUDGET) {
+            reason = "per-frame cost budget exceeded (too many signals on one CAN ID)";
+        }
+    }
+
+    if (error) {
+        *error = reason;
+    }
+    return reason == nullptr;
+}
+
+// =============================================================================
+// Table
+// =============================================================================
+
+void CustomSignalTable::assign(const Signal* source, size_t sourceCount) {
+    clear();
+    if (sourceCount > MAX_SIGNALS) {
+        sourceCount = MAX_SIGNALS;
+    }
+
+    // Stable insertion sort by CAN ID, so each ID's signals are contiguous
+    for (size_t i = 0; i < sourceCount; i++) {
+        size_t pos = count;
+        while (pos > 0 && signals[pos - 1].canId > source[i].canId) {
+            signals[pos] = signals[pos - 1];
+            pos--;
+        }
+        signals[pos] = source[i];
+        signals[pos].key[KEY_SIZE - 1] = '\0';
+        count++;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        raw[i] = 0;
+        updated[i] = Freshness();
+        minDlc[i] = signalMinDlc(signals[i]);
+
+        uint16_t canId = signals[i].canId;
+        if (ids == 0 || idList[ids - 1] != canId) {
+            if (ids == MAX_IDS) {
+                count = i;  // validate() rejects this; keep the table consistent anyway
+                break;
+            }
+            idList[ids] = canId;
+            firstSignal[ids] = i;
+            signalCount[ids] = 0;
+            idBitmap[canId >> 5] |= 1UL << (canId & 31);
+            ids++;
+        }
+        signalCount[ids - 1]++;
+    }
+
+    framesMatched = 0;
+    signalsDecoded = 0;
+    shortFrames = 0;
+}
+
+void CustomSignalTable::decodeFrame(uint16_t canId, const uint8_t* data, uint8_t dlc) {
+    // Binary search; the bitmap guarantees the ID is present
+    size_t low = 0;
+    size_t high = ids;
+    while (high - low > 1) {
+        size_t mid = (low + high) / 2;
+        if (idList[mid] <= canId) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+    if (idList[low] != canId) {
+        return;
+    }
+
+    framesMatched++;
+    uint64_t frame = BroadcastDecoder::loadFrameLE(data);
+    size_t end = firstSignal[low] + signalCount[low];
+    for (size_t i = firstSignal[low]; i < end; i++) {
+        const Signal& signal = signals[i];
+        if (dlc < minDlc[i]) {
+            shortFrames++;
+            continue;
+        }
+
+        uint32_t value = signal.order == BroadcastDecoder::ByteOrder::INTEL
+            ? BroadcastDecoder::extractSignalLE(frame, signal.startBit, signal.length)
+            : BroadcastDecoder::extractSignalBE(data, signal.startBit, signal.length);
+        if (signal.sign == BroadcastDecoder::Signedness::SIGNED) {
+            uint8_t shift = 32 - signal.length;
+            raw[i] = (int32_t)(value << shift) >> shift;   // Sign-extend
+        } else {
+            raw[i] = (int32_t)value;
+        }
+        updated[i].touch();
+        signalsDecoded++;
+    }
+}
+
+// =============================================================================
+// Persistence (NVS)
+// =============================================================================
+
+bool CustomSignalTable::load() {
+    Preferences prefs;
+    if (!prefs.begin(NVS_NAMESPACE, true)) {
+        return false;
+    }
+
+    uint8_t buffer[sizeof(CustomSignalRecordHeader) + sizeof(Signal) * MAX_SIGNALS];
+    size_t length = prefs.getBytesLength(NVS_KEY);
+    if (length < sizeof(CustomSignalRecordHeader) || length > sizeof(buffer)) {
+        prefs.end();
+        return false;
+    }
+    prefs.getBytes(NVS_KEY, buffer, length);
+    prefs.end();
+
+    CustomSignalRecordHeader header;
+    memcpy(&header, buffer, sizeof(header));
+    if (header.magic != RECORD_MAGIC || header.version != RECORD_VERSION ||
+        length != sizeof(header) + sizeof(Signal) * header.count) {
+        Serial.println("[CustomSignals] Ignoring NVS table (unknown layout)");
+        return false;
+    }
+
+    Signal stored[MAX_SIGNALS];
+    memcpy(stored, buffer + sizeof(header), sizeof(Signal) * header.count);
+    const char* error = nullptr;
+    if (!validate(stored, header.count, &error)) {
+        Serial.printf("[CustomSignals] Ignoring NVS table: %s\r\n", error);
+        return false;
+    }
+
+    assign(stored, header.count);
+    return count > 0;
+}
+
+bool CustomSignalTable::save() const {
+    Preferences prefs;
+    if (!prefs.begin(NVS_NAMESPACE, false)) {
+        return false;
+    }
+
+    if (count == 0) {
+        prefs.remove(NVS_KEY);
+        prefs.end();
+        return true;
+    }
+
+    uint8_t buffer[sizeof(CustomSignalRecordHeader) + sizeof(Signal) * MAX_SIGNALS];
+    CustomSignalRecordHeader header = {};
+    header.magic = RECORD_MAGIC;
+    header.version = RECORD_VERSION;
+    header.count = count;
+    memcpy(buffer, &header, sizeof(header));
+    memcpy(buffer + sizeof(header), signals, sizeof(Signal) * count);
+
+    size_t length = sizeof(header) + sizeof(Signal) * count;
+    bool ok = prefs.putBytes(NVS_KEY, buffer, length) == length;
+    prefs.end();
+    return ok;
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <Arduino.h>
+#include <cstdint>
+#include "../VehicleTypes.h"
+#include "../protocols/BroadcastDecoder.h"
+
+/**
+ * CustomSignalTable - Broadcast signals configured at runtime
+ *
+ * Signals without a compiled decoder (e.g. 0x594 climate temperature or
+ * 0x588 heating controls from OCU_FEATURES.md) are added from the server
+ * with vehicle.setCustomSignals. Each entry gives the standard CAN ID, the
+ * DBC bit layout, scale/offset and the key its value is reported under in
+ * the "custom" telemetry section. The table is persisted to NVS and loaded
+ * at setup, so it survives reboots without a firmware release.
+ *
+ * RX path cost is bounded per frame:
+ * - A 2048-bit ID bitmap rejects frames without custom signals with one
+ *   load and mask (the common case)
+ * - Matching IDs are found by binary search over the sorted ID list
+ * - The signals of one ID are contiguous and extracted from one payload word
+ *
+ * validate() rejects any table whose worst-case frame (search steps plus the
+ * signals of its busiest ID) exceeds FRAME_COST_BUDGET, so a bad config
+ * cannot starve the CAN task.
+ *
+ * Like the domain states, values are stored raw with a freshness stamp and
+ * converted to physical units only when read.
+ *
+ * Thread Safety:
+ * - process() from the CAN decode task with the VehicleManager mutex held
+ * - assign() with the same mutex held (VehicleManager::setCustomSignals)
+ * - load()/save() and reads from the main loop
+ */
+class CustomSignalTable {
+public:
+    static constexpr size_t MAX_SIGNALS = 24;
+    static constexpr size_t MAX_IDS = 16;
+    static constexpr size_t KEY_SIZE = 16;              // Including terminator
+    static constexpr uint16_t STD_ID_COUNT = 0x800;
+
+    // Worst-case work per frame: one unit per binary search step plus one
+    // per signal decoded from the frame
+    static constexpr uint8_t FRAME_COST_BUDGET = 12;
+
+    /**
+     * One configured signal (also the NVS record layout).
+     */
+    struct Signal {
+        uint16_t canId;
+        uint8_t startBit;                               // DBC notation
+        uint8_t length;                                 // 1-32 bits
+        BroadcastDecoder::ByteOrder order;
+        BroadcastDecoder::Signedness sign;
+        float scale;
+        float offset;
+        char key[KEY_SIZE];                             // Telemetry key
+    };
+
+    CustomSignalTable();
+
+    /**
+     * Check a table before assign().
+     * @param error Set to a human-readable reason on failure
+     * @return true if the table is valid and within the frame cost budget
+     */
+    static bool validate(const Signal* signals, size_t count, const char** error);
+
+    /**
+     * Worst-case cost units of one frame for a table (see FRAME_COST_BUDGET).
+     */
+    static uint8_t frameCost(const Signal* signals, size_t count);
+
+    /**
+     * Replace the table (must have passed validate()). Clears all values.
+     */
+    void assign(const Signal* signals, size_t count);
+
+    /**
+     * Load the table from NVS (invalid or missing records load as empty).
+     * @return true if a non-empty table was loaded
+     */
+    bool load();
+
+    /**
+     * Persist the current table to NVS (an empty table removes the record).
+     */
+    bool save() const;
+
+    /**
+     * Decode the custom signals of a frame.
+     * @return true if the ID has custom signals
+     */
+    bool process(uint32_t canId, const uint8_t* data, uint8_t dlc) {
+        if (canId >= STD_ID_COUNT || (idBitmap[canId >> 5] & (1UL << (canId & 31))) == 0) {
+            return false;
+        }
+        decodeFrame((uint16_t)canId, data, dlc);
+        return true;
+    }
+
+    // Table access
+    size_t size() const { return count; }
+    const Signal& getSignal(size_t index) const { return signals[index]; }
+    size_t idCount() const { return ids; }
+    uint16_t getId(size_t index) const { return idList[index]; }
+
+    /**
+     * Value access (raw decoded value, converted on read).
+     */
+    bool hasValue(size_t index) const { return updated[index].valid(); }
+    int32_t getRaw(size_t index) const { return raw[index]; }
+    float getValue(size_t index) const { return raw[index] * signals[index].scale + signals[index].offset; }
+    uint16_t getAgeSec(size_t index) const { return updated[index].ageSec(); }
+
+    // Statistics
+    uint32_t getFramesMatched() const { return framesMatched; }
+    uint32_t getSignalsDecoded() const { return signalsDecoded; }
+    uint32_t getShortFrames() const { return shortFrames; }
+
+private:
+    Signal signals[MAX_SIGNALS];                        // Sorted by canId
+    int32_t raw[MAX_SIGNALS];
+    Freshness updated[MAX_SIGNALS];
+    uint8_t minDlc[MAX_SIGNALS];                        // Bytes the signal needs
+
+    uint16_t idList[MAX_IDS];                           // Sorted, unique
+    uint8_t firstSignal[MAX_IDS];
+    uint8_t signalCount[MAX_IDS];
+    uint32_t idBitmap[STD_ID_COUNT / 32];
+
+    size_t count = 0;
+    size_t ids = 0;
+
+    volatile uint32_t framesMatched = 0;
+    volatile uint32_t signalsDecoded = 0;
+    volatile uint32_t shortFrames = 0;
+
+    void decodeFrame(uint16_t canId, const uint8_t* data, uint8_t dlc);
+    void clear();
+};
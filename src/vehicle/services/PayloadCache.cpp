@@ -0,0 +1,46 @@
+#include "PayloadCache.h"
+
+PayloadCache::PayloadCache() {
+    memset(slotOf, NO_SLOT, sizeof(slotOf));
+}
+
+bool PayloadCache::addId(uint16_t canId) {
+    if (canId >= STD_ID_COUNT || count >= MAX_IDS) {
+        return false;
+    }
+    if (slotOf[canId] != NO_SLOT) {
+        return true;  // Already cached
+    }
+    entries[count] = Entry();
+    entries[count].canId = canId;
+    slotOf[canId] = count;
+    count++;
+    return true;
+}
+
+void PayloadCache::invalidate() {
+    for (size_t i = 0; i < count; i++) {
+        entries[i].valid = false;
+    }
+}
+
+float PayloadCache::getHitRatio(size_t index) const {
+    uint32_t total = entries[index].hits + entries[index].misses;
+    return total ? (float)entries[index].hits / total : 0.0f;
+}
+
+uint32_t PayloadCache::getTotalHits() const {
+    uint32_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        total += entries[i].hits;
+    }
+    return total;
+}
+
+uint32_t PayloadCache::getTotalMisses() const {
+    uint32_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        total += entries[i].misses;
+    }
+    return total;
+}
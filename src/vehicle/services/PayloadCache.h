@@ -0,0 +1,109 @@
+#pragma once
+
+#include <Arduino.h>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * PayloadCache - Last payload per routed standard CAN ID
+ *
+ * Most broadcast frames repeat the same bytes for seconds at a time (doors,
+ * locks, range). VehicleManager checks each standard frame here first: an
+ * unchanged payload (same DLC, same 8 bytes as one 64-bit compare) only
+ * refreshes the domain's freshness timestamps, skipping decode and
+ * subscriber notification.
+ *
+ * Slots are dense, assigned by addId() at setup; an 11-bit index table maps
+ * the CAN ID to its slot, so lookup is O(1) with no hashing.
+ *
+ * IDs whose decode depends on more than the payload (e.g. a source-priority
+ * timeout) must not be added.
+ *
+ * Thread Safety:
+ * - addId() during setup only
+ * - unchanged() and invalidate() from the CAN decode task with the
+ *   VehicleManager mutex held
+ * - Counters are read without locking for statistics (may be slightly stale)
+ */
+class PayloadCache {
+public:
+    static constexpr size_t MAX_IDS = 32;
+    static constexpr uint16_t STD_ID_COUNT = 0x800;
+
+    PayloadCache();
+
+    /**
+     * Register a standard ID for caching.
+     * @return false if the ID is out of range or all slots are used
+     */
+    bool addId(uint16_t canId);
+
+    /**
+     * Compare a frame with the last payload of its ID and remember it.
+     * @return true if the ID is cached and DLC and payload are unchanged
+     */
+    bool unchanged(uint32_t canId, const uint8_t* data, uint8_t dlc) {
+        if (!enabled || canId >= STD_ID_COUNT) {
+            return false;
+        }
+        uint8_t slot = slotOf[canId];
+        if (slot == NO_SLOT) {
+            return false;
+        }
+
+        Entry& entry = entries[slot];
+        uint64_t payload = 0;
+        memcpy(&payload, data, dlc > 8 ? 8 : dlc);
+        if (entry.valid && entry.dlc == dlc && entry.payload == payload) {
+            entry.hits++;
+            return true;
+        }
+        entry.payload = payload;
+        entry.dlc = dlc;
+        entry.valid = true;
+        entry.misses++;
+        return false;
+    }
+
+    /**
+     * Forget all payloads; the next frame of every ID is decoded in full.
+     */
+    void invalidate();
+
+    /**
+     * Enable/disable the fast path (disabled: every frame is decoded).
+     */
+    void setEnabled(bool enable) {
+        enabled = enable;
+        if (!enable) {
+            invalidate();
+        }
+    }
+    bool isEnabled() const { return enabled; }
+
+    // Statistics
+    size_t size() const { return count; }
+    uint16_t getId(size_t index) const { return entries[index].canId; }
+    uint32_t getHits(size_t index) const { return entries[index].hits; }
+    uint32_t getMisses(size_t index) const { return entries[index].misses; }
+    float getHitRatio(size_t index) const;
+    uint32_t getTotalHits() const;
+    uint32_t getTotalMisses() const;
+
+private:
+    static constexpr uint8_t NO_SLOT = 0xFF;
+
+    struct Entry {
+        uint64_t payload = 0;
+        uint32_t hits = 0;
+        uint32_t misses = 0;
+        uint16_t canId = 0;
+        uint8_t dlc = 0;
+        bool valid = false;
+    };
+
+    uint8_t slotOf[STD_ID_COUNT];
+    Entry entries[MAX_IDS];
+    size_t count = 0;
+    bool enabled = true;
+};
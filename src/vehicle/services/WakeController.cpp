@@ -1,7 +1,6 @@
 #include "WakeController.h"
 #include "../../modules/CanManager.h"
 #include "../IDomain.h"
-#include <driver/twai.h>
 
 WakeController::WakeController(CanManager* canMgr)
     : canManager(canMgr) {
@@ -88,9 +87,10 @@ void WakeController::loop(bool vehicleHasCanActivity) {
     case WakeState::WAKING:
         // Check if vehicle has woken up (CAN activity)
         if (vehicleHasCanActivity) {
-            // Wait for BAP initialization
-            if (elapsed >= BAP_INIT_WAIT) {
-                Serial.printf("[WakeController] Vehicle awake after %lums\r\n", elapsed);
+            // Wait for BAP initialization (no longer once the FSGs answer)
+            if (bapReady || elapsed >= BAP_INIT_WAIT) {
+                Serial.printf("[WakeController] Vehicle awake after %lums (%s)\r\n",
+                              elapsed, bapReady ? "BAP ready" : "BAP init wait");
                 setWakeState(WakeState::AWAKE);
             }
         }
@@ -186,16 +186,28 @@ bool WakeController::sendBapInitFrame() {
 bool WakeController::sendKeepAliveFrame() {
     uint8_t keepAliveData[8] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
 
-    if (sendCanFrame(CAN_ID_KEEPALIVE, keepAliveData, 8, false)) {
-        keepAlivesSent++;
-        return true;
-    }
+    // Counted once the frame is acknowledged, not when queued. Failures are
+    // only counted (logStatistics): on a sleeping bus every 500 ms one fails.
+    bool queued = sendCanFrame(CAN_ID_KEEPALIVE, keepAliveData, 8, false, [this](CanTxResult result) {
+        if (result == CanTxResult::SENT) {
+            keepAlivesSent++;
+        } else {
+            keepAliveFailures++;
+            lastKeepAliveFailure = result;
+        }
+    });
 
-    Serial.println("[WakeController] Failed to send keep-alive frame");
-    return false;
+    // Rejected on submit: no callback will run, so record the cause here
+    if (!queued) {
+        keepAliveFailures++;
+        lastKeepAliveFailure = (canManager && canManager->isRunning()) ? CanTxResult::QUEUE_FULL
+                                                                       : CanTxResult::NOT_RUNNING;
+    }
+    return queued;
 }
 
-bool WakeController::sendCanFrame(uint32_t canId, const uint8_t* data, uint8_t dlc, bool extended) {
+bool WakeController::sendCanFrame(uint32_t canId, const uint8_t* data, uint8_t dlc, bool extended,
+                                  CanTxCallback onComplete) {
     if (!canManager) {
         Serial.println("[WakeController] No CAN manager - cannot send");
         return false;
@@ -206,26 +218,12 @@ bool WakeController::sendCanFrame(uint32_t canId, const uint8_t* data, uint8_t d
         return false;
     }
 
-    // Build TWAI message
-    twai_message_t message;
-    message.identifier = canId;
-    message.extd = extended ? 1 : 0;
-    message.rtr = 0;
-    message.data_length_code = dlc;
-    memcpy(message.data, data, dlc);
-
-    // Send with 100ms timeout
-    esp_err_t result = twai_transmit(&message, pdMS_TO_TICKS(100));
-
-    if (result == ESP_OK) {
-        return true;
-    } else if (result == ESP_ERR_TIMEOUT) {
-        Serial.println("[WakeController] TX timeout - no ACK");
-        return false;
-    } else {
-        Serial.printf("[WakeController] TX failed: %s\r\n", esp_err_to_name(result));
+    // Wake and keep-alive frames go ahead of everything else in the TX queue
+    if (!canManager->transmit(canId, data, dlc, extended, CanTxPriority::KEEP_ALIVE, std::move(onComplete))) {
+        Serial.printf("[WakeController] TX rejected: ID:0x%03lX (queue full)\r\n", canId);
         return false;
     }
+    return true;
 }
 
 void WakeController::startKeepAlive() {
@@ -2,6 +2,7 @@
 
 #include <Arduino.h>
 #include <cstdint>
+#include "../../modules/CanTxScheduler.h"
 
 // Forward declaration
 class CanManager;
@@ -12,7 +13,8 @@ class IDomain;
  * 
  * Extracted from VehicleManager to separate concerns.
  * Handles:
- * - Wake sequence (wake frame + BAP init)
+ * - Wake sequence (wake frame + BAP init; AWAKE once BAP answers, or
+ *   after BAP_INIT_WAIT)
  * - Keep-alive heartbeat management
  * - CAN activity tracking
  * - Wake timeout handling
@@ -83,6 +85,12 @@ public:
      */
     void stopKeepAlive();
 
+    /**
+     * Report whether BAP is answering (VehicleManager: BapDiscovery done).
+     * A wake in progress then completes without the rest of BAP_INIT_WAIT.
+     */
+    void setBapReady(bool ready) { bapReady = ready; }
+
     /**
      * Notify controller of CAN activity (called on every frame).
      */
@@ -113,6 +121,13 @@ public:
         failed = wakeFailed;
     }
 
+    /**
+     * Keep-alive frames not queued or not sent, and why the last one failed
+     * (QUEUE_FULL / NOT_RUNNING when rejected on submit, else its TX result).
+     */
+    uint32_t getKeepAliveFailures() const { return keepAliveFailures; }
+    CanTxResult getLastKeepAliveFailure() const { return lastKeepAliveFailure; }
+
 private:
     CanManager* canManager;
 
@@ -120,6 +135,7 @@ private:
     WakeState wakeState = WakeState::ASLEEP;
     unsigned long wakeStateStartTime = 0;  // When current state was entered
     bool canInitializing = true;            // Ignore CAN activity during first loop
+    bool bapReady = false;                  // FSGs answered BAP after this wake
 
     // Keep-alive management
     bool keepAliveActive = false;
@@ -129,12 +145,14 @@ private:
     // Wake statistics
     uint32_t wakeAttempts = 0;
     uint32_t keepAlivesSent = 0;
+    uint32_t keepAliveFailures = 0;
+    CanTxResult lastKeepAliveFailure = CanTxResult::SENT;
     uint32_t wakeFailed = 0;
 
     // Wake timing constants
     static constexpr unsigned long KEEPALIVE_INTERVAL = 500;      // Send keep-alive every 500ms
     static constexpr unsigned long KEEPALIVE_TIMEOUT = 300000;    // Stop after 5 minutes of inactivity
-    static constexpr unsigned long BAP_INIT_WAIT = 2000;          // Wait 2s after wake for BAP init
+    static constexpr unsigned long BAP_INIT_WAIT = 2000;          // Wait up to 2s after wake for BAP init
     static constexpr unsigned long WAKE_TIMEOUT = 10000;          // Give up if no CAN activity after 10s
 
     // Wake CAN IDs
@@ -171,9 +189,11 @@ private:
     bool sendKeepAliveFrame();
 
     /**
-     * Send a CAN frame.
+     * Queue a CAN frame at KEEP_ALIVE priority (ahead of BAP and commands).
+     * @return true if queued; onComplete reports the outcome from the main loop
      */
-    bool sendCanFrame(uint32_t canId, const uint8_t* data, uint8_t dlc, bool extended);
+    bool sendCanFrame(uint32_t canId, const uint8_t* data, uint8_t dlc, bool extended,
+                      CanTxCallback onComplete = nullptr);
 
     /**
      * Start keep-alive heartbeat.
@@ -0,0 +1,805 @@
+#!/usr/bin/env python3
+"""
+DBC-to-C++ Code Generator for e-Golf Broadcast Messages
+
+Reads message definitions from DBC files and/or the extracted signal tables
+(extract_dbc_signals.py output), picks the messages and signals named in a
+selection list and emits one C++ header with:
+
+- a BROADCAST_RAW_MESSAGE table and decode<Struct>() per message
+  (SignalCodec.h: fixed-width integer extraction only, scale/offset kept
+  as descriptor metadata)
+- for multiplexed messages (DBC M/m<N> signals), one table per mux page and
+  a BROADCAST_MUX_MESSAGE that decodes only the page of each frame
+- the routing table for VehicleManager: ROUTED_STD_IDS/ROUTED_EXT_IDS
+  (acceptance filter), domainOf()/extendedDomainOf() and a decode() dispatch
+  switch
+
+Optionally emits a golden check program that runs the generated decoders
+against sample frames (see golden/ocu_features.txt).
+
+Usage:
+    python dbc_codegen.py --extracted hcan.md --dbc extra.dbc \\
+        --select selection.txt --output VehicleMessages.h \\
+        [--golden golden.txt --golden-output golden_check.cpp]
+"""
+
+import argparse
+import re
+import sys
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Optional
+
+REPO_ROOT = Path(__file__).resolve().parents[2]
+sys.dont_write_bytecode = True
+sys.path.insert(0, str(REPO_ROOT / 'docs' / 'canbus-reverse-engineering'))
+
+from extract_dbc_signals import Message, Signal, parse_dbc_file  # noqa: E402
+
+CAN_EFF_FLAG = 0x80000000   # DBC marks extended IDs with bit 31
+
+# DBC unit names -> short units for SignalDesc
+UNITS = {
+    'Unit_Amper': 'A',
+    'Unit_DegreCelsi': 'C',
+    'Unit_DegreOfArc': 'deg',
+    'Unit_Hours': 'h',
+    'Unit_KiloMeter': 'km',
+    'Unit_KiloMeterPerHour': 'km/h',
+    'Unit_KiloWatt': 'kW',
+    'Unit_Meter': 'm',
+    'Unit_Minut': 'min',
+    'Unit_None': '',
+    'Unit_PerCent': '%',
+    'Unit_Secon': 's',
+    'Unit_Volt': 'V',
+    'Unit_Watt': 'W',
+    'Unit_WattHour': 'Wh',
+}
+
+
+@dataclass
+class Selection:
+    message: str
+    domain: str
+    struct: Optional[str]
+    signals: list = field(default_factory=list)     # (dbc name, field name or None)
+    pages: dict = field(default_factory=dict)       # mux value -> page member name
+    line: int = 0
+
+
+@dataclass
+class Golden:
+    message: str
+    payload: list
+    expected: list      # (signal name, physical value text)
+    comment: str
+    line: int
+
+
+class GeneratorError(Exception):
+    pass
+
+
+# =============================================================================
+# Input parsing
+# =============================================================================
+
+def parse_extracted_md(filepath: Path) -> dict:
+    """Parse an extracted_*.md table (extract_dbc_signals.py output)."""
+    messages = {}
+    current_message = None
+    current_signal = None
+
+    msg_pattern = re.compile(r'^### 0x([0-9A-Fa-f]+) \(\d+\) - (\w+)')
+    dlc_pattern = re.compile(r'^DLC: (\d+), Transmitter: (\S+)')
+    sig_pattern = re.compile(r'^  (\w+):$')
+    bits_pattern = re.compile(r'^    Bits: (\d+)\|(\d+) \((Intel|Motorola)[^,]*, (unsigned|signed)\)')
+    mux_pattern = re.compile(r'^    Mux: (M|m\d+)$')
+    formula_pattern = re.compile(r'^    Formula: raw \* (\S+) \+ (\S+)')
+    unit_pattern = re.compile(r'^    Unit: (\S+)')
+    comment_pattern = re.compile(r'^    Comment: (.*)')
+
+    with open(filepath, 'r', encoding='utf-8') as f:
+        for line in f:
+            line = line.rstrip('\n')
+
+            match = msg_pattern.match(line)
+            if match:
+                can_id = int(match.group(1), 16)
+                current_message = Message(can_id=can_id, name=match.group(2), dlc=8,
+                                          transmitter='', signals=[])
+                messages[can_id] = current_message
+                current_signal = None
+                continue
+            if current_message is None:
+                continue
+
+            match = dlc_pattern.match(line)
+            if match:
+                current_message.dlc = int(match.group(1))
+                current_message.transmitter = match.group(2)
+                continue
+
+            match = sig_pattern.match(line)
+            if match:
+                current_signal = Signal(name=match.group(1), start_bit=0, length=0, byte_order='1',
+                                        signed=False, scale=1.0, offset=0.0, min_val=0.0,
+                                        max_val=0.0, unit='')
+                current_message.signals.append(current_signal)
+                continue
+            if current_signal is None:
+                continue
+
+            match = bits_pattern.match(line)
+            if match:
+                current_signal.start_bit = int(match.group(1))
+                current_signal.length = int(match.group(2))
+                current_signal.byte_order = '1' if match.group(3) == 'Intel' else '0'
+                current_signal.signed = match.group(4) == 'signed'
+                continue
+            match = mux_pattern.match(line)
+            if match:
+                current_signal.mux = match.group(1)
+                continue
+            match = formula_pattern.match(line)
+            if match:
+                current_signal.scale = float(match.group(1))
+                current_signal.offset = float(match.group(2))
+                continue
+            match = unit_pattern.match(line)
+            if match:
+                current_signal.unit = match.group(1)
+                continue
+            match = comment_pattern.match(line)
+            if match:
+                current_signal.comment = match.group(1)
+
+    return messages
+
+
+def merge_messages(sources: list) -> dict:
+    """
+    Merge message dicts by CAN ID. The extracted tables are filtered subsets
+    of their DBCs, so signals are united by name; the first source that
+    defines a message or signal wins.
+    """
+    merged = {}
+    for messages in sources:
+        for can_id, msg in messages.items():
+            if can_id not in merged:
+                merged[can_id] = Message(can_id=can_id, name=msg.name, dlc=msg.dlc,
+                                         transmitter=msg.transmitter, signals=list(msg.signals),
+                                         comment=msg.comment)
+                continue
+            known = {sig.name for sig in merged[can_id].signals}
+            merged[can_id].signals.extend(sig for sig in msg.signals if sig.name not in known)
+            if not merged[can_id].comment:
+                merged[can_id].comment = msg.comment
+    return merged
+
+
+def parse_selection(filepath: Path) -> list:
+    selections = []
+    with open(filepath, 'r', encoding='utf-8') as f:
+        for number, raw in enumerate(f, 1):
+            line = raw.split('#', 1)[0].rstrip()
+            if not line.strip():
+                continue
+            parts = line.split()
+            if not raw[0].isspace():
+                if len(parts) not in (2, 3):
+                    raise GeneratorError(f'{filepath}:{number}: expected "<Message> <domain> [Struct]"')
+                selections.append(Selection(message=parts[0], domain=parts[1],
+                                            struct=parts[2] if len(parts) == 3 else None, line=number))
+            elif re.fullmatch(r'm\d+', parts[0]):
+                if not selections or len(parts) != 2:
+                    raise GeneratorError(f'{filepath}:{number}: expected "    m<N> <page>" under a message')
+                selections[-1].pages[int(parts[0][1:])] = parts[1]
+            else:
+                if not selections or len(parts) not in (1, 2):
+                    raise GeneratorError(f'{filepath}:{number}: expected "    <Signal> [field]" under a message')
+                selections[-1].signals.append((parts[0], parts[1] if len(parts) == 2 else None))
+    return selections
+
+
+def parse_golden(filepath: Path) -> list:
+    goldens = []
+    comment = ''
+    with open(filepath, 'r', encoding='utf-8') as f:
+        for number, raw in enumerate(f, 1):
+            line = raw.strip()
+            if line.startswith('#'):
+                comment = line.lstrip('# ')
+                continue
+            if not line:
+                continue
+            parts = line.split()
+            payload = [int(b, 16) for b in parts[1].split(',')]
+            if len(parts) < 3 or len(payload) != 8:
+                raise GeneratorError(f'{filepath}:{number}: expected "<Message> <8 payload bytes> <Signal>=<value>..."')
+            expected = [tuple(p.split('=', 1)) for p in parts[2:]]
+            goldens.append(Golden(message=parts[0], payload=payload, expected=expected,
+                                  comment=comment, line=number))
+            comment = ''
+    return goldens
+
+
+# =============================================================================
+# Naming and formatting
+# =============================================================================
+
+def struct_name(message_name: str) -> str:
+    """ESP_21 -> Esp21Raw, NavPos_01 -> NavPos01Raw"""
+    parts = []
+    for part in message_name.split('_'):
+        if part.isupper() or part.isdigit():
+            part = part.capitalize()
+        parts.append(part[0].upper() + part[1:])
+    return ''.join(parts) + 'Raw'
+
+
+def macro_name(message_name: str, suffix: str = 'SIGNALS') -> str:
+    """NavPos_01 -> NAV_POS_01_RAW_SIGNALS"""
+    return re.sub(r'([a-z])([A-Z])', r'\1_\2', message_name).upper() + '_RAW_' + suffix
+
+
+def page_struct_name(struct: str, page: str) -> str:
+    """NavPos02MapMatchedRaw, position -> NavPos02MapMatchedPositionRaw"""
+    base = struct[:-len('Raw')] if struct.endswith('Raw') else struct
+    return base + page[0].upper() + page[1:] + 'Raw'
+
+
+def field_name(signal_name: str) -> str:
+    """NP_LatDegree -> npLatDegree"""
+    words = [w for w in re.split(r'_+', signal_name) if w]
+    first = words[0].lower()
+    return first + ''.join(w[0].upper() + w[1:] for w in words[1:])
+
+
+def raw_type(sig: Signal) -> str:
+    for bits in (8, 16, 32):
+        if sig.length <= bits:
+            return f'int{bits}_t' if sig.signed else f'uint{bits}_t'
+    raise GeneratorError(f'{sig.name}: {sig.length}-bit signals are not supported (max 32)')
+
+
+def number(value: float) -> str:
+    if value == int(value):
+        return str(int(value))
+    return f'{value:.10g}'
+
+
+def unit(sig: Signal) -> str:
+    if sig.unit in UNITS:
+        return UNITS[sig.unit]
+    return sig.unit[len('Unit_'):] if sig.unit.startswith('Unit_') else sig.unit
+
+
+def signal_bits(sig: Signal) -> int:
+    """Frame bits covered by a signal, in DBC (Intel) bit numbering."""
+    mask = 0
+    bit = sig.start_bit
+    for _ in range(sig.length):
+        mask |= 1 << bit
+        if sig.byte_order == '1':
+            bit += 1
+        elif bit % 8 == 0:
+            bit += 15       # Motorola: MSB first, continue at the top of the next byte
+        else:
+            bit -= 1
+    return mask
+
+
+def cpp_string(text: str) -> str:
+    return '"' + text.replace('\\', '\\\\').replace('"', '\\"') + '"'
+
+
+def padded(rows: list) -> list:
+    """Align table columns (all but the last get a trailing comma)."""
+    widths = [max(len(row[i]) + (1 if i < len(row) - 1 else 0) for row in rows) for i in range(len(rows[0]))]
+    lines = []
+    for row in rows:
+        cells = [(cell + ',').ljust(widths[i] + 1) if i < len(row) - 1 else cell for i, cell in enumerate(row)]
+        lines.append(''.join(cells))
+    return lines
+
+
+# =============================================================================
+# Resolution
+# =============================================================================
+
+@dataclass
+class Page:
+    value: int
+    member: str
+    struct: str
+    signals: list       # (Signal, field name)
+
+
+@dataclass
+class Resolved:
+    selection: Selection
+    message: Message
+    struct: str
+    signals: list       # (Signal, field name): all selected signals incl. selector and pages
+    can_id: int = 0
+    extended: bool = False
+    selector: Optional[tuple] = None    # (Signal, field name) of a multiplexed message
+    common: list = field(default_factory=list)  # signals in every frame of a multiplexed message
+    pages: list = field(default_factory=list)   # Page per mux value
+
+    def member_path(self, sig_name: str) -> Optional[str]:
+        """Struct member holding a signal (page.field for page signals)."""
+        for page in self.pages:
+            for sig, member in page.signals:
+                if sig.name == sig_name:
+                    return f'{page.member}.{member}'
+        for sig, member in self.signals:
+            if sig.name == sig_name:
+                return member
+        return None
+
+
+def resolve_mux(res: Resolved, signals_by_name: dict) -> None:
+    """Split a multiplexed message into selector, common signals and pages."""
+    sel = res.selection
+    selectors = [sig for sig in signals_by_name.values() if sig.mux == 'M']
+    if len(selectors) != 1:
+        raise GeneratorError(f'{sel.message}: multiplexed message needs exactly one M signal')
+    selector = selectors[0]
+    if selector.length > 8 or selector.signed:
+        raise GeneratorError(f'{sel.message}: mux selector {selector.name} must be unsigned and at most 8 bits')
+
+    chosen = {sig.name: member for sig, member in res.signals}
+    if selector.name not in chosen:
+        member = field_name(selector.name)
+        res.signals.insert(0, (selector, member))
+        chosen[selector.name] = member
+    res.selector = (selector, chosen[selector.name])
+    res.common = [(sig, member) for sig, member in res.signals if sig.mux is None]
+
+    by_value = {}
+    for sig, member in res.signals:
+        if sig.mux and sig.mux != 'M':
+            by_value.setdefault(int(sig.mux[1:]), []).append((sig, member))
+    unknown = set(sel.pages) - set(by_value)
+    if unknown:
+        raise GeneratorError(f'{sel.message}: page name for mux value {min(unknown)} without selected signals')
+    fixed_bits = 0
+    for sig, _ in [res.selector] + res.common:
+        fixed_bits |= signal_bits(sig)
+    for value in sorted(by_value):
+        if value >= 1 << selector.length:
+            raise GeneratorError(f'{sel.message}: mux value {value} does not fit {selector.name}')
+        member = sel.pages.get(value, f'page{value}')
+        for sig, _ in by_value[value]:
+            if signal_bits(sig) & fixed_bits:
+                raise GeneratorError(f'{sel.message}: {sig.name} overlaps the selector or a common signal')
+        res.pages.append(Page(value=value, member=member, struct=page_struct_name(res.struct, member),
+                              signals=by_value[value]))
+
+
+def resolve(selections: list, messages: dict) -> list:
+    by_name = {msg.name: msg for msg in messages.values()}
+    resolved = []
+    seen_ids = set()
+    for sel in selections:
+        msg = by_name.get(sel.message)
+        if msg is None:
+            raise GeneratorError(f'selection line {sel.line}: message {sel.message} not found in the inputs')
+        extended = bool(msg.can_id & CAN_EFF_FLAG) or msg.can_id > 0x7FF
+        can_id = msg.can_id & ~CAN_EFF_FLAG
+        if extended and can_id <= 0x7FF:
+            raise GeneratorError(f'{sel.message}: extended ID 0x{can_id:X} would collide with standard IDs')
+        if extended and (can_id & 0xFFFF0000) == 0x17330000:
+            raise GeneratorError(f'{sel.message}: 0x1733xxxx is routed by the BAP path, not the broadcast table')
+        if can_id in seen_ids:
+            raise GeneratorError(f'{sel.message}: CAN ID 0x{can_id:03X} selected twice')
+        seen_ids.add(can_id)
+
+        signals_by_name = {sig.name: sig for sig in msg.signals}
+        chosen = sel.signals or [(sig.name, None) for sig in msg.signals]
+        signals = []
+        fields = set()
+        for sig_name, member in chosen:
+            sig = signals_by_name.get(sig_name)
+            if sig is None:
+                raise GeneratorError(f'{sel.message}: signal {sig_name} not found (have: '
+                                     f'{", ".join(sorted(signals_by_name))})')
+            member = member or field_name(sig_name)
+            if member in fields:
+                raise GeneratorError(f'{sel.message}: field {member} used twice')
+            fields.add(member)
+            raw_type(sig)   # Rejects signals wider than 32 bits
+            signals.append((sig, member))
+
+        res = Resolved(selection=sel, message=msg, struct=sel.struct or struct_name(msg.name),
+                       signals=signals, can_id=can_id, extended=extended)
+        if any(sig.mux for sig, _ in signals):
+            resolve_mux(res, signals_by_name)
+        elif sel.pages:
+            raise GeneratorError(f'{sel.message}: page names given but no multiplexed signal selected')
+        resolved.append(res)
+    return resolved
+
+
+# =============================================================================
+# Header generation
+# =============================================================================
+
+def domain_enum(domain: str) -> str:
+    return domain[0].upper() + domain[1:]
+
+
+def can_id_text(res: Resolved) -> str:
+    return f'0x{res.can_id:03X}'
+
+
+def signal_table(macro: str, params: str, signals: list) -> list:
+    """#define <macro>(<params>) with one SIG line per (Signal, field name)."""
+    if not signals:
+        return [f'#define {macro}({params})']
+    rows = []
+    for sig, member in signals:
+        rows.append([f'SIG({raw_type(sig)}', member, cpp_string(sig.name), str(sig.start_bit), str(sig.length),
+                     'INTEL' if sig.byte_order == '1' else 'MOTOROLA',
+                     'SIGNED' if sig.signed else 'UNSIGNED',
+                     number(sig.scale), number(sig.offset), cpp_string(unit(sig)) + ')'])
+    out = [f'#define {macro}({params}) \\']
+    lines = padded(rows)
+    for i, (line, (sig, _)) in enumerate(zip(lines, signals)):
+        comment = f' /* {sig.comment} */' if sig.comment and len(sig.comment) <= 40 else ''
+        out.append(f'    {line}{comment}' + (' \\' if i < len(lines) - 1 else ''))
+    return out
+
+
+def emit_mux_message(emit, res: Resolved) -> None:
+    name = res.message.name
+    for page in res.pages:
+        macro = macro_name(name, page.member.upper() + '_SIGNALS')
+        for line in signal_table(macro, 'SIG, FIELD', page.signals):
+            emit(line)
+        emit(f'BROADCAST_RAW_MESSAGE({page.struct}, {macro})')
+        emit('')
+
+    selector = macro_name(name, 'SELECTOR')
+    common = macro_name(name)
+    pages = macro_name(name, 'PAGES')
+    for line in signal_table(selector, 'SIG', [res.selector]):
+        emit(line)
+    for line in signal_table(common, 'SIG, FIELD', [s for s in res.common if s is not res.selector]):
+        emit(line)
+    emit(f'#define {pages}(PAGE) \\')
+    rows = padded([[f'PAGE({page.value}', page.member, page.struct + ')'] for page in res.pages])
+    for i, row in enumerate(rows):
+        emit(f'    {row}' + (' \\' if i < len(rows) - 1 else ''))
+    emit(f'BROADCAST_MUX_MESSAGE({res.struct}, {common}, {selector}, {pages})')
+    emit('')
+    emit('/**')
+    emit(' * Decode the frame\'s page into cache (the other pages keep their last value).')
+    emit(' * @return false if the selector value has no page')
+    emit(' */')
+    emit(f'inline bool decode{res.struct}(const uint8_t* data, {res.struct}& cache) {{')
+    emit('    return decodeSignals(loadFrameLE(data), cache);')
+    emit('}')
+
+
+def generate_header(resolved: list, inputs: list, selection: Path) -> str:
+    out = []
+    emit = out.append
+
+    emit('#pragma once')
+    emit('')
+    emit('// Generated by tools/dbc_codegen/dbc_codegen.py - do not edit.')
+    emit('// Inputs:    ' + ', '.join(inputs))
+    emit('// Selection: ' + selection)
+    emit('// Regenerate with: make -C tools/dbc_codegen')
+    emit('')
+    emit('#include "BroadcastDecoder.h"')
+    emit('')
+    emit('/**')
+    emit(' * VehicleMessages - Raw decoders and routing table for the broadcast messages')
+    emit(' * selected in tools/dbc_codegen/selection.txt')
+    emit(' *')
+    emit(' * Decoders store the raw integer of every signal. Each struct has a static')
+    emit(' * <field>Physical(raw) converter, and its SignalDesc table')
+    emit(' * (MessageLayout<Struct>::signals()) carries scale, offset and unit.')
+    emit(' */')
+    emit('namespace BroadcastDecoder {')
+
+    domain = None
+    for res in resolved:
+        msg = res.message
+        if res.selection.domain != domain:
+            domain = res.selection.domain
+            emit('')
+            emit('// ' + '=' * 76)
+            emit(f'// {domain_enum(domain)}')
+            emit('// ' + '=' * 76)
+        emit('')
+        emit('/**')
+        extended = ', extended' if res.extended else ''
+        emit(f' * {msg.name} ({can_id_text(res)}{extended}) - DLC {msg.dlc}, {msg.transmitter}')
+        if msg.comment:
+            emit(f' * {msg.comment}')
+        if res.selector:
+            pages = ', '.join(f'{page.value} = {page.member}' for page in res.pages)
+            emit(f' * Multiplexed on {res.selector[0].name}: {pages}')
+        emit(' */')
+        if res.selector:
+            emit_mux_message(emit, res)
+            continue
+
+        for line in signal_table(macro_name(msg.name), 'SIG, FIELD', res.signals):
+            emit(line)
+        emit(f'BROADCAST_RAW_MESSAGE({res.struct}, {macro_name(msg.name)})')
+        emit('')
+        emit(f'inline {res.struct} decode{res.struct}(const uint8_t* data) {{')
+        emit(f'    {res.struct} result;')
+        emit('    decodeSignals(loadFrameLE(data), result);')
+        emit('    return result;')
+        emit('}')
+
+    emit('')
+    emit('} // namespace BroadcastDecoder')
+    emit('')
+    emit('namespace VehicleMessages {')
+    emit('')
+
+    domains = []
+    for res in resolved:
+        if res.selection.domain not in domains:
+            domains.append(res.selection.domain)
+
+    emit('/**')
+    emit(' * VehicleManager domain that receives a message.')
+    emit(' */')
+    emit('enum class Domain : uint8_t {')
+    emit('    None,')
+    for name in domains:
+        emit(f'    {domain_enum(name)},')
+    emit('};')
+    emit('')
+    emit('struct Route {')
+    emit('    uint32_t canId;                 // Extended IDs are above 0x7FF')
+    emit('    uint8_t dlc;')
+    emit('    Domain domain;')
+    emit('    const char* name;')
+    emit('};')
+    emit('')
+    emit('static constexpr Route ROUTES[] = {')
+    for line in padded([[f'    {{ {can_id_text(res)}', str(res.message.dlc),
+                         f'Domain::{domain_enum(res.selection.domain)}', cpp_string(res.message.name) + ' },']
+                        for res in resolved]):
+        emit(line)
+    emit('};')
+    emit('static constexpr size_t ROUTE_COUNT = sizeof(ROUTES) / sizeof(ROUTES[0]);')
+    emit('')
+    standard = [res for res in resolved if not res.extended]
+    extended = [res for res in resolved if res.extended]
+
+    def id_list(routes: list) -> None:
+        for name in domains:
+            ids = ', '.join(can_id_text(res) for res in routes if res.selection.domain == name)
+            if ids:
+                emit(f'    {ids},'.ljust(28) + f'// {domain_enum(name)}')
+
+    def domain_switch(routes: list) -> None:
+        emit('    switch (canId) {')
+        for name in domains:
+            cases = [res for res in routes if res.selection.domain == name]
+            for res in cases:
+                emit(f'    case {can_id_text(res)}:')
+            if cases:
+                emit(f'        return Domain::{domain_enum(name)};')
+        emit('    default:')
+        emit('        return Domain::None;')
+        emit('    }')
+
+    emit('// Standard IDs routed by VehicleManager (hardware acceptance filter input)')
+    emit('static constexpr uint16_t ROUTED_STD_IDS[] = {')
+    id_list(standard)
+    emit('};')
+    emit('')
+    emit('// Extended IDs routed by VehicleManager (BAP is routed separately)')
+    emit('static constexpr uint32_t ROUTED_EXT_IDS[] = {')
+    id_list(extended)
+    if not extended:
+        emit('    0,                      // Placeholder (see ROUTED_EXT_ID_COUNT)')
+    emit('};')
+    emit(f'static constexpr size_t ROUTED_EXT_ID_COUNT = {len(extended)};')
+    emit('')
+    emit('/**')
+    emit(' * Domain of a standard CAN ID (Domain::None if not routed).')
+    emit(' */')
+    emit('inline Domain domainOf(uint32_t canId) {')
+    domain_switch(standard)
+    emit('}')
+    emit('')
+    emit('/**')
+    emit(' * Domain of an extended CAN ID (Domain::None if not routed).')
+    emit(' */')
+    emit('inline Domain extendedDomainOf(uint32_t canId) {')
+    domain_switch(extended)
+    emit('}')
+    emit('')
+    emit('/**')
+    emit(' * Decode a routed frame and pass the raw struct to handler(const Struct&).')
+    emit(' * Multiplexed messages pass a struct holding only the frame\'s page.')
+    emit(' * @return false if the ID is not routed, the frame is shorter than its DLC')
+    emit(' *         or its mux value has no page')
+    emit(' */')
+    emit('template<typename Handler>')
+    emit('inline bool decode(uint32_t canId, const uint8_t* data, uint8_t dlc, Handler& handler) {')
+    emit('    switch (canId) {')
+    for res in resolved:
+        if res.selector:
+            emit(f'    case {can_id_text(res)}: {{')
+            emit(f'        if (dlc < {res.message.dlc}) return false;')
+            emit(f'        BroadcastDecoder::{res.struct} message;')
+            emit(f'        if (!BroadcastDecoder::decode{res.struct}(data, message)) return false;')
+            emit('        handler(message);')
+            emit('        return true;')
+            emit('    }')
+            continue
+        emit(f'    case {can_id_text(res)}:')
+        emit(f'        if (dlc < {res.message.dlc}) return false;')
+        emit(f'        handler(BroadcastDecoder::decode{res.struct}(data));')
+        emit('        return true;')
+    emit('    default:')
+    emit('        return false;')
+    emit('    }')
+    emit('}')
+    emit('')
+    emit('} // namespace VehicleMessages')
+    return '\n'.join(out) + '\n'
+
+
+# =============================================================================
+# Golden check generation
+# =============================================================================
+
+def expected_raw(sig: Signal, text: str, where: str) -> int:
+    """Physical golden value -> the raw integer the decoder must return."""
+    physical = float(text)
+    raw = round((physical - sig.offset) / sig.scale)
+    if abs(raw * sig.scale + sig.offset - physical) > abs(sig.scale) / 2:
+        raise GeneratorError(f'{where}: {sig.name}={text} is not representable (scale {number(sig.scale)})')
+    low = -(1 << (sig.length - 1)) if sig.signed else 0
+    high = (1 << (sig.length - 1)) - 1 if sig.signed else (1 << sig.length) - 1
+    if not low <= raw <= high:
+        raise GeneratorError(f'{where}: {sig.name}={text} is out of range for {sig.length} bits')
+    return raw
+
+
+def generate_golden(goldens: list, resolved: list, golden_path: str) -> str:
+    by_name = {res.message.name: res for res in resolved}
+    out = []
+    emit = out.append
+
+    emit(f'// Generated by tools/dbc_codegen/dbc_codegen.py from {golden_path} - do not edit.')
+    emit('')
+    emit('#include <cstdio>')
+    emit('')
+    emit('// The header generated next to this file, not the committed one')
+    emit('#include "VehicleMessages.h"')
+    emit('')
+    emit('static int checks = 0;')
+    emit('static int failures = 0;')
+    emit('')
+    emit('static void expect(const char* what, long long actual, long long expected) {')
+    emit('    checks++;')
+    emit('    if (actual != expected) {')
+    emit('        failures++;')
+    emit('        printf("FAIL %s: raw %lld, expected %lld\\n", what, actual, expected);')
+    emit('    }')
+    emit('}')
+    emit('')
+    emit('struct RouteCheck {')
+    emit('    int decoded = 0;')
+    emit('    template<typename Message>')
+    emit('    void operator()(const Message&) { decoded++; }')
+    emit('};')
+    emit('')
+    emit('int main() {')
+    for golden in goldens:
+        where = f'{golden_path}:{golden.line}'
+        res = by_name.get(golden.message)
+        if res is None:
+            raise GeneratorError(f'{where}: {golden.message} is not in the selection')
+        fields = {sig.name: sig for sig, _ in res.signals}
+        can_id = can_id_text(res)
+        payload = ', '.join(f'0x{b:02X}' for b in golden.payload)
+
+        emit('    {')
+        if golden.comment:
+            emit(f'        // {golden.comment}')
+        emit(f'        static const uint8_t frame[8] = {{ {payload} }};')
+        if res.selector:
+            emit(f'        BroadcastDecoder::{res.struct} msg;')
+            emit(f'        expect("{golden.message} page", BroadcastDecoder::decode{res.struct}(frame, msg), 1);')
+        else:
+            emit(f'        BroadcastDecoder::{res.struct} msg = BroadcastDecoder::decode{res.struct}(frame);')
+        for sig_name, value in golden.expected:
+            if sig_name not in fields:
+                raise GeneratorError(f'{where}: {golden.message}.{sig_name} is not a selected signal')
+            sig = fields[sig_name]
+            raw = expected_raw(sig, value, where)
+            emit(f'        expect("{golden.message}.{sig_name}", msg.{res.member_path(sig_name)}, {raw}LL);'
+                 f'  // {value} {unit(sig)}'.rstrip())
+        emit('        RouteCheck route;')
+        emit(f'        expect("{golden.message} routed", VehicleMessages::decode({can_id}, frame, 8, route) '
+             f'&& route.decoded == 1, 1);')
+        emit('    }')
+    emit('    printf("Golden: %d checks, %d failures\\n", checks, failures);')
+    emit('    return failures == 0 ? 0 : 1;')
+    emit('}')
+    return '\n'.join(out) + '\n'
+
+
+# =============================================================================
+# Main
+# =============================================================================
+
+def relative(path: Path) -> str:
+    try:
+        return str(path.resolve().relative_to(REPO_ROOT))
+    except ValueError:
+        return str(path)
+
+
+class InputAction(argparse.Action):
+    """Collect --dbc/--extracted into one list, keeping command-line order."""
+
+    def __call__(self, parser, namespace, value, option_string=None):
+        inputs = getattr(namespace, self.dest) or []
+        inputs.append((option_string.lstrip('-'), Path(value)))
+        setattr(namespace, self.dest, inputs)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate C++ broadcast decoders from DBC/extracted tables')
+    parser.add_argument('--dbc', action=InputAction, dest='inputs', help='DBC file (repeatable)')
+    parser.add_argument('--extracted', action=InputAction, dest='inputs', help='extracted_*.md table (repeatable)')
+    parser.add_argument('--select', type=Path, required=True, help='Selection list')
+    parser.add_argument('--output', type=Path, required=True, help='Generated header')
+    parser.add_argument('--golden', type=Path, help='Golden frames file')
+    parser.add_argument('--golden-output', type=Path, help='Generated golden check program')
+    args = parser.parse_args()
+
+    if not args.inputs:
+        parser.error('need at least one --dbc or --extracted input')
+    if bool(args.golden) != bool(args.golden_output):
+        parser.error('--golden and --golden-output go together')
+
+    # Inputs are merged in command-line order (first definition wins)
+    sources = []
+    for kind, path in args.inputs:
+        sources.append(parse_dbc_file(path) if kind == 'dbc' else parse_extracted_md(path))
+    inputs = [relative(path) for _, path in args.inputs]
+
+    try:
+        resolved = resolve(parse_selection(args.select), merge_messages(sources))
+        header = generate_header(resolved, inputs, relative(args.select))
+        golden = None
+        if args.golden:
+            golden = generate_golden(parse_golden(args.golden), resolved, relative(args.golden))
+    except GeneratorError as e:
+        print(f'dbc_codegen: error: {e}', file=sys.stderr)
+        return 1
+
+    args.output.parent.mkdir(parents=True, exist_ok=True)
+    args.output.write_text(header, encoding='utf-8')
+    print(f'Wrote {args.output} ({len(resolved)} messages, '
+          f'{sum(len(res.signals) for res in resolved)} signals)')
+    if golden is not None:
+        args.golden_output.parent.mkdir(parents=True, exist_ok=True)
+        args.golden_output.write_text(golden, encoding='utf-8')
+        print(f'Wrote {args.golden_output}')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
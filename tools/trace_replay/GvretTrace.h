@@ -0,0 +1,134 @@
+#pragma once
+
+/**
+ * GvretTrace - GVRET CSV trace loading shared by the host tools
+ *
+ * Reads a SavvyCAN/GVRET export (Time Stamp, ID, Extended, [LEN], D1..D8):
+ *
+ * - Rows whose timestamp or ID does not parse are skipped and counted
+ * - LEN, when present, sets the DLC (clamped to 8); otherwise the number of
+ *   non-empty data columns does
+ * - Timestamps are rebased to the first frame and never step backwards
+ *   (SavvyCAN traces are not always monotonic)
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "modules/CanRxFrame.h"
+
+namespace GvretTrace {
+
+struct Frame {
+    uint64_t timestampUs;   // Relative to the first frame
+    CanRxFrame frame;       // frame.timestampUs: the same, truncated to 32 bits
+};
+
+inline std::vector<std::string> splitCsv(const std::string& line) {
+    std::vector<std::string> fields;
+    std::string field;
+    std::istringstream in(line);
+    while (std::getline(in, field, ',')) {
+        // Trim whitespace and a trailing CR
+        size_t start = field.find_first_not_of(" \t\r");
+        size_t end = field.find_last_not_of(" \t\r");
+        fields.push_back(start == std::string::npos ? "" : field.substr(start, end - start + 1));
+    }
+    return fields;
+}
+
+inline int columnIndex(const std::vector<std::string>& header, const char* name) {
+    for (size_t i = 0; i < header.size(); i++) {
+        if (header[i] == name) return (int)i;
+    }
+    return -1;
+}
+
+/**
+ * Append the frames of `path` to `frames`. Returns false (after printing why
+ * on stderr) if the file cannot be read or lacks the GVRET columns.
+ */
+inline bool load(const char* path, std::vector<Frame>& frames, size_t& skippedRows) {
+    std::ifstream file(path);
+    if (!file) {
+        fprintf(stderr, "Cannot open %s\n", path);
+        return false;
+    }
+
+    std::string line;
+    if (!std::getline(file, line)) {
+        fprintf(stderr, "%s is empty\n", path);
+        return false;
+    }
+
+    std::vector<std::string> header = splitCsv(line);
+    int colTime = columnIndex(header, "Time Stamp");
+    int colId = columnIndex(header, "ID");
+    int colExt = columnIndex(header, "Extended");
+    int colLen = columnIndex(header, "LEN");
+    int colData = columnIndex(header, "D1");
+    if (colTime < 0 || colId < 0 || colExt < 0 || colData < 0) {
+        fprintf(stderr, "%s: missing GVRET columns (Time Stamp, ID, Extended, D1..D8)\n", path);
+        return false;
+    }
+
+    size_t firstFrame = frames.size();
+    uint64_t firstUs = 0;
+    uint64_t lastUs = 0;
+    skippedRows = 0;
+
+    while (std::getline(file, line)) {
+        std::vector<std::string> f = splitCsv(line);
+        if (f.size() <= (size_t)std::max(colTime, std::max(colId, colExt))) {
+            skippedRows++;
+            continue;
+        }
+
+        Frame tf = {};
+        char* end = nullptr;
+        uint64_t ts = strtoull(f[colTime].c_str(), &end, 10);
+        if (f[colTime].empty() || *end != '\0') {
+            skippedRows++;
+            continue;
+        }
+        tf.frame.canId = (uint32_t)strtoul(f[colId].c_str(), &end, 16);
+        if (f[colId].empty() || *end != '\0') {
+            skippedRows++;
+            continue;
+        }
+        tf.frame.extended = f[colExt] == "true" || f[colExt] == "True" || f[colExt] == "1";
+
+        uint8_t dlc = 0;
+        for (int i = 0; i < 8 && colData + i < (int)f.size() && !f[colData + i].empty(); i++) {
+            tf.frame.data[i] = (uint8_t)strtoul(f[colData + i].c_str(), nullptr, 16);
+            dlc++;
+        }
+        if (colLen >= 0 && colLen < (int)f.size() && !f[colLen].empty()) {
+            dlc = (uint8_t)std::min(8UL, strtoul(f[colLen].c_str(), nullptr, 10));
+        }
+        tf.frame.dlc = dlc;
+
+        if (frames.size() == firstFrame) {
+            firstUs = ts;
+        }
+        // Never step backwards
+        uint64_t rel = ts >= firstUs ? ts - firstUs : 0;
+        if (rel < lastUs) {
+            rel = lastUs;
+        }
+        lastUs = rel;
+
+        tf.timestampUs = rel;
+        tf.frame.timestampUs = (uint32_t)rel;
+        frames.push_back(tf);
+    }
+    return true;
+}
+
+}  // namespace GvretTrace
@@ -0,0 +1,551 @@
+/**
+ * bap_bench - Check and time BapFrameAssembler against the slot-scan version
+ *
+ * The scan assembler it replaced is kept below as the reference: every
+ * continuation searched all slots backwards, every add/remove recounted
+ * them, a message that lost a continuation held its slot until reset, and
+ * every complete message was copied into a 128-byte BapMessage.
+ *
+ * Synthetic scenarios follow the interleavings that
+ * docs/canbus-reverse-engineering/analyze_concurrent_bap.py looks for on
+ * 0x17332510:
+ *
+ *   groups      four long messages in flight, one per group, round-robin
+ *   shared      two functions in one group, the second starting mid-message
+ *   lost        a continuation dropped every few messages, more than
+ *               PENDING_TIMEOUT_MS before the group is used again
+ *   restart     a start frame repeated for a function that is still pending
+ *
+ * For each scenario, both assemblers report the messages delivered intact
+ * (device, function and payload match what was sent) and the best-of-rounds
+ * cycles per frame. A scenario where the indexed assembler delivers fewer
+ * intact messages than the reference fails the run (exit code 1).
+ *
+ * GVRET CSV traces given on the command line are replayed too (frames on
+ * 0x17332510 only). There is no expected list for a trace, so the report
+ * shows what each assembler delivered and where they disagree.
+ *
+ * Usage:
+ *   bap_bench [rounds] [trace.csv ...]
+ */
+
+#include <Arduino.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "vehicle/protocols/BapProtocol.h"
+
+#include "GvretTrace.h"
+
+using namespace BapProtocol;
+
+static constexpr uint32_t BAP_RX_ID = 0x17332510;
+
+struct BenchFrame {
+    uint8_t data[8];
+    uint8_t dlc;
+    uint32_t ms;
+};
+
+struct Delivered {
+    uint8_t deviceId;
+    uint8_t functionId;
+    std::vector<uint8_t> payload;
+
+    bool operator==(const Delivered& other) const {
+        return deviceId == other.deviceId && functionId == other.functionId && payload == other.payload;
+    }
+};
+
+// =============================================================================
+// Reference (slot-scan assembler as it was before group indexing)
+// =============================================================================
+
+struct ScanMessage {
+    uint8_t opcode = 0;
+    uint8_t deviceId = 0;
+    uint8_t functionId = 0;
+    uint8_t payloadLen = 0;
+    uint8_t payload[128];
+};
+
+class ScanAssembler {
+public:
+    static constexpr size_t MAX_PAYLOAD_SIZE = 128;
+    static constexpr size_t MAX_PENDING_MESSAGES = 16;
+
+    uint32_t continuationErrors = 0;
+    uint32_t pendingOverflows = 0;
+
+    bool processFrame(const uint8_t* data, uint8_t dlc, ScanMessage& outMsg) {
+        if (dlc < 2) {
+            return false;
+        }
+        BapHeader header = decodeHeader(data, dlc);
+
+        if (!header.isLong) {
+            outMsg.opcode = header.opcode;
+            outMsg.deviceId = header.deviceId;
+            outMsg.functionId = header.functionId;
+            outMsg.payloadLen = getShortPayloadLength(dlc);
+            if (outMsg.payloadLen > 0) {
+                memcpy(outMsg.payload, getShortPayload(data), outMsg.payloadLen);
+            }
+            return true;
+        }
+
+        int8_t idx;
+        uint8_t chunkLen;
+        const uint8_t* chunk;
+        if (!header.isContinuation) {
+            idx = addPendingMessage(header.group, header.opcode, header.deviceId, header.functionId,
+                                    header.totalLength);
+            if (idx < 0) {
+                pendingOverflows++;
+                return false;
+            }
+            chunkLen = (dlc > 4) ? (dlc - 4) : 0;
+            chunk = data + 4;
+        } else {
+            idx = findPendingMessage(header.group, header.index);
+            if (idx < 0) {
+                continuationErrors++;
+                return false;
+            }
+            chunkLen = dlc - 1;
+            chunk = data + 1;
+            pending[idx].nextExpectedIndex = (pending[idx].nextExpectedIndex + 1) & 0x0F;
+        }
+
+        PendingMessage& pm = pending[idx];
+        uint8_t remaining = pm.expectedLength - pm.assembledLength;
+        if (chunkLen > remaining) {
+            chunkLen = remaining;
+        }
+        if (chunkLen > 0 && pm.assembledLength + chunkLen <= MAX_PAYLOAD_SIZE) {
+            memcpy(pm.buffer + pm.assembledLength, chunk, chunkLen);
+            pm.assembledLength += chunkLen;
+        }
+        if (pm.assembledLength >= pm.expectedLength) {
+            outMsg.opcode = pm.opcode;
+            outMsg.deviceId = pm.deviceId;
+            outMsg.functionId = pm.functionId;
+            outMsg.payloadLen = pm.expectedLength;
+            memcpy(outMsg.payload, pm.buffer, pm.expectedLength);
+            removePendingMessage(idx);
+            return true;
+        }
+        return false;
+    }
+
+    void reset() {
+        for (size_t i = 0; i < MAX_PENDING_MESSAGES; i++) {
+            pending[i].active = false;
+            pending[i].assembledLength = 0;
+        }
+        pendingCount = 0;
+    }
+
+private:
+    struct PendingMessage {
+        bool active = false;
+        uint8_t group = 0;
+        uint8_t nextExpectedIndex = 0;
+        uint8_t opcode = 0;
+        uint8_t deviceId = 0;
+        uint8_t functionId = 0;
+        uint8_t expectedLength = 0;
+        uint8_t assembledLength = 0;
+        uint8_t buffer[MAX_PAYLOAD_SIZE];
+    };
+
+    PendingMessage pending[MAX_PENDING_MESSAGES];
+    uint8_t pendingCount = 0;
+
+    int8_t findPendingMessage(uint8_t group, uint8_t index) {
+        for (int8_t i = MAX_PENDING_MESSAGES - 1; i >= 0; i--) {
+            if (pending[i].active && pending[i].group == group && pending[i].nextExpectedIndex == index &&
+                pending[i].assembledLength < pending[i].expectedLength) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    int8_t addPendingMessage(uint8_t group, uint8_t opcode, uint8_t deviceId, uint8_t functionId,
+                             uint8_t expectedLength) {
+        int8_t idx = -1;
+        for (uint8_t i = 0; i < MAX_PENDING_MESSAGES; i++) {
+            if (!pending[i].active) {
+                idx = i;
+                break;
+            }
+        }
+        if (idx < 0) {
+            return -1;
+        }
+        PendingMessage& pm = pending[idx];
+        pm.active = true;
+        pm.group = group;
+        pm.nextExpectedIndex = 0;
+        pm.opcode = opcode;
+        pm.deviceId = deviceId;
+        pm.functionId = functionId;
+        pm.expectedLength = expectedLength;
+        pm.assembledLength = 0;
+        recount();
+        return idx;
+    }
+
+    void removePendingMessage(uint8_t index) {
+        pending[index].active = false;
+        pending[index].assembledLength = 0;
+        recount();
+    }
+
+    void recount() {
+        pendingCount = 0;
+        for (uint8_t i = 0; i < MAX_PENDING_MESSAGES; i++) {
+            if (pending[i].active) {
+                pendingCount++;
+            }
+        }
+    }
+};
+
+// =============================================================================
+// Scenario generation
+// =============================================================================
+
+/**
+ * Frames of one long message as the vehicle sends them (byte 1 is the
+ * payload length, as BapFrameAssembler reads it).
+ */
+static std::vector<BenchFrame> longMessageFrames(uint8_t group, uint8_t deviceId, uint8_t functionId,
+                                                 const std::vector<uint8_t>& payload) {
+    std::vector<BenchFrame> frames;
+    BenchFrame start = {};
+    start.data[0] = 0x80 | ((group & 0x03) << 4);
+    start.data[1] = (uint8_t)payload.size();
+    encodeHeader(start.data + 2, OpCode::STATUS, deviceId, functionId);
+    size_t offset = payload.size() < 4 ? payload.size() : 4;
+    memcpy(start.data + 4, payload.data(), offset);
+    start.dlc = 8;
+    frames.push_back(start);
+
+    for (uint8_t index = 0; offset < payload.size(); index = (index + 1) & 0x0F) {
+        BenchFrame cont = {};
+        cont.data[0] = 0xC0 | ((group & 0x03) << 4) | index;
+        size_t chunk = payload.size() - offset < 7 ? payload.size() - offset : 7;
+        memcpy(cont.data + 1, payload.data() + offset, chunk);
+        cont.dlc = 8;
+        frames.push_back(cont);
+        offset += chunk;
+    }
+    return frames;
+}
+
+static std::vector<uint8_t> payloadOf(size_t length, uint32_t& seed) {
+    std::vector<uint8_t> payload(length);
+    for (uint8_t& b : payload) {
+        seed = seed * 1103515245 + 12345;
+        b = seed >> 24;
+    }
+    return payload;
+}
+
+struct Scenario {
+    const char* name;
+    std::vector<BenchFrame> frames;
+    std::vector<Delivered> expected;   // Messages that were sent complete
+};
+
+/**
+ * Merge messages round-robin, one frame each, starting message i at
+ * frame offset `stagger * i`. Frames are 2 ms apart.
+ */
+static void interleave(Scenario& scenario, const std::vector<std::vector<BenchFrame>>& messages,
+                       size_t stagger, uint32_t& ms) {
+    size_t longest = 0;
+    for (size_t m = 0; m < messages.size(); m++) {
+        size_t end = stagger * m + messages[m].size();
+        longest = end > longest ? end : longest;
+    }
+    for (size_t step = 0; step < longest; step++) {
+        for (size_t m = 0; m < messages.size(); m++) {
+            if (step >= stagger * m && step - stagger * m < messages[m].size()) {
+                BenchFrame frame = messages[m][step - stagger * m];
+                frame.ms = ms;
+                ms += 2;
+                scenario.frames.push_back(frame);
+            }
+        }
+    }
+}
+
+static std::vector<Scenario> buildScenarios() {
+    static const uint8_t DEVICE = 0x25;
+    static const uint8_t FUNCTIONS[] = {0x11, 0x12, 0x18, 0x19};
+    std::vector<Scenario> scenarios;
+    uint32_t seed = 0xBA9;
+
+    {
+        Scenario s = {"groups", {}, {}};
+        uint32_t ms = 0;
+        for (int burst = 0; burst < 64; burst++) {
+            std::vector<std::vector<BenchFrame>> messages;
+            for (uint8_t g = 0; g < 4; g++) {
+                std::vector<uint8_t> payload = payloadOf(20 + 8 * g, seed);
+                messages.push_back(longMessageFrames(g, DEVICE, FUNCTIONS[g], payload));
+                s.expected.push_back({DEVICE, FUNCTIONS[g], payload});
+            }
+            interleave(s, messages, 0, ms);
+        }
+        scenarios.push_back(s);
+    }
+
+    {
+        Scenario s = {"shared", {}, {}};
+        uint32_t ms = 0;
+        for (int burst = 0; burst < 128; burst++) {
+            std::vector<std::vector<BenchFrame>> messages;
+            for (uint8_t f = 0; f < 2; f++) {
+                std::vector<uint8_t> payload = payloadOf(40, seed);
+                messages.push_back(longMessageFrames(0, DEVICE, FUNCTIONS[f], payload));
+                s.expected.push_back({DEVICE, FUNCTIONS[f], payload});
+            }
+            interleave(s, messages, 3, ms);
+        }
+        scenarios.push_back(s);
+    }
+
+    {
+        Scenario s = {"lost", {}, {}};
+        uint32_t ms = 0;
+        for (int n = 0; n < 256; n++) {
+            uint8_t group = n & 0x03;
+            uint8_t function = FUNCTIONS[(n >> 2) & 0x03];
+            std::vector<uint8_t> payload = payloadOf(33, seed);
+            std::vector<BenchFrame> frames = longMessageFrames(group, DEVICE, function, payload);
+            bool lose = n % 3 == 0;
+            if (lose) {
+                frames.erase(frames.begin() + 2);
+            } else {
+                s.expected.push_back({DEVICE, function, payload});
+            }
+            for (BenchFrame& frame : frames) {
+                frame.ms = ms;
+                ms += 2;
+                s.frames.push_back(frame);
+            }
+            ms += lose ? BapFrameAssembler::PENDING_TIMEOUT_MS : 20;
+        }
+        scenarios.push_back(s);
+    }
+
+    {
+        Scenario s = {"restart", {}, {}};
+        uint32_t ms = 0;
+        for (int n = 0; n < 256; n++) {
+            uint8_t function = FUNCTIONS[n & 0x03];
+            std::vector<uint8_t> aborted = payloadOf(47, seed);
+            std::vector<uint8_t> payload = payloadOf(47, seed);
+            std::vector<BenchFrame> frames = longMessageFrames(1, DEVICE, function, aborted);
+            frames.resize(3);
+            std::vector<BenchFrame> resent = longMessageFrames(1, DEVICE, function, payload);
+            frames.insert(frames.end(), resent.begin(), resent.end());
+            s.expected.push_back({DEVICE, function, payload});
+            for (BenchFrame& frame : frames) {
+                frame.ms = ms;
+                ms += 2;
+                s.frames.push_back(frame);
+            }
+            ms += 20;
+        }
+        scenarios.push_back(s);
+    }
+
+    return scenarios;
+}
+
+// =============================================================================
+// GVRET traces
+// =============================================================================
+
+static bool loadBapFrames(const char* path, Scenario& scenario) {
+    std::vector<GvretTrace::Frame> trace;
+    size_t skippedRows = 0;
+    if (!GvretTrace::load(path, trace, skippedRows)) {
+        return false;
+    }
+
+    for (const GvretTrace::Frame& tf : trace) {
+        if (tf.frame.canId != BAP_RX_ID) {
+            continue;
+        }
+        BenchFrame frame = {};
+        frame.dlc = tf.frame.dlc;
+        memcpy(frame.data, tf.frame.data, sizeof(frame.data));
+        frame.ms = (uint32_t)(tf.timestampUs / 1000);
+        scenario.frames.push_back(frame);
+    }
+    return true;
+}
+
+// =============================================================================
+// Runs
+// =============================================================================
+
+template<typename Process>
+static std::vector<Delivered> deliver(const std::vector<BenchFrame>& frames, Process process) {
+    std::vector<Delivered> out;
+    BapMessageView msg;
+    for (const BenchFrame& frame : frames) {
+        if (process(frame, msg)) {
+            out.push_back({msg.deviceId, msg.functionId,
+                           std::vector<uint8_t>(msg.payload, msg.payload + msg.payloadLen)});
+        }
+    }
+    return out;
+}
+
+/**
+ * Messages of `got` equal to a sent message (each sent message counts once).
+ */
+static size_t intactCount(const std::vector<Delivered>& got, const std::vector<Delivered>& expected) {
+    size_t matched = 0;
+    std::vector<bool> used(expected.size(), false);
+    for (const Delivered& message : got) {
+        for (size_t e = 0; e < expected.size(); e++) {
+            if (!used[e] && expected[e] == message) {
+                used[e] = true;
+                matched++;
+                break;
+            }
+        }
+    }
+    return matched;
+}
+
+/**
+ * Best-of-rounds cycles per frame, starting each round from a reset assembler.
+ */
+template<typename Reset, typename Process>
+static double measure(const std::vector<BenchFrame>& frames, int rounds, Reset reset, Process process) {
+    double best = 1e30;
+    volatile uint32_t sink = 0;
+    BapMessageView msg;
+    for (int r = 0; r < rounds; r++) {
+        reset();
+        uint32_t delivered = 0;
+        uint32_t start = ESP.getCycleCount();
+        for (const BenchFrame& frame : frames) {
+            delivered += process(frame, msg) ? 1 : 0;
+        }
+        double perFrame = (double)(uint32_t)(ESP.getCycleCount() - start) / frames.size();
+        sink = delivered;
+        if (perFrame < best) {
+            best = perFrame;
+        }
+    }
+    (void)sink;
+    return best;
+}
+
+static ScanAssembler scan;
+static BapFrameAssembler indexed;
+
+static bool runScenario(const Scenario& scenario, int rounds, bool synthetic) {
+    // The scan path copies into a BapMessage-sized struct, as the channel did
+    auto scanProcess = [](const BenchFrame& f, BapMessageView& m) {
+        static ScanMessage copy;
+        if (!scan.processFrame(f.data, f.dlc, copy)) {
+            return false;
+        }
+        m.deviceId = copy.deviceId;
+        m.functionId = copy.functionId;
+        m.payloadLen = copy.payloadLen;
+        m.payload = copy.payload;
+        return true;
+    };
+    // The view stays valid until the next processFrame(), which releases the slot
+    auto indexedProcess = [](const BenchFrame& f, BapMessageView& m) {
+        return indexed.processFrame(f.data, f.dlc, m, f.ms);
+    };
+
+    scan.reset();
+    scan.continuationErrors = 0;
+    scan.pendingOverflows = 0;
+    std::vector<Delivered> scanOut = deliver(scenario.frames, scanProcess);
+    uint32_t scanErrors = scan.continuationErrors;
+    uint32_t scanOverflows = scan.pendingOverflows;
+
+    indexed = BapFrameAssembler();
+    std::vector<Delivered> indexedOut = deliver(scenario.frames, indexedProcess);
+    char indexedCounters[96];
+    snprintf(indexedCounters, sizeof(indexedCounters), "contErrors:%u overflows:%u timeouts:%u restarts:%u",
+             (unsigned)indexed.continuationErrors, (unsigned)indexed.pendingOverflows,
+             (unsigned)indexed.timeoutEvictions, (unsigned)indexed.staleReplacements);
+
+    double scanCycles = measure(scenario.frames, rounds, [] { scan.reset(); }, scanProcess);
+    double indexedCycles = measure(scenario.frames, rounds, [] { indexed.reset(); }, indexedProcess);
+
+    printf("\n%s: %zu frames\n", scenario.name, scenario.frames.size());
+    bool ok = true;
+    if (synthetic) {
+        size_t scanIntact = intactCount(scanOut, scenario.expected);
+        size_t indexedIntact = intactCount(indexedOut, scenario.expected);
+        printf("  scan     %4zu/%zu intact  contErrors:%u overflows:%u\n", scanIntact,
+               scenario.expected.size(), scanErrors, scanOverflows);
+        printf("  indexed  %4zu/%zu intact  %s\n", indexedIntact, scenario.expected.size(), indexedCounters);
+        ok = indexedIntact >= scanIntact;
+    } else {
+        size_t disagree = 0;
+        for (size_t i = 0; i < scanOut.size() || i < indexedOut.size(); i++) {
+            if (i >= scanOut.size() || i >= indexedOut.size() || !(scanOut[i] == indexedOut[i])) {
+                disagree++;
+            }
+        }
+        printf("  scan     %4zu delivered  contErrors:%u overflows:%u\n", scanOut.size(), scanErrors,
+               scanOverflows);
+        printf("  indexed  %4zu delivered  %s\n", indexedOut.size(), indexedCounters);
+        printf("  %zu delivered messages differ\n", disagree);
+    }
+    printf("  cycles/frame  scan %.1f  indexed %.1f  (%.2fx)  pending max %u, buffered max %u of %zu B\n",
+           scanCycles, indexedCycles, scanCycles / indexedCycles, (unsigned)indexed.maxPendingCount,
+           (unsigned)indexed.maxBufferedBytes, BapFrameAssembler::footprintBytes());
+    if (!ok) {
+        printf("  FAIL: indexed assembler delivered fewer intact messages\n");
+    }
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    int rounds = argc > 1 ? atoi(argv[1]) : 200;
+    if (rounds <= 0) {
+        fprintf(stderr, "Usage: bap_bench [rounds] [trace.csv ...]\n");
+        return 2;
+    }
+
+    bool ok = true;
+    for (const Scenario& scenario : buildScenarios()) {
+        ok = runScenario(scenario, rounds, true) && ok;
+    }
+
+    for (int i = 2; i < argc; i++) {
+        Scenario trace = {argv[i], {}, {}};
+        if (!loadBapFrames(argv[i], trace)) {
+            return 2;
+        }
+        if (trace.frames.empty()) {
+            printf("\n%s: no frames on 0x%08X\n", argv[i], BAP_RX_ID);
+            continue;
+        }
+        runScenario(trace, rounds, false);
+    }
+
+    return ok ? 0 : 1;
+}
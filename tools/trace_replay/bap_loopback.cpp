@@ -0,0 +1,550 @@
+/**
+ * bap_loopback - BapTransmitter frames reassembled by BapFrameAssembler
+ *
+ * Checks on the host that every message the transmitter sends comes out of
+ * the receiver's assembler intact, whatever the interleaving:
+ *
+ *   wrap          the 127-byte message (start + 18 continuations) carries
+ *                 continuation indices 0..15, 0, 1 and reassembles
+ *   exhaustive    frame streams of 2, 3 and 4 concurrent long messages (one
+ *                 group each) fed to the assembler in every possible
+ *                 interleaving that keeps each message's frames in order
+ *   random        the same for four 19-frame messages, random interleavings
+ *   engine        the transmitter driven like the main loop: messages sent
+ *                 at random times on two CAN IDs, a bus that takes frames
+ *                 from either ID's queue at random, completions dispatched
+ *                 in random batches, a scheduler queue that can be full,
+ *                 with and without an inter-frame gap; all four groups of
+ *                 one CAN ID must be in use at some point
+ *   failure       as engine, with one frame per run failing; only its
+ *                 message may be lost, nothing is delivered corrupt
+ *
+ * Short messages come out with the 6 bytes of the frame (BAP short frames
+ * carry no length), so their expected payload is zero-padded to 6 bytes.
+ *
+ * Any mismatch, continuation error or lost message fails the run (exit 1).
+ *
+ * Usage:
+ *   bap_loopback [runs] [seed]
+ */
+
+#include <Arduino.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "vehicle/protocols/BapProtocol.h"
+#include "vehicle/bap/BapTransmitter.h"
+
+using namespace BapProtocol;
+
+static constexpr uint32_t TX_ID_BATTERY = 0x17332501;
+static constexpr uint32_t TX_ID_DOORS = 0x17330D00;
+static constexpr size_t SCHEDULER_SLOTS = CanTxScheduler::MAX_PENDING;
+
+struct Message {
+    uint32_t canId = 0;
+    uint8_t opcode = 0;
+    uint8_t deviceId = 0;
+    uint8_t functionId = 0;
+    std::vector<uint8_t> payload;
+
+    bool operator<(const Message& other) const {
+        if (canId != other.canId) return canId < other.canId;
+        if (deviceId != other.deviceId) return deviceId < other.deviceId;
+        if (functionId != other.functionId) return functionId < other.functionId;
+        if (opcode != other.opcode) return opcode < other.opcode;
+        return payload < other.payload;
+    }
+    bool operator==(const Message& other) const {
+        return !(*this < other) && !(other < *this);
+    }
+};
+
+static int failures = 0;
+
+static void fail(const char* scenario, const char* what) {
+    printf("FAIL %-11s %s\n", scenario, what);
+    failures++;
+}
+
+static std::vector<uint8_t> randomPayload(std::mt19937& rng, uint8_t len) {
+    std::vector<uint8_t> payload(len);
+    for (uint8_t& b : payload) {
+        b = (uint8_t)rng();
+    }
+    return payload;
+}
+
+/**
+ * What the receiver should deliver for a sent message.
+ */
+static Message expectedOf(const Message& sent) {
+    Message expected = sent;
+    if (expected.payload.size() <= 6) {
+        expected.payload.resize(6, 0);
+    }
+    return expected;
+}
+
+// =============================================================================
+// Receiver: one assembler per CAN ID, like BapChannelRouter's routes
+// =============================================================================
+
+class Receiver {
+public:
+    void deliver(uint32_t canId, const uint8_t* data, uint8_t dlc, uint32_t nowMs) {
+        BapMessageView view;
+        if (assemblers[canId].processFrame(data, dlc, view, nowMs)) {
+            Message msg;
+            msg.canId = canId;
+            msg.opcode = view.opcode;
+            msg.deviceId = view.deviceId;
+            msg.functionId = view.functionId;
+            msg.payload.assign(view.payload, view.payload + view.payloadLen);
+            delivered.push_back(msg);
+        }
+    }
+
+    uint32_t continuationErrors() {
+        uint32_t errors = 0;
+        for (auto& entry : assemblers) {
+            errors += entry.second.continuationErrors;
+        }
+        return errors;
+    }
+
+    uint32_t pendingOverflows() {
+        uint32_t overflows = 0;
+        for (auto& entry : assemblers) {
+            overflows += entry.second.pendingOverflows;
+        }
+        return overflows;
+    }
+
+    std::vector<Message> delivered;
+
+private:
+    std::map<uint32_t, BapFrameAssembler> assemblers;
+};
+
+// =============================================================================
+// Frame streams straight from the transmitter (no bus)
+// =============================================================================
+
+struct Frame {
+    uint8_t data[8];
+};
+
+/**
+ * Send the messages on one CAN ID and collect each long message's frames,
+ * in order, keyed by the group the transmitter assigned.
+ */
+static std::vector<std::vector<Frame>> streamsOf(const std::vector<Message>& messages) {
+    std::vector<CanTxCallback> completions;
+    std::map<uint8_t, std::vector<Frame>> byGroup;
+
+    BapTransmitter tx([&](const CanTxFrame& frame, CanTxPriority, CanTxCallback onComplete) {
+        Frame f;
+        memcpy(f.data, frame.data, 8);
+        byGroup[(frame.data[0] >> 4) & 0x03].push_back(f);
+        completions.push_back(std::move(onComplete));
+        return true;
+    });
+    for (const Message& msg : messages) {
+        tx.send(msg.canId, msg.opcode, msg.deviceId, msg.functionId, msg.payload.data(),
+                (uint8_t)msg.payload.size());
+    }
+    while (tx.getQueuedCount() > 0) {
+        tx.loop();
+        std::vector<CanTxCallback> batch;
+        batch.swap(completions);
+        for (CanTxCallback& done : batch) {
+            done(CanTxResult::SENT);
+        }
+    }
+
+    std::vector<std::vector<Frame>> streams;
+    for (auto& entry : byGroup) {
+        streams.push_back(entry.second);
+    }
+    return streams;
+}
+
+/**
+ * Feed one interleaving (stream index per frame) and compare what comes out.
+ */
+static bool checkInterleaving(const std::vector<std::vector<Frame>>& streams, const std::vector<uint8_t>& order,
+                              const std::vector<Message>& sent) {
+    Receiver rx;
+    std::vector<size_t> next(streams.size(), 0);
+    for (uint8_t s : order) {
+        rx.deliver(sent[0].canId, streams[s][next[s]++].data, 8, 0);
+    }
+
+    std::vector<Message> expected;
+    for (const Message& msg : sent) {
+        expected.push_back(expectedOf(msg));
+    }
+    std::sort(expected.begin(), expected.end());
+    std::sort(rx.delivered.begin(), rx.delivered.end());
+    return rx.delivered == expected && rx.continuationErrors() == 0;
+}
+
+/**
+ * Every interleaving of the streams that keeps each stream in order.
+ */
+static void enumerate(const std::vector<std::vector<Frame>>& streams, const std::vector<Message>& sent,
+                      std::vector<size_t>& used, std::vector<uint8_t>& order, size_t total,
+                      uint32_t& checked, uint32_t& bad) {
+    if (order.size() == total) {
+        checked++;
+        bad += checkInterleaving(streams, order, sent) ? 0 : 1;
+        return;
+    }
+    for (uint8_t s = 0; s < streams.size(); s++) {
+        if (used[s] < streams[s].size()) {
+            used[s]++;
+            order.push_back(s);
+            enumerate(streams, sent, used, order, total, checked, bad);
+            order.pop_back();
+            used[s]--;
+        }
+    }
+}
+
+static std::vector<Message> longMessages(std::mt19937& rng, const std::vector<uint8_t>& lengths) {
+    std::vector<Message> messages;
+    for (size_t i = 0; i < lengths.size(); i++) {
+        Message msg;
+        msg.canId = TX_ID_BATTERY;
+        msg.opcode = OpCode::SET_GET;
+        msg.deviceId = 0x25;
+        msg.functionId = (uint8_t)(0x10 + i);
+        msg.payload = randomPayload(rng, lengths[i]);
+        messages.push_back(msg);
+    }
+    return messages;
+}
+
+static void scenarioWrap(std::mt19937& rng) {
+    std::vector<Message> sent = longMessages(rng, {127});
+    std::vector<std::vector<Frame>> streams = streamsOf(sent);
+    if (streams.size() != 1 || streams[0].size() != MAX_MESSAGE_FRAMES) {
+        fail("wrap", "127-byte message is not 19 frames");
+        return;
+    }
+
+    bool indicesOk = streams[0][0].data[1] == 127;
+    for (size_t i = 1; i < streams[0].size(); i++) {
+        indicesOk = indicesOk && (streams[0][i].data[0] & 0x0F) == ((i - 1) & 0x0F);
+    }
+    std::vector<uint8_t> order(streams[0].size(), 0);
+    bool intact = checkInterleaving(streams, order, sent);
+    printf("wrap         19 frames, indices 0..15,0,1: %s, reassembled: %s\n",
+           indicesOk ? "yes" : "NO", intact ? "yes" : "NO");
+    if (!indicesOk || !intact) {
+        fail("wrap", "continuation index or reassembly wrong");
+    }
+}
+
+static void scenarioExhaustive(std::mt19937& rng) {
+    // Payload lengths giving 2..5 frames, including exact fits (11 = 4 + 7)
+    static const std::vector<std::vector<uint8_t>> SETS = {
+        {7, 11}, {11, 18}, {18, 25}, {25, 32}, {7, 32}, {32, 32},
+        {11, 11, 11}, {7, 18, 25}, {18, 18, 18},
+        {7, 7, 7, 7}, {11, 7, 11, 7}, {11, 11, 11, 11},
+    };
+
+    uint32_t checked = 0;
+    uint32_t bad = 0;
+    for (const std::vector<uint8_t>& lengths : SETS) {
+        std::vector<Message> sent = longMessages(rng, lengths);
+        std::vector<std::vector<Frame>> streams = streamsOf(sent);
+        if (streams.size() != lengths.size()) {
+            fail("exhaustive", "messages did not get one group each");
+            continue;
+        }
+        size_t total = 0;
+        for (const auto& stream : streams) {
+            total += stream.size();
+        }
+        std::vector<size_t> used(streams.size(), 0);
+        std::vector<uint8_t> order;
+        enumerate(streams, sent, used, order, total, checked, bad);
+    }
+    printf("exhaustive   %u message sets, %lu interleavings, %lu wrong\n",
+           (unsigned)SETS.size(), (unsigned long)checked, (unsigned long)bad);
+    if (bad > 0) {
+        fail("exhaustive", "interleaving reassembled wrong");
+    }
+}
+
+static void scenarioRandom(std::mt19937& rng, uint32_t runs) {
+    std::vector<Message> sent = longMessages(rng, {127, 127, 120, 127});
+    std::vector<std::vector<Frame>> streams = streamsOf(sent);
+    if (streams.size() != 4) {
+        fail("random", "messages did not get one group each");
+        return;
+    }
+
+    uint32_t bad = 0;
+    for (uint32_t run = 0; run < runs; run++) {
+        std::vector<uint8_t> order;
+        for (uint8_t s = 0; s < streams.size(); s++) {
+            order.insert(order.end(), streams[s].size(), s);
+        }
+        std::shuffle(order.begin(), order.end(), rng);  // Stream order is kept by construction
+        bad += checkInterleaving(streams, order, sent) ? 0 : 1;
+    }
+    printf("random       4 x 19 frames, %lu interleavings, %lu wrong\n", (unsigned long)runs, (unsigned long)bad);
+    if (bad > 0) {
+        fail("random", "interleaving reassembled wrong");
+    }
+}
+
+// =============================================================================
+// Transmitter driven like the main loop
+// =============================================================================
+
+struct EngineResult {
+    uint32_t messages = 0;
+    uint32_t intact = 0;
+    uint32_t failed = 0;
+    uint32_t corrupt = 0;
+    uint32_t frames = 0;
+    uint32_t switches = 0;          // Consecutive bus frames from different messages
+    uint32_t gapViolations = 0;
+    uint32_t continuationErrors = 0;
+    uint32_t rejects = 0;
+    uint8_t maxGroupsPerId = 0;     // Long messages in flight on one CAN ID (groups are per ID)
+};
+
+static EngineResult runEngine(std::mt19937& rng, uint32_t gapUs, bool injectFailure) {
+    struct Queued {
+        CanTxFrame frame;
+        CanTxCallback onComplete;
+    };
+    std::map<uint32_t, std::deque<Queued>> bus;     // Scheduler keeps order per CAN ID
+    size_t queued = 0;
+    std::vector<CanTxCallback> completions;
+    std::vector<CanTxResult> results;
+    std::vector<uint32_t> handOverUs;
+    Receiver rx;
+    EngineResult result;
+
+    // Long messages from their start frame's hand-over to completion, per CAN ID
+    std::vector<bool> longOpen;
+    std::map<uint32_t, uint8_t> openLong;
+
+    uint64_t nowUs = 1000000;
+    HostClock::setMicros(nowUs);
+
+    BapTransmitter tx([&](const CanTxFrame& frame, CanTxPriority, CanTxCallback onComplete) {
+        if (queued >= SCHEDULER_SLOTS || rng() % 16 == 0) {
+            return false;  // Scheduler full
+        }
+        handOverUs.push_back((uint32_t)nowUs);
+        BapHeader header = decodeHeader(frame.data, frame.dlc);
+        if (header.isLong && !header.isContinuation) {
+            longOpen[header.functionId - 1] = true;     // Functions are backlog index + 1
+            result.maxGroupsPerId = std::max(result.maxGroupsPerId, ++openLong[frame.canId]);
+        }
+        bus[frame.canId].push_back(Queued{frame, std::move(onComplete)});
+        queued++;
+        return true;
+    });
+    tx.setInterFrameGapUs(gapUs);
+
+    // Backlog: distinct functions so every delivery maps to one sent message
+    std::vector<Message> backlog;
+    uint32_t count = 6 + rng() % 10;
+    for (uint32_t i = 0; i < count; i++) {
+        Message msg;
+        msg.canId = rng() % 3 == 0 ? TX_ID_DOORS : TX_ID_BATTERY;
+        msg.opcode = OpCode::SET_GET;
+        msg.deviceId = msg.canId == TX_ID_DOORS ? 0x0D : 0x25;
+        msg.functionId = (uint8_t)(0x01 + i);
+        uint8_t len;
+        switch (rng() % 4) {
+            case 0: len = rng() % 7; break;                 // Short
+            case 1: len = 127; break;                       // Index wrap
+            default: len = 7 + rng() % 121; break;
+        }
+        msg.payload = randomPayload(rng, len);
+        backlog.push_back(msg);
+    }
+    longOpen.resize(backlog.size());
+    std::vector<Message> sent;
+    uint32_t failFrame = injectFailure ? rng() % 40 : UINT32_MAX;
+    uint32_t busFrames = 0;
+    std::pair<uint32_t, uint8_t> lastOnBus;
+    bool haveLast = false;
+
+    for (uint32_t iteration = 0; iteration < 200000 && (sent.size() < backlog.size() || results.size() < sent.size());
+         iteration++) {
+        nowUs += rng() % 400;
+        HostClock::setMicros(nowUs);
+
+        // Application: new messages now and then (retried while the table is full)
+        if (sent.size() < backlog.size() && rng() % 4 == 0) {
+            size_t index = sent.size();
+            const Message& msg = backlog[index];
+            auto done = [&results, &longOpen, &openLong, index, canId = msg.canId](CanTxResult r) {
+                results.push_back(r);
+                if (longOpen[index]) {
+                    longOpen[index] = false;
+                    openLong[canId]--;
+                }
+            };
+            if (tx.send(msg.canId, msg.opcode, msg.deviceId, msg.functionId, msg.payload.data(),
+                        (uint8_t)msg.payload.size(), done) > 0) {
+                sent.push_back(msg);
+            }
+        }
+
+        tx.loop();
+
+        // Bus: a few frames, from whichever CAN ID wins arbitration
+        uint32_t onBus = rng() % 4;
+        for (uint32_t n = 0; n < onBus && queued > 0; n++) {
+            std::vector<uint32_t> ids;
+            for (auto& entry : bus) {
+                if (!entry.second.empty()) {
+                    ids.push_back(entry.first);
+                }
+            }
+            std::deque<Queued>& queue = bus[ids[rng() % ids.size()]];
+            Queued q = std::move(queue.front());
+            queue.pop_front();
+            queued--;
+
+            CanTxResult outcome = busFrames++ == failFrame ? CanTxResult::NO_ACK : CanTxResult::SENT;
+            if (outcome == CanTxResult::SENT) {
+                rx.deliver(q.frame.canId, q.frame.data, q.frame.dlc, millis());
+
+                // Which message a frame belongs to: CAN ID + group, or 0xFF for a short message
+                uint8_t group = (q.frame.data[0] & 0x80) ? (q.frame.data[0] >> 4) & 0x03 : 0xFF;
+                std::pair<uint32_t, uint8_t> owner(q.frame.canId, group);
+                if (haveLast && owner != lastOnBus) {
+                    result.switches++;
+                }
+                lastOnBus = owner;
+                haveLast = true;
+            }
+            CanTxCallback done = std::move(q.onComplete);
+            completions.push_back([done, outcome](CanTxResult) { done(outcome); });
+        }
+
+        // CanManager::loop(): completions in batches
+        size_t batch = completions.empty() ? 0 : rng() % (completions.size() + 1);
+        std::vector<CanTxCallback> ready(completions.begin(), completions.begin() + batch);
+        completions.erase(completions.begin(), completions.begin() + batch);
+        for (CanTxCallback& done : ready) {
+            done(CanTxResult::SENT);
+        }
+    }
+
+    result.messages = (uint32_t)sent.size();
+    result.frames = busFrames;
+    result.rejects = tx.getSinkRejects();
+    result.continuationErrors = rx.continuationErrors();
+    for (CanTxResult r : results) {
+        result.failed += r == CanTxResult::SENT ? 0 : 1;
+    }
+    if (results.size() < sent.size()) {
+        result.failed += (uint32_t)(sent.size() - results.size());  // Never completed
+    }
+
+    for (size_t i = 1; i < handOverUs.size(); i++) {
+        if (gapUs > 0 && handOverUs[i] - handOverUs[i - 1] < gapUs) {
+            result.gapViolations++;
+        }
+    }
+
+    std::vector<Message> expected;
+    for (const Message& msg : sent) {
+        expected.push_back(expectedOf(msg));
+    }
+    for (const Message& got : rx.delivered) {
+        if (std::find(expected.begin(), expected.end(), got) != expected.end()) {
+            result.intact++;
+        } else {
+            result.corrupt++;
+        }
+    }
+    return result;
+}
+
+static void scenarioEngine(std::mt19937& rng, uint32_t runs, uint32_t gapUs) {
+    EngineResult total;
+    uint32_t wrongRuns = 0;
+    for (uint32_t run = 0; run < runs; run++) {
+        EngineResult r = runEngine(rng, gapUs, false);
+        bool ok = r.intact == r.messages && r.failed == 0 && r.corrupt == 0 &&
+                  r.continuationErrors == 0 && r.gapViolations == 0;
+        wrongRuns += ok ? 0 : 1;
+        total.messages += r.messages;
+        total.intact += r.intact;
+        total.frames += r.frames;
+        total.switches += r.switches;
+        total.rejects += r.rejects;
+        total.continuationErrors += r.continuationErrors;
+        total.gapViolations += r.gapViolations;
+        total.maxGroupsPerId = std::max(total.maxGroupsPerId, r.maxGroupsPerId);
+    }
+    printf("engine       gap %4luus: %lu runs, %lu/%lu messages intact, %lu frames, %.0f%% message switches, "
+           "max %u groups on one ID, %lu sink rejects, contErrors:%lu gap violations:%lu\n",
+           (unsigned long)gapUs, (unsigned long)runs, (unsigned long)total.intact, (unsigned long)total.messages,
+           (unsigned long)total.frames, total.frames ? total.switches * 100.0 / total.frames : 0.0,
+           total.maxGroupsPerId, (unsigned long)total.rejects, (unsigned long)total.continuationErrors,
+           (unsigned long)total.gapViolations);
+    if (wrongRuns > 0) {
+        fail("engine", "message lost, corrupt or paced too closely");
+    }
+    if (total.maxGroupsPerId != BapTransmitter::GROUP_COUNT) {
+        fail("engine", "never had all four groups of one CAN ID in use");
+    }
+}
+
+static void scenarioFailure(std::mt19937& rng, uint32_t runs) {
+    uint32_t failed = 0;
+    uint32_t corrupt = 0;
+    uint32_t lostOthers = 0;
+    for (uint32_t run = 0; run < runs; run++) {
+        EngineResult r = runEngine(rng, 0, true);
+        failed += r.failed;
+        corrupt += r.corrupt;
+        // Only the message with the failed frame may be missing
+        lostOthers += r.intact + r.failed < r.messages ? 1 : 0;
+    }
+    printf("failure      %lu runs, %lu messages reported failed, %lu corrupt deliveries, %lu runs lost others\n",
+           (unsigned long)runs, (unsigned long)failed, (unsigned long)corrupt, (unsigned long)lostOthers);
+    if (corrupt > 0 || lostOthers > 0) {
+        fail("failure", "failed frame corrupted or lost another message");
+    }
+}
+
+int main(int argc, char** argv) {
+    uint32_t runs = argc > 1 ? (uint32_t)atoi(argv[1]) : 200;
+    uint32_t seed = argc > 2 ? (uint32_t)strtoul(argv[2], nullptr, 0) : 1;
+    std::mt19937 rng(seed);
+
+    printf("bap_loopback: %lu runs, seed %lu\n", (unsigned long)runs, (unsigned long)seed);
+    scenarioWrap(rng);
+    scenarioExhaustive(rng);
+    scenarioRandom(rng, runs * 10);
+    scenarioEngine(rng, runs, 0);
+    scenarioEngine(rng, runs, 500);
+    scenarioFailure(rng, runs);
+
+    printf("%s\n", failures ? "FAILED" : "OK");
+    return failures ? 1 : 0;
+}
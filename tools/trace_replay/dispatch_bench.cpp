@@ -0,0 +1,205 @@
+/**
+ * dispatch_bench - Host cycle counts for CAN frame and BAP subscriber dispatch
+ *
+ * Compares the ways a drained RX batch can reach its consumer, using the
+ * same cycle counter as the firmware (ESP.getCycleCount(), rdtsc here):
+ *
+ *   callback   per-frame std::function (setFrameCallback / CallbackFrameSink)
+ *   virtual    one ICanFrameSink::onCanFrames call per batch (setFrameSink)
+ *   static     one Delegate call per batch, qualified call in a stub (bindFrameSink)
+ *
+ * each against a trivial consumer (dispatch overhead only) and against the
+ * real VehicleManager (end-to-end decode), plus BAP state notification
+ * through std::function vectors vs a DelegateList.
+ *
+ * Usage:
+ *   dispatch_bench [rounds]
+ *
+ * Frames are synthetic (routed IDs, pseudo-random payloads) in batches of
+ * DECODE_BATCH, like CanManager::drainRing(). Figures are the best round.
+ */
+
+#include <Arduino.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+#include "core/Delegate.h"
+#include "modules/CanManager.h"
+#include "vehicle/VehicleManager.h"
+
+static constexpr size_t FRAME_COUNT = 4096;
+static constexpr size_t DECODE_BATCH = 32;
+
+static const uint32_t BENCH_IDS[] = {
+    0x5CA, 0x59E, 0x483, 0x66E, 0x5E1, 0x3D0, 0x3D1, 0x583, 0x3C0, 0x0FD, 0x6B2, 0x123,
+};
+
+// =============================================================================
+// Trivial consumers (dispatch overhead only)
+// =============================================================================
+
+class ChecksumSink final : public ICanFrameSink {
+public:
+    uint32_t sum = 0;
+
+    void onCanFrames(const CanRxFrame* frames, size_t count) override {
+        for (size_t i = 0; i < count; i++) {
+            sum += frames[i].canId ^ frames[i].data[0];
+        }
+    }
+
+    void onFrame(uint32_t canId, const uint8_t* data, uint8_t, bool) {
+        sum += canId ^ data[0];
+    }
+};
+
+class PlugSubscriber {
+public:
+    PlugState last;
+    uint32_t updates = 0;
+
+    void onPlugState(const PlugState& plug) {
+        last = plug;
+        updates++;
+    }
+};
+
+template<typename Sink>
+static void batchStub(void* sink, const CanRxFrame* frames, size_t count) {
+    static_cast<Sink*>(sink)->Sink::onCanFrames(frames, count);
+}
+
+using BatchDelegate = Delegate<void(const CanRxFrame*, size_t)>;
+
+// =============================================================================
+// Measurement
+// =============================================================================
+
+/**
+ * Best-of-rounds cycles per frame for delivering all frames in batches.
+ */
+template<typename Deliver>
+static double measure(const std::vector<CanRxFrame>& frames, int rounds, Deliver deliver) {
+    double best = 1e30;
+    for (int r = 0; r < rounds; r++) {
+        uint32_t start = ESP.getCycleCount();
+        for (size_t i = 0; i < frames.size(); i += DECODE_BATCH) {
+            size_t count = frames.size() - i < DECODE_BATCH ? frames.size() - i : DECODE_BATCH;
+            deliver(&frames[i], count);
+        }
+        double perFrame = (double)(uint32_t)(ESP.getCycleCount() - start) / frames.size();
+        if (perFrame < best) {
+            best = perFrame;
+        }
+    }
+    return best;
+}
+
+static void report(const char* name, double cycles, double baseline) {
+    printf("  %-10s %8.1f cycles/frame  (%.2fx)\n", name, cycles, baseline > 0 ? cycles / baseline : 0.0);
+}
+
+int main(int argc, char** argv) {
+    int rounds = argc > 1 ? atoi(argv[1]) : 200;
+    if (rounds <= 0) {
+        fprintf(stderr, "Usage: dispatch_bench [rounds]\n");
+        return 2;
+    }
+    Serial.setEnabled(false);
+
+    std::vector<CanRxFrame> frames(FRAME_COUNT);
+    uint32_t seed = 0x1234567;
+    for (size_t i = 0; i < FRAME_COUNT; i++) {
+        CanRxFrame& f = frames[i];
+        f.timestampUs = i * 250;
+        f.canId = BENCH_IDS[i % (sizeof(BENCH_IDS) / sizeof(BENCH_IDS[0]))];
+        f.dlc = 8;
+        f.extended = false;
+        for (uint8_t b = 0; b < 8; b++) {
+            seed = seed * 1103515245 + 12345;
+            f.data[b] = seed >> 24;
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    // Frame sink, trivial consumer
+    // -------------------------------------------------------------------------
+    ChecksumSink checksum;
+    CallbackFrameSink callbackSink([&checksum](uint32_t canId, const uint8_t* data, uint8_t dlc, bool ext) {
+        checksum.onFrame(canId, data, dlc, ext);
+    });
+    ICanFrameSink* virtualSink = &checksum;
+    ICanFrameSink* callbackPath = &callbackSink;
+    BatchDelegate staticSink = BatchDelegate::bindStub<&batchStub<ChecksumSink>>(&checksum);
+
+    printf("Frame sink, trivial consumer (%zu frames, batches of %zu, best of %d):\n",
+           FRAME_COUNT, DECODE_BATCH, rounds);
+    double cb = measure(frames, rounds, [&](const CanRxFrame* f, size_t n) { callbackPath->onCanFrames(f, n); });
+    double vt = measure(frames, rounds, [&](const CanRxFrame* f, size_t n) { virtualSink->onCanFrames(f, n); });
+    double st = measure(frames, rounds, [&](const CanRxFrame* f, size_t n) { staticSink(f, n); });
+    report("callback", cb, cb);
+    report("virtual", vt, cb);
+    report("static", st, cb);
+
+    // -------------------------------------------------------------------------
+    // Frame sink, real vehicle stack
+    // -------------------------------------------------------------------------
+    CanManager can;
+    VehicleManager vehicle(&can);
+    can.setup();
+    vehicle.setup();
+
+    CallbackFrameSink vehicleCallback([&vehicle](uint32_t canId, const uint8_t* data, uint8_t dlc, bool ext) {
+        vehicle.onCanFrame(canId, data, dlc, ext);
+    });
+    ICanFrameSink* vehicleVirtual = &vehicle;
+    ICanFrameSink* vehicleCallbackPath = &vehicleCallback;
+    BatchDelegate vehicleStatic = BatchDelegate::bindStub<&batchStub<VehicleManager>>(&vehicle);
+
+    printf("\nFrame sink, VehicleManager decode:\n");
+    cb = measure(frames, rounds, [&](const CanRxFrame* f, size_t n) { vehicleCallbackPath->onCanFrames(f, n); });
+    vt = measure(frames, rounds, [&](const CanRxFrame* f, size_t n) { vehicleVirtual->onCanFrames(f, n); });
+    st = measure(frames, rounds, [&](const CanRxFrame* f, size_t n) { vehicleStatic(f, n); });
+    report("callback", cb, cb);
+    report("virtual", vt, cb);
+    report("static", st, cb);
+
+    // -------------------------------------------------------------------------
+    // BAP state notification (two subscribers, as Battery/ClimateManager)
+    // -------------------------------------------------------------------------
+    PlugSubscriber subA, subB;
+    std::vector<std::function<void(const PlugState&)>> functionList;
+    functionList.push_back([&subA](const PlugState& plug) { subA.onPlugState(plug); });
+    functionList.push_back([&subB](const PlugState& plug) { subB.onPlugState(plug); });
+    DelegateList<void(const PlugState&), 4> delegateList;
+    delegateList.add(Delegate<void(const PlugState&)>::bind<PlugSubscriber, &PlugSubscriber::onPlugState>(&subA));
+    delegateList.add(Delegate<void(const PlugState&)>::bind<PlugSubscriber, &PlugSubscriber::onPlugState>(&subB));
+
+    PlugState plug;
+    printf("\nBAP plug state notify (per update, 2 subscribers):\n");
+    double fn = measure(frames, rounds, [&](const CanRxFrame* f, size_t n) {
+        for (size_t i = 0; i < n; i++) {
+            plug.plugState = f[i].data[0];
+            for (const auto& callback : functionList) {
+                if (callback) {
+                    callback(plug);
+                }
+            }
+        }
+    });
+    double dl = measure(frames, rounds, [&](const CanRxFrame* f, size_t n) {
+        for (size_t i = 0; i < n; i++) {
+            plug.plugState = f[i].data[0];
+            delegateList(plug);
+        }
+    });
+    report("function", fn, fn);
+    report("delegate", dl, fn);
+
+    // Keep the consumers observable
+    printf("\n(checksum %08x, updates %u)\n", checksum.sum, subA.updates + subB.updates);
+    return 0;
+}
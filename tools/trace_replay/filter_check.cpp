@@ -0,0 +1,383 @@
+/**
+ * filter_check - CanFilterPlanner plans checked against the IDs they were made for
+ *
+ * Runs the planner on the host and fails (exit 1) if a plan rejects an ID it
+ * was given:
+ *
+ *   real         the plan VehicleManager::applyAcceptanceFilter() installs
+ *                (ROUTED_STD_IDS, the BAP range, ROUTED_EXT_IDS); every routed
+ *                ID and sampled BAP IDs must pass. The inputs are rebuilt here
+ *                and must give the same plan, so the CPU figure is for the
+ *                real set. Reports the measured standard false-accept rate
+ *                (all 2048 IDs) next to the planner's estimate
+ *   empty        no IDs: accept all
+ *   exhaustive   random sets of 1..16 items (dual split searched exhaustively)
+ *   heuristic    random sets of 17..32 items (split seeds plus local search)
+ *   overflow     more than 32 items: accept all
+ *   pressure     a synthetic bus (routed IDs plus unrouted broadcasts, BAP and
+ *                NM traffic), and any GVRET traces given, fed through the
+ *                real plan and accept-all: frames queued to the RX ring per
+ *                second and VehicleManager decode cycles per bus second
+ *
+ * Random sets mix standard IDs with exact and masked extended ranges; each
+ * registered ID (and sampled IDs of each range) must pass acceptsId().
+ * Planner CPU is the best of several runs in cycles (ESP.getCycleCount(),
+ * rdtsc here), so only the ratio between set sizes carries over to the S3.
+ *
+ * Usage:
+ *   filter_check [runs] [seed] [trace.csv ...]
+ */
+
+#include <Arduino.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "modules/CanFilterPlanner.h"
+#include "modules/CanManager.h"
+#include "vehicle/VehicleManager.h"
+#include "vehicle/bap/channels/BatteryControlChannel.h"
+#include "vehicle/protocols/VehicleMessages.h"
+
+#include "GvretTrace.h"
+
+using CanFilterPlanner::ExtRange;
+using CanFilterPlanner::Plan;
+
+// Mirrors ROUTED_EXT_RANGES in VehicleManager.cpp (checked against the installed plan)
+static const ExtRange BAP_RANGE = { 0x17330000, 0x1FFF0000 };
+
+static constexpr size_t SET_MAX = 40;
+static constexpr int PLAN_ROUNDS = 20;
+static constexpr uint32_t BUS_SECONDS = 10;
+
+static int failures = 0;
+
+static void fail(const char* scenario, const char* what) {
+    printf("FAIL %-11s %s\n", scenario, what);
+    failures++;
+}
+
+// =============================================================================
+// Planner runs
+// =============================================================================
+
+struct IdSet {
+    std::vector<uint16_t> stdIds;
+    std::vector<ExtRange> extRanges;
+};
+
+/**
+ * Best-of-rounds planner cycles.
+ */
+static double planCycles(const IdSet& set, Plan& result) {
+    double best = 1e30;
+    for (int r = 0; r < PLAN_ROUNDS; r++) {
+        uint32_t start = ESP.getCycleCount();
+        result = CanFilterPlanner::plan(set.stdIds.data(), set.stdIds.size(),
+                                        set.extRanges.data(), set.extRanges.size());
+        double cycles = (double)(uint32_t)(ESP.getCycleCount() - start);
+        best = std::min(best, cycles);
+    }
+    return best;
+}
+
+/**
+ * Check that every registered ID passes; samples IDs inside each extended range.
+ * @return Number of rejected IDs
+ */
+static uint32_t rejectedIds(const Plan& plan, const IdSet& set, std::mt19937& rng) {
+    uint32_t rejected = 0;
+    for (uint16_t id : set.stdIds) {
+        if (!CanFilterPlanner::acceptsId(plan, id, false)) {
+            rejected++;
+        }
+    }
+    for (const ExtRange& range : set.extRanges) {
+        uint32_t mask = range.mask & 0x1FFFFFFF;
+        for (int i = 0; i < 64; i++) {
+            uint32_t id = (range.id & mask) | (rng() & ~mask & 0x1FFFFFFF);
+            if (!CanFilterPlanner::acceptsId(plan, id, true)) {
+                rejected++;
+            }
+        }
+    }
+    return rejected;
+}
+
+/**
+ * Measured share of the unregistered standard IDs that pass.
+ */
+static double measuredStdRate(const Plan& plan, const IdSet& set) {
+    uint32_t accepted = 0;
+    for (uint32_t id = 0; id < 0x800; id++) {
+        if (CanFilterPlanner::acceptsId(plan, id, false)) {
+            accepted++;
+        }
+    }
+    size_t wanted = set.stdIds.size();
+    return wanted >= 0x800 ? 0.0 : (double)(accepted - wanted) / (0x800 - wanted);
+}
+
+static IdSet randomSet(std::mt19937& rng, size_t items) {
+    IdSet set;
+    std::vector<uint16_t> pool(0x800);
+    for (size_t i = 0; i < pool.size(); i++) {
+        pool[i] = (uint16_t)i;
+    }
+    std::shuffle(pool.begin(), pool.end(), rng);
+
+    // Mostly standard IDs, like the routing table
+    for (size_t i = 0; i < items; i++) {
+        if (rng() % 8 != 0) {
+            set.stdIds.push_back(pool[set.stdIds.size()]);
+        } else if (rng() % 2) {
+            set.extRanges.push_back({ (uint32_t)rng() & 0x1FFFFFFF, 0x1FFFFFFF });
+        } else {
+            set.extRanges.push_back({ (uint32_t)rng() & 0x1FFF0000, 0x1FFF0000 });
+        }
+    }
+    return set;
+}
+
+// =============================================================================
+// Scenarios
+// =============================================================================
+
+static Plan scenarioReal(const Plan& installed, std::mt19937& rng) {
+    IdSet set;
+    for (uint16_t id : VehicleMessages::ROUTED_STD_IDS) {
+        set.stdIds.push_back(id);
+    }
+    set.extRanges.push_back(BAP_RANGE);
+    for (size_t i = 0; i < VehicleMessages::ROUTED_EXT_ID_COUNT; i++) {
+        set.extRanges.push_back({ VehicleMessages::ROUTED_EXT_IDS[i], 0x1FFFFFFF });
+    }
+
+    Plan plan;
+    double cycles = planCycles(set, plan);
+    if (plan != installed) {
+        fail("real", "rebuilt inputs differ from VehicleManager (update BAP_RANGE)");
+    }
+
+    uint32_t rejected = rejectedIds(installed, set, rng);
+    const uint32_t bapIds[] = {
+        BatteryControlChannel::CAN_ID_TX, BatteryControlChannel::CAN_ID_RX,
+    };
+    for (uint32_t id : bapIds) {
+        if (!CanFilterPlanner::acceptsId(installed, id, true)) {
+            rejected++;
+        }
+    }
+
+    printf("real         %zu std + %zu ext items: %s code=0x%08lX mask=0x%08lX, %.0f cycles\n",
+           set.stdIds.size(), set.extRanges.size(), installed.singleFilter ? "single" : "dual",
+           (unsigned long)installed.acceptanceCode, (unsigned long)installed.acceptanceMask, cycles);
+    printf("             std false accepts %.1f%% measured, %.1f%% estimated; ext %.1f%% estimated\n",
+           measuredStdRate(installed, set) * 100.0, installed.stdFalseAcceptRate * 100.0,
+           installed.extFalseAcceptRate * 100.0);
+    if (installed.acceptAll) {
+        fail("real", "routed IDs give an accept-all plan");
+    }
+    if (rejected > 0) {
+        fail("real", "routed ID rejected");
+    }
+    return installed;
+}
+
+static void scenarioEmpty() {
+    Plan plan = CanFilterPlanner::plan(nullptr, 0, nullptr, 0);
+    printf("empty        accept all: %s\n", plan.acceptAll ? "yes" : "no");
+    if (!plan.acceptAll || plan.acceptanceMask != 0xFFFFFFFF) {
+        fail("empty", "empty set does not accept all");
+    }
+}
+
+/**
+ * Random sets with item counts in [minItems, maxItems].
+ */
+static void scenarioRandom(const char* name, std::mt19937& rng, uint32_t runs,
+                           size_t minItems, size_t maxItems, bool expectAcceptAll) {
+    uint32_t rejected = 0;
+    uint32_t acceptAll = 0;
+    uint32_t dual = 0;
+    double rateSum = 0.0;
+    double cyclesSum = 0.0;
+    double cyclesMax = 0.0;
+
+    for (uint32_t run = 0; run < runs; run++) {
+        IdSet set = randomSet(rng, minItems + rng() % (maxItems - minItems + 1));
+        Plan plan;
+        double cycles = planCycles(set, plan);
+        cyclesSum += cycles;
+        cyclesMax = std::max(cyclesMax, cycles);
+
+        rejected += rejectedIds(plan, set, rng);
+        acceptAll += plan.acceptAll ? 1 : 0;
+        dual += plan.singleFilter ? 0 : 1;
+        rateSum += measuredStdRate(plan, set);
+    }
+
+    printf("%-12s %lu sets of %zu..%zu items: %lu dual, %lu accept all, std false accepts %.1f%% mean, "
+           "%.0f cycles mean / %.0f max\n",
+           name, (unsigned long)runs, minItems, maxItems, (unsigned long)dual, (unsigned long)acceptAll,
+           rateSum / runs * 100.0, cyclesSum / runs, cyclesMax);
+    if (rejected > 0) {
+        fail(name, "registered ID rejected");
+    }
+    if (expectAcceptAll && acceptAll != runs) {
+        fail(name, "oversized set planned instead of accept all");
+    }
+}
+
+// =============================================================================
+// Queue pressure
+// =============================================================================
+
+/**
+ * Synthetic powertrain bus: the routed broadcasts, as many unrouted standard
+ * broadcasts, BAP traffic and NM frames, each periodic.
+ */
+static std::vector<CanRxFrame> syntheticBus(std::mt19937& rng) {
+    struct Source {
+        uint32_t canId;
+        bool extended;
+        uint32_t periodMs;
+    };
+    static const uint32_t PERIODS_MS[] = { 10, 20, 20, 50, 100, 100, 200, 500, 1000 };
+    static constexpr size_t PERIOD_COUNT = sizeof(PERIODS_MS) / sizeof(PERIODS_MS[0]);
+
+    std::vector<Source> sources;
+    std::vector<bool> used(0x800, false);
+    for (uint16_t id : VehicleMessages::ROUTED_STD_IDS) {
+        sources.push_back({ id, false, PERIODS_MS[rng() % PERIOD_COUNT] });
+        used[id] = true;
+    }
+    size_t unrouted = sources.size();
+    while (sources.size() < unrouted * 2) {
+        uint16_t id = rng() & 0x7FF;
+        if (!used[id]) {
+            sources.push_back({ id, false, PERIODS_MS[rng() % PERIOD_COUNT] });
+            used[id] = true;
+        }
+    }
+    for (size_t i = 0; i < VehicleMessages::ROUTED_EXT_ID_COUNT; i++) {
+        sources.push_back({ VehicleMessages::ROUTED_EXT_IDS[i], true, 1000 });
+    }
+    sources.push_back({ BatteryControlChannel::CAN_ID_RX, true, 100 });
+    sources.push_back({ 0x17330D10, true, 200 });                   // Doors BAP
+    for (uint32_t node = 0; node < 8; node++) {
+        sources.push_back({ 0x1B000000 | (0x40 + node), true, 200 });  // NM
+    }
+
+    std::vector<CanRxFrame> frames;
+    for (const Source& s : sources) {
+        uint32_t offsetUs = rng() % (s.periodMs * 1000);
+        for (uint32_t t = offsetUs; t < BUS_SECONDS * 1000000; t += s.periodMs * 1000) {
+            CanRxFrame f = {};
+            f.timestampUs = t;
+            f.canId = s.canId;
+            f.extended = s.extended;
+            f.dlc = 8;
+            for (uint8_t& b : f.data) {
+                b = (uint8_t)rng();
+            }
+            frames.push_back(f);
+        }
+    }
+    std::sort(frames.begin(), frames.end(), [](const CanRxFrame& a, const CanRxFrame& b) {
+        return a.timestampUs < b.timestampUs;
+    });
+    return frames;
+}
+
+/**
+ * Decode cycles for the frames passing the plan, in RX batches.
+ */
+static double decodeCycles(const std::vector<CanRxFrame>& frames, const Plan& plan, size_t& queued) {
+    std::vector<CanRxFrame> accepted;
+    for (const CanRxFrame& f : frames) {
+        if (CanFilterPlanner::acceptsId(plan, f.canId, f.extended)) {
+            accepted.push_back(f);
+        }
+    }
+    queued = accepted.size();
+
+    CanManager can;
+    VehicleManager vehicle(&can);
+    can.setup();
+    vehicle.setup();
+
+    uint64_t cycles = 0;
+    for (size_t i = 0; i < accepted.size(); i += CanManager::DECODE_BATCH_MAX) {
+        size_t count = std::min<size_t>(accepted.size() - i, CanManager::DECODE_BATCH_MAX);
+        HostClock::setMicros(accepted[i + count - 1].timestampUs);
+        uint32_t start = ESP.getCycleCount();
+        vehicle.onCanFrames(&accepted[i], count);
+        cycles += (uint32_t)(ESP.getCycleCount() - start);
+    }
+    return (double)cycles;
+}
+
+static void reportPressure(const char* name, const std::vector<CanRxFrame>& frames, const Plan& plan) {
+    if (frames.empty()) {
+        printf("pressure     %s: no frames\n", name);
+        return;
+    }
+    double seconds = std::max(1e-3, frames.back().timestampUs / 1e6);
+    size_t queuedAll = 0;
+    size_t queuedPlan = 0;
+    double cyclesAll = decodeCycles(frames, Plan(), queuedAll);
+    double cyclesPlan = decodeCycles(frames, plan, queuedPlan);
+
+    printf("pressure     %s (%zu frames, %.1f s)\n", name, frames.size(), seconds);
+    printf("               accept all  %7.0f frames/s queued, %9.0f decode cycles/s\n",
+           queuedAll / seconds, cyclesAll / seconds);
+    printf("               plan        %7.0f frames/s queued, %9.0f decode cycles/s (%.0f%% of frames, %.0f%% of cycles)\n",
+           queuedPlan / seconds, cyclesPlan / seconds,
+           queuedAll ? 100.0 * queuedPlan / queuedAll : 0.0, cyclesAll > 0 ? 100.0 * cyclesPlan / cyclesAll : 0.0);
+}
+
+int main(int argc, char** argv) {
+    uint32_t runs = argc > 1 ? (uint32_t)atoi(argv[1]) : 200;
+    uint32_t seed = argc > 2 ? (uint32_t)strtoul(argv[2], nullptr, 0) : 1;
+    if (runs == 0) {
+        fprintf(stderr, "Usage: filter_check [runs] [seed] [trace.csv ...]\n");
+        return 2;
+    }
+    std::mt19937 rng(seed);
+    Serial.setEnabled(false);
+
+    // The plan the firmware installs
+    CanManager can;
+    VehicleManager vehicle(&can);
+    can.setup();
+    vehicle.setup();
+
+    printf("filter_check: %lu runs, seed %lu\n", (unsigned long)runs, (unsigned long)seed);
+    Plan real = scenarioReal(can.getFilterPlan(), rng);
+    scenarioEmpty();
+    scenarioRandom("exhaustive", rng, runs, 1, CanFilterPlanner::EXHAUSTIVE_LIMIT, false);
+    scenarioRandom("heuristic", rng, runs, CanFilterPlanner::EXHAUSTIVE_LIMIT + 1, 32, false);
+    scenarioRandom("overflow", rng, runs / 10 + 1, 33, SET_MAX, true);
+
+    reportPressure("synthetic bus", syntheticBus(rng), real);
+    for (int i = 3; i < argc; i++) {
+        std::vector<GvretTrace::Frame> trace;
+        size_t skippedRows = 0;
+        if (!GvretTrace::load(argv[i], trace, skippedRows)) {
+            return 2;
+        }
+        std::vector<CanRxFrame> frames;
+        for (const GvretTrace::Frame& tf : trace) {
+            frames.push_back(tf.frame);
+        }
+        reportPressure(argv[i], frames, real);
+    }
+
+    printf("%s\n", failures ? "FAILED" : "OK");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,229 @@
+/**
+ * recorder_check - CanFlightRecorder trigger window checked on the host
+ *
+ * Feeds the recorder like CanManager::drainRing() does and decodes the
+ * frozen capture export (CaptureHeader, blocks of LEB128-delta records):
+ *
+ *   queued       trigger() fires while frames received before it are still
+ *                in the RX ring; they must be recorded as pre-trigger
+ *                traffic, and the capture must only freeze once a frame
+ *                postTriggerMs after the trigger arrives
+ *   silent       no frames after the trigger: poll() freezes on time
+ *   wrap         as queued, with micros() wrapping around inside the window
+ *
+ * Each capture must cover the whole pre-trigger window held in the ring
+ * and the post-trigger window, with every recorded frame decoded in order,
+ * and carry the acceptance filter CanManager reported. Any violation fails
+ * the run (exit 1).
+ *
+ * Usage:
+ *   recorder_check [capture.bin]     also write the queued capture (for
+ *                                    flight_recorder_to_gvret.py)
+ */
+
+#include <Arduino.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "modules/CanFlightRecorder.h"
+
+using Trigger = CanFlightRecorder::Trigger;
+using State = CanFlightRecorder::State;
+
+static constexpr size_t BUFFER_BYTES = 64 * 1024;
+static constexpr uint32_t FRAME_PERIOD_US = 1000;
+static constexpr uint32_t PRE_MS = 200;
+static constexpr uint32_t POST_MS = 100;
+static constexpr uint32_t BATCH = 32;
+
+// Dual filter as CanManager would report it after installing a plan
+static constexpr uint32_t FILTER_CODE = 0x10008040;
+static constexpr uint32_t FILTER_MASK = 0xEFBF7FBF;
+
+static int failures = 0;
+
+static void fail(const char* scenario, const char* what) {
+    printf("FAIL %-11s %s\n", scenario, what);
+    failures++;
+}
+
+static CanRxFrame frameAt(uint32_t timestampUs, uint32_t seq) {
+    CanRxFrame f = {};
+    f.timestampUs = timestampUs;
+    f.canId = 0x100 + (seq & 0xFF);
+    f.dlc = 8;
+    memcpy(f.data, &seq, sizeof(seq));
+    return f;
+}
+
+/**
+ * Capture export decoded back to timestamps (in record order).
+ */
+struct Capture {
+    CanFlightRecorder::CaptureHeader header = {};
+    std::vector<uint32_t> timestamps;
+    std::vector<uint8_t> data;
+    bool valid = false;
+};
+
+static Capture readCapture(const CanFlightRecorder& recorder) {
+    Capture capture;
+    std::vector<uint8_t>& data = capture.data;
+    data.resize(recorder.getCaptureSize());
+    if (data.size() < sizeof(capture.header) ||
+        recorder.readCapture(0, data.data(), data.size()) != data.size()) {
+        return capture;
+    }
+    memcpy(&capture.header, data.data(), sizeof(capture.header));
+
+    size_t pos = sizeof(capture.header);
+    for (uint16_t b = 0; b < capture.header.blockCount; b++) {
+        CanFlightRecorder::BlockHeader block;
+        if (pos + sizeof(block) > data.size()) {
+            return capture;
+        }
+        memcpy(&block, &data[pos], sizeof(block));
+        pos += sizeof(block);
+        size_t end = pos + block.usedBytes;
+        uint32_t ts = block.firstTimestampUs;
+        for (uint16_t r = 0; r < block.recordCount && pos < end; r++) {
+            uint8_t flags = data[pos++];
+            uint32_t delta = 0;
+            for (int shift = 0; pos < end; shift += 7) {
+                uint8_t byte = data[pos++];
+                delta |= (uint32_t)(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) break;
+            }
+            ts += delta;
+            pos += (flags & 0x80) ? 4 : 2;
+            pos += flags & 0x0F;
+            capture.timestamps.push_back(ts);
+        }
+        if (pos != end) {
+            return capture;
+        }
+    }
+    capture.valid = pos == data.size();
+    return capture;
+}
+
+/**
+ * Record frames every FRAME_PERIOD_US from startUs, fire a trigger at
+ * triggerUs with `queued` frames older than the trigger still waiting, then
+ * feed (or not) the post-trigger traffic.
+ */
+static void runScenario(const char* name, uint32_t startUs, uint32_t queued, bool silent,
+                        const char* outPath = nullptr) {
+    CanFlightRecorder recorder;
+    recorder.setWindow(PRE_MS, POST_MS);
+    recorder.setAcceptanceFilter(FILTER_CODE, FILTER_MASK, false);
+    if (!recorder.begin(BUFFER_BYTES)) {
+        fail(name, "no buffer");
+        return;
+    }
+
+    // Frames received up to the trigger; the last `queued` stay in the ring
+    uint32_t preFrames = (PRE_MS * 2 * 1000) / FRAME_PERIOD_US;
+    std::vector<CanRxFrame> ring;
+    uint32_t seq = 0;
+    uint32_t ts = startUs;
+    for (; seq < preFrames; seq++, ts += FRAME_PERIOD_US) {
+        ring.push_back(frameAt(ts, seq));
+    }
+    size_t drained = ring.size() - queued;
+    for (size_t i = 0; i < drained; i += BATCH) {
+        recorder.record(&ring[i], std::min<size_t>(BATCH, drained - i));
+    }
+
+    // Main loop fires the trigger later than the queued frames were received
+    uint32_t triggerUs = ts + 5000;
+    HostClock::setMicros(triggerUs);
+    recorder.trigger(Trigger::MANUAL);
+
+    recorder.record(&ring[drained], queued);
+    recorder.poll();
+    if (recorder.getState() != State::TRIGGERED) {
+        fail(name, "frozen by frames queued before the trigger");
+        return;
+    }
+
+    uint32_t postEndUs = triggerUs + POST_MS * 1000;
+    if (silent) {
+        HostClock::setMicros(postEndUs - 1000);
+        recorder.poll();
+        if (recorder.getState() != State::TRIGGERED) {
+            fail(name, "frozen before the post-trigger window ended");
+            return;
+        }
+        HostClock::setMicros(postEndUs);
+        recorder.poll();
+    } else {
+        std::vector<CanRxFrame> post;
+        for (ts = triggerUs; (int32_t)(ts - postEndUs) < 10000; ts += FRAME_PERIOD_US, seq++) {
+            post.push_back(frameAt(ts, seq));
+        }
+        for (size_t i = 0; i < post.size() && recorder.getState() == State::TRIGGERED; i += BATCH) {
+            HostClock::setMicros(post[i].timestampUs);
+            recorder.record(&post[i], std::min<size_t>(BATCH, post.size() - i));
+        }
+    }
+    if (recorder.getState() != State::FROZEN) {
+        fail(name, "not frozen after the post-trigger window");
+        return;
+    }
+
+    Capture capture = readCapture(recorder);
+    if (!capture.valid || capture.timestamps.size() != capture.header.recordCount) {
+        fail(name, "capture export does not decode");
+        return;
+    }
+    int32_t firstMs = (int32_t)(capture.timestamps.front() - triggerUs) / 1000;
+    int32_t lastMs = (int32_t)(capture.timestamps.back() - triggerUs) / 1000;
+    printf("%-12s %lu records, %ld..%+ld ms around the trigger, %u blocks\n",
+           name, (unsigned long)capture.header.recordCount, (long)firstMs, (long)lastMs,
+           (unsigned)capture.header.blockCount);
+
+    for (size_t i = 1; i < capture.timestamps.size(); i++) {
+        if ((int32_t)(capture.timestamps[i] - capture.timestamps[i - 1]) <= 0) {
+            fail(name, "records out of order");
+            break;
+        }
+    }
+    if (firstMs > -(int32_t)PRE_MS) {
+        fail(name, "pre-trigger window missing");
+    }
+    // The frame that ends the window is not part of it
+    uint32_t expectedLastUs = silent ? ring.back().timestampUs : postEndUs - FRAME_PERIOD_US;
+    if (capture.timestamps.back() != expectedLastUs) {
+        fail(name, "post-trigger window not captured");
+    }
+    if (capture.header.version != CanFlightRecorder::FORMAT_VERSION ||
+        capture.header.acceptanceCode != FILTER_CODE || capture.header.acceptanceMask != FILTER_MASK ||
+        capture.header.singleFilter != 0) {
+        fail(name, "acceptance filter missing from the capture header");
+    }
+
+    if (outPath) {
+        FILE* out = fopen(outPath, "wb");
+        if (!out || fwrite(capture.data.data(), 1, capture.data.size(), out) != capture.data.size()) {
+            fail(name, "cannot write the capture");
+        }
+        if (out) {
+            fclose(out);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    Serial.setEnabled(false);
+    printf("recorder_check: window -%lums/+%lums\n", (unsigned long)PRE_MS, (unsigned long)POST_MS);
+    runScenario("queued", 1000000, 20, false, argc > 1 ? argv[1] : nullptr);
+    runScenario("silent", 1000000, 20, true);
+    runScenario("wrap", 0xFFFFFFFFu - PRE_MS * 2 * 1000, 20, false);
+
+    printf("%s\n", failures ? "FAILED" : "OK");
+    return failures ? 1 : 0;
+}
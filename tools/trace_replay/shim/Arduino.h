@@ -0,0 +1,91 @@
+#pragma once
+
+/**
+ * Host shim for the Arduino core (trace replay only).
+ *
+ * millis()/micros() run on the replay clock (trace time), not wall time,
+ * so domain timestamps and timeouts behave as they did in the car.
+ * Serial output is discarded unless verbose logging is enabled.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <string>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_err.h"
+
+#define IRAM_ATTR
+#define RTC_DATA_ATTR
+#define RTC_NOINIT_ATTR
+
+using std::min;
+using std::max;
+
+template<class T, class L, class H>
+T constrain(T x, L low, H high) { return x < low ? low : (x > high ? high : x); }
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+
+// =============================================================================
+// Replay clock (driven by the replay tool)
+// =============================================================================
+
+namespace HostClock {
+    /**
+     * Set the current time in microseconds since the start of the trace.
+     */
+    void setMicros(uint64_t us);
+    uint64_t getMicros();
+}
+
+// =============================================================================
+// Serial
+// =============================================================================
+
+class HostSerial {
+public:
+    void begin(unsigned long) {}
+    void flush() {}
+    void print(const char* s);
+    void println(const char* s = "");
+    void printf(const char* format, ...);
+
+    void setEnabled(bool enable) { enabled = enable; }
+
+private:
+    bool enabled = false;
+};
+
+extern HostSerial Serial;
+
+// =============================================================================
+// ESP (cycle counter only)
+// =============================================================================
+
+class EspClass {
+public:
+    /**
+     * Host cycle counter (TSC on x86, nanoseconds elsewhere), truncated
+     * to 32 bits like CCOUNT on the ESP32.
+     */
+    uint32_t getCycleCount();
+};
+
+extern EspClass ESP;
+
+class String : public std::string {
+public:
+    using std::string::string;
+    String() = default;
+    String(const std::string& s) : std::string(s) {}
+    explicit String(int value) : std::string(std::to_string(value)) {}
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+/**
+ * Minimal ArduinoJson stand-in (trace replay only).
+ *
+ * The replay never serializes anything; this only has to be enough for
+ * the command/telemetry headers pulled in by the vehicle sources and for
+ * CanIdProfiler::toJson() to compile. All writes are discarded.
+ */
+
+#include <cstddef>
+
+class JsonVariant {
+public:
+    template<class T> JsonVariant& operator=(const T&) { return *this; }
+    JsonVariant operator[](const char*) const { return {}; }
+    JsonVariant operator[](size_t) const { return {}; }
+    template<class T> T to() const { return T(); }
+    template<class T> T as() const { return T(); }
+    template<class T> bool is() const { return false; }
+    template<class T> T operator|(T fallback) const { return fallback; }
+    const char* operator|(const char* fallback) const { return fallback; }
+    bool isNull() const { return true; }
+    size_t size() const { return 0; }
+    template<class T> bool add(const T&) { return true; }
+    template<class T> T add() { return T(); }
+};
+
+class JsonObject : public JsonVariant {};
+
+class JsonArray : public JsonVariant {
+public:
+    JsonVariant* begin() const { return nullptr; }
+    JsonVariant* end() const { return nullptr; }
+};
+
+class JsonDocument : public JsonVariant {
+public:
+    void clear() {}
+};
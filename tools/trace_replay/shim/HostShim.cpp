@@ -0,0 +1,138 @@
+#include <Arduino.h>
+#include <driver/twai.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <mutex>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// =============================================================================
+// Replay clock
+// =============================================================================
+
+static std::atomic<uint64_t> clockUs{0};
+
+void HostClock::setMicros(uint64_t us) { clockUs.store(us, std::memory_order_relaxed); }
+uint64_t HostClock::getMicros() { return clockUs.load(std::memory_order_relaxed); }
+
+unsigned long millis() { return (unsigned long)(uint32_t)(HostClock::getMicros() / 1000); }
+unsigned long micros() { return (unsigned long)(uint32_t)HostClock::getMicros(); }
+
+void delay(unsigned long) {
+    // Code under test must not block the replay on wall time
+}
+
+// =============================================================================
+// Serial
+// =============================================================================
+
+HostSerial Serial;
+
+void HostSerial::print(const char* s) {
+    if (enabled) fputs(s, stderr);
+}
+
+void HostSerial::println(const char* s) {
+    if (enabled) fprintf(stderr, "%s\n", s);
+}
+
+void HostSerial::printf(const char* format, ...) {
+    if (!enabled) return;
+    va_list args;
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+}
+
+// =============================================================================
+// ESP
+// =============================================================================
+
+EspClass ESP;
+
+uint32_t EspClass::getCycleCount() {
+#if defined(__x86_64__) || defined(__i386__)
+    return (uint32_t)__rdtsc();
+#else
+    return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// =============================================================================
+// FreeRTOS
+// =============================================================================
+
+struct HostSemaphore {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool available;
+};
+
+SemaphoreHandle_t xSemaphoreCreateMutex() { return new HostSemaphore{{}, {}, true}; }
+SemaphoreHandle_t xSemaphoreCreateBinary() { return new HostSemaphore{{}, {}, false}; }
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks) {
+    std::unique_lock<std::mutex> lock(sem->mutex);
+    if (ticks == portMAX_DELAY) {
+        sem->cv.wait(lock, [sem] { return sem->available; });
+    } else if (!sem->cv.wait_for(lock, std::chrono::milliseconds(ticks), [sem] { return sem->available; })) {
+        return pdFALSE;
+    }
+    sem->available = false;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem) {
+    {
+        std::lock_guard<std::mutex> lock(sem->mutex);
+        sem->available = true;
+    }
+    sem->cv.notify_one();
+    return pdTRUE;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t sem) { delete sem; }
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t, const char*, uint32_t, void*,
+                                   UBaseType_t, TaskHandle_t* handle, BaseType_t) {
+    if (handle) *handle = nullptr;
+    return pdFAIL;
+}
+
+void vTaskDelete(TaskHandle_t) {}
+void vTaskDelay(TickType_t ticks) { std::this_thread::sleep_for(std::chrono::milliseconds(ticks)); }
+uint32_t ulTaskNotifyTake(BaseType_t, TickType_t) { return 0; }
+BaseType_t xTaskNotifyGive(TaskHandle_t) { return pdPASS; }
+eTaskState eTaskGetState(TaskHandle_t) { return eDeleted; }
+BaseType_t xPortGetCoreID() { return 0; }
+
+// =============================================================================
+// TWAI (no controller)
+// =============================================================================
+
+esp_err_t twai_driver_install(const twai_general_config_t*, const twai_timing_config_t*,
+                              const twai_filter_config_t*) { return ESP_ERR_INVALID_STATE; }
+esp_err_t twai_driver_uninstall() { return ESP_ERR_INVALID_STATE; }
+esp_err_t twai_start() { return ESP_ERR_INVALID_STATE; }
+esp_err_t twai_stop() { return ESP_ERR_INVALID_STATE; }
+esp_err_t twai_transmit(const twai_message_t*, TickType_t) { return ESP_OK; }
+esp_err_t twai_receive(twai_message_t*, TickType_t) { return ESP_ERR_TIMEOUT; }
+esp_err_t twai_initiate_recovery() { return ESP_ERR_INVALID_STATE; }
+
+esp_err_t twai_read_alerts(uint32_t* alerts, TickType_t) {
+    *alerts = 0;
+    return ESP_ERR_TIMEOUT;
+}
+
+esp_err_t twai_get_status_info(twai_status_info_t* status) {
+    *status = twai_status_info_t{};
+    status->state = TWAI_STATE_STOPPED;
+    return ESP_OK;
+}
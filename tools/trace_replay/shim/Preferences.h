@@ -0,0 +1,60 @@
+#pragma once
+
+/**
+ * Preferences (NVS) shim (trace replay only).
+ *
+ * Values live in process memory, keyed by namespace and key, so a replay
+ * starts with empty NVS every run.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string>
+
+class Preferences {
+public:
+    bool begin(const char* name, bool readOnly = false) {
+        (void)readOnly;
+        space = name;
+        return true;
+    }
+    void end() {}
+
+    uint8_t getUChar(const char* key, uint8_t defaultValue = 0) {
+        auto it = store().find(space + "/" + key);
+        return it == store().end() || it->second.empty() ? defaultValue : (uint8_t)it->second[0];
+    }
+    size_t putUChar(const char* key, uint8_t value) {
+        store()[space + "/" + key] = std::string(1, (char)value);
+        return 1;
+    }
+    size_t getBytesLength(const char* key) {
+        auto it = store().find(space + "/" + key);
+        return it == store().end() ? 0 : it->second.size();
+    }
+    size_t getBytes(const char* key, void* buf, size_t maxLen) {
+        auto it = store().find(space + "/" + key);
+        if (it == store().end() || it->second.size() > maxLen) {
+            return 0;
+        }
+        memcpy(buf, it->second.data(), it->second.size());
+        return it->second.size();
+    }
+    size_t putBytes(const char* key, const void* value, size_t len) {
+        store()[space + "/" + key] = std::string((const char*)value, len);
+        return len;
+    }
+    bool remove(const char* key) {
+        return store().erase(space + "/" + key) > 0;
+    }
+
+private:
+    std::string space;
+
+    static std::map<std::string, std::string>& store() {
+        static std::map<std::string, std::string> values;
+        return values;
+    }
+};
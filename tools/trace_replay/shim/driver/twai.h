@@ -0,0 +1,112 @@
+#pragma once
+
+/**
+ * TWAI driver shim (trace replay only).
+ *
+ * There is no controller on the host: install/start fail with
+ * ESP_ERR_INVALID_STATE and transmit reports success without sending,
+ * so wake/keep-alive paths in loop() run without side effects.
+ */
+
+#include <cstdint>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+
+typedef int gpio_num_t;
+#define GPIO_NUM_21 21
+#define GPIO_NUM_47 47
+
+typedef enum {
+    TWAI_MODE_NORMAL,
+    TWAI_MODE_NO_ACK,
+    TWAI_MODE_LISTEN_ONLY,
+} twai_mode_t;
+
+typedef enum {
+    TWAI_STATE_STOPPED,
+    TWAI_STATE_RUNNING,
+    TWAI_STATE_BUS_OFF,
+    TWAI_STATE_RECOVERING,
+} twai_state_t;
+
+typedef struct {
+    union {
+        struct {
+            uint32_t extd: 1;
+            uint32_t rtr: 1;
+            uint32_t ss: 1;
+            uint32_t self: 1;
+            uint32_t dlc_non_comp: 1;
+            uint32_t reserved: 27;
+        };
+        uint32_t flags;
+    };
+    uint32_t identifier;
+    uint8_t data_length_code;
+    uint8_t data[8];
+} twai_message_t;
+
+typedef struct {
+    uint32_t brp;
+    uint8_t tseg_1;
+    uint8_t tseg_2;
+    uint8_t sjw;
+    bool triple_sampling;
+} twai_timing_config_t;
+
+typedef struct {
+    uint32_t acceptance_code;
+    uint32_t acceptance_mask;
+    bool single_filter;
+} twai_filter_config_t;
+
+typedef struct {
+    twai_mode_t mode;
+    gpio_num_t tx_io;
+    gpio_num_t rx_io;
+    int clkout_io;
+    int bus_off_io;
+    uint32_t tx_queue_len;
+    uint32_t rx_queue_len;
+    uint32_t alerts_enabled;
+    uint32_t clkout_divider;
+    int intr_flags;
+} twai_general_config_t;
+
+typedef struct {
+    twai_state_t state;
+    uint32_t msgs_to_tx;
+    uint32_t msgs_to_rx;
+    uint32_t tx_error_counter;
+    uint32_t rx_error_counter;
+    uint32_t tx_failed_count;
+    uint32_t rx_missed_count;
+    uint32_t rx_overrun_count;
+    uint32_t arb_lost_count;
+    uint32_t bus_error_count;
+} twai_status_info_t;
+
+#define TWAI_TIMING_CONFIG_100KBITS()   {20, 15, 4, 3, false}
+#define TWAI_TIMING_CONFIG_125KBITS()   {16, 15, 4, 3, false}
+#define TWAI_TIMING_CONFIG_250KBITS()   {8, 15, 4, 3, false}
+#define TWAI_TIMING_CONFIG_500KBITS()   {4, 15, 4, 3, false}
+#define TWAI_TIMING_CONFIG_1MBITS()     {2, 15, 4, 3, false}
+#define TWAI_FILTER_CONFIG_ACCEPT_ALL() {0, 0xFFFFFFFF, true}
+#define TWAI_GENERAL_CONFIG_DEFAULT(tx, rx, op_mode) \
+    {op_mode, tx, rx, -1, -1, 5, 5, 0, 0, 0}
+
+#define TWAI_ALERT_TX_IDLE      0x00000001
+#define TWAI_ALERT_TX_SUCCESS   0x00000002
+#define TWAI_ALERT_TX_FAILED    0x00040000
+#define TWAI_ALERT_BUS_OFF      0x00001000
+
+esp_err_t twai_driver_install(const twai_general_config_t*, const twai_timing_config_t*,
+                              const twai_filter_config_t*);
+esp_err_t twai_driver_uninstall();
+esp_err_t twai_start();
+esp_err_t twai_stop();
+esp_err_t twai_transmit(const twai_message_t* message, TickType_t ticks);
+esp_err_t twai_receive(twai_message_t* message, TickType_t ticks);
+esp_err_t twai_get_status_info(twai_status_info_t* status);
+esp_err_t twai_initiate_recovery();
+esp_err_t twai_read_alerts(uint32_t* alerts, TickType_t ticks);
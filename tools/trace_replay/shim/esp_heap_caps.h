@@ -0,0 +1,10 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+
+#define MALLOC_CAP_8BIT     (1 << 2)
+#define MALLOC_CAP_SPIRAM   (1 << 10)
+
+inline void* heap_caps_malloc(size_t size, unsigned) { return malloc(size); }
+inline void heap_caps_free(void* ptr) { free(ptr); }
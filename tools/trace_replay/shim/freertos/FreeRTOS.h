@@ -0,0 +1,19 @@
+#pragma once
+
+/**
+ * FreeRTOS shim (trace replay only). Ticks are milliseconds.
+ */
+
+#include <cstdint>
+
+typedef int BaseType_t;
+typedef unsigned UBaseType_t;
+typedef uint32_t TickType_t;
+typedef void* TaskHandle_t;
+
+#define pdTRUE          1
+#define pdFALSE         0
+#define pdPASS          pdTRUE
+#define pdFAIL          pdFALSE
+#define portMAX_DELAY   0xFFFFFFFFUL
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
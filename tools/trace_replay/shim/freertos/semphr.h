@@ -0,0 +1,17 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+/**
+ * Mutex and binary semaphore shim backed by std::mutex/condition_variable.
+ * VehicleManager's stateMutex is contended between the replay's decode
+ * thread and its loop() calls, like Core 0 vs Core 1 on the device.
+ */
+
+typedef struct HostSemaphore* SemaphoreHandle_t;
+
+SemaphoreHandle_t xSemaphoreCreateMutex();
+SemaphoreHandle_t xSemaphoreCreateBinary();
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem);
+void vSemaphoreDelete(SemaphoreHandle_t sem);
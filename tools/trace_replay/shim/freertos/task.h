@@ -0,0 +1,22 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+/**
+ * Tasks are not created on the host: the replay tool drives the RX ring
+ * and decode path from its own threads, so CanManager::start() fails
+ * cleanly and the notify calls are no-ops.
+ */
+
+typedef void (*TaskFunction_t)(void*);
+
+typedef enum { eRunning, eReady, eBlocked, eSuspended, eDeleted } eTaskState;
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t, const char*, uint32_t, void*,
+                                   UBaseType_t, TaskHandle_t*, BaseType_t);
+void vTaskDelete(TaskHandle_t task);
+void vTaskDelay(TickType_t ticks);
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks);
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+eTaskState eTaskGetState(TaskHandle_t task);
+BaseType_t xPortGetCoreID();
@@ -0,0 +1,204 @@
+/**
+ * signal_bench - Check and time BroadcastDecoder's signal extraction kernels
+ *
+ * 1. Equivalence: the word-at-a-time extractSignalLE/extractSignalBE must
+ *    return exactly what the original bit-by-bit loops (kept below as the
+ *    reference) return, for every start bit (0-63) and length (1-32) over a
+ *    set of payload patterns. Any mismatch fails the run (exit code 1).
+ *
+ * 2. Timing: ns/signal for both versions over the decoders' own signal set.
+ *
+ * Usage:
+ *   signal_bench [iterations]
+ */
+
+#include <Arduino.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "vehicle/protocols/BroadcastDecoder.h"
+
+using Clock = std::chrono::steady_clock;
+
+// =============================================================================
+// Reference (original bit-by-bit implementations)
+// =============================================================================
+
+static uint32_t referenceLE(const uint8_t* data, uint8_t startBit, uint8_t length) {
+    uint32_t result = 0;
+    for (uint8_t i = 0; i < length; i++) {
+        uint8_t bitPos = startBit + i;
+        uint8_t byteIdx = bitPos / 8;
+        uint8_t bitIdx = bitPos % 8;
+        if (byteIdx < 8) {
+            if (data[byteIdx] & (1 << bitIdx)) {
+                result |= (1UL << i);
+            }
+        }
+    }
+    return result;
+}
+
+static uint32_t referenceBE(const uint8_t* data, uint8_t startBit, uint8_t length) {
+    uint32_t result = 0;
+    uint8_t byteIdx = startBit / 8;
+    uint8_t bitIdx = startBit % 8;
+    for (uint8_t i = 0; i < length; i++) {
+        if (byteIdx < 8) {
+            if (data[byteIdx] & (1 << bitIdx)) {
+                result |= (1UL << (length - 1 - i));
+            }
+        }
+        if (bitIdx == 0) {
+            bitIdx = 7;
+            byteIdx++;
+        } else {
+            bitIdx--;
+        }
+    }
+    return result;
+}
+
+// =============================================================================
+// Equivalence check
+// =============================================================================
+
+static std::vector<std::vector<uint8_t>> payloadPatterns() {
+    std::vector<std::vector<uint8_t>> patterns;
+    patterns.push_back(std::vector<uint8_t>(8, 0x00));
+    patterns.push_back(std::vector<uint8_t>(8, 0xFF));
+    patterns.push_back(std::vector<uint8_t>(8, 0xAA));
+    patterns.push_back(std::vector<uint8_t>(8, 0x55));
+    patterns.push_back({0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF});
+
+    // Single bits and single holes (catch off-by-one shifts)
+    for (int bit = 0; bit < 64; bit++) {
+        std::vector<uint8_t> one(8, 0x00), hole(8, 0xFF);
+        one[bit / 8] |= 1 << (bit % 8);
+        hole[bit / 8] &= ~(1 << (bit % 8));
+        patterns.push_back(one);
+        patterns.push_back(hole);
+    }
+
+    uint32_t seed = 0xC0FFEE;
+    for (int n = 0; n < 256; n++) {
+        std::vector<uint8_t> random(8);
+        for (uint8_t& b : random) {
+            seed = seed * 1103515245 + 12345;
+            b = seed >> 24;
+        }
+        patterns.push_back(random);
+    }
+    return patterns;
+}
+
+static bool checkEquivalence() {
+    size_t checks = 0;
+    size_t mismatches = 0;
+    for (const auto& payload : payloadPatterns()) {
+        const uint8_t* data = payload.data();
+        for (uint8_t start = 0; start < 64; start++) {
+            for (uint8_t length = 1; length <= 32; length++) {
+                uint32_t le = BroadcastDecoder::extractSignalLE(data, start, length);
+                uint32_t be = BroadcastDecoder::extractSignalBE(data, start, length);
+                uint32_t refLe = referenceLE(data, start, length);
+                uint32_t refBe = referenceBE(data, start, length);
+                checks += 2;
+                if (le != refLe || be != refBe) {
+                    if (mismatches++ < 10) {
+                        printf("MISMATCH start=%u len=%u data=%02X%02X%02X%02X%02X%02X%02X%02X "
+                               "LE %08X/%08X BE %08X/%08X\n",
+                               start, length, data[0], data[1], data[2], data[3], data[4], data[5],
+                               data[6], data[7], le, refLe, be, refBe);
+                    }
+                }
+                if (BroadcastDecoder::extractSignalLE(BroadcastDecoder::loadFrameLE(data), start, length) != refLe ||
+                    BroadcastDecoder::extractBit(BroadcastDecoder::loadFrameLE(data), start) !=
+                        BroadcastDecoder::extractBit(data, start)) {
+                    if (mismatches++ < 10) {
+                        printf("MISMATCH (word API) start=%u len=%u\n", start, length);
+                    }
+                }
+            }
+        }
+    }
+    printf("Equivalence: %zu checks (start 0-63, length 1-32, %zu payloads), %zu mismatches\n",
+           checks, payloadPatterns().size(), mismatches);
+    return mismatches == 0;
+}
+
+// =============================================================================
+// Timing
+// =============================================================================
+
+struct Signal {
+    uint8_t startBit;
+    uint8_t length;
+};
+
+// The signals decoded from the routed broadcast frames (BroadcastDecoder.h)
+static const Signal SIGNALS[] = {
+    {12, 11}, {32, 11}, {30, 2},                                    // BMS_07
+    {16, 8},                                                        // BMS_06
+    {32, 16},                                                       // ESP_21
+    {8, 20}, {28, 7}, {35, 4}, {39, 5}, {44, 5}, {49, 6}, {55, 6},  // Diagnose_01
+    {0, 27}, {27, 28}, {57, 5}, {62, 2},                            // NavPos_01
+    {0, 5}, {8, 5}, {13, 7}, {20, 12}, {32, 32},                    // NavData_02
+    {0, 10}, {10, 10}, {20, 10}, {30, 10}, {40, 10}, {50, 12},      // NavData_01
+    {32, 8},                                                        // Klima_03
+};
+static constexpr size_t SIGNAL_COUNT = sizeof(SIGNALS) / sizeof(SIGNALS[0]);
+
+template<typename Extract>
+static double nsPerSignal(const std::vector<uint8_t>& frames, size_t iterations, Extract extract) {
+    size_t frameCount = frames.size() / 8;
+    volatile uint32_t sink = 0;
+    uint32_t acc = 0;
+    Clock::time_point start = Clock::now();
+    for (size_t it = 0; it < iterations; it++) {
+        for (size_t f = 0; f < frameCount; f++) {
+            const uint8_t* data = &frames[f * 8];
+            for (size_t s = 0; s < SIGNAL_COUNT; s++) {
+                acc += extract(data, SIGNALS[s].startBit, SIGNALS[s].length);
+            }
+        }
+    }
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    sink = acc;
+    (void)sink;
+    return ns / ((double)iterations * frameCount * SIGNAL_COUNT);
+}
+
+int main(int argc, char** argv) {
+    size_t iterations = argc > 1 ? strtoul(argv[1], nullptr, 10) : 200;
+    if (iterations == 0) {
+        fprintf(stderr, "Usage: signal_bench [iterations]\n");
+        return 2;
+    }
+
+    bool equivalent = checkEquivalence();
+
+    std::vector<uint8_t> frames(1024 * 8);
+    uint32_t seed = 0x5EED;
+    for (uint8_t& b : frames) {
+        seed = seed * 1103515245 + 12345;
+        b = seed >> 24;
+    }
+
+    printf("\nTiming: %zu signals x %zu frames x %zu iterations\n", SIGNAL_COUNT, frames.size() / 8, iterations);
+    double refLe = nsPerSignal(frames, iterations, referenceLE);
+    double wordLe = nsPerSignal(frames, iterations, [](const uint8_t* d, uint8_t s, uint8_t l) {
+        return BroadcastDecoder::extractSignalLE(d, s, l);
+    });
+    double refBe = nsPerSignal(frames, iterations, referenceBE);
+    double wordBe = nsPerSignal(frames, iterations, [](const uint8_t* d, uint8_t s, uint8_t l) {
+        return BroadcastDecoder::extractSignalBE(d, s, l);
+    });
+    printf("  LE  bitwise %6.2f ns/signal   word %6.2f ns/signal  (%.1fx)\n", refLe, wordLe, refLe / wordLe);
+    printf("  BE  bitwise %6.2f ns/signal   word %6.2f ns/signal  (%.1fx)\n", refBe, wordBe, refBe / wordBe);
+
+    return equivalent ? 0 : 1;
+}
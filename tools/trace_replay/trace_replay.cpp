@@ -0,0 +1,410 @@
+/**
+ * trace_replay - Replay a GVRET CSV trace through the vehicle stack on the host
+ *
+ * Builds the real VehicleManager, domain managers, BatteryControlChannel and
+ * BapFrameAssembler against the shims in shim/, and feeds them a recorded
+ * trace the same way the device does:
+ *
+ *   producer thread (CAN RX task)   -> hardware filter plan -> CanFrameRing
+ *   decode thread   (CAN_DEC task)  -> profiler/recorder -> VehicleManager::onCanFrames
+ *
+ * The decode thread mirrors CanManager::drainRing() and owns the replay
+ * clock (millis()/micros() = trace time of the newest decoded frame), and
+ * runs VehicleManager::loop() every LOOP_INTERVAL_MS of trace time.
+ *
+ * Usage:
+ *   trace_replay <trace.csv> [--speed N | --max] [--no-filter] [--state-only] [--no-cache] [--verbose]
+ *                [--signal KEY,ID,START,LEN,ORDER,SIGN,SCALE,OFFSET ...]
+ *
+ *   --speed N     Replay at N x the recorded timing (default 1)
+ *   --max         Replay as fast as possible; the producer waits for ring
+ *                 space instead of dropping, so this measures throughput
+ *   --no-filter   Feed every frame (ignore the TWAI acceptance filter plan)
+ *   --state-only  Print only the final domain states (regression baseline)
+ *   --no-cache    Decode every frame (disable the payload-unchanged fast path)
+ *   --verbose     Show the firmware's Serial output on stderr
+ *   --signal ...  Add a custom signal as vehicle.setCustomSignals would
+ *                 (ORDER intel|motorola, SIGN u|s; repeatable), e.g.
+ *                 --signal climateTarget,0x594,16,5,intel,u,0.5,15.5
+ *
+ * Latency is enqueue -> decode complete per frame (includes queueing, as on
+ * the device). Decode cost is batch decode time divided over its frames.
+ */
+
+#include <Arduino.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "modules/CanManager.h"
+#include "modules/CanFrameRing.h"
+#include "vehicle/VehicleManager.h"
+
+#include "GvretTrace.h"
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr uint32_t LOOP_INTERVAL_MS = 10;
+static constexpr uint32_t DECODE_WAIT_MS = 10;    // Same idle wake-up as the decode task
+
+using TraceFrame = GvretTrace::Frame;
+
+struct Options {
+    const char* path = nullptr;
+    double speed = 1.0;
+    bool maxSpeed = false;
+    bool filter = true;
+    std::vector<CustomSignalTable::Signal> signals;
+    bool stateOnly = false;
+    bool payloadCache = true;
+    bool verbose = false;
+};
+
+// =============================================================================
+// Final state dump (regression baseline: values only, no timestamps)
+// =============================================================================
+
+static void printState(VehicleManager& vehicle) {
+    const BatteryManager::State& b = vehicle.battery()->getState();
+    printf("battery.energyWh=%.1f maxEnergyWh=%.1f temperature=%.1f powerKw=%.2f\n",
+           b.energyWh(), b.maxEnergyWh(), b.temperature(), b.powerKw());
+    printf("battery.soc=%u socSource=%u charging=%d chargingSource=%u chargingActive=%d balancingActive=%d\n",
+           (unsigned)b.soc, (unsigned)b.socSource, b.charging, (unsigned)b.chargingSource,
+           b.chargingActive, b.balancingActive);
+    printf("battery.chargingMode=%u chargingStatus=%u chargingAmps=%u targetSoc=%u remainingTimeMin=%u\n",
+           b.chargingMode, b.chargingStatus, b.chargingAmps, b.targetSoc, b.remainingTimeMin);
+    printf("battery.plug lockSetup=%u lockState=%u supplyState=%u plugState=%u source=%u\n",
+           b.plugState.lockSetup, b.plugState.lockState, b.plugState.supplyState,
+           b.plugState.plugState, (unsigned)b.plugStateSource);
+
+    const ClimateManager::State& c = vehicle.climate()->getState();
+    printf("climate.insideTemp=%.1f outsideTemp=%.1f active=%d heating=%d cooling=%d ventilation=%d autoDefrost=%d timeMin=%u\n",
+           c.insideTemp(), c.outsideTemp(), c.climateActive, c.heating, c.cooling,
+           c.ventilation, c.autoDefrost, c.climateTimeMin);
+
+    const BodyManager::State& body = vehicle.body()->getState();
+    printf("body.centralLock=%u trunkOpen=%d zv02=%02X/%02X\n",
+           (unsigned)body.centralLock, body.trunkOpen, body.zv02_byte2, body.zv02_byte7);
+    const DoorState* doors[] = { &body.driverDoor, &body.passengerDoor, &body.rearLeftDoor, &body.rearRightDoor };
+    const char* doorNames[] = { "driver", "passenger", "rearLeft", "rearRight" };
+    for (size_t i = 0; i < 4; i++) {
+        printf("body.%s open=%d locked=%d window=%u\n",
+               doorNames[i], doors[i]->open, doors[i]->locked, doors[i]->windowPosition);
+    }
+
+    const DriveManager::State& d = vehicle.drive()->getState();
+    printf("drive.ignition=%u keyInserted=%d ignitionOn=%d startRequested=%d speedKmh=%.1f odometerKm=%u\n",
+           (unsigned)d.ignition, d.keyInserted, d.ignitionOn, d.startRequested, d.speedKmh(), d.odometerKm);
+    printf("drive.time=%04u-%02u-%02u %02u:%02u:%02u\n",
+           d.year, d.month, d.day, d.hour, d.minute, d.second);
+
+    const GpsManager::State& g = vehicle.gps()->getState();
+    printf("gps.lat=%.6f lon=%.6f sats=%u fix=%u altitude=%.1f utc=%u inUse=%u inView=%u accuracy=%u\n",
+           g.latitude(), g.longitude(), g.satellites, g.fixType, g.altitude(), g.utcTime,
+           g.satsInUse, g.satsInView, g.accuracy());
+    printf("gps.heading=%.1f hdop=%.1f vdop=%.1f pdop=%.1f init=%d\n",
+           g.heading(), g.hdop(), g.vdop(), g.pdop(), g.gpsInit);
+    printf("gps.mapLat=%.6f mapLon=%.6f mapHeading=%.1f lastSync=%u utcRef=%u pages=0x%x\n",
+           g.mapLatitude(), g.mapLongitude(), g.mapHeading(), g.mapMatched.heading.lastSyncSec,
+           g.mapMatched.heading.utcReference, g.mapMatched.pagesSeen);
+
+    const RangeManager::State& r = vehicle.range()->getState();
+    printf("range.totalKm=%u electricKm=%u consumption=%u displayKm=%u tendency=%u reserveWarning=%d\n",
+           r.totalRangeKm, r.electricRangeKm, (unsigned)r.consumptionKwh100km(), r.displayRangeKm,
+           (unsigned)r.tendency, r.reserveWarning);
+
+    const CustomSignalTable& custom = vehicle.customSignals();
+    for (size_t i = 0; i < custom.size(); i++) {
+        if (custom.hasValue(i)) {
+            printf("custom.%s=%g raw=%d\n", custom.getSignal(i).key, custom.getValue(i), custom.getRaw(i));
+        } else {
+            printf("custom.%s=none\n", custom.getSignal(i).key);
+        }
+    }
+
+    printf("vehicle.frames=%u wake=%s bapContinuationErrors=%u\n",
+           vehicle.getFrameCount(), vehicle.getWakeStateName(),
+           vehicle.bapChannels().getContinuationErrors());
+}
+
+// =============================================================================
+// Replay
+// =============================================================================
+
+static uint64_t percentile(std::vector<uint64_t>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    size_t index = (size_t)(p / 100.0 * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+static void usage() {
+    fprintf(stderr,
+        "Usage: trace_replay <trace.csv> [--speed N | --max] [--no-filter] [--state-only] [--no-cache] [--verbose]\n"
+        "                    [--signal KEY,ID,START,LEN,ORDER,SIGN,SCALE,OFFSET ...]\n");
+}
+
+static bool parseSignal(const char* spec, CustomSignalTable::Signal& signal) {
+    char key[64], order[16], sign[4];
+    unsigned canId, startBit, length;
+    float scale, offset;
+    if (sscanf(spec, "%63[^,],%i,%u,%u,%15[^,],%3[^,],%f,%f",
+               key, (int*)&canId, &startBit, &length, order, sign, &scale, &offset) != 8) {
+        return false;
+    }
+    memset(&signal, 0, sizeof(signal));
+    signal.canId = canId;
+    signal.startBit = startBit;
+    signal.length = length;
+    signal.order = std::string(order) == "motorola" ? BroadcastDecoder::ByteOrder::MOTOROLA
+                                                    : BroadcastDecoder::ByteOrder::INTEL;
+    signal.sign = sign[0] == 's' ? BroadcastDecoder::Signedness::SIGNED : BroadcastDecoder::Signedness::UNSIGNED;
+    signal.scale = scale;
+    signal.offset = offset;
+    if (strlen(key) >= sizeof(signal.key)) {
+        return false;
+    }
+    memcpy(signal.key, key, strlen(key) + 1);
+    return true;
+}
+
+static bool parseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--speed" && i + 1 < argc) {
+            opt.speed = atof(argv[++i]);
+            if (opt.speed <= 0) return false;
+        } else if (arg == "--max") {
+            opt.maxSpeed = true;
+        } else if (arg == "--no-filter") {
+            opt.filter = false;
+        } else if (arg == "--state-only") {
+            opt.stateOnly = true;
+        } else if (arg == "--no-cache") {
+            opt.payloadCache = false;
+        } else if (arg == "--verbose") {
+            opt.verbose = true;
+        } else if (arg == "--signal" && i + 1 < argc) {
+            CustomSignalTable::Signal signal;
+            if (!parseSignal(argv[++i], signal)) return false;
+            opt.signals.push_back(signal);
+        } else if (arg[0] != '-' && opt.path == nullptr) {
+            opt.path = argv[i];
+        } else {
+            return false;
+        }
+    }
+    return opt.path != nullptr;
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        usage();
+        return 2;
+    }
+    Serial.setEnabled(opt.verbose);
+
+    std::vector<TraceFrame> trace;
+    size_t skippedRows = 0;
+    if (!GvretTrace::load(opt.path, trace, skippedRows)) {
+        return 1;
+    }
+    if (trace.empty()) {
+        fprintf(stderr, "%s: no frames\n", opt.path);
+        return 1;
+    }
+
+    CanManager can;
+    VehicleManager vehicle(&can);
+    can.setup();
+    vehicle.setup();
+    vehicle.frameCache().setEnabled(opt.payloadCache);
+    if (!opt.signals.empty()) {
+        const char* error = nullptr;
+        if (!vehicle.setCustomSignals(opt.signals.data(), opt.signals.size(), &error)) {
+            fprintf(stderr, "Custom signal table rejected: %s\n", error);
+            return 2;
+        }
+    }
+
+    const CanFilterPlanner::Plan& plan = can.getFilterPlan();
+    CanIdProfiler& profiler = can.profiler();
+    CanFlightRecorder& recorder = can.recorder();
+
+    static CanFrameRing<CanManager::RX_RING_CAPACITY> ring;
+
+    // Enqueue time per accepted frame, indexed by acceptance order
+    std::vector<Clock::time_point> enqueueTime(trace.size());
+    std::vector<uint64_t> latencyNs;
+    std::vector<uint64_t> decodeNs;
+    latencyNs.reserve(trace.size());
+    decodeNs.reserve(trace.size());
+
+    std::atomic<bool> producerDone{false};
+    SemaphoreHandle_t rxNotify = xSemaphoreCreateBinary();   // Stands in for the task notification
+    size_t batches = 0;
+    uint32_t maxBatch = 0;
+
+    // -------------------------------------------------------------------------
+    // Decode thread (mirrors CanManager::drainRing)
+    // -------------------------------------------------------------------------
+    std::thread decoder([&]() {
+        size_t decoded = 0;
+        uint64_t nextLoopMs = 0;
+        uint64_t clockUs = 0;
+
+        for (;;) {
+            const CanRxFrame* frames = nullptr;
+            uint32_t count = ring.peekSpan(frames, CanManager::DECODE_BATCH_MAX);
+            if (count == 0) {
+                if (producerDone.load(std::memory_order_acquire) && ring.size() == 0) {
+                    break;
+                }
+                xSemaphoreTake(rxNotify, DECODE_WAIT_MS);
+                continue;
+            }
+
+            // Trace time of the newest frame (unwrapped by tracking the delta)
+            clockUs += (uint32_t)(frames[count - 1].timestampUs - (uint32_t)clockUs);
+            HostClock::setMicros(clockUs);
+
+            Clock::time_point start = Clock::now();
+            profiler.record(frames, count);
+            recorder.record(frames, count);
+            vehicle.onCanFrames(frames, count);
+            recorder.poll();
+            Clock::time_point done = Clock::now();
+
+            uint64_t perFrameNs = std::chrono::duration_cast<std::chrono::nanoseconds>(done - start).count() / count;
+            for (uint32_t i = 0; i < count; i++) {
+                latencyNs.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    done - enqueueTime[decoded + i]).count());
+                decodeNs.push_back(perFrameNs);
+            }
+            decoded += count;
+            ring.pop(count);
+
+            batches++;
+            maxBatch = std::max(maxBatch, count);
+
+            if (clockUs / 1000 >= nextLoopMs) {
+                vehicle.loop();
+                nextLoopMs = clockUs / 1000 + LOOP_INTERVAL_MS;
+            }
+        }
+    });
+
+    // -------------------------------------------------------------------------
+    // Producer (CAN RX task): pace, filter, enqueue
+    // -------------------------------------------------------------------------
+    size_t accepted = 0;
+    size_t filtered = 0;
+    size_t dropped = 0;
+    CanBusLoad busLoad;     // Trace clock, so windows match the recorded bus
+    Clock::time_point replayStart = Clock::now();
+
+    for (const TraceFrame& tf : trace) {
+        const CanRxFrame& f = tf.frame;
+
+        if (!opt.maxSpeed) {
+            // Sleep rather than spin - the decoder may share the core
+            std::this_thread::sleep_until(replayStart + std::chrono::microseconds((uint64_t)(tf.timestampUs / opt.speed)));
+        }
+
+        if (opt.filter && !CanFilterPlanner::acceptsId(plan, f.canId, f.extended)) {
+            filtered++;
+            continue;
+        }
+
+        if (busLoad.rolloverDue(f.timestampUs)) {
+            busLoad.rollover(f.timestampUs, 0, ring.getOverflows());
+        }
+        busLoad.record(f.dlc, f.extended);
+
+        // Paced replay drops on a full ring like the RX task; max speed waits
+        enqueueTime[accepted] = Clock::now();
+        bool queued = ring.push(f.canId, f.data, f.dlc, f.extended, f.timestampUs);
+        while (!queued && opt.maxSpeed) {
+            std::this_thread::yield();
+            enqueueTime[accepted] = Clock::now();
+            queued = ring.push(f.canId, f.data, f.dlc, f.extended, f.timestampUs);
+        }
+        if (!queued) {
+            dropped++;
+            continue;
+        }
+        accepted++;
+        xSemaphoreGive(rxNotify);
+    }
+
+    producerDone.store(true, std::memory_order_release);
+    xSemaphoreGive(rxNotify);
+    decoder.join();
+    double wallSec = std::chrono::duration<double>(Clock::now() - replayStart).count();
+
+    // -------------------------------------------------------------------------
+    // Report
+    // -------------------------------------------------------------------------
+    if (!opt.stateOnly) {
+        double traceSec = trace.back().timestampUs / 1e6;
+        std::sort(latencyNs.begin(), latencyNs.end());
+        std::sort(decodeNs.begin(), decodeNs.end());
+        uint64_t decodeTotalNs = 0;
+        for (uint64_t ns : decodeNs) decodeTotalNs += ns;
+
+        printf("Trace:      %s (%zu frames, %.1f s, %zu rows skipped)\n",
+               opt.path, trace.size(), traceSec, skippedRows);
+        if (opt.maxSpeed) {
+            printf("Mode:       max speed\n");
+        } else {
+            printf("Mode:       %gx\n", opt.speed);
+        }
+        if (!opt.filter) {
+            printf("Filter:     off\n");
+        } else if (plan.acceptAll) {
+            printf("Filter:     accept all\n");
+        } else {
+            printf("Filter:     %s code=0x%08lX mask=0x%08lX, %zu frames rejected\n",
+                   plan.singleFilter ? "single" : "dual",
+                   (unsigned long)plan.acceptanceCode, (unsigned long)plan.acceptanceMask, filtered);
+        }
+        printf("Frames:     %zu decoded, %zu dropped (ring overflow), ring high water %lu/%lu\n",
+               latencyNs.size(), dropped, (unsigned long)ring.getHighWater(),
+               (unsigned long)ring.capacity());
+        printf("Throughput: %.0f frames/s over %.3f s wall (trace rate %.0f frames/s)\n",
+               latencyNs.size() / wallSec, wallSec, traceSec > 0 ? trace.size() / traceSec : 0.0);
+        printf("Batches:    %zu, avg %.1f, max %u frames\n",
+               batches, batches ? (double)latencyNs.size() / batches : 0.0, maxBatch);
+        printf("Latency us: p50 %.1f  p90 %.1f  p99 %.1f  p99.9 %.1f  max %.1f (enqueue -> decoded)\n",
+               percentile(latencyNs, 50) / 1e3, percentile(latencyNs, 90) / 1e3,
+               percentile(latencyNs, 99) / 1e3, percentile(latencyNs, 99.9) / 1e3,
+               (latencyNs.empty() ? 0 : latencyNs.back()) / 1e3);
+        printf("Decode ns:  p50 %lu  p99 %lu  max %lu  mean %.0f (per frame)\n",
+               (unsigned long)percentile(decodeNs, 50), (unsigned long)percentile(decodeNs, 99),
+               (unsigned long)(decodeNs.empty() ? 0 : decodeNs.back()),
+               decodeNs.empty() ? 0.0 : (double)decodeTotalNs / decodeNs.size());
+        const CanBusLoad::Window& loadWindow = busLoad.getWindow(CanBusLoad::WINDOW_COUNT - 1);
+        printf("Bus load:   %.1f%% expected, %.1f%% worst-case stuffing (last %u s at 500 kbps), peak %lu frames/s\n",
+               busLoad.loadPercent(loadWindow, false), busLoad.loadPercent(loadWindow, true),
+               loadWindow.seconds, (unsigned long)busLoad.getPeakFramesPerSecond());
+        PayloadCache& cache = vehicle.frameCache();
+        uint32_t cacheHits = cache.getTotalHits();
+        uint32_t cacheTotal = cacheHits + cache.getTotalMisses();
+        printf("Payload:    %lu/%lu standard frames unchanged (%.1f%%), decode skipped%s\n",
+               (unsigned long)cacheHits, (unsigned long)cacheTotal,
+               cacheTotal ? cacheHits * 100.0 / cacheTotal : 0.0, cache.isEnabled() ? "" : " (cache off)");
+        printf("Profiler:   %u IDs, recorder %s (%lu frames)\n",
+               (unsigned)profiler.getIdCount(), CanFlightRecorder::stateName(recorder.getState()),
+               (unsigned long)recorder.getRecordedFrames());
+        printf("\n");
+    }
+
+    printState(vehicle);
+    return 0;
+}